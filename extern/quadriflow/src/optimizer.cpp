@@ -13,6 +13,10 @@
 #include "flow.hpp"
 #include "parametrizer.hpp"
 
+#ifdef WITH_TBB
+#include "tbb/tbb.h"
+#endif
+
 namespace qflow {
 
 #ifdef WITH_CUDA
@@ -27,6 +31,23 @@ template<class T>
 using LinearSolver = Eigen::SparseLU<T>;
 #endif
 
+// Run `func` for every index in [0, size). The orientation and position fields are smoothed in
+// phases of a graph coloring, so the vertices within a phase are independent of each other.
+template <typename Func>
+static void parallel_for_index(int size, const Func& func) {
+#ifdef WITH_TBB
+    tbb::parallel_for(tbb::blocked_range<int>(0, size, GRAIN_SIZE),
+                      [&](const tbb::blocked_range<int>& range) {
+                          for (int i = range.begin(); i != range.end(); ++i) func(i);
+                      });
+#else
+#ifdef WITH_OMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < size; ++i) func(i);
+#endif
+}
+
 Optimizer::Optimizer() {}
 
 void Optimizer::optimize_orientations(Hierarchy& mRes) {
@@ -49,10 +70,7 @@ void Optimizer::optimize_orientations(Hierarchy& mRes) {
         for (int iter = 0; iter < levelIterations; ++iter) {
             for (int phase = 0; phase < phases.size(); ++phase) {
                 auto& p = phases[phase];
-#ifdef WITH_OMP
-#pragma omp parallel for
-#endif
-                for (int pi = 0; pi < p.size(); ++pi) {
+                parallel_for_index(p.size(), [&](int pi) {
                     int i = p[pi];
                     const Vector3d n_i = N.col(i);
                     double weight_sum = 0.0f;
@@ -88,7 +106,7 @@ void Optimizer::optimize_orientations(Hierarchy& mRes) {
                     if (weight_sum > 0) {
                         Q.col(i) = sum;
                     }
-                }
+                });
             }
         }
         if (level > 0) {
@@ -96,17 +114,14 @@ void Optimizer::optimize_orientations(Hierarchy& mRes) {
             const MatrixXi& toUpper = mRes.mToUpper[level - 1];
             MatrixXd& destField = mRes.mQ[level - 1];
             const MatrixXd& N = mRes.mN[level - 1];
-#ifdef WITH_OMP
-#pragma omp parallel for
-#endif
-            for (int i = 0; i < srcField.cols(); ++i) {
+            parallel_for_index(srcField.cols(), [&](int i) {
                 for (int k = 0; k < 2; ++k) {
                     int dest = toUpper(k, i);
                     if (dest == -1) continue;
                     Vector3d q = srcField.col(i), n = N.col(dest);
                     destField.col(dest) = q - n * n.dot(q);
                 }
-            }
+            });
         }
     }
 
@@ -116,10 +131,7 @@ void Optimizer::optimize_orientations(Hierarchy& mRes) {
         const MatrixXd& Q = mRes.mQ[l];
         MatrixXd& Q_next = mRes.mQ[l + 1];
         auto& toUpper = mRes.mToUpper[l];
-#ifdef WITH_OMP
-#pragma omp parallel for
-#endif
-        for (int i = 0; i < toUpper.cols(); ++i) {
+        parallel_for_index(toUpper.cols(), [&](int i) {
             Vector2i upper = toUpper.col(i);
             Vector3d q0 = Q.col(upper[0]);
             Vector3d n0 = N.col(upper[0]);
@@ -138,7 +150,7 @@ void Optimizer::optimize_orientations(Hierarchy& mRes) {
             if (q.squaredNorm() > RCPOVERFLOW) q.normalize();
 
             Q_next.col(i) = q;
-        }
+        });
     }
 
 #endif
@@ -284,10 +296,7 @@ void Optimizer::optimize_positions(Hierarchy& mRes, int with_scale) {
             auto& phases = mRes.mPhases[level];
             for (int phase = 0; phase < phases.size(); ++phase) {
                 auto& p = phases[phase];
-#ifdef WITH_OMP
-#pragma omp parallel for
-#endif
-                for (int pi = 0; pi < p.size(); ++pi) {
+                parallel_for_index(p.size(), [&](int pi) {
                     int i = p[pi];
                     double scale_x = mRes.mScale;
                     double scale_y = mRes.mScale;
@@ -347,7 +356,7 @@ void Optimizer::optimize_positions(Hierarchy& mRes, int with_scale) {
                         O.col(i) = position_round_4(sum, q_i, n_i, v_i, scale_x, scale_y,
                                                     inv_scale_x, inv_scale_y);
                     }
-                }
+                });
             }
         }
         if (level > 0) {
@@ -356,10 +365,7 @@ void Optimizer::optimize_positions(Hierarchy& mRes, int with_scale) {
             MatrixXd& destField = mRes.mO[level - 1];
             const MatrixXd& N = mRes.mN[level - 1];
             const MatrixXd& V = mRes.mV[level - 1];
-#ifdef WITH_OMP
-#pragma omp parallel for
-#endif
-            for (int i = 0; i < srcField.cols(); ++i) {
+            parallel_for_index(srcField.cols(), [&](int i) {
                 for (int k = 0; k < 2; ++k) {
                     int dest = toUpper(k, i);
                     if (dest == -1) continue;
@@ -367,7 +373,7 @@ void Optimizer::optimize_positions(Hierarchy& mRes, int with_scale) {
                     o -= n * n.dot(o - v);
                     destField.col(dest) = o;
                 }
-            }
+            });
         }
     }
 #endif
@@ -262,17 +262,10 @@ void EIG_linear_solver_right_hand_side_add(LinearSolver *solver, int rhs, int in
 
 /* Solve */
 
-bool EIG_linear_solver_solve(LinearSolver *solver)
+static bool linear_solver_factorize(LinearSolver *solver)
 {
-  /* nothing to solve, perhaps all variables were locked */
-  if (solver->m == 0 || solver->n == 0) {
-    return true;
-  }
-
   bool result = true;
 
-  assert(solver->state != LinearSolver::STATE_VARIABLES_CONSTRUCT);
-
   if (solver->state == LinearSolver::STATE_MATRIX_CONSTRUCT) {
     /* create matrix from triplets */
     solver->M.resize(solver->m, solver->n);
@@ -298,6 +291,32 @@ bool EIG_linear_solver_solve(LinearSolver *solver)
     solver->state = LinearSolver::STATE_MATRIX_SOLVED;
   }
 
+  return result;
+}
+
+bool EIG_linear_solver_factorize(LinearSolver *solver)
+{
+  linear_solver_ensure_matrix_construct(solver);
+
+  /* nothing to solve, perhaps all variables were locked */
+  if (solver->m == 0 || solver->n == 0) {
+    return true;
+  }
+
+  return linear_solver_factorize(solver);
+}
+
+bool EIG_linear_solver_solve(LinearSolver *solver)
+{
+  /* nothing to solve, perhaps all variables were locked */
+  if (solver->m == 0 || solver->n == 0) {
+    return true;
+  }
+
+  assert(solver->state != LinearSolver::STATE_VARIABLES_CONSTRUCT);
+
+  bool result = linear_solver_factorize(solver);
+
   if (result) {
     /* solve for each right hand side */
     for (int rhs = 0; rhs < solver->num_rhs; rhs++) {
@@ -344,6 +363,34 @@ bool EIG_linear_solver_solve(LinearSolver *solver)
   return result;
 }
 
+bool EIG_linear_solver_solve_vector(const LinearSolver *solver, const double *b, double *x)
+{
+  assert(!solver->least_squares);
+
+  if (solver->m == 0 || solver->n == 0) {
+    return true;
+  }
+  if (solver->state != LinearSolver::STATE_MATRIX_SOLVED ||
+      solver->sparseLU->info() != Eigen::Success)
+  {
+    return false;
+  }
+
+  EigenVectorX b_vec(solver->m);
+  for (int i = 0; i < solver->num_variables; i++) {
+    assert(!solver->variable[i].locked);
+    b_vec[solver->variable[i].index] = b[i];
+  }
+
+  const EigenVectorX x_vec = solver->sparseLU->solve(b_vec);
+
+  for (int i = 0; i < solver->num_variables; i++) {
+    x[i] = x_vec[solver->variable[i].index];
+  }
+
+  return true;
+}
+
 /* Debugging */
 
 void EIG_linear_solver_print_matrix(LinearSolver *solver)
@@ -44,6 +44,17 @@ void EIG_linear_solver_right_hand_side_add(LinearSolver *solver, int rhs, int in
 
 bool EIG_linear_solver_solve(LinearSolver *solver);
 
+/* Factorize the matrix without solving, so that #EIG_linear_solver_solve_vector can be used. */
+
+bool EIG_linear_solver_factorize(LinearSolver *solver);
+
+/* Solve for a right hand side using the factorization of a previous solve or factorize call.
+ * The solver is not modified, so different right hand sides can be solved from multiple threads
+ * at the same time. Both b and x are indexed by variable, locked variables and least squares
+ * solvers are not supported. */
+
+bool EIG_linear_solver_solve_vector(const LinearSolver *solver, const double *b, double *x);
+
 /* Debugging */
 
 void EIG_linear_solver_print_matrix(LinearSolver *solver);
@@ -118,6 +118,7 @@ int insert_bezt_fcurve(FCurve *fcu, const BezTriple *bezt, eInsertKeyFlags flag)
 
   /* Are there already keyframes? */
   if (fcu->bezt) {
+    BKE_fcurve_bezt_ensure_mutable(fcu);
     bool replace;
     i = BKE_fcurve_bezt_binarysearch_index(fcu->bezt, bezt->vec[1][0], fcu->totvert, &replace);
 
@@ -497,6 +498,7 @@ void bake_fcurve(FCurve *fcu,
 
   if (fcu->bezt != nullptr) {
     /* Can happen if we removed all keys beforehand. */
+    BKE_fcurve_bezt_ensure_mutable(fcu);
     MEM_freeN(fcu->bezt);
   }
   MEM_freeN(baked_keys);
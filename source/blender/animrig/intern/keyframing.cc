@@ -271,6 +271,7 @@ static void make_new_fcurve_cyclic(FCurve *fcu, const blender::float2 &action_ra
   if (fcu->totvert != 1 || !fcu->bezt) {
     return;
   }
+  BKE_fcurve_bezt_ensure_mutable(fcu);
 
   const float period = action_range[1] - action_range[0];
 
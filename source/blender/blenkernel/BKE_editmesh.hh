@@ -13,6 +13,8 @@
  */
 
 #include <array>
+#include <memory>
+#include <mutex>
 
 #include "BLI_array.hh"
 #include "BLI_math_vector_types.hh"
@@ -30,6 +32,27 @@ struct Mesh;
 struct Object;
 struct Scene;
 
+namespace blender::bke {
+
+/**
+ * The last conversion of an edit-mesh to a #Mesh for evaluation. It's kept so that edits which
+ * don't change the topology can be patched into it instead of converting the whole #BMesh again,
+ * see #BKE_editmesh_mesh_eval_sync.
+ */
+struct EditMeshEvalSync {
+  /** Evaluated meshes wrapping the same edit-mesh can be converted from multiple threads. */
+  std::mutex mutex;
+  Mesh *mesh = nullptr;
+  /** The #BMesh the mesh was converted from, and the #BMesh.sync_count after the conversion. */
+  const BMesh *bm = nullptr;
+  int sync_count = 0;
+  CustomData_MeshMasks cd_mask_extra = {};
+
+  ~EditMeshEvalSync();
+};
+
+}  // namespace blender::bke
+
 /**
  * This structure is used for mesh edit-mode.
  *
@@ -64,6 +87,10 @@ struct BMEditMesh {
    * Set #Main.is_memfile_undo_flush_needed when enabling.
    */
   char needs_flush_to_id;
+
+  /** Shared by shallow copies of this struct, since they also share the #BMesh. */
+  std::shared_ptr<blender::bke::EditMeshEvalSync> eval_sync =
+      std::make_shared<blender::bke::EditMeshEvalSync>();
 };
 
 /* editmesh.cc */
@@ -100,6 +127,16 @@ BMEditMesh *BKE_editmesh_from_object(Object *ob);
  */
 void BKE_editmesh_free_data(BMEditMesh *em);
 
+/**
+ * Fill the empty \a mesh with the edit-mesh geometry for evaluation, like
+ * #BM_mesh_bm_to_me_for_eval. The result of the previous conversion is kept in
+ * #BMEditMesh.eval_sync, so only changes declared with #BM_mesh_sync_tag_changes have to be
+ * copied, and the arrays are shared with \a mesh rather than copied again.
+ */
+void BKE_editmesh_mesh_eval_sync(BMEditMesh &em,
+                                 const CustomData_MeshMasks &cd_mask_extra,
+                                 Mesh &mesh);
+
 blender::Array<blender::float3> BKE_editmesh_vert_coords_alloc(Depsgraph *depsgraph,
                                                                BMEditMesh *em,
                                                                Scene *scene,
@@ -219,8 +219,17 @@ FCurve *BKE_fcurve_create(void);
 void BKE_fcurve_free(FCurve *fcu);
 /**
  * Duplicate a F-Curve.
+ *
+ * \param share_keyframes: Share the keyframe array with the source F-Curve instead of copying
+ * it. Used for evaluated copies, which do not modify the keyframes.
+ */
+FCurve *BKE_fcurve_copy(const FCurve *fcu, bool share_keyframes = false);
+/**
+ * Make sure the keyframe array is not shared with other F-Curves, so that it can be modified,
+ * reallocated or freed with the regular `MEM_*` functions. Must be called before any such change
+ * of #FCurve.bezt.
  */
-FCurve *BKE_fcurve_copy(const FCurve *fcu);
+void BKE_fcurve_bezt_ensure_mutable(FCurve *fcu);
 /**
  * Frees a list of F-Curves.
  */
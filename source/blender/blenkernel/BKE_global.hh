@@ -258,6 +258,11 @@ enum {
 
   G_DEBUG_GHOST = (1 << 23),  /* Debug GHOST module. */
   G_DEBUG_WINTAB = (1 << 24), /* Debug Wintab. */
+
+  G_DEBUG_DEPSGRAPH_VALIDATE = (1 << 25), /* Compare partially updated depsgraph relations
+                                           * against a full rebuild. */
+  G_DEBUG_DEPSGRAPH_PROFILE = (1 << 26),  /* Write per-operation evaluation statistics to the
+                                           * file from `--debug-depsgraph-profile`. */
 };
 
 #define G_DEBUG_ALL \
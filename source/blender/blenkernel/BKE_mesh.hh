@@ -89,6 +89,12 @@ void normals_calc_faces(Span<float3> vert_positions,
                         OffsetIndices<int> faces,
                         Span<int> corner_verts,
                         MutableSpan<float3> face_normals);
+/** Calculate normals of the faces in the mask only, other values are left unchanged. */
+void normals_calc_faces(Span<float3> vert_positions,
+                        OffsetIndices<int> faces,
+                        Span<int> corner_verts,
+                        const IndexMask &face_mask,
+                        MutableSpan<float3> face_normals);
 
 /**
  * Calculate vertex normals directly into the result array.
@@ -105,6 +111,14 @@ void normals_calc_verts(Span<float3> vert_positions,
                         GroupedSpan<int> vert_to_face_map,
                         Span<float3> face_normals,
                         MutableSpan<float3> vert_normals);
+/** Calculate normals of the vertices in the mask only, other values are left unchanged. */
+void normals_calc_verts(Span<float3> vert_positions,
+                        OffsetIndices<int> faces,
+                        Span<int> corner_verts,
+                        GroupedSpan<int> vert_to_face_map,
+                        Span<float3> face_normals,
+                        const IndexMask &vert_mask,
+                        MutableSpan<float3> vert_normals);
 
 /** \} */
 
@@ -123,8 +123,22 @@ enum ModifierTypeFlag {
 
   /** Accepts #GreasePencil data input. */
   eModifierTypeFlag_AcceptsGreasePencil = (1 << 12),
+
+  /**
+   * #ModifierTypeInfo::deform_verts tags the moved vertices of the mesh itself, so that only the
+   * normals around them are recomputed.
+   */
+  eModifierTypeFlag_TagsChangedPositions = (1 << 13),
+
+  /**
+   * #ModifierTypeInfo::modify_geometry_set handles any geometry set, not only the mesh component,
+   * so the modifier can run on volumes but not on object types that don't output geometry sets
+   * (surfaces and lattices). Modifiers that only use geometry sets to add optional instances to a
+   * mesh result shouldn't set this.
+   */
+  eModifierTypeFlag_AcceptsGeometrySet = (1 << 14),
 };
-ENUM_OPERATORS(ModifierTypeFlag, eModifierTypeFlag_AcceptsGreasePencil)
+ENUM_OPERATORS(ModifierTypeFlag, eModifierTypeFlag_AcceptsGeometrySet)
 
 using IDWalkFunc = void (*)(void *user_data, Object *ob, ID **idpoin, int cb_flag);
 using TexWalkFunc = void (*)(void *user_data, Object *ob, ModifierData *md, const char *propname);
@@ -146,6 +146,9 @@ struct Displacement {
   void *user_data;
 };
 
+/* Opaque identity of the mesh data a subdivision surface descriptor was created from. */
+struct SourceMeshKey;
+
 /* This structure contains everything needed to construct subdivided surface.
  * It does not specify storage, memory layout or anything else.
  * It is possible to create different storage's (like, grid based CPU side
@@ -166,6 +169,9 @@ struct Subdiv {
   Displacement *displacement_evaluator;
   /* Statistics for debugging. */
   SubdivStats stats;
+  /* Identity of the mesh arrays the topology refiner was created from, used to skip the full
+   * topology comparison when only vertex positions changed. See #update_from_mesh(). */
+  SourceMeshKey *source_mesh_key;
 
   /* Cached values, are not supposed to be accessed directly. */
   struct {
@@ -240,6 +246,9 @@ Subdiv *new_from_mesh(const Settings *settings, const Mesh *mesh);
 Subdiv *update_from_converter(Subdiv *subdiv,
                               const Settings *settings,
                               OpenSubdiv_Converter *converter);
+/* Same as above for a mesh. When the mesh still references the very same implicitly shared
+ * topology arrays the descriptor was created from, it is re-used without comparing the
+ * topology, which makes the common animated case of only vertex positions changing cheap. */
 Subdiv *update_from_mesh(Subdiv *subdiv, const Settings *settings, const Mesh *mesh);
 
 void free(Subdiv *subdiv);
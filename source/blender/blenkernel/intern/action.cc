@@ -128,8 +128,10 @@ static void action_copy_data(Main * /*bmain*/,
     /* Duplicate F-Curve. */
 
     /* XXX TODO: pass sub-data flag?
-     * But surprisingly does not seem to be doing any ID reference-counting. */
-    fcurve_dst = BKE_fcurve_copy(fcurve_src);
+     * But surprisingly does not seem to be doing any ID reference-counting.
+     *
+     * Evaluated copies never modify the keyframes, so they share them with the original. */
+    fcurve_dst = BKE_fcurve_copy(fcurve_src, (flag & LIB_ID_COPY_SET_COPIED_ON_WRITE) != 0);
 
     BLI_addtail(&action_dst.curves, fcurve_dst);
 
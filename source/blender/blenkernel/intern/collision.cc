@@ -15,9 +15,12 @@
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_math_geom.h"
+#include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -646,147 +649,199 @@ static void cloth_collision_impulse_vert(const float clamp_sq,
   vert->impulse_count++;
 }
 
-static int cloth_collision_response_static(ClothModifierData *clmd,
-                                           CollisionModifierData *collmd,
-                                           Object *collob,
-                                           CollPair *collpair,
-                                           uint collision_count,
-                                           const float dt)
-{
-  int result = 0;
-  Cloth *cloth = clmd->clothObject;
-  const float clamp_sq = square_f(clmd->coll_parms->clamp * dt);
-  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
-  const float epsilon2 = BLI_bvhtree_get_epsilon(collmd->bvhtree);
-  const float min_distance = (clmd->coll_parms->epsilon + epsilon2) * (8.0f / 9.0f);
+/** Outcome of the collision response computation for a single collision pair. */
+enum class CollPairResponse : int8_t {
+  /** The pair is not handled by the static collision response. */
+  Skip,
+  /** No impulse is needed for this pair. */
+  None,
+  /** Impulses were computed for the vertices of the pair. */
+  Impulse,
+};
 
+/**
+ * Response to a single collision pair. This only reads the cloth state, so that all pairs can be
+ * processed in parallel. The resulting impulses are applied to the vertices afterwards.
+ */
+static CollPairResponse cloth_collision_response_pair(const ClothModifierData *clmd,
+                                                      const CollisionModifierData *collmd,
+                                                      const Object *collob,
+                                                      const CollPair *collpair,
+                                                      const float min_distance,
+                                                      const float time_multiplier,
+                                                      float r_impulses[3][3])
+{
+  const Cloth *cloth = clmd->clothObject;
   const bool is_hair = (clmd->hairdata != nullptr);
-  for (int i = 0; i < collision_count; i++, collpair++) {
-    float i1[3], i2[3], i3[3];
-    float v1[3], v2[3], relativeVelocity[3];
-    zero_v3(i1);
-    zero_v3(i2);
-    zero_v3(i3);
-
-    /* Only handle static collisions here. */
-    if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
-    }
+  float *i1 = r_impulses[0], *i2 = r_impulses[1], *i3 = r_impulses[2];
+  float v1[3], v2[3], relativeVelocity[3];
+  zero_v3(i1);
+  zero_v3(i2);
+  zero_v3(i3);
 
-    /* Compute barycentric coordinates and relative "velocity" for both collision points. */
-    float w1 = collpair->aw1, w2 = collpair->aw2, w3 = collpair->aw3;
-    float u1 = collpair->bw1, u2 = collpair->bw2, u3 = collpair->bw3;
+  /* Only handle static collisions here. */
+  if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+    return CollPairResponse::Skip;
+  }
 
-    if (is_hair) {
-      interp_v3_v3v3(v1, cloth->verts[collpair->ap1].tv, cloth->verts[collpair->ap2].tv, w2);
-    }
-    else {
-      collision_interpolateOnTriangle(v1,
-                                      cloth->verts[collpair->ap1].tv,
-                                      cloth->verts[collpair->ap2].tv,
-                                      cloth->verts[collpair->ap3].tv,
-                                      w1,
-                                      w2,
-                                      w3);
-    }
+  /* Compute barycentric coordinates and relative "velocity" for both collision points. */
+  float w1 = collpair->aw1, w2 = collpair->aw2, w3 = collpair->aw3;
+  float u1 = collpair->bw1, u2 = collpair->bw2, u3 = collpair->bw3;
 
-    collision_interpolateOnTriangle(v2,
-                                    collmd->current_v[collpair->bp1],
-                                    collmd->current_v[collpair->bp2],
-                                    collmd->current_v[collpair->bp3],
-                                    u1,
-                                    u2,
-                                    u3);
-
-    sub_v3_v3v3(relativeVelocity, v2, v1);
-
-    /* Calculate the normal component of the relative velocity
-     * (actually only the magnitude - the direction is stored in 'normal'). */
-    const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
-    const float d = min_distance - collpair->distance;
-
-    /* If magrelVel < 0 the edges are approaching each other. */
-    if (magrelVel > 0.0f) {
-      /* Calculate Impulse magnitude to stop all motion in normal direction. */
-      float magtangent = 0, repulse = 0;
-      double impulse = 0.0;
-      float vrel_t_pre[3];
-      float temp[3];
-
-      /* Calculate tangential velocity. */
-      copy_v3_v3(temp, collpair->normal);
-      mul_v3_fl(temp, magrelVel);
-      sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
-
-      /* Decrease in magnitude of relative tangential velocity due to coulomb friction
-       * in original formula "magrelVel" should be the
-       * "change of relative velocity in normal direction". */
-      magtangent = min_ff(collob->pd->pdef_cfrict * 0.01f * magrelVel, len_v3(vrel_t_pre));
-
-      /* Apply friction impulse. */
-      if (magtangent > ALMOST_ZERO) {
-        normalize_v3(vrel_t_pre);
-
-        impulse = magtangent / 1.5;
-
-        VECADDMUL(i1, vrel_t_pre, double(w1) * impulse);
-        VECADDMUL(i2, vrel_t_pre, double(w2) * impulse);
-
-        if (!is_hair) {
-          VECADDMUL(i3, vrel_t_pre, double(w3) * impulse);
-        }
-      }
+  if (is_hair) {
+    interp_v3_v3v3(v1, cloth->verts[collpair->ap1].tv, cloth->verts[collpair->ap2].tv, w2);
+  }
+  else {
+    collision_interpolateOnTriangle(v1,
+                                    cloth->verts[collpair->ap1].tv,
+                                    cloth->verts[collpair->ap2].tv,
+                                    cloth->verts[collpair->ap3].tv,
+                                    w1,
+                                    w2,
+                                    w3);
+  }
+
+  collision_interpolateOnTriangle(v2,
+                                  collmd->current_v[collpair->bp1],
+                                  collmd->current_v[collpair->bp2],
+                                  collmd->current_v[collpair->bp3],
+                                  u1,
+                                  u2,
+                                  u3);
 
-      /* Apply velocity stopping impulse. */
-      impulse = magrelVel / 1.5f;
+  sub_v3_v3v3(relativeVelocity, v2, v1);
 
-      VECADDMUL(i1, collpair->normal, double(w1) * impulse);
-      VECADDMUL(i2, collpair->normal, double(w2) * impulse);
-      if (!is_hair) {
-        VECADDMUL(i3, collpair->normal, double(w3) * impulse);
-      }
+  /* Calculate the normal component of the relative velocity
+   * (actually only the magnitude - the direction is stored in 'normal'). */
+  const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
+  const float d = min_distance - collpair->distance;
 
-      if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
-        repulse = std::min(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+  /* If magrelVel < 0 the edges are approaching each other. */
+  if (magrelVel > 0.0f) {
+    /* Calculate Impulse magnitude to stop all motion in normal direction. */
+    float magtangent = 0, repulse = 0;
+    double impulse = 0.0;
+    float vrel_t_pre[3];
+    float temp[3];
 
-        /* Stay on the safe side and clamp repulse. */
-        if (impulse > ALMOST_ZERO) {
-          repulse = min_ff(repulse, 5.0f * impulse);
-        }
+    /* Calculate tangential velocity. */
+    copy_v3_v3(temp, collpair->normal);
+    mul_v3_fl(temp, magrelVel);
+    sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
 
-        repulse = max_ff(impulse, repulse);
+    /* Decrease in magnitude of relative tangential velocity due to coulomb friction
+     * in original formula "magrelVel" should be the
+     * "change of relative velocity in normal direction". */
+    magtangent = min_ff(collob->pd->pdef_cfrict * 0.01f * magrelVel, len_v3(vrel_t_pre));
 
-        impulse = repulse / 1.5f;
+    /* Apply friction impulse. */
+    if (magtangent > ALMOST_ZERO) {
+      normalize_v3(vrel_t_pre);
 
-        VECADDMUL(i1, collpair->normal, impulse);
-        VECADDMUL(i2, collpair->normal, impulse);
-        if (!is_hair) {
-          VECADDMUL(i3, collpair->normal, impulse);
-        }
+      impulse = magtangent / 1.5;
+
+      VECADDMUL(i1, vrel_t_pre, double(w1) * impulse);
+      VECADDMUL(i2, vrel_t_pre, double(w2) * impulse);
+
+      if (!is_hair) {
+        VECADDMUL(i3, vrel_t_pre, double(w3) * impulse);
       }
+    }
 
-      result = 1;
+    /* Apply velocity stopping impulse. */
+    impulse = magrelVel / 1.5f;
+
+    VECADDMUL(i1, collpair->normal, double(w1) * impulse);
+    VECADDMUL(i2, collpair->normal, double(w2) * impulse);
+    if (!is_hair) {
+      VECADDMUL(i3, collpair->normal, double(w3) * impulse);
     }
-    else if (d > ALMOST_ZERO) {
+
+    if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
+      repulse = std::min(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+
       /* Stay on the safe side and clamp repulse. */
-      float repulse = d / time_multiplier;
-      float impulse = repulse / 4.5f;
+      if (impulse > ALMOST_ZERO) {
+        repulse = min_ff(repulse, 5.0f * impulse);
+      }
+
+      repulse = max_ff(impulse, repulse);
 
-      VECADDMUL(i1, collpair->normal, w1 * impulse);
-      VECADDMUL(i2, collpair->normal, w2 * impulse);
+      impulse = repulse / 1.5f;
 
+      VECADDMUL(i1, collpair->normal, impulse);
+      VECADDMUL(i2, collpair->normal, impulse);
       if (!is_hair) {
-        VECADDMUL(i3, collpair->normal, w3 * impulse);
+        VECADDMUL(i3, collpair->normal, impulse);
       }
+    }
+
+    return CollPairResponse::Impulse;
+  }
+  else if (d > ALMOST_ZERO) {
+    /* Stay on the safe side and clamp repulse. */
+    float repulse = d / time_multiplier;
+    float impulse = repulse / 4.5f;
 
+    VECADDMUL(i1, collpair->normal, w1 * impulse);
+    VECADDMUL(i2, collpair->normal, w2 * impulse);
+
+    if (!is_hair) {
+      VECADDMUL(i3, collpair->normal, w3 * impulse);
+    }
+
+    return CollPairResponse::Impulse;
+  }
+
+  return CollPairResponse::None;
+}
+
+static int cloth_collision_response_static(ClothModifierData *clmd,
+                                           CollisionModifierData *collmd,
+                                           Object *collob,
+                                           CollPair *collpair,
+                                           uint collision_count,
+                                           const float dt)
+{
+  using namespace blender;
+  int result = 0;
+  Cloth *cloth = clmd->clothObject;
+  const float clamp_sq = square_f(clmd->coll_parms->clamp * dt);
+  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
+  const float epsilon2 = BLI_bvhtree_get_epsilon(collmd->bvhtree);
+  const float min_distance = (clmd->coll_parms->epsilon + epsilon2) * (8.0f / 9.0f);
+
+  const bool is_hair = (clmd->hairdata != nullptr);
+
+  /* Compute the impulses of all pairs in parallel, then accumulate them on the vertices in the
+   * original order, since the accumulation depends on it. */
+  Array<CollPairResponse> responses(collision_count);
+  Array<float3x3> impulses(collision_count);
+  threading::parallel_for(IndexRange(collision_count), 256, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      responses[i] = cloth_collision_response_pair(clmd,
+                                                   collmd,
+                                                   collob,
+                                                   &collpair[i],
+                                                   min_distance,
+                                                   time_multiplier,
+                                                   impulses[i].ptr());
+    }
+  });
+
+  for (int i = 0; i < collision_count; i++, collpair++) {
+    if (responses[i] == CollPairResponse::Skip) {
+      continue;
+    }
+    if (responses[i] == CollPairResponse::Impulse) {
       result = 1;
     }
 
     if (result) {
-      cloth_collision_impulse_vert(clamp_sq, i1, &cloth->verts[collpair->ap1]);
-      cloth_collision_impulse_vert(clamp_sq, i2, &cloth->verts[collpair->ap2]);
+      cloth_collision_impulse_vert(clamp_sq, impulses[i][0], &cloth->verts[collpair->ap1]);
+      cloth_collision_impulse_vert(clamp_sq, impulses[i][1], &cloth->verts[collpair->ap2]);
       if (!is_hair) {
-        cloth_collision_impulse_vert(clamp_sq, i3, &cloth->verts[collpair->ap3]);
+        cloth_collision_impulse_vert(clamp_sq, impulses[i][2], &cloth->verts[collpair->ap3]);
       }
     }
   }
@@ -794,93 +849,108 @@ static int cloth_collision_response_static(ClothModifierData *clmd,
   return result;
 }
 
-static int cloth_selfcollision_response_static(ClothModifierData *clmd,
-                                               CollPair *collpair,
-                                               uint collision_count,
-                                               const float dt)
+/** Same as #cloth_collision_response_pair for self collisions, with impulses for 6 vertices. */
+static CollPairResponse cloth_selfcollision_response_pair(const ClothModifierData *clmd,
+                                                          const CollPair *collpair,
+                                                          const float min_distance,
+                                                          const float time_multiplier,
+                                                          float r_impulses[6][3])
 {
-  int result = 0;
-  Cloth *cloth = clmd->clothObject;
-  const float clamp_sq = square_f(clmd->coll_parms->self_clamp * dt);
-  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
-  const float min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f);
+  const Cloth *cloth = clmd->clothObject;
+  float(*ia)[3] = r_impulses;
+  float(*ib)[3] = r_impulses + 3;
+  memset(r_impulses, 0, sizeof(float[6][3]));
+  float v1[3], v2[3], relativeVelocity[3];
+
+  /* Only handle static collisions here. */
+  if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+    return CollPairResponse::Skip;
+  }
+
+  /* Retrieve barycentric coordinates for both collision points. */
+  float w1 = collpair->aw1, w2 = collpair->aw2, w3 = collpair->aw3;
+  float u1 = collpair->bw1, u2 = collpair->bw2, u3 = collpair->bw3;
+
+  /* Calculate relative "velocity". */
+  collision_interpolateOnTriangle(v1,
+                                  cloth->verts[collpair->ap1].tv,
+                                  cloth->verts[collpair->ap2].tv,
+                                  cloth->verts[collpair->ap3].tv,
+                                  w1,
+                                  w2,
+                                  w3);
+
+  collision_interpolateOnTriangle(v2,
+                                  cloth->verts[collpair->bp1].tv,
+                                  cloth->verts[collpair->bp2].tv,
+                                  cloth->verts[collpair->bp3].tv,
+                                  u1,
+                                  u2,
+                                  u3);
 
-  for (int i = 0; i < collision_count; i++, collpair++) {
-    float ia[3][3] = {{0.0f}};
-    float ib[3][3] = {{0.0f}};
-    float v1[3], v2[3], relativeVelocity[3];
+  sub_v3_v3v3(relativeVelocity, v2, v1);
 
-    /* Only handle static collisions here. */
-    if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
+  /* Calculate the normal component of the relative velocity
+   * (actually only the magnitude - the direction is stored in 'normal'). */
+  const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
+  const float d = min_distance - collpair->distance;
+
+  /* TODO: Impulses should be weighed by mass as this is self col,
+   * this has to be done after mass distribution is implemented. */
+
+  /* If magrelVel < 0 the edges are approaching each other. */
+  if (magrelVel > 0.0f) {
+    /* Calculate Impulse magnitude to stop all motion in normal direction. */
+    float magtangent = 0, repulse = 0;
+    double impulse = 0.0;
+    float vrel_t_pre[3];
+    float temp[3];
+
+    /* Calculate tangential velocity. */
+    copy_v3_v3(temp, collpair->normal);
+    mul_v3_fl(temp, magrelVel);
+    sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
+
+    /* Decrease in magnitude of relative tangential velocity due to coulomb friction
+     * in original formula "magrelVel" should be the
+     * "change of relative velocity in normal direction". */
+    magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
+
+    /* Apply friction impulse. */
+    if (magtangent > ALMOST_ZERO) {
+      normalize_v3(vrel_t_pre);
+
+      impulse = magtangent / 1.5;
+
+      VECADDMUL(ia[0], vrel_t_pre, double(w1) * impulse);
+      VECADDMUL(ia[1], vrel_t_pre, double(w2) * impulse);
+      VECADDMUL(ia[2], vrel_t_pre, double(w3) * impulse);
+
+      VECADDMUL(ib[0], vrel_t_pre, double(u1) * -impulse);
+      VECADDMUL(ib[1], vrel_t_pre, double(u2) * -impulse);
+      VECADDMUL(ib[2], vrel_t_pre, double(u3) * -impulse);
     }
 
-    /* Retrieve barycentric coordinates for both collision points. */
-    float w1 = collpair->aw1, w2 = collpair->aw2, w3 = collpair->aw3;
-    float u1 = collpair->bw1, u2 = collpair->bw2, u3 = collpair->bw3;
+    /* Apply velocity stopping impulse. */
+    impulse = magrelVel / 3.0f;
 
-    /* Calculate relative "velocity". */
-    collision_interpolateOnTriangle(v1,
-                                    cloth->verts[collpair->ap1].tv,
-                                    cloth->verts[collpair->ap2].tv,
-                                    cloth->verts[collpair->ap3].tv,
-                                    w1,
-                                    w2,
-                                    w3);
+    VECADDMUL(ia[0], collpair->normal, double(w1) * impulse);
+    VECADDMUL(ia[1], collpair->normal, double(w2) * impulse);
+    VECADDMUL(ia[2], collpair->normal, double(w3) * impulse);
+
+    VECADDMUL(ib[0], collpair->normal, double(u1) * -impulse);
+    VECADDMUL(ib[1], collpair->normal, double(u2) * -impulse);
+    VECADDMUL(ib[2], collpair->normal, double(u3) * -impulse);
 
-    collision_interpolateOnTriangle(v2,
-                                    cloth->verts[collpair->bp1].tv,
-                                    cloth->verts[collpair->bp2].tv,
-                                    cloth->verts[collpair->bp3].tv,
-                                    u1,
-                                    u2,
-                                    u3);
-
-    sub_v3_v3v3(relativeVelocity, v2, v1);
-
-    /* Calculate the normal component of the relative velocity
-     * (actually only the magnitude - the direction is stored in 'normal'). */
-    const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
-    const float d = min_distance - collpair->distance;
-
-    /* TODO: Impulses should be weighed by mass as this is self col,
-     * this has to be done after mass distribution is implemented. */
-
-    /* If magrelVel < 0 the edges are approaching each other. */
-    if (magrelVel > 0.0f) {
-      /* Calculate Impulse magnitude to stop all motion in normal direction. */
-      float magtangent = 0, repulse = 0;
-      double impulse = 0.0;
-      float vrel_t_pre[3];
-      float temp[3];
-
-      /* Calculate tangential velocity. */
-      copy_v3_v3(temp, collpair->normal);
-      mul_v3_fl(temp, magrelVel);
-      sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
-
-      /* Decrease in magnitude of relative tangential velocity due to coulomb friction
-       * in original formula "magrelVel" should be the
-       * "change of relative velocity in normal direction". */
-      magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
-
-      /* Apply friction impulse. */
-      if (magtangent > ALMOST_ZERO) {
-        normalize_v3(vrel_t_pre);
-
-        impulse = magtangent / 1.5;
-
-        VECADDMUL(ia[0], vrel_t_pre, double(w1) * impulse);
-        VECADDMUL(ia[1], vrel_t_pre, double(w2) * impulse);
-        VECADDMUL(ia[2], vrel_t_pre, double(w3) * impulse);
-
-        VECADDMUL(ib[0], vrel_t_pre, double(u1) * -impulse);
-        VECADDMUL(ib[1], vrel_t_pre, double(u2) * -impulse);
-        VECADDMUL(ib[2], vrel_t_pre, double(u3) * -impulse);
+    if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
+      repulse = std::min(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+
+      if (impulse > ALMOST_ZERO) {
+        repulse = min_ff(repulse, 5.0 * impulse);
       }
 
-      /* Apply velocity stopping impulse. */
-      impulse = magrelVel / 3.0f;
+      repulse = max_ff(impulse, repulse);
+      impulse = repulse / 1.5f;
 
       VECADDMUL(ia[0], collpair->normal, double(w1) * impulse);
       VECADDMUL(ia[1], collpair->normal, double(w2) * impulse);
@@ -889,45 +959,65 @@ static int cloth_selfcollision_response_static(ClothModifierData *clmd,
       VECADDMUL(ib[0], collpair->normal, double(u1) * -impulse);
       VECADDMUL(ib[1], collpair->normal, double(u2) * -impulse);
       VECADDMUL(ib[2], collpair->normal, double(u3) * -impulse);
+    }
 
-      if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
-        repulse = std::min(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
-
-        if (impulse > ALMOST_ZERO) {
-          repulse = min_ff(repulse, 5.0 * impulse);
-        }
+    return CollPairResponse::Impulse;
+  }
+  else if (d > ALMOST_ZERO) {
+    /* Stay on the safe side and clamp repulse. */
+    float repulse = d * 1.0f / time_multiplier;
+    float impulse = repulse / 9.0f;
 
-        repulse = max_ff(impulse, repulse);
-        impulse = repulse / 1.5f;
+    VECADDMUL(ia[0], collpair->normal, w1 * impulse);
+    VECADDMUL(ia[1], collpair->normal, w2 * impulse);
+    VECADDMUL(ia[2], collpair->normal, w3 * impulse);
 
-        VECADDMUL(ia[0], collpair->normal, double(w1) * impulse);
-        VECADDMUL(ia[1], collpair->normal, double(w2) * impulse);
-        VECADDMUL(ia[2], collpair->normal, double(w3) * impulse);
+    VECADDMUL(ib[0], collpair->normal, u1 * -impulse);
+    VECADDMUL(ib[1], collpair->normal, u2 * -impulse);
+    VECADDMUL(ib[2], collpair->normal, u3 * -impulse);
 
-        VECADDMUL(ib[0], collpair->normal, double(u1) * -impulse);
-        VECADDMUL(ib[1], collpair->normal, double(u2) * -impulse);
-        VECADDMUL(ib[2], collpair->normal, double(u3) * -impulse);
-      }
+    return CollPairResponse::Impulse;
+  }
 
-      result = 1;
-    }
-    else if (d > ALMOST_ZERO) {
-      /* Stay on the safe side and clamp repulse. */
-      float repulse = d * 1.0f / time_multiplier;
-      float impulse = repulse / 9.0f;
+  return CollPairResponse::None;
+}
 
-      VECADDMUL(ia[0], collpair->normal, w1 * impulse);
-      VECADDMUL(ia[1], collpair->normal, w2 * impulse);
-      VECADDMUL(ia[2], collpair->normal, w3 * impulse);
+static int cloth_selfcollision_response_static(ClothModifierData *clmd,
+                                               CollPair *collpair,
+                                               uint collision_count,
+                                               const float dt)
+{
+  using namespace blender;
+  int result = 0;
+  Cloth *cloth = clmd->clothObject;
+  const float clamp_sq = square_f(clmd->coll_parms->self_clamp * dt);
+  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
+  const float min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f);
 
-      VECADDMUL(ib[0], collpair->normal, u1 * -impulse);
-      VECADDMUL(ib[1], collpair->normal, u2 * -impulse);
-      VECADDMUL(ib[2], collpair->normal, u3 * -impulse);
+  /* See #cloth_collision_response_static. */
+  struct PairImpulses {
+    float ab[6][3];
+  };
+  Array<CollPairResponse> responses(collision_count);
+  Array<PairImpulses> impulses(collision_count);
+  threading::parallel_for(IndexRange(collision_count), 256, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      responses[i] = cloth_selfcollision_response_pair(
+          clmd, &collpair[i], min_distance, time_multiplier, impulses[i].ab);
+    }
+  });
 
+  for (int i = 0; i < collision_count; i++, collpair++) {
+    if (responses[i] == CollPairResponse::Skip) {
+      continue;
+    }
+    if (responses[i] == CollPairResponse::Impulse) {
       result = 1;
     }
 
     if (result) {
+      const float(*ia)[3] = impulses[i].ab;
+      const float(*ib)[3] = impulses[i].ab + 3;
       cloth_collision_impulse_vert(clamp_sq, ia[0], &cloth->verts[collpair->ap1]);
       cloth_collision_impulse_vert(clamp_sq, ia[1], &cloth->verts[collpair->ap2]);
       cloth_collision_impulse_vert(clamp_sq, ia[2], &cloth->verts[collpair->ap3]);
@@ -1426,6 +1516,34 @@ static bool cloth_bvh_selfcollisions_nearcheck(ClothModifierData *clmd,
   return data.collided;
 }
 
+/**
+ * Add the accumulated collision impulses to the vertex velocities.
+ * \return The number of vertices that received an impulse.
+ */
+static int cloth_collision_impulses_apply(ClothVertex *verts, const int mvert_num)
+{
+  using namespace blender;
+  return threading::parallel_reduce(
+      IndexRange(mvert_num),
+      1024,
+      0,
+      [&](const IndexRange range, int count) {
+        for (const int64_t i : range) {
+          /* Calculate "velocities" (just xnew = xold + v; no dt in v). */
+          if (verts[i].impulse_count) {
+            add_v3_v3(verts[i].tv, verts[i].impulse);
+            add_v3_v3(verts[i].dcvel, verts[i].impulse);
+            zero_v3(verts[i].impulse);
+            verts[i].impulse_count = 0;
+
+            count++;
+          }
+        }
+        return count;
+      },
+      std::plus<int>());
+}
+
 static int cloth_bvh_objcollisions_resolve(ClothModifierData *clmd,
                                            Object **collobjs,
                                            CollPair **collisions,
@@ -1460,17 +1578,7 @@ static int cloth_bvh_objcollisions_resolve(ClothModifierData *clmd,
 
     /* Apply impulses in parallel. */
     if (result) {
-      for (i = 0; i < mvert_num; i++) {
-        // calculate "velocities" (just xnew = xold + v; no dt in v)
-        if (verts[i].impulse_count) {
-          add_v3_v3(verts[i].tv, verts[i].impulse);
-          add_v3_v3(verts[i].dcvel, verts[i].impulse);
-          zero_v3(verts[i].impulse);
-          verts[i].impulse_count = 0;
-
-          ret++;
-        }
-      }
+      ret += cloth_collision_impulses_apply(verts, mvert_num);
     }
     else {
       break;
@@ -1485,7 +1593,7 @@ static int cloth_bvh_selfcollisions_resolve(ClothModifierData *clmd,
                                             const float dt)
 {
   Cloth *cloth = clmd->clothObject;
-  int i = 0, j = 0, mvert_num = 0;
+  int j = 0, mvert_num = 0;
   ClothVertex *verts = nullptr;
   int ret = 0;
   int result = 0;
@@ -1500,17 +1608,7 @@ static int cloth_bvh_selfcollisions_resolve(ClothModifierData *clmd,
 
     /* Apply impulses in parallel. */
     if (result) {
-      for (i = 0; i < mvert_num; i++) {
-        if (verts[i].impulse_count) {
-          // VECADDMUL ( verts[i].tv, verts[i].impulse, 1.0f / verts[i].impulse_count );
-          add_v3_v3(verts[i].tv, verts[i].impulse);
-          add_v3_v3(verts[i].dcvel, verts[i].impulse);
-          zero_v3(verts[i].impulse);
-          verts[i].impulse_count = 0;
-
-          ret++;
-        }
-      }
+      ret += cloth_collision_impulses_apply(verts, mvert_num);
     }
 
     if (!result) {
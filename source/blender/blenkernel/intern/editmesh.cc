@@ -13,11 +13,13 @@
 #include "DNA_object_types.h"
 
 #include "BLI_bitmap.h"
+#include "BLI_implicit_sharing.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 
 #include "BKE_customdata.hh"
 #include "BKE_editmesh.hh"
+#include "BKE_lib_id.hh"
 #include "BKE_mesh.hh"
 #include "BKE_mesh_iterators.hh"
 #include "BKE_mesh_runtime.hh"
@@ -52,6 +54,7 @@ BMEditMesh *BKE_editmesh_copy(BMEditMesh *em)
    * in that case it makes more sense to do the
    * tessellation only when/if that copy ends up getting used. */
   em_copy->looptris = {};
+  em_copy->eval_sync = std::make_shared<blender::bke::EditMeshEvalSync>();
 
   /* Copy various settings. */
   em_copy->selectmode = em->selectmode;
@@ -124,6 +127,61 @@ void BKE_editmesh_free_data(BMEditMesh *em)
   if (em->bm) {
     BM_mesh_free(em->bm);
   }
+  em->eval_sync = std::make_shared<blender::bke::EditMeshEvalSync>();
+}
+
+namespace blender::bke {
+
+EditMeshEvalSync::~EditMeshEvalSync()
+{
+  if (this->mesh) {
+    BKE_id_free(nullptr, this->mesh);
+  }
+}
+
+}  // namespace blender::bke
+
+void BKE_editmesh_mesh_eval_sync(BMEditMesh &em,
+                                 const CustomData_MeshMasks &cd_mask_extra,
+                                 Mesh &mesh)
+{
+  using namespace blender;
+  BLI_assert(mesh.verts_num == 0);
+  bke::EditMeshEvalSync &sync = *em.eval_sync;
+  BMesh &bm = *em.bm;
+
+  std::lock_guard lock{sync.mutex};
+  const bool mesh_is_synced = sync.mesh != nullptr && sync.bm == &bm &&
+                              sync.sync_count == bm.sync_count &&
+                              memcmp(&sync.cd_mask_extra,
+                                     &cd_mask_extra,
+                                     sizeof(CustomData_MeshMasks)) == 0;
+  if (sync.mesh == nullptr) {
+    sync.mesh = BKE_mesh_new_nomain(0, 0, 0, 0);
+  }
+  BM_mesh_bm_to_me_for_eval_sync(bm, *sync.mesh, &cd_mask_extra, mesh_is_synced);
+  sync.bm = &bm;
+  sync.sync_count = bm.sync_count;
+  sync.cd_mask_extra = cd_mask_extra;
+
+  /* Share the arrays with the result, they are only copied again when they are modified. */
+  const Mesh &src = *sync.mesh;
+  mesh.verts_num = src.verts_num;
+  mesh.edges_num = src.edges_num;
+  mesh.faces_num = src.faces_num;
+  mesh.corners_num = src.corners_num;
+  CustomData_copy(&src.vert_data, &mesh.vert_data, CD_MASK_ALL, mesh.verts_num);
+  CustomData_copy(&src.edge_data, &mesh.edge_data, CD_MASK_ALL, mesh.edges_num);
+  CustomData_copy(&src.face_data, &mesh.face_data, CD_MASK_ALL, mesh.faces_num);
+  CustomData_copy(&src.corner_data, &mesh.corner_data, CD_MASK_ALL, mesh.corners_num);
+  implicit_sharing::copy_shared_pointer(src.face_offset_indices,
+                                        src.runtime->face_offsets_sharing_info,
+                                        &mesh.face_offset_indices,
+                                        &mesh.runtime->face_offsets_sharing_info);
+  mesh.act_face = src.act_face;
+  mesh.runtime->deformed_only = src.runtime->deformed_only;
+  mesh.runtime->loose_verts_cache = src.runtime->loose_verts_cache;
+  mesh.runtime->loose_edges_cache = src.runtime->loose_edges_cache;
 }
 
 struct CageUserData {
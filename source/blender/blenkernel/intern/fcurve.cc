@@ -11,6 +11,7 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <mutex>
 
 #include "MEM_guardedalloc.h"
 
@@ -25,6 +26,7 @@
 #include "BLI_blenlib.h"
 #include "BLI_easing.h"
 #include "BLI_ghash.h"
+#include "BLI_implicit_sharing.hh"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector_types.hh"
 #include "BLI_sort_utils.h"
@@ -52,11 +54,127 @@
 
 #include "CLG_log.h"
 
+#include "atomic_ops.h"
+
 #define SMALL -1.0e-10
 #define SELECT 1
 
 static CLG_LogRef LOG = {"bke.fcurve"};
 
+/* -------------------------------------------------------------------- */
+/** \name F-Curve Keyframe Sharing
+ * \{ */
+
+namespace blender::bke {
+
+/**
+ * Owns the keyframe array of F-Curves sharing it. Unlike #implicit_sharing::info_for_mem_free it
+ * can hand the array back to the last user, so that making the array mutable again does not need
+ * a copy.
+ */
+class FCurveKeyframesSharingInfo : public ImplicitSharingInfo {
+ public:
+  BezTriple *data;
+
+  FCurveKeyframesSharingInfo(BezTriple *data) : data(data) {}
+
+  /** Remove the last user without freeing the data, which is then owned by the caller. */
+  void release_data_and_delete()
+  {
+    BLI_assert(this->is_mutable());
+    data = nullptr;
+    this->remove_user_and_delete_if_last();
+  }
+
+ private:
+  void delete_self_with_data() override
+  {
+    MEM_SAFE_FREE(data);
+    MEM_delete(this);
+  }
+};
+
+/**
+ * Sharing is set up lazily when an evaluated copy is made, which can happen from multiple
+ * dependency graphs at the same time, so changes of #FCurve.bezt_sharing_info are serialized.
+ */
+static std::mutex fcurve_sharing_mutex;
+
+/**
+ * #FCurve.bezt_sharing_info is only changed with #fcurve_sharing_mutex locked, but it may be read
+ * without the lock, so it is always accessed atomically.
+ */
+static const ImplicitSharingInfoHandle *fcurve_bezt_sharing_info_get(const FCurve *fcu)
+{
+  return static_cast<const ImplicitSharingInfoHandle *>(
+      atomic_load_ptr((void *const *)&fcu->bezt_sharing_info));
+}
+
+static void fcurve_bezt_sharing_info_set(FCurve *fcu, const ImplicitSharingInfoHandle *info)
+{
+  atomic_store_ptr((void **)&fcu->bezt_sharing_info, (void *)info);
+}
+
+}  // namespace blender::bke
+
+static void fcurve_bezt_copy_shared(const FCurve *fcu_src, FCurve *fcu_dst)
+{
+  using namespace blender;
+  if (fcu_src->bezt == nullptr) {
+    fcu_dst->bezt = nullptr;
+    fcu_dst->bezt_sharing_info = nullptr;
+    return;
+  }
+  std::lock_guard lock(bke::fcurve_sharing_mutex);
+  /* The sharing info is run-time data, creating it does not change the source F-Curve. */
+  FCurve *fcu_src_mutable = const_cast<FCurve *>(fcu_src);
+  if (fcu_src_mutable->bezt_sharing_info == nullptr) {
+    bke::fcurve_bezt_sharing_info_set(
+        fcu_src_mutable,
+        MEM_new<bke::FCurveKeyframesSharingInfo>(__func__, fcu_src_mutable->bezt));
+  }
+  implicit_sharing::copy_shared_pointer(fcu_src_mutable->bezt,
+                                        fcu_src_mutable->bezt_sharing_info,
+                                        &fcu_dst->bezt,
+                                        &fcu_dst->bezt_sharing_info);
+}
+
+/** Free the keyframe array, or remove this F-Curve as user of it when it is shared. */
+static void fcurve_bezt_data_free(FCurve *fcu)
+{
+  if (fcu->bezt_sharing_info) {
+    blender::implicit_sharing::free_shared_data(&fcu->bezt, &fcu->bezt_sharing_info);
+  }
+  else {
+    MEM_SAFE_FREE(fcu->bezt);
+  }
+}
+
+void BKE_fcurve_bezt_ensure_mutable(FCurve *fcu)
+{
+  using namespace blender;
+  /* Sharing is only set up when copying the F-Curve, which doesn't happen while it is being
+   * edited. So checking for it doesn't need the lock, which keeps unshared F-Curves cheap, but
+   * the read has to be atomic because the copy sets it from another thread. */
+  if (bke::fcurve_bezt_sharing_info_get(fcu) == nullptr) {
+    return;
+  }
+  std::lock_guard lock(bke::fcurve_sharing_mutex);
+  const ImplicitSharingInfo *sharing_info = fcu->bezt_sharing_info;
+  if (sharing_info->is_mutable()) {
+    const_cast<bke::FCurveKeyframesSharingInfo *>(
+        static_cast<const bke::FCurveKeyframesSharingInfo *>(sharing_info))
+        ->release_data_and_delete();
+  }
+  else {
+    fcu->bezt = static_cast<BezTriple *>(MEM_dupallocN(fcu->bezt));
+    sharing_info->remove_user_and_delete_if_last();
+  }
+  bke::fcurve_bezt_sharing_info_set(fcu, nullptr);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name F-Curve Data Create
  * \{ */
@@ -80,7 +198,7 @@ void BKE_fcurve_free(FCurve *fcu)
   }
 
   /* Free curve data. */
-  MEM_SAFE_FREE(fcu->bezt);
+  fcurve_bezt_data_free(fcu);
   MEM_SAFE_FREE(fcu->fpt);
 
   /* Free RNA-path, as this were allocated when getting the path string. */
@@ -121,7 +239,7 @@ void BKE_fcurves_free(ListBase *list)
 /** \name F-Curve Data Copy
  * \{ */
 
-FCurve *BKE_fcurve_copy(const FCurve *fcu)
+FCurve *BKE_fcurve_copy(const FCurve *fcu, const bool share_keyframes)
 {
   /* Sanity check. */
   if (fcu == nullptr) {
@@ -135,7 +253,13 @@ FCurve *BKE_fcurve_copy(const FCurve *fcu)
   fcu_d->grp = nullptr;
 
   /* Copy curve data. */
-  fcu_d->bezt = static_cast<BezTriple *>(MEM_dupallocN(fcu_d->bezt));
+  if (share_keyframes) {
+    fcurve_bezt_copy_shared(fcu, fcu_d);
+  }
+  else {
+    fcu_d->bezt = static_cast<BezTriple *>(MEM_dupallocN(fcu_d->bezt));
+    fcu_d->bezt_sharing_info = nullptr;
+  }
   fcu_d->fpt = static_cast<FPoint *>(MEM_dupallocN(fcu_d->fpt));
 
   /* Copy rna-path. */
@@ -1075,9 +1199,7 @@ void fcurve_store_samples(FCurve *fcu, void *data, int start, int end, FcuSample
   }
 
   /* Free any existing sample/keyframe data on curve. */
-  if (fcu->bezt) {
-    MEM_freeN(fcu->bezt);
-  }
+  fcurve_bezt_data_free(fcu);
   if (fcu->fpt) {
     MEM_freeN(fcu->fpt);
   }
@@ -1118,9 +1240,7 @@ void fcurve_samples_to_keyframes(FCurve *fcu, const int start, const int end)
   }
 
   /* Free any existing sample/keyframe data on the curve. */
-  if (fcu->bezt) {
-    MEM_freeN(fcu->bezt);
-  }
+  fcurve_bezt_data_free(fcu);
 
   FPoint *fpt = fcu->fpt;
   int keyframes_to_insert = end - start;
@@ -1247,6 +1367,7 @@ void BKE_fcurve_handles_recalc_ex(FCurve *fcu, eBezTriple_Flag handle_sel_flag)
   {
     return;
   }
+  BKE_fcurve_bezt_ensure_mutable(fcu);
 
   /* If the first modifier is Cycles, smooth the curve through the cycle. */
   BezTriple *first = &fcu->bezt[0];
@@ -1325,6 +1446,7 @@ void testhandles_fcurve(FCurve *fcu, eBezTriple_Flag sel_flag, const bool use_ha
   if (ELEM(nullptr, fcu, fcu->bezt)) {
     return;
   }
+  BKE_fcurve_bezt_ensure_mutable(fcu);
 
   /* Loop over beztriples. */
   BezTriple *bezt;
@@ -1343,6 +1465,7 @@ void sort_time_fcurve(FCurve *fcu)
   if (fcu->bezt == nullptr) {
     return;
   }
+  BKE_fcurve_bezt_ensure_mutable(fcu);
 
   /* Keep adjusting order of beztriples until nothing moves (bubble-sort). */
   BezTriple *bezt;
@@ -1607,7 +1730,7 @@ static void berekeny(float f1, float f2, float f3, float f4, float *o, int b)
 
 static void fcurve_bezt_free(FCurve *fcu)
 {
-  MEM_SAFE_FREE(fcu->bezt);
+  fcurve_bezt_data_free(fcu);
   fcu->totvert = 0;
 }
 
@@ -1687,6 +1810,7 @@ void BKE_fcurve_bezt_shrink(FCurve *fcu, const int new_totvert)
     return;
   }
 
+  BKE_fcurve_bezt_ensure_mutable(fcu);
   fcu->bezt = static_cast<BezTriple *>(
       MEM_reallocN(fcu->bezt, new_totvert * sizeof(*(fcu->bezt))));
   fcu->totvert = new_totvert;
@@ -1711,6 +1835,7 @@ void BKE_fcurve_delete_key(FCurve *fcu, int index)
   }
 
   /* Delete this keyframe */
+  BKE_fcurve_bezt_ensure_mutable(fcu);
   memmove(
       &fcu->bezt[index], &fcu->bezt[index + 1], sizeof(BezTriple) * (fcu->totvert - index - 1));
   fcu->totvert--;
@@ -1729,6 +1854,7 @@ void BKE_fcurve_delete_keys(FCurve *fcu, blender::uint2 index_range)
   BLI_assert(index_range[1] <= fcu->totvert);
 
   const int removed_index_count = index_range[1] - index_range[0];
+  BKE_fcurve_bezt_ensure_mutable(fcu);
   memmove(&fcu->bezt[index_range[0]],
           &fcu->bezt[index_range[1]],
           sizeof(BezTriple) * (fcu->totvert - index_range[1]));
@@ -1801,6 +1927,7 @@ bool BKE_fcurve_delete_keys_selected(FCurve *fcu)
   if (fcu->bezt == nullptr) { /* ignore baked curves */
     return false;
   }
+  BKE_fcurve_bezt_ensure_mutable(fcu);
 
   bool changed = false;
 
@@ -1851,6 +1978,7 @@ void BKE_fcurve_merge_duplicate_keys(FCurve *fcu, const int sel_flag, const bool
   if ((fcu->totvert == 0) || (fcu->bezt == nullptr)) {
     return;
   }
+  BKE_fcurve_bezt_ensure_mutable(fcu);
 
   /* 1) Identify selected keyframes, and average the values on those
    * in case there are collisions due to multiple keys getting scaled
@@ -1968,6 +2096,7 @@ void BKE_fcurve_deduplicate_keys(FCurve *fcu)
   if (fcu->bezt == nullptr) {
     return;
   }
+  BKE_fcurve_bezt_ensure_mutable(fcu);
 
   int prev_bezt_index = 0;
   for (int i = 1; i < fcu->totvert; i++) {
@@ -2637,6 +2766,7 @@ void BKE_fcurve_blend_read_data(BlendDataReader *reader, FCurve *fcu)
   /* curve data */
   BLO_read_struct_array(reader, BezTriple, fcu->totvert, &fcu->bezt);
   BLO_read_struct_array(reader, FPoint, fcu->totvert, &fcu->fpt);
+  fcu->bezt_sharing_info = nullptr;
 
   /* rna path */
   BLO_read_string(reader, &fcu->rna_path);
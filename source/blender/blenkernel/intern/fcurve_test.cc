@@ -754,4 +754,41 @@ TEST(BKE_fcurve, BKE_fcurve_deduplicate_keys_prefer_whole_frames)
   BKE_fcurve_free(fcu);
 }
 
+TEST(BKE_fcurve, BKE_fcurve_copy_share_keyframes)
+{
+  FCurve *fcu = BKE_fcurve_create();
+  const KeyframeSettings settings = get_keyframe_settings(false);
+  insert_vert_fcurve(fcu, {1.0f, 7.0f}, settings, INSERTKEY_NOFLAGS);
+  insert_vert_fcurve(fcu, {2.0f, 13.0f}, settings, INSERTKEY_NOFLAGS);
+
+  /* The shared copy uses the same keyframes. */
+  FCurve *fcu_shared = BKE_fcurve_copy(fcu, true);
+  EXPECT_EQ(fcu_shared->bezt, fcu->bezt);
+  EXPECT_NE(fcu->bezt_sharing_info, nullptr);
+  EXPECT_EQ(fcu_shared->bezt_sharing_info, fcu->bezt_sharing_info);
+
+  /* A regular copy of either never shares. */
+  FCurve *fcu_copy = BKE_fcurve_copy(fcu_shared);
+  EXPECT_NE(fcu_copy->bezt, fcu->bezt);
+  EXPECT_EQ(fcu_copy->bezt_sharing_info, nullptr);
+  BKE_fcurve_free(fcu_copy);
+
+  /* Modifying the original un-shares the keyframes, leaving the copy unchanged. */
+  insert_vert_fcurve(fcu, {3.0f, 19.0f}, settings, INSERTKEY_NOFLAGS);
+  EXPECT_NE(fcu_shared->bezt, fcu->bezt);
+  EXPECT_EQ(fcu->bezt_sharing_info, nullptr);
+  EXPECT_EQ(fcu->totvert, 3);
+  EXPECT_EQ(fcu_shared->totvert, 2);
+  EXPECT_NEAR(evaluate_fcurve(fcu_shared, 2.0f), 13.0f, EPSILON);
+
+  /* The last user gets the keyframes back without a copy. */
+  BezTriple *shared_bezt = fcu_shared->bezt;
+  BKE_fcurve_bezt_ensure_mutable(fcu_shared);
+  EXPECT_EQ(fcu_shared->bezt, shared_bezt);
+  EXPECT_EQ(fcu_shared->bezt_sharing_info, nullptr);
+
+  BKE_fcurve_free(fcu_shared);
+  BKE_fcurve_free(fcu);
+}
+
 }  // namespace blender::bke::tests
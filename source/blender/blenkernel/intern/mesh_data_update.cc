@@ -874,7 +874,6 @@ static void editbmesh_calc_modifiers(Depsgraph &depsgraph,
       else {
         BKE_mesh_wrapper_ensure_mdata(mesh);
         BKE_modifier_deform_verts(md, &mectx, mesh, mesh->vert_positions_for_write());
-        mesh->tag_positions_changed();
       }
     }
     else {
@@ -19,6 +19,7 @@
 
 #include "BLI_array_utils.hh"
 #include "BLI_bit_vector.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_linklist.h"
 #include "BLI_math_base.hh"
 #include "BLI_math_vector.hh"
@@ -142,6 +143,43 @@ float3 face_normal_calc(const Span<float3> vert_positions, const Span<int> face_
  * meshes can slow down high-poly meshes. For details on performance, see D11993.
  * \{ */
 
+/**
+ * Triangles and quads make up the vast majority of faces in most meshes, so they are handled
+ * without the generic loop of Newell's method. A single cross product gives the same normal for
+ * triangles, and the cross product of the diagonals gives it for quads (including non-planar
+ * ones), matching #face_normal_calc.
+ */
+BLI_INLINE float3 normal_calc_face(const Span<float3> positions, const Span<int> face_verts)
+{
+  switch (face_verts.size()) {
+    case 3: {
+      const float3 &v1 = positions[face_verts[0]];
+      const float3 &v2 = positions[face_verts[1]];
+      const float3 &v3 = positions[face_verts[2]];
+      const float3 normal = math::cross(v1 - v2, v2 - v3);
+      const float length_squared = math::length_squared(normal);
+      if (UNLIKELY(length_squared == 0.0f)) {
+        return float3(0.0f, 0.0f, 1.0f);
+      }
+      return normal / std::sqrt(length_squared);
+    }
+    case 4: {
+      const float3 &v1 = positions[face_verts[0]];
+      const float3 &v2 = positions[face_verts[1]];
+      const float3 &v3 = positions[face_verts[2]];
+      const float3 &v4 = positions[face_verts[3]];
+      const float3 normal = math::cross(v1 - v3, v2 - v4);
+      const float length_squared = math::length_squared(normal);
+      if (UNLIKELY(length_squared == 0.0f)) {
+        return float3(0.0f, 0.0f, 1.0f);
+      }
+      return normal / std::sqrt(length_squared);
+    }
+    default:
+      return normal_calc_ngon(positions, face_verts);
+  }
+}
+
 void normals_calc_faces(const Span<float3> positions,
                         const OffsetIndices<int> faces,
                         const Span<int> corner_verts,
@@ -150,11 +188,48 @@ void normals_calc_faces(const Span<float3> positions,
   BLI_assert(faces.size() == face_normals.size());
   threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
     for (const int i : range) {
-      face_normals[i] = normal_calc_ngon(positions, corner_verts.slice(faces[i]));
+      face_normals[i] = normal_calc_face(positions, corner_verts.slice(faces[i]));
     }
   });
 }
 
+void normals_calc_faces(const Span<float3> positions,
+                        const OffsetIndices<int> faces,
+                        const Span<int> corner_verts,
+                        const IndexMask &face_mask,
+                        MutableSpan<float3> face_normals)
+{
+  BLI_assert(faces.size() == face_normals.size());
+  face_mask.foreach_index(GrainSize(1024), [&](const int i) {
+    face_normals[i] = normal_calc_face(positions, corner_verts.slice(faces[i]));
+  });
+}
+
+static float3 normal_calc_vert(const Span<float3> positions,
+                               const OffsetIndices<int> faces,
+                               const Span<int> corner_verts,
+                               const GroupedSpan<int> vert_to_face_map,
+                               const Span<float3> face_normals,
+                               const int vert)
+{
+  const Span<int> vert_faces = vert_to_face_map[vert];
+  if (vert_faces.is_empty()) {
+    return math::normalize(positions[vert]);
+  }
+
+  float3 vert_normal(0);
+  for (const int face : vert_faces) {
+    const int2 adjacent_verts = face_find_adjacent_verts(faces[face], corner_verts, vert);
+    const float3 dir_prev = math::normalize(positions[adjacent_verts[0]] - positions[vert]);
+    const float3 dir_next = math::normalize(positions[adjacent_verts[1]] - positions[vert]);
+    const float factor = math::safe_acos_approx(math::dot(dir_prev, dir_next));
+
+    vert_normal += face_normals[face] * factor;
+  }
+
+  return math::normalize(vert_normal);
+}
+
 void normals_calc_verts(const Span<float3> vert_positions,
                         const OffsetIndices<int> faces,
                         const Span<int> corner_verts,
@@ -165,27 +240,26 @@ void normals_calc_verts(const Span<float3> vert_positions,
   const Span<float3> positions = vert_positions;
   threading::parallel_for(positions.index_range(), 1024, [&](const IndexRange range) {
     for (const int vert : range) {
-      const Span<int> vert_faces = vert_to_face_map[vert];
-      if (vert_faces.is_empty()) {
-        vert_normals[vert] = math::normalize(positions[vert]);
-        continue;
-      }
-
-      float3 vert_normal(0);
-      for (const int face : vert_faces) {
-        const int2 adjacent_verts = face_find_adjacent_verts(faces[face], corner_verts, vert);
-        const float3 dir_prev = math::normalize(positions[adjacent_verts[0]] - positions[vert]);
-        const float3 dir_next = math::normalize(positions[adjacent_verts[1]] - positions[vert]);
-        const float factor = math::safe_acos_approx(math::dot(dir_prev, dir_next));
-
-        vert_normal += face_normals[face] * factor;
-      }
-
-      vert_normals[vert] = math::normalize(vert_normal);
+      vert_normals[vert] = normal_calc_vert(
+          positions, faces, corner_verts, vert_to_face_map, face_normals, vert);
     }
   });
 }
 
+void normals_calc_verts(const Span<float3> vert_positions,
+                        const OffsetIndices<int> faces,
+                        const Span<int> corner_verts,
+                        const GroupedSpan<int> vert_to_face_map,
+                        const Span<float3> face_normals,
+                        const IndexMask &vert_mask,
+                        MutableSpan<float3> vert_normals)
+{
+  vert_mask.foreach_index(GrainSize(1024), [&](const int vert) {
+    vert_normals[vert] = normal_calc_vert(
+        vert_positions, faces, corner_verts, vert_to_face_map, face_normals, vert);
+  });
+}
+
 /** \} */
 
 }  // namespace blender::bke::mesh
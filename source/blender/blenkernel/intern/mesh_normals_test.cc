@@ -0,0 +1,99 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_index_mask.hh"
+#include "BLI_math_vector.hh"
+
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
+#include "BKE_mesh_runtime.hh"
+
+namespace blender::bke::tests {
+
+/** Create a grid of `size * size` quads with a bumpy surface, so normals differ everywhere. */
+static Mesh *grid_mesh_create(const int size)
+{
+  const int verts_x = size + 1;
+  Mesh *mesh = BKE_mesh_new_nomain(verts_x * verts_x, 0, size * size, size * size * 4);
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  for (const int y : IndexRange(verts_x)) {
+    for (const int x : IndexRange(verts_x)) {
+      positions[y * verts_x + x] = float3(x, y, float((x * 7 + y * 3) % 5) * 0.1f);
+    }
+  }
+  MutableSpan<int> face_offsets = mesh->face_offsets_for_write();
+  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+  for (const int y : IndexRange(size)) {
+    for (const int x : IndexRange(size)) {
+      const int face = y * size + x;
+      face_offsets[face] = face * 4;
+      corner_verts[face * 4 + 0] = y * verts_x + x;
+      corner_verts[face * 4 + 1] = y * verts_x + x + 1;
+      corner_verts[face * 4 + 2] = (y + 1) * verts_x + x + 1;
+      corner_verts[face * 4 + 3] = (y + 1) * verts_x + x;
+    }
+  }
+  face_offsets.last() = size * size * 4;
+  return mesh;
+}
+
+static void expect_normals_near(const Span<float3> a, const Span<float3> b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  for (const int i : a.index_range()) {
+    EXPECT_NEAR(math::distance(a[i], b[i]), 0.0f, 1e-6f) << "index " << i;
+  }
+}
+
+TEST(mesh_normals, tag_positions_changed_mask)
+{
+  BKE_idtype_init();
+  Mesh *mesh = grid_mesh_create(8);
+  /* Cache the normals, so that they are updated in place. */
+  mesh->face_normals();
+  mesh->vert_normals();
+
+  IndexMaskMemory memory;
+  const IndexMask changed_verts = IndexMask::from_indices<int>({10, 11, 40}, memory);
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  changed_verts.foreach_index([&](const int vert) { positions[vert].z += 0.5f; });
+  mesh->tag_positions_changed(changed_verts);
+  EXPECT_TRUE(mesh->runtime->face_normals_cache.is_cached());
+  EXPECT_TRUE(mesh->runtime->vert_normals_cache.is_cached());
+
+  Mesh *mesh_full = BKE_mesh_copy_for_eval(*mesh);
+  mesh_full->tag_positions_changed();
+  expect_normals_near(mesh->face_normals(), mesh_full->face_normals());
+  expect_normals_near(mesh->vert_normals(), mesh_full->vert_normals());
+
+  BKE_id_free(nullptr, mesh_full);
+  BKE_id_free(nullptr, mesh);
+}
+
+TEST(mesh_normals, tag_positions_changed_mask_not_cached)
+{
+  BKE_idtype_init();
+  Mesh *mesh = grid_mesh_create(2);
+  mesh->face_normals();
+
+  mesh->vert_positions_for_write()[4].z = 1.0f;
+  IndexMaskMemory memory;
+  mesh->tag_positions_changed(IndexMask::from_indices<int>({4}, memory));
+  /* Vertex normals weren't cached, so they are computed from the updated face normals. */
+  EXPECT_FALSE(mesh->runtime->vert_normals_cache.is_cached());
+  EXPECT_TRUE(mesh->runtime->face_normals_cache.is_cached());
+
+  Mesh *mesh_full = BKE_mesh_copy_for_eval(*mesh);
+  mesh_full->tag_positions_changed();
+  expect_normals_near(mesh->face_normals(), mesh_full->face_normals());
+  expect_normals_near(mesh->vert_normals(), mesh_full->vert_normals());
+
+  BKE_id_free(nullptr, mesh_full);
+  BKE_id_free(nullptr, mesh);
+}
+
+}  // namespace blender::bke::tests
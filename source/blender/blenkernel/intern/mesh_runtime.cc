@@ -9,6 +9,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array_utils.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_math_geom.h"
 #include "BLI_task.hh"
 
@@ -390,6 +391,67 @@ void Mesh::tag_positions_changed()
   this->tag_positions_changed_no_normals();
 }
 
+void Mesh::tag_positions_changed(const blender::IndexMask &changed_verts)
+{
+  using namespace blender;
+  using namespace blender::bke;
+  if (changed_verts.is_empty()) {
+    return;
+  }
+  this->runtime->corner_normals_cache.tag_dirty();
+  this->tag_positions_changed_no_normals();
+
+  if (!this->runtime->face_normals_cache.is_cached()) {
+    /* Nothing to update in place, everything is recomputed lazily. */
+    this->runtime->face_normals_cache.tag_dirty();
+    this->runtime->vert_normals_cache.tag_dirty();
+    return;
+  }
+
+  const Span<float3> positions = this->vert_positions();
+  const OffsetIndices faces = this->faces();
+  const Span<int> corner_verts = this->corner_verts();
+
+  /* The normal of every face using a moved vertex changes. The normals of all vertices of these
+   * faces change too, since they are weighted by the face normals and by the corner angles. */
+  Array<bool> verts_changed(this->verts_num, false);
+  changed_verts.to_bools(verts_changed);
+  IndexMaskMemory memory;
+  const IndexMask face_mask = IndexMask::from_predicate(
+      faces.index_range(), GrainSize(1024), memory, [&](const int face) {
+        const Span<int> face_verts = corner_verts.slice(faces[face]);
+        return std::any_of(face_verts.begin(), face_verts.end(), [&](const int vert) {
+          return verts_changed[vert];
+        });
+      });
+
+  this->runtime->face_normals_cache.update([&](Vector<float3> &r_data) {
+    mesh::normals_calc_faces(positions, faces, corner_verts, face_mask, r_data);
+  });
+
+  if (!this->runtime->vert_normals_cache.is_cached()) {
+    this->runtime->vert_normals_cache.tag_dirty();
+    return;
+  }
+
+  const GroupedSpan<int> vert_to_face = this->vert_to_face_map();
+  Array<bool> faces_changed(faces.size(), false);
+  face_mask.to_bools(faces_changed);
+  const IndexMask vert_mask = IndexMask::from_predicate(
+      IndexRange(this->verts_num), GrainSize(1024), memory, [&](const int vert) {
+        const Span<int> vert_faces = vert_to_face[vert];
+        return std::any_of(vert_faces.begin(), vert_faces.end(), [&](const int face) {
+          return faces_changed[face];
+        });
+      });
+
+  const Span<float3> face_normals = this->runtime->face_normals_cache.data();
+  this->runtime->vert_normals_cache.update([&](Vector<float3> &r_data) {
+    mesh::normals_calc_verts(
+        positions, faces, corner_verts, vert_to_face, face_normals, vert_mask, r_data);
+  });
+}
+
 void Mesh::tag_positions_changed_no_normals()
 {
   free_bvh_cache(*this->runtime);
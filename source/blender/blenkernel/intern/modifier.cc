@@ -922,7 +922,7 @@ void BKE_modifier_deform_verts(ModifierData *md,
 {
   const ModifierTypeInfo *mti = BKE_modifier_get_info(ModifierType(md->type));
   mti->deform_verts(md, ctx, mesh, positions);
-  if (mesh) {
+  if (mesh && !(mti->flags & eModifierTypeFlag_TagsChangedPositions)) {
     mesh->tag_positions_changed();
   }
 }
@@ -12,9 +12,11 @@
 
 #include "DNA_mesh_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_customdata.hh"
@@ -608,7 +610,7 @@ static void foreach_single_vertex(const blender::bke::subdiv::ForeachContext *fo
   Vertex *vertex = &reshape_smooth_context->geometry.vertices[subdiv_vertex_index];
 
   vertex->grid_coords = static_cast<GridCoord *>(
-      MEM_reallocN(vertex->grid_coords, sizeof(Vertex) * (vertex->num_grid_coords + 1)));
+      MEM_reallocN(vertex->grid_coords, sizeof(GridCoord) * (vertex->num_grid_coords + 1)));
   vertex->grid_coords[vertex->num_grid_coords] = *grid_coord;
   ++vertex->num_grid_coords;
 
@@ -1100,16 +1102,22 @@ using ReshapeSubdivCoarsePositionCb =
 static void reshape_subdiv_refine(const MultiresReshapeSmoothContext *reshape_smooth_context,
                                   ReshapeSubdivCoarsePositionCb coarse_position_cb)
 {
-  blender::bke::subdiv::Subdiv *reshape_subdiv = reshape_smooth_context->reshape_subdiv;
-
-  /* TODO(sergey): For non-trivial coarse_position_cb we should multi-thread this loop. */
+  using namespace blender;
+  bke::subdiv::Subdiv *reshape_subdiv = reshape_smooth_context->reshape_subdiv;
 
+  /* Positions are calculated in parallel, since evaluating the limit surface at the original
+   * grids is not trivial, and then passed to the evaluator in a single call. */
   const int num_vertices = reshape_smooth_context->geometry.num_vertices;
-  for (int i = 0; i < num_vertices; ++i) {
-    const Vertex *vertex = &reshape_smooth_context->geometry.vertices[i];
-    float P[3];
-    coarse_position_cb(reshape_smooth_context, vertex, P);
-    reshape_subdiv->evaluator->setCoarsePositions(reshape_subdiv->evaluator, P, i, 1);
+  Array<float3> positions(num_vertices);
+  threading::parallel_for(IndexRange(num_vertices), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const Vertex *vertex = &reshape_smooth_context->geometry.vertices[i];
+      coarse_position_cb(reshape_smooth_context, vertex, positions[i]);
+    }
+  });
+  if (num_vertices != 0) {
+    reshape_subdiv->evaluator->setCoarsePositions(
+        reshape_subdiv->evaluator, &positions.first().x, 0, num_vertices);
   }
   reshape_subdiv->evaluator->refine(reshape_subdiv->evaluator);
 }
@@ -0,0 +1,45 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "DNA_modifier_types.h"
+#include "DNA_object_types.h"
+
+#include "BKE_modifier.hh"
+#include "BKE_object.hh"
+
+namespace blender::bke::tests {
+
+TEST(object, support_modifier_type_check)
+{
+  BKE_modifier_init();
+
+  Object ob{};
+  ob.type = OB_SURF;
+  /* The array modifier implements #ModifierTypeInfo::modify_geometry_set for instancing, but
+   * surfaces still support it through #ModifierTypeInfo::modify_mesh. */
+  EXPECT_TRUE(BKE_object_support_modifier_type_check(&ob, eModifierType_Array));
+  EXPECT_TRUE(BKE_object_support_modifier_type_check(&ob, eModifierType_Subsurf));
+  EXPECT_FALSE(BKE_object_support_modifier_type_check(&ob, eModifierType_Nodes));
+
+  ob.type = OB_LATTICE;
+  EXPECT_FALSE(BKE_object_support_modifier_type_check(&ob, eModifierType_Array));
+  EXPECT_TRUE(BKE_object_support_modifier_type_check(&ob, eModifierType_Lattice));
+
+  ob.type = OB_MESH;
+  EXPECT_TRUE(BKE_object_support_modifier_type_check(&ob, eModifierType_Array));
+
+  ob.type = OB_VOLUME;
+  EXPECT_FALSE(BKE_object_support_modifier_type_check(&ob, eModifierType_Array));
+  EXPECT_TRUE(BKE_object_support_modifier_type_check(&ob, eModifierType_Nodes));
+  EXPECT_TRUE(BKE_object_support_modifier_type_check(&ob, eModifierType_VolumeDisplace));
+  EXPECT_TRUE(BKE_object_support_modifier_type_check(&ob, eModifierType_MeshToVolume));
+
+  ob.type = OB_POINTCLOUD;
+  EXPECT_FALSE(BKE_object_support_modifier_type_check(&ob, eModifierType_Array));
+  EXPECT_TRUE(BKE_object_support_modifier_type_check(&ob, eModifierType_Nodes));
+}
+
+}  // namespace blender::bke::tests
@@ -19,10 +19,12 @@
 #include "DNA_modifier_types.h"
 #include "DNA_scene_types.h"
 
+#include "BLI_fftw.hh"
 #include "BLI_math_vector.h"
 #include "BLI_path_util.h"
 #include "BLI_rand.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_image.h"
@@ -39,6 +41,8 @@
 
 #ifdef WITH_OCEANSIM
 
+using blender::IndexRange;
+
 /* Ocean code */
 
 static float nextfr(RNG *rng, float min, float max)
@@ -441,7 +445,7 @@ static void ocean_compute_displacement_y(TaskPool *__restrict pool, void * /*tas
   OceanSimulateData *osd = static_cast<OceanSimulateData *>(BLI_task_pool_user_data(pool));
   const Ocean *o = osd->o;
 
-  fftw_execute(o->_disp_y_plan);
+  fftw_execute_dft_c2r(o->_c2r_plan, o->_fft_in, o->_disp_y);
 }
 
 static void ocean_compute_displacement_x(TaskPool *__restrict pool, void * /*taskdata*/)
@@ -450,27 +454,29 @@ static void ocean_compute_displacement_x(TaskPool *__restrict pool, void * /*tas
   const Ocean *o = osd->o;
   const float scale = osd->scale;
   const float chop_amount = osd->chop_amount;
-  int i, j;
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      fftw_complex mul_param;
-      fftw_complex minus_i;
-
-      init_complex(minus_i, 0.0, -1.0);
-      init_complex(mul_param, -scale, 0);
-      mul_complex_f(mul_param, mul_param, chop_amount);
-      mul_complex_c(mul_param, mul_param, minus_i);
-      mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
-      mul_complex_f(mul_param,
-                    mul_param,
-                    ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
-                         0.0f :
-                         o->_kx[i] / o->_k[i * (1 + o->_N / 2) + j]));
-      init_complex(o->_fft_in_x[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
+  blender::threading::parallel_for(IndexRange(o->_M), 16, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (int j = 0; j <= o->_N / 2; j++) {
+        fftw_complex mul_param;
+        fftw_complex minus_i;
+
+        init_complex(minus_i, 0.0, -1.0);
+        init_complex(mul_param, -scale, 0);
+        mul_complex_f(mul_param, mul_param, chop_amount);
+        mul_complex_c(mul_param, mul_param, minus_i);
+        mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
+        mul_complex_f(mul_param,
+                      mul_param,
+                      ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
+                           0.0f :
+                           o->_kx[i] / o->_k[i * (1 + o->_N / 2) + j]));
+        init_complex(
+            o->_fft_in_x[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
+      }
     }
-  }
-  fftw_execute(o->_disp_x_plan);
+  });
+  fftw_execute_dft_c2r(o->_c2r_plan, o->_fft_in_x, o->_disp_x);
 }
 
 static void ocean_compute_displacement_z(TaskPool *__restrict pool, void * /*taskdata*/)
@@ -479,27 +485,29 @@ static void ocean_compute_displacement_z(TaskPool *__restrict pool, void * /*tas
   const Ocean *o = osd->o;
   const float scale = osd->scale;
   const float chop_amount = osd->chop_amount;
-  int i, j;
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      fftw_complex mul_param;
-      fftw_complex minus_i;
-
-      init_complex(minus_i, 0.0, -1.0);
-      init_complex(mul_param, -scale, 0);
-      mul_complex_f(mul_param, mul_param, chop_amount);
-      mul_complex_c(mul_param, mul_param, minus_i);
-      mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
-      mul_complex_f(mul_param,
-                    mul_param,
-                    ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
-                         0.0f :
-                         o->_kz[j] / o->_k[i * (1 + o->_N / 2) + j]));
-      init_complex(o->_fft_in_z[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
+  blender::threading::parallel_for(IndexRange(o->_M), 16, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (int j = 0; j <= o->_N / 2; j++) {
+        fftw_complex mul_param;
+        fftw_complex minus_i;
+
+        init_complex(minus_i, 0.0, -1.0);
+        init_complex(mul_param, -scale, 0);
+        mul_complex_f(mul_param, mul_param, chop_amount);
+        mul_complex_c(mul_param, mul_param, minus_i);
+        mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
+        mul_complex_f(mul_param,
+                      mul_param,
+                      ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
+                           0.0f :
+                           o->_kz[j] / o->_k[i * (1 + o->_N / 2) + j]));
+        init_complex(
+            o->_fft_in_z[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
+      }
     }
-  }
-  fftw_execute(o->_disp_z_plan);
+  });
+  fftw_execute_dft_c2r(o->_c2r_plan, o->_fft_in_z, o->_disp_z);
 }
 
 static void ocean_compute_jacobian_jxx(TaskPool *__restrict pool, void * /*taskdata*/)
@@ -507,32 +515,36 @@ static void ocean_compute_jacobian_jxx(TaskPool *__restrict pool, void * /*taskd
   OceanSimulateData *osd = static_cast<OceanSimulateData *>(BLI_task_pool_user_data(pool));
   const Ocean *o = osd->o;
   const float chop_amount = osd->chop_amount;
-  int i, j;
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      fftw_complex mul_param;
-
-      // init_complex(mul_param, -scale, 0);
-      init_complex(mul_param, -1, 0);
-
-      mul_complex_f(mul_param, mul_param, chop_amount);
-      mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
-      mul_complex_f(mul_param,
-                    mul_param,
-                    ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
-                         0.0f :
-                         o->_kx[i] * o->_kx[i] / o->_k[i * (1 + o->_N / 2) + j]));
-      init_complex(o->_fft_in_jxx[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
+  blender::threading::parallel_for(IndexRange(o->_M), 16, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (int j = 0; j <= o->_N / 2; j++) {
+        fftw_complex mul_param;
+
+        // init_complex(mul_param, -scale, 0);
+        init_complex(mul_param, -1, 0);
+
+        mul_complex_f(mul_param, mul_param, chop_amount);
+        mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
+        mul_complex_f(mul_param,
+                      mul_param,
+                      ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
+                           0.0f :
+                           o->_kx[i] * o->_kx[i] / o->_k[i * (1 + o->_N / 2) + j]));
+        init_complex(
+            o->_fft_in_jxx[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
+      }
     }
-  }
-  fftw_execute(o->_Jxx_plan);
+  });
+  fftw_execute_dft_c2r(o->_c2r_plan, o->_fft_in_jxx, o->_Jxx);
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j < o->_N; j++) {
-      o->_Jxx[i * o->_N + j] += 1.0;
+  blender::threading::parallel_for(IndexRange(o->_M), 16, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (int j = 0; j < o->_N; j++) {
+        o->_Jxx[i * o->_N + j] += 1.0;
+      }
     }
-  }
+  });
 }
 
 static void ocean_compute_jacobian_jzz(TaskPool *__restrict pool, void * /*taskdata*/)
@@ -540,32 +552,36 @@ static void ocean_compute_jacobian_jzz(TaskPool *__restrict pool, void * /*taskd
   OceanSimulateData *osd = static_cast<OceanSimulateData *>(BLI_task_pool_user_data(pool));
   const Ocean *o = osd->o;
   const float chop_amount = osd->chop_amount;
-  int i, j;
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      fftw_complex mul_param;
-
-      // init_complex(mul_param, -scale, 0);
-      init_complex(mul_param, -1, 0);
-
-      mul_complex_f(mul_param, mul_param, chop_amount);
-      mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
-      mul_complex_f(mul_param,
-                    mul_param,
-                    ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
-                         0.0f :
-                         o->_kz[j] * o->_kz[j] / o->_k[i * (1 + o->_N / 2) + j]));
-      init_complex(o->_fft_in_jzz[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
+  blender::threading::parallel_for(IndexRange(o->_M), 16, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (int j = 0; j <= o->_N / 2; j++) {
+        fftw_complex mul_param;
+
+        // init_complex(mul_param, -scale, 0);
+        init_complex(mul_param, -1, 0);
+
+        mul_complex_f(mul_param, mul_param, chop_amount);
+        mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
+        mul_complex_f(mul_param,
+                      mul_param,
+                      ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
+                           0.0f :
+                           o->_kz[j] * o->_kz[j] / o->_k[i * (1 + o->_N / 2) + j]));
+        init_complex(
+            o->_fft_in_jzz[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
+      }
     }
-  }
-  fftw_execute(o->_Jzz_plan);
+  });
+  fftw_execute_dft_c2r(o->_c2r_plan, o->_fft_in_jzz, o->_Jzz);
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j < o->_N; j++) {
-      o->_Jzz[i * o->_N + j] += 1.0;
+  blender::threading::parallel_for(IndexRange(o->_M), 16, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (int j = 0; j < o->_N; j++) {
+        o->_Jzz[i * o->_N + j] += 1.0;
+      }
     }
-  }
+  });
 }
 
 static void ocean_compute_jacobian_jxz(TaskPool *__restrict pool, void * /*taskdata*/)
@@ -573,64 +589,70 @@ static void ocean_compute_jacobian_jxz(TaskPool *__restrict pool, void * /*taskd
   OceanSimulateData *osd = static_cast<OceanSimulateData *>(BLI_task_pool_user_data(pool));
   const Ocean *o = osd->o;
   const float chop_amount = osd->chop_amount;
-  int i, j;
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      fftw_complex mul_param;
-
-      // init_complex(mul_param, -scale, 0);
-      init_complex(mul_param, -1, 0);
-
-      mul_complex_f(mul_param, mul_param, chop_amount);
-      mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
-      mul_complex_f(mul_param,
-                    mul_param,
-                    ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
-                         0.0f :
-                         o->_kx[i] * o->_kz[j] / o->_k[i * (1 + o->_N / 2) + j]));
-      init_complex(o->_fft_in_jxz[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
+  blender::threading::parallel_for(IndexRange(o->_M), 16, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (int j = 0; j <= o->_N / 2; j++) {
+        fftw_complex mul_param;
+
+        // init_complex(mul_param, -scale, 0);
+        init_complex(mul_param, -1, 0);
+
+        mul_complex_f(mul_param, mul_param, chop_amount);
+        mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
+        mul_complex_f(mul_param,
+                      mul_param,
+                      ((o->_k[i * (1 + o->_N / 2) + j] == 0.0f) ?
+                           0.0f :
+                           o->_kx[i] * o->_kz[j] / o->_k[i * (1 + o->_N / 2) + j]));
+        init_complex(
+            o->_fft_in_jxz[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
+      }
     }
-  }
-  fftw_execute(o->_Jxz_plan);
+  });
+  fftw_execute_dft_c2r(o->_c2r_plan, o->_fft_in_jxz, o->_Jxz);
 }
 
 static void ocean_compute_normal_x(TaskPool *__restrict pool, void * /*taskdata*/)
 {
   OceanSimulateData *osd = static_cast<OceanSimulateData *>(BLI_task_pool_user_data(pool));
   const Ocean *o = osd->o;
-  int i, j;
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      fftw_complex mul_param;
+  blender::threading::parallel_for(IndexRange(o->_M), 16, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (int j = 0; j <= o->_N / 2; j++) {
+        fftw_complex mul_param;
 
-      init_complex(mul_param, 0.0, -1.0);
-      mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
-      mul_complex_f(mul_param, mul_param, o->_kx[i]);
-      init_complex(o->_fft_in_nx[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
+        init_complex(mul_param, 0.0, -1.0);
+        mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
+        mul_complex_f(mul_param, mul_param, o->_kx[i]);
+        init_complex(
+            o->_fft_in_nx[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
+      }
     }
-  }
-  fftw_execute(o->_N_x_plan);
+  });
+  fftw_execute_dft_c2r(o->_c2r_plan, o->_fft_in_nx, o->_N_x);
 }
 
 static void ocean_compute_normal_z(TaskPool *__restrict pool, void * /*taskdata*/)
 {
   OceanSimulateData *osd = static_cast<OceanSimulateData *>(BLI_task_pool_user_data(pool));
   const Ocean *o = osd->o;
-  int i, j;
 
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      fftw_complex mul_param;
+  blender::threading::parallel_for(IndexRange(o->_M), 16, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (int j = 0; j <= o->_N / 2; j++) {
+        fftw_complex mul_param;
 
-      init_complex(mul_param, 0.0, -1.0);
-      mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
-      mul_complex_f(mul_param, mul_param, o->_kz[i]);
-      init_complex(o->_fft_in_nz[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
+        init_complex(mul_param, 0.0, -1.0);
+        mul_complex_c(mul_param, mul_param, o->_htilda[i * (1 + o->_N / 2) + j]);
+        mul_complex_f(mul_param, mul_param, o->_kz[i]);
+        init_complex(
+            o->_fft_in_nz[i * (1 + o->_N / 2) + j], real_c(mul_param), image_c(mul_param));
+      }
     }
-  }
-  fftw_execute(o->_N_z_plan);
+  });
+  fftw_execute_dft_c2r(o->_c2r_plan, o->_fft_in_nz, o->_N_z);
 }
 
 bool BKE_ocean_is_valid(const Ocean *o)
@@ -966,63 +988,53 @@ bool BKE_ocean_init(Ocean *o,
     }
   }
 
-  o->_fft_in = (fftw_complex *)MEM_mallocN(o->_M * (1 + o->_N / 2) * sizeof(fftw_complex),
-                                           "ocean_fft_in");
-  o->_htilda = (fftw_complex *)MEM_mallocN(o->_M * (1 + o->_N / 2) * sizeof(fftw_complex),
-                                           "ocean_htilda");
+  /* Arrays used by the transforms are aligned as required by the shared plan. */
+  const size_t complex_size = size_t(o->_M) * (1 + o->_N / 2) * sizeof(fftw_complex);
+  const size_t real_size = size_t(o->_M) * o->_N * sizeof(double);
+  const size_t fft_alignment = blender::fftw::plan_alignment;
+
+  o->_fft_in = (fftw_complex *)MEM_mallocN_aligned(complex_size, fft_alignment, "ocean_fft_in");
+  o->_htilda = (fftw_complex *)MEM_mallocN(complex_size, "ocean_htilda");
 
-  BLI_thread_lock(LOCK_FFTW);
+  o->_c2r_plan = blender::fftw::plan_c2r_2d_get(blender::int2(o->_M, o->_N));
 
   if (o->_do_disp_y) {
-    o->_disp_y = (double *)MEM_mallocN(o->_M * o->_N * sizeof(double), "ocean_disp_y");
-    o->_disp_y_plan = fftw_plan_dft_c2r_2d(o->_M, o->_N, o->_fft_in, o->_disp_y, FFTW_ESTIMATE);
+    o->_disp_y = (double *)MEM_mallocN_aligned(real_size, fft_alignment, "ocean_disp_y");
   }
 
   if (o->_do_normals) {
-    o->_fft_in_nx = (fftw_complex *)MEM_mallocN(o->_M * (1 + o->_N / 2) * sizeof(fftw_complex),
-                                                "ocean_fft_in_nx");
-    o->_fft_in_nz = (fftw_complex *)MEM_mallocN(o->_M * (1 + o->_N / 2) * sizeof(fftw_complex),
-                                                "ocean_fft_in_nz");
+    o->_fft_in_nx = (fftw_complex *)MEM_mallocN_aligned(
+        complex_size, fft_alignment, "ocean_fft_in_nx");
+    o->_fft_in_nz = (fftw_complex *)MEM_mallocN_aligned(
+        complex_size, fft_alignment, "ocean_fft_in_nz");
 
-    o->_N_x = (double *)MEM_mallocN(o->_M * o->_N * sizeof(double), "ocean_N_x");
+    o->_N_x = (double *)MEM_mallocN_aligned(real_size, fft_alignment, "ocean_N_x");
     // o->_N_y = (float *) fftwf_malloc(o->_M * o->_N * sizeof(float)); /* (MEM01) */
-    o->_N_z = (double *)MEM_mallocN(o->_M * o->_N * sizeof(double), "ocean_N_z");
-
-    o->_N_x_plan = fftw_plan_dft_c2r_2d(o->_M, o->_N, o->_fft_in_nx, o->_N_x, FFTW_ESTIMATE);
-    o->_N_z_plan = fftw_plan_dft_c2r_2d(o->_M, o->_N, o->_fft_in_nz, o->_N_z, FFTW_ESTIMATE);
+    o->_N_z = (double *)MEM_mallocN_aligned(real_size, fft_alignment, "ocean_N_z");
   }
 
   if (o->_do_chop) {
-    o->_fft_in_x = (fftw_complex *)MEM_mallocN(o->_M * (1 + o->_N / 2) * sizeof(fftw_complex),
-                                               "ocean_fft_in_x");
-    o->_fft_in_z = (fftw_complex *)MEM_mallocN(o->_M * (1 + o->_N / 2) * sizeof(fftw_complex),
-                                               "ocean_fft_in_z");
-
-    o->_disp_x = (double *)MEM_mallocN(o->_M * o->_N * sizeof(double), "ocean_disp_x");
-    o->_disp_z = (double *)MEM_mallocN(o->_M * o->_N * sizeof(double), "ocean_disp_z");
+    o->_fft_in_x = (fftw_complex *)MEM_mallocN_aligned(
+        complex_size, fft_alignment, "ocean_fft_in_x");
+    o->_fft_in_z = (fftw_complex *)MEM_mallocN_aligned(
+        complex_size, fft_alignment, "ocean_fft_in_z");
 
-    o->_disp_x_plan = fftw_plan_dft_c2r_2d(o->_M, o->_N, o->_fft_in_x, o->_disp_x, FFTW_ESTIMATE);
-    o->_disp_z_plan = fftw_plan_dft_c2r_2d(o->_M, o->_N, o->_fft_in_z, o->_disp_z, FFTW_ESTIMATE);
+    o->_disp_x = (double *)MEM_mallocN_aligned(real_size, fft_alignment, "ocean_disp_x");
+    o->_disp_z = (double *)MEM_mallocN_aligned(real_size, fft_alignment, "ocean_disp_z");
   }
   if (o->_do_jacobian) {
-    o->_fft_in_jxx = (fftw_complex *)MEM_mallocN(o->_M * (1 + o->_N / 2) * sizeof(fftw_complex),
-                                                 "ocean_fft_in_jxx");
-    o->_fft_in_jzz = (fftw_complex *)MEM_mallocN(o->_M * (1 + o->_N / 2) * sizeof(fftw_complex),
-                                                 "ocean_fft_in_jzz");
-    o->_fft_in_jxz = (fftw_complex *)MEM_mallocN(o->_M * (1 + o->_N / 2) * sizeof(fftw_complex),
-                                                 "ocean_fft_in_jxz");
+    o->_fft_in_jxx = (fftw_complex *)MEM_mallocN_aligned(
+        complex_size, fft_alignment, "ocean_fft_in_jxx");
+    o->_fft_in_jzz = (fftw_complex *)MEM_mallocN_aligned(
+        complex_size, fft_alignment, "ocean_fft_in_jzz");
+    o->_fft_in_jxz = (fftw_complex *)MEM_mallocN_aligned(
+        complex_size, fft_alignment, "ocean_fft_in_jxz");
 
-    o->_Jxx = (double *)MEM_mallocN(o->_M * o->_N * sizeof(double), "ocean_Jxx");
-    o->_Jzz = (double *)MEM_mallocN(o->_M * o->_N * sizeof(double), "ocean_Jzz");
-    o->_Jxz = (double *)MEM_mallocN(o->_M * o->_N * sizeof(double), "ocean_Jxz");
-
-    o->_Jxx_plan = fftw_plan_dft_c2r_2d(o->_M, o->_N, o->_fft_in_jxx, o->_Jxx, FFTW_ESTIMATE);
-    o->_Jzz_plan = fftw_plan_dft_c2r_2d(o->_M, o->_N, o->_fft_in_jzz, o->_Jzz, FFTW_ESTIMATE);
-    o->_Jxz_plan = fftw_plan_dft_c2r_2d(o->_M, o->_N, o->_fft_in_jxz, o->_Jxz, FFTW_ESTIMATE);
+    o->_Jxx = (double *)MEM_mallocN_aligned(real_size, fft_alignment, "ocean_Jxx");
+    o->_Jzz = (double *)MEM_mallocN_aligned(real_size, fft_alignment, "ocean_Jzz");
+    o->_Jxz = (double *)MEM_mallocN_aligned(real_size, fft_alignment, "ocean_Jxz");
   }
 
-  BLI_thread_unlock(LOCK_FFTW);
-
   BLI_rw_mutex_unlock(&o->oceanmutex);
 
   set_height_normalize_factor(o);
@@ -1040,18 +1052,13 @@ void BKE_ocean_free_data(Ocean *oc)
 
   BLI_rw_mutex_lock(&oc->oceanmutex, THREAD_LOCK_WRITE);
 
-  BLI_thread_lock(LOCK_FFTW);
-
   if (oc->_do_disp_y) {
-    fftw_destroy_plan(oc->_disp_y_plan);
     MEM_freeN(oc->_disp_y);
   }
 
   if (oc->_do_normals) {
     MEM_freeN(oc->_fft_in_nx);
     MEM_freeN(oc->_fft_in_nz);
-    fftw_destroy_plan(oc->_N_x_plan);
-    fftw_destroy_plan(oc->_N_z_plan);
     MEM_freeN(oc->_N_x);
     // fftwf_free(oc->_N_y); /* (MEM01) */
     MEM_freeN(oc->_N_z);
@@ -1060,8 +1067,6 @@ void BKE_ocean_free_data(Ocean *oc)
   if (oc->_do_chop) {
     MEM_freeN(oc->_fft_in_x);
     MEM_freeN(oc->_fft_in_z);
-    fftw_destroy_plan(oc->_disp_x_plan);
-    fftw_destroy_plan(oc->_disp_z_plan);
     MEM_freeN(oc->_disp_x);
     MEM_freeN(oc->_disp_z);
   }
@@ -1070,16 +1075,11 @@ void BKE_ocean_free_data(Ocean *oc)
     MEM_freeN(oc->_fft_in_jxx);
     MEM_freeN(oc->_fft_in_jzz);
     MEM_freeN(oc->_fft_in_jxz);
-    fftw_destroy_plan(oc->_Jxx_plan);
-    fftw_destroy_plan(oc->_Jzz_plan);
-    fftw_destroy_plan(oc->_Jxz_plan);
     MEM_freeN(oc->_Jxx);
     MEM_freeN(oc->_Jzz);
     MEM_freeN(oc->_Jxz);
   }
 
-  BLI_thread_unlock(LOCK_FFTW);
-
   if (oc->_fft_in) {
     MEM_freeN(oc->_fft_in);
   }
@@ -1383,13 +1383,9 @@ void BKE_ocean_bake(Ocean *o,
                     void (*update_cb)(void *, float progress, int *cancel),
                     void *update_cb_data)
 {
-  /* NOTE(@ideasman42): some of these values remain uninitialized unless certain options
-   * are enabled, take care that #BKE_ocean_eval_ij() initializes a member before use. */
-  OceanResult ocr;
-
   ImageFormatData imf = {0};
 
-  int f, i = 0, x, y, cancel = 0;
+  int f, i = 0, cancel = 0;
   float progress;
 
   ImBuf *ibuf_foam, *ibuf_disp, *ibuf_normal, *ibuf_spray, *ibuf_spray_inverse;
@@ -1430,71 +1426,78 @@ void BKE_ocean_bake(Ocean *o,
     BKE_ocean_simulate(o, och->time[i], och->wave_scale, och->chop_amount);
 
     /* add new foam */
-    for (y = 0; y < res_y; y++) {
-      for (x = 0; x < res_x; x++) {
+    blender::threading::parallel_for(IndexRange(res_y), 16, [&](const IndexRange range) {
+      /* NOTE(@ideasman42): some of these values remain uninitialized unless certain options
+       * are enabled, take care that #BKE_ocean_eval_ij() initializes a member before use. */
+      OceanResult ocr;
 
-        BKE_ocean_eval_ij(o, &ocr, x, y);
+      for (const int y : range) {
+        for (int x = 0; x < res_x; x++) {
+          BKE_ocean_eval_ij(o, &ocr, x, y);
 
-        /* add to the image */
-        rgb_to_rgba_unit_alpha(&ibuf_disp->float_buffer.data[4 * (res_x * y + x)], ocr.disp);
+          /* add to the image */
+          rgb_to_rgba_unit_alpha(&ibuf_disp->float_buffer.data[4 * (res_x * y + x)], ocr.disp);
 
-        if (o->_do_jacobian) {
-          /* TODO(@ideasman42): cleanup unused code. */
+          if (o->_do_jacobian) {
+            /* TODO(@ideasman42): cleanup unused code. */
 
-          float /* r, */ /* UNUSED */ pr = 0.0f, foam_result;
-          float neg_disp, neg_eplus;
+            float /* r, */ /* UNUSED */ pr = 0.0f, foam_result;
+            float neg_disp, neg_eplus;
 
-          ocr.foam = BKE_ocean_jminus_to_foam(ocr.Jminus, och->foam_coverage);
+            ocr.foam = BKE_ocean_jminus_to_foam(ocr.Jminus, och->foam_coverage);
 
-          /* accumulate previous value for this cell */
-          if (i > 0) {
-            pr = prev_foam[res_x * y + x];
-          }
+            /* accumulate previous value for this cell */
+            if (i > 0) {
+              pr = prev_foam[res_x * y + x];
+            }
 
-          // r = BLI_rng_get_float(rng); /* UNUSED */ /* randomly reduce foam */
+            // r = BLI_rng_get_float(rng); /* UNUSED */ /* randomly reduce foam */
 
-          // pr = pr * och->foam_fade; /* overall fade */
+            // pr = pr * och->foam_fade; /* overall fade */
 
-          /* Remember ocean coord system is Y up!
-           * break up the foam where height (Y) is low (wave valley),
-           * and X and Z displacement is greatest. */
+            /* Remember ocean coord system is Y up!
+             * break up the foam where height (Y) is low (wave valley),
+             * and X and Z displacement is greatest. */
 
-          neg_disp = ocr.disp[1] < 0.0f ? 1.0f + ocr.disp[1] : 1.0f;
-          neg_disp = neg_disp < 0.0f ? 0.0f : neg_disp;
+            neg_disp = ocr.disp[1] < 0.0f ? 1.0f + ocr.disp[1] : 1.0f;
+            neg_disp = neg_disp < 0.0f ? 0.0f : neg_disp;
 
-          /* foam, 'ocr.Eplus' only initialized with do_jacobian */
-          neg_eplus = ocr.Eplus[2] < 0.0f ? 1.0f + ocr.Eplus[2] : 1.0f;
-          neg_eplus = neg_eplus < 0.0f ? 0.0f : neg_eplus;
+            /* foam, 'ocr.Eplus' only initialized with do_jacobian */
+            neg_eplus = ocr.Eplus[2] < 0.0f ? 1.0f + ocr.Eplus[2] : 1.0f;
+            neg_eplus = neg_eplus < 0.0f ? 0.0f : neg_eplus;
 
-          if (pr < 1.0f) {
-            pr *= pr;
-          }
+            if (pr < 1.0f) {
+              pr *= pr;
+            }
 
-          pr *= och->foam_fade * (0.75f + neg_eplus * 0.25f);
+            pr *= och->foam_fade * (0.75f + neg_eplus * 0.25f);
 
-          /* A full clamping should not be needed! */
-          foam_result = min_ff(pr + ocr.foam, 1.0f);
+            /* A full clamping should not be needed! */
+            foam_result = min_ff(pr + ocr.foam, 1.0f);
 
-          prev_foam[res_x * y + x] = foam_result;
+            prev_foam[res_x * y + x] = foam_result;
 
-          // foam_result = min_ff(foam_result, 1.0f);
+            // foam_result = min_ff(foam_result, 1.0f);
 
-          value_to_rgba_unit_alpha(&ibuf_foam->float_buffer.data[4 * (res_x * y + x)],
-                                   foam_result);
+            value_to_rgba_unit_alpha(&ibuf_foam->float_buffer.data[4 * (res_x * y + x)],
+                                     foam_result);
 
-          /* spray map baking */
-          if (o->_do_spray) {
-            rgb_to_rgba_unit_alpha(&ibuf_spray->float_buffer.data[4 * (res_x * y + x)], ocr.Eplus);
-            rgb_to_rgba_unit_alpha(&ibuf_spray_inverse->float_buffer.data[4 * (res_x * y + x)],
-                                   ocr.Eminus);
+            /* spray map baking */
+            if (o->_do_spray) {
+              rgb_to_rgba_unit_alpha(&ibuf_spray->float_buffer.data[4 * (res_x * y + x)],
+                                     ocr.Eplus);
+              rgb_to_rgba_unit_alpha(&ibuf_spray_inverse->float_buffer.data[4 * (res_x * y + x)],
+                                     ocr.Eminus);
+            }
           }
-        }
 
-        if (o->_do_normals) {
-          rgb_to_rgba_unit_alpha(&ibuf_normal->float_buffer.data[4 * (res_x * y + x)], ocr.normal);
+          if (o->_do_normals) {
+            rgb_to_rgba_unit_alpha(&ibuf_normal->float_buffer.data[4 * (res_x * y + x)],
+                                   ocr.normal);
+          }
         }
       }
-    }
+    });
 
     /* write the images */
     cache_filepath(filepath, och->bakepath, och->relbase, f, CACHE_TYPE_DISPLACE);
@@ -72,15 +72,8 @@ typedef struct Ocean {
   fftw_complex *_fft_in_nz;  /* init w   sim w */
   fftw_complex *_htilda;     /* init w   sim w (only once) */
 
-  /* fftw "plans" */
-  fftw_plan _disp_y_plan; /* init w   sim r */
-  fftw_plan _disp_x_plan; /* init w   sim r */
-  fftw_plan _disp_z_plan; /* init w   sim r */
-  fftw_plan _N_x_plan;    /* init w   sim r */
-  fftw_plan _N_z_plan;    /* init w   sim r */
-  fftw_plan _Jxx_plan;    /* init w   sim r */
-  fftw_plan _Jxz_plan;    /* init w   sim r */
-  fftw_plan _Jzz_plan;    /* init w   sim r */
+  /* fftw "plan" used for all transforms, shared with other oceans of the same resolution. */
+  fftw_plan _c2r_plan; /* init w   sim r */
 
   /* two dimensional arrays of float */
   double *_disp_y; /* init w   sim w via plan? */
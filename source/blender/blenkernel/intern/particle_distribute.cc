@@ -10,12 +10,14 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_jitter_2d.h"
 #include "BLI_kdtree.h"
 #include "BLI_math_geom.h"
 #include "BLI_rand.h"
 #include "BLI_sort.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_mesh_types.h"
@@ -889,7 +891,7 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
   Mesh *final_mesh = sim->psmd->mesh_final;
   Object *ob = sim->ob;
   ParticleSystem *psys = sim->psys;
-  ParticleData *pa = nullptr, *tpars = nullptr;
+  ParticleData *tpars = nullptr;
   ParticleSettings *part;
   ParticleSeam *seams = nullptr;
   KDTree_3d *tree = nullptr;
@@ -900,7 +902,7 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
   int totelem = 0, totpart, *particle_element = nullptr, children = 0, totseam = 0;
   int jitlevel = 1, distr;
   float *element_weight = nullptr, *jitter_offset = nullptr, *vweight = nullptr;
-  float cur, maxweight = 0.0, tweight, totweight, inv_totweight, co[3], nor[3], orco[3];
+  float cur, maxweight = 0.0, totweight, inv_totweight, co[3];
   RNG *rng = nullptr;
 
   if (ELEM(nullptr, ob, psys, psys->part)) {
@@ -978,20 +980,32 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
 
     tree = BLI_kdtree_3d_new(totpart);
 
-    for (p = 0, pa = psys->particles; p < totpart; p++, pa++) {
-      psys_particle_on_dm(mesh,
-                          part->from,
-                          pa->num,
-                          pa->num_dmcache,
-                          pa->fuv,
-                          pa->foffset,
-                          co,
-                          nor,
-                          nullptr,
-                          nullptr,
-                          orco);
-      BKE_mesh_orco_verts_transform(static_cast<Mesh *>(ob->data), &orco, 1, true);
-      BLI_kdtree_3d_insert(tree, p, orco);
+    /* Evaluating the parent locations is the expensive part, do it in parallel and insert them
+     * into the tree in order afterwards so the balanced tree doesn't depend on the scheduling. */
+    blender::Array<blender::float3> parent_orcos(totpart);
+    blender::threading::parallel_for(
+        blender::IndexRange(totpart), 1024, [&](const blender::IndexRange range) {
+          for (const int p : range) {
+            const ParticleData *pa = &psys->particles[p];
+            float co[3], nor[3];
+            psys_particle_on_dm(mesh,
+                                part->from,
+                                pa->num,
+                                pa->num_dmcache,
+                                pa->fuv,
+                                pa->foffset,
+                                co,
+                                nor,
+                                nullptr,
+                                nullptr,
+                                parent_orcos[p]);
+            BKE_mesh_orco_verts_transform(
+                static_cast<Mesh *>(ob->data), (float(*)[3])&parent_orcos[p], 1, true);
+          }
+        });
+
+    for (p = 0; p < totpart; p++) {
+      BLI_kdtree_3d_insert(tree, p, parent_orcos[p]);
     }
 
     BLI_kdtree_3d_balance(tree);
@@ -1069,46 +1083,57 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
 
   /* Calculate weights from face areas */
   if ((part->flag & PART_EDISTR || children) && from != PART_FROM_VERT) {
-    float totarea = 0.0f, co1[3], co2[3], co3[3], co4[3];
+    float totarea = 0.0f;
     const float(*orcodata)[3];
 
     orcodata = static_cast<const float(*)[3]>(CustomData_get_layer(&mesh->vert_data, CD_ORCO));
 
-    MFace *mfaces = (MFace *)CustomData_get_layer_for_write(
-        &mesh->fdata_legacy, CD_MFACE, mesh->totface_legacy);
-    for (i = 0; i < totelem; i++) {
-      MFace *mf = &mfaces[i];
-
-      if (orcodata) {
-        /* Transform orcos from normalized 0..1 to object space. */
-        copy_v3_v3(co1, orcodata[mf->v1]);
-        copy_v3_v3(co2, orcodata[mf->v2]);
-        copy_v3_v3(co3, orcodata[mf->v3]);
-        BKE_mesh_orco_verts_transform(static_cast<Mesh *>(ob->data), &co1, 1, true);
-        BKE_mesh_orco_verts_transform(static_cast<Mesh *>(ob->data), &co2, 1, true);
-        BKE_mesh_orco_verts_transform(static_cast<Mesh *>(ob->data), &co3, 1, true);
-        if (mf->v4) {
-          copy_v3_v3(co4, orcodata[mf->v4]);
-          BKE_mesh_orco_verts_transform(static_cast<Mesh *>(ob->data), &co4, 1, true);
-        }
-      }
-      else {
-        blender::MutableSpan<blender::float3> positions = mesh->vert_positions_for_write();
-        copy_v3_v3(co1, positions[mf->v1]);
-        copy_v3_v3(co2, positions[mf->v2]);
-        copy_v3_v3(co3, positions[mf->v3]);
-        if (mf->v4) {
-          copy_v3_v3(co4, positions[mf->v4]);
-        }
-      }
+    const MFace *mfaces = static_cast<const MFace *>(
+        CustomData_get_layer(&mesh->fdata_legacy, CD_MFACE));
+    const blender::Span<blender::float3> positions = mesh->vert_positions();
+    Mesh *ob_mesh = static_cast<Mesh *>(ob->data);
+
+    blender::threading::parallel_for(
+        blender::IndexRange(totelem), 4096, [&](const blender::IndexRange range) {
+          float co1[3], co2[3], co3[3], co4[3];
+          for (const int i : range) {
+            const MFace *mf = &mfaces[i];
+
+            if (orcodata) {
+              /* Transform orcos from normalized 0..1 to object space. */
+              copy_v3_v3(co1, orcodata[mf->v1]);
+              copy_v3_v3(co2, orcodata[mf->v2]);
+              copy_v3_v3(co3, orcodata[mf->v3]);
+              BKE_mesh_orco_verts_transform(ob_mesh, &co1, 1, true);
+              BKE_mesh_orco_verts_transform(ob_mesh, &co2, 1, true);
+              BKE_mesh_orco_verts_transform(ob_mesh, &co3, 1, true);
+              if (mf->v4) {
+                copy_v3_v3(co4, orcodata[mf->v4]);
+                BKE_mesh_orco_verts_transform(ob_mesh, &co4, 1, true);
+              }
+            }
+            else {
+              copy_v3_v3(co1, positions[mf->v1]);
+              copy_v3_v3(co2, positions[mf->v2]);
+              copy_v3_v3(co3, positions[mf->v3]);
+              if (mf->v4) {
+                copy_v3_v3(co4, positions[mf->v4]);
+              }
+            }
 
-      cur = mf->v4 ? area_quad_v3(co1, co2, co3, co4) : area_tri_v3(co1, co2, co3);
+            element_weight[i] = mf->v4 ? area_quad_v3(co1, co2, co3, co4) :
+                                         area_tri_v3(co1, co2, co3);
+          }
+        });
+
+    /* Sum in element order so the distribution is identical regardless of the thread count. */
+    for (i = 0; i < totelem; i++) {
+      cur = element_weight[i];
 
       if (cur > maxweight) {
         maxweight = cur;
       }
 
-      element_weight[i] = cur;
       totarea += cur;
     }
 
@@ -1136,22 +1161,25 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
       }
     }
     else { /* PART_FROM_FACE / PART_FROM_VOLUME */
-      MFace *mfaces = (MFace *)CustomData_get_layer_for_write(
-          &mesh->fdata_legacy, CD_MFACE, mesh->totface_legacy);
-      for (i = 0; i < totelem; i++) {
-        MFace *mf = &mfaces[i];
-        tweight = vweight[mf->v1] + vweight[mf->v2] + vweight[mf->v3];
-
-        if (mf->v4) {
-          tweight += vweight[mf->v4];
-          tweight /= 4.0f;
-        }
-        else {
-          tweight /= 3.0f;
-        }
+      const MFace *mfaces = static_cast<const MFace *>(
+          CustomData_get_layer(&mesh->fdata_legacy, CD_MFACE));
+      blender::threading::parallel_for(
+          blender::IndexRange(totelem), 4096, [&](const blender::IndexRange range) {
+            for (const int i : range) {
+              const MFace *mf = &mfaces[i];
+              float tweight = vweight[mf->v1] + vweight[mf->v2] + vweight[mf->v3];
+
+              if (mf->v4) {
+                tweight += vweight[mf->v4];
+                tweight /= 4.0f;
+              }
+              else {
+                tweight /= 3.0f;
+              }
 
-        element_weight[i] *= tweight;
-      }
+              element_weight[i] *= tweight;
+            }
+          });
     }
     MEM_freeN(vweight);
   }
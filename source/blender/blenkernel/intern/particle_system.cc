@@ -63,6 +63,8 @@
 #include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_query.hh"
 
+#include "particle_private.h"
+
 /* FLUID sim particle import */
 #ifdef WITH_FLUID
 #  include "DNA_fluid_types.h"
@@ -3770,6 +3772,61 @@ static void dynamics_step_sph_ddr_task_cb_ex(void *__restrict userdata,
   }
 }
 
+/**
+ * Newtonian integration can only be split over threads when every particle is independent of the
+ * evaluation order: the brownian force, noisy force fields and collision response all draw from
+ * shared random number generators, so they keep the serial loop to stay deterministic.
+ * Systems that are their own effector (#PART_SELF_EFFECT) read the state of the particles that
+ * other threads are integrating, so they have to stay serial as well.
+ */
+bool psys_dynamics_step_newton_use_threading(ParticleSimulationData *sim)
+{
+  ParticleSystem *psys = sim->psys;
+
+  if (psys->part->brownfac != 0.0f || sim->colliders) {
+    return false;
+  }
+
+  if (psys->part->flag & PART_SELF_EFFECT) {
+    return false;
+  }
+
+  if (psys->effectors) {
+    LISTBASE_FOREACH (EffectorCache *, eff, psys->effectors) {
+      if (eff->psys == psys) {
+        return false;
+      }
+      if (eff->pd && eff->pd->f_noise > 0.0f) {
+        return false;
+      }
+    }
+  }
+
+  return psys->totpart > 100;
+}
+
+static void dynamics_step_newton_task_cb_ex(void *__restrict userdata,
+                                            const int p,
+                                            const TaskParallelTLS *__restrict /*tls*/)
+{
+  DynamicStepSolverTaskData *data = static_cast<DynamicStepSolverTaskData *>(userdata);
+  ParticleSimulationData *sim = data->sim;
+  ParticleSystem *psys = sim->psys;
+  ParticleSettings *part = psys->part;
+
+  ParticleData *pa;
+
+  if ((pa = psys->particles + p)->state.time <= 0.0f) {
+    return;
+  }
+
+  /* do global forces & effectors */
+  basic_integrate(sim, p, pa->state.time, data->cfra);
+
+  /* rotations */
+  basic_rotate(part, pa, pa->state.time, data->timestep);
+}
+
 static void dynamics_step_sph_classical_basic_integrate_task_cb_ex(
     void *__restrict userdata, const int p, const TaskParallelTLS *__restrict /*tls*/)
 {
@@ -3968,6 +4025,21 @@ static void dynamics_step(ParticleSimulationData *sim, float cfra)
 
   switch (part->phystype) {
     case PART_PHYS_NEWTON: {
+      if (psys_dynamics_step_newton_use_threading(sim)) {
+        DynamicStepSolverTaskData task_data{};
+        task_data.sim = sim;
+        task_data.cfra = cfra;
+        task_data.timestep = timestep;
+        task_data.dtime = dtime;
+
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        settings.min_iter_per_thread = 64;
+        BLI_task_parallel_range(
+            0, psys->totpart, &task_data, dynamics_step_newton_task_cb_ex, &settings);
+        break;
+      }
+
       LOOP_DYNAMIC_PARTICLES
       {
         /* do global forces & effectors */
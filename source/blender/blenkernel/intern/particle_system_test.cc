@@ -0,0 +1,76 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+#include "testing/testing.h"
+
+#include "DNA_listBase.h"
+#include "DNA_object_force_types.h"
+#include "DNA_particle_types.h"
+
+#include "BLI_listbase.h"
+
+#include "BKE_effect.h"
+#include "BKE_particle.h"
+
+#include "particle_private.h"
+
+namespace blender::bke::tests {
+
+struct NewtonThreadingTestContext {
+  ParticleSettings part = {};
+  ParticleSystem psys = {};
+  ParticleSimulationData sim = {};
+  ListBase effectors = {nullptr, nullptr};
+  EffectorCache eff = {};
+  PartDeflect pd = {};
+
+  NewtonThreadingTestContext()
+  {
+    psys.part = &part;
+    psys.totpart = 1000;
+    sim.psys = &psys;
+    eff.pd = &pd;
+  }
+
+  void add_effector(ParticleSystem *eff_psys)
+  {
+    eff.psys = eff_psys;
+    BLI_addtail(&effectors, &eff);
+    psys.effectors = &effectors;
+  }
+};
+
+TEST(particle_system, newton_threading_independent_particles)
+{
+  NewtonThreadingTestContext ctx;
+  EXPECT_TRUE(psys_dynamics_step_newton_use_threading(&ctx.sim));
+
+  ParticleSystem other_psys = {};
+  ctx.add_effector(&other_psys);
+  EXPECT_TRUE(psys_dynamics_step_newton_use_threading(&ctx.sim));
+}
+
+TEST(particle_system, newton_threading_self_effect_flag)
+{
+  NewtonThreadingTestContext ctx;
+  ctx.part.flag |= PART_SELF_EFFECT;
+  EXPECT_FALSE(psys_dynamics_step_newton_use_threading(&ctx.sim));
+}
+
+TEST(particle_system, newton_threading_self_effector)
+{
+  /* Particles reading the state of their own system must not race with the other threads. */
+  NewtonThreadingTestContext ctx;
+  ctx.add_effector(&ctx.psys);
+  EXPECT_FALSE(psys_dynamics_step_newton_use_threading(&ctx.sim));
+}
+
+TEST(particle_system, newton_threading_noise_effector)
+{
+  NewtonThreadingTestContext ctx;
+  ctx.pd.f_noise = 1.0f;
+  ctx.add_effector(nullptr);
+  EXPECT_FALSE(psys_dynamics_step_newton_use_threading(&ctx.sim));
+}
+
+}  // namespace blender::bke::tests
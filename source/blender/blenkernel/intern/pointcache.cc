@@ -40,6 +40,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
 
@@ -86,6 +87,8 @@
 #  include "LzmaLib.h"
 #endif
 
+#include <zstd.h>
+
 #define PTCACHE_DATA_FROM(data, type, from) \
   if (data[type]) { \
     memcpy(data[type], from, ptcache_data_size[type]); \
@@ -704,11 +707,12 @@ static int ptcache_dynamicpaint_write(PTCacheFile *pf, void *dp_v)
       return 0;
     }
 
-    out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len), "pointcache_lzo_buffer");
+    out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
 
-    ptcache_file_compressed_write(
+    const int ok = ptcache_file_compressed_write(
         pf, (uchar *)surface->data->type_data, in_len, out, cache_compress);
     MEM_freeN(out);
+    return ok;
   }
   return 1;
 }
@@ -1508,6 +1512,34 @@ static void ptcache_file_close(PTCacheFile *pf)
   }
 }
 
+/**
+ * Reorder the bytes of 4-byte words so that all first bytes come first, then all second bytes
+ * and so on. Point cache data is mostly made of floats, whose sign/exponent bytes vary much
+ * less than the mantissa bytes between neighboring points, so grouping them greatly improves
+ * the compression ratio.
+ */
+static void ptcache_filter_shuffle(const uchar *in, uchar *out, const size_t len)
+{
+  const size_t words_num = len / 4;
+  for (size_t i = 0; i < words_num; i++) {
+    for (size_t b = 0; b < 4; b++) {
+      out[b * words_num + i] = in[i * 4 + b];
+    }
+  }
+  /* Trailing bytes that don't fill a whole word are kept as is. */
+  memcpy(out + words_num * 4, in + words_num * 4, len - words_num * 4);
+}
+static void ptcache_filter_unshuffle(const uchar *in, uchar *out, const size_t len)
+{
+  const size_t words_num = len / 4;
+  for (size_t i = 0; i < words_num; i++) {
+    for (size_t b = 0; b < 4; b++) {
+      out[i * 4 + b] = in[b * words_num + i];
+    }
+  }
+  memcpy(out + words_num * 4, in + words_num * 4, len - words_num * 4);
+}
+
 static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len)
 {
   int r = 0;
@@ -1545,6 +1577,21 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len
         r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
       }
 #endif
+      if (compressed == 3) {
+        const size_t result_len = ZSTD_decompress(result, len, in, in_len);
+        r = (ZSTD_isError(result_len) || result_len != len) ? 1 : 0;
+      }
+      else if (compressed == 4) {
+        uchar *filtered = (uchar *)MEM_mallocN(len, "pointcache_filtered_buffer");
+        const size_t result_len = ZSTD_decompress(filtered, len, in, in_len);
+        if (ZSTD_isError(result_len) || result_len != len) {
+          r = 1;
+        }
+        else {
+          ptcache_filter_unshuffle(filtered, result, len);
+        }
+        MEM_freeN(filtered);
+      }
       MEM_freeN(in);
     }
   }
@@ -1556,23 +1603,31 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len
 
   return r;
 }
-static int ptcache_file_compressed_write(
-    PTCacheFile *pf, uchar *in, uint in_len, uchar *out, int mode)
+
+/**
+ * Compress a buffer without touching the file, so that independent data arrays of a frame
+ * can be compressed concurrently. The `out` buffer must hold at least `LZO_OUT_LEN(in_len) * 4`
+ * bytes and `props` at least 16 bytes.
+ *
+ * \return The compression type that is stored in the file, 0 when the data is stored as is.
+ */
+static uchar ptcache_compress_buffer(const uchar *in,
+                                     const uint in_len,
+                                     uchar *out,
+                                     size_t *r_out_len,
+                                     uchar *props,
+                                     size_t *r_props_len,
+                                     const int mode)
 {
-  int r = 0;
   uchar compressed = 0;
   size_t out_len = 0;
-  uchar *props = static_cast<uchar *>(MEM_callocN(sizeof(char[16]), "tmp"));
-  size_t sizeOfIt = 5;
-
-  (void)mode; /* unused when building w/o compression */
 
 #ifdef WITH_LZO
   out_len = LZO_OUT_LEN(in_len);
   if (mode == PTCACHE_COMPRESS_LZO) {
     LZO_HEAP_ALLOC(wrkmem, LZO1X_MEM_COMPRESS);
 
-    r = lzo1x_1_compress(in, (lzo_uint)in_len, out, (lzo_uint *)&out_len, wrkmem);
+    const int r = lzo1x_1_compress(in, (lzo_uint)in_len, out, (lzo_uint *)&out_len, wrkmem);
     if (!(r == LZO_E_OK) || (out_len >= in_len)) {
       compressed = 0;
     }
@@ -1583,20 +1638,22 @@ static int ptcache_file_compressed_write(
 #endif
 #ifdef WITH_LZMA
   if (mode == PTCACHE_COMPRESS_LZMA) {
-
-    r = LzmaCompress(out,
-                     &out_len,
-                     in,
-                     in_len, /* Assume `sizeof(char) == 1`. */
-                     props,
-                     &sizeOfIt,
-                     5,
-                     1 << 24,
-                     3,
-                     0,
-                     2,
-                     32,
-                     2);
+    out_len = LZO_OUT_LEN(in_len);
+    *r_props_len = 5;
+
+    const int r = LzmaCompress(out,
+                               &out_len,
+                               in,
+                               in_len, /* Assume `sizeof(char) == 1`. */
+                               props,
+                               r_props_len,
+                               5,
+                               1 << 24,
+                               3,
+                               0,
+                               2,
+                               32,
+                               2);
 
     if (!(r == SZ_OK) || (out_len >= in_len)) {
       compressed = 0;
@@ -1606,26 +1663,72 @@ static int ptcache_file_compressed_write(
     }
   }
 #endif
+  if (ELEM(mode, PTCACHE_COMPRESS_ZSTD_FAST, PTCACHE_COMPRESS_ZSTD_FILTERED)) {
+    const size_t out_capacity = LZO_OUT_LEN(in_len) * 4;
+    BLI_assert(ZSTD_compressBound(in_len) <= out_capacity);
 
-  ptcache_file_write(pf, &compressed, 1, sizeof(uchar));
+    if (mode == PTCACHE_COMPRESS_ZSTD_FILTERED) {
+      uchar *filtered = (uchar *)MEM_mallocN(in_len, "pointcache_filtered_buffer");
+      ptcache_filter_shuffle(in, filtered, in_len);
+      out_len = ZSTD_compress(out, out_capacity, filtered, in_len, 3);
+      MEM_freeN(filtered);
+    }
+    else {
+      out_len = ZSTD_compress(out, out_capacity, in, in_len, 1);
+    }
+
+    if (ZSTD_isError(out_len) || (out_len >= in_len)) {
+      compressed = 0;
+    }
+    else {
+      compressed = (mode == PTCACHE_COMPRESS_ZSTD_FILTERED) ? 4 : 3;
+    }
+  }
+
+  UNUSED_VARS(props, r_props_len);
+
+  *r_out_len = out_len;
+  return compressed;
+}
+/** \return 1 when all data was written, 0 on a write error. */
+static int ptcache_file_compressed_buffer_write(PTCacheFile *pf,
+                                                const uchar *in,
+                                                const uint in_len,
+                                                const uchar compressed,
+                                                const uchar *out,
+                                                const size_t out_len,
+                                                const uchar *props,
+                                                const size_t props_len)
+{
+  int ok = ptcache_file_write(pf, &compressed, 1, sizeof(uchar));
   if (compressed) {
     uint size = out_len;
-    ptcache_file_write(pf, &size, 1, sizeof(uint));
-    ptcache_file_write(pf, out, out_len, sizeof(uchar));
+    ok = ok && ptcache_file_write(pf, &size, 1, sizeof(uint));
+    ok = ok && ptcache_file_write(pf, out, out_len, sizeof(uchar));
   }
   else {
-    ptcache_file_write(pf, in, in_len, sizeof(uchar));
+    ok = ok && ptcache_file_write(pf, in, in_len, sizeof(uchar));
   }
 
   if (compressed == 2) {
-    uint size = sizeOfIt;
-    ptcache_file_write(pf, &sizeOfIt, 1, sizeof(uint));
-    ptcache_file_write(pf, props, size, sizeof(uchar));
+    uint size = props_len;
+    ok = ok && ptcache_file_write(pf, &size, 1, sizeof(uint));
+    ok = ok && ptcache_file_write(pf, props, size, sizeof(uchar));
   }
 
-  MEM_freeN(props);
+  return ok;
+}
+static int ptcache_file_compressed_write(
+    PTCacheFile *pf, uchar *in, uint in_len, uchar *out, int mode)
+{
+  uchar props[16] = {0};
+  size_t props_len = 5;
+  size_t out_len = 0;
 
-  return r;
+  const uchar compressed = ptcache_compress_buffer(
+      in, in_len, out, &out_len, props, &props_len, mode);
+  return ptcache_file_compressed_buffer_write(
+      pf, in, in_len, compressed, out, out_len, props, props_len);
 }
 static int ptcache_file_read(PTCacheFile *pf, void *f, uint tot, uint size)
 {
@@ -2064,13 +2167,52 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
 
   if (!error) {
     if (pid->cache->compression) {
+      /* Every data array is compressed independently, do that in parallel and only write the
+       * results to the file sequentially afterwards. */
+      struct CompressedData {
+        uchar compressed = 0;
+        uchar *out = nullptr;
+        size_t out_len = 0;
+        uchar props[16] = {0};
+        size_t props_len = 5;
+      };
+      CompressedData compressed_data[BPHYS_TOT_DATA];
+      const int compression = pid->cache->compression;
+
+      blender::threading::parallel_for(
+          blender::IndexRange(BPHYS_TOT_DATA), 1, [&](const blender::IndexRange range) {
+            for (const int64_t data_i : range) {
+              if (pm->data[data_i] == nullptr) {
+                continue;
+              }
+              CompressedData &data = compressed_data[data_i];
+              const uint in_len = pm->totpoint * ptcache_data_size[data_i];
+              data.out = (uchar *)MEM_mallocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
+              data.compressed = ptcache_compress_buffer((uchar *)(pm->data[data_i]),
+                                                        in_len,
+                                                        data.out,
+                                                        &data.out_len,
+                                                        data.props,
+                                                        &data.props_len,
+                                                        compression);
+            }
+          });
+
       for (i = 0; i < BPHYS_TOT_DATA; i++) {
         if (pm->data[i]) {
-          uint in_len = pm->totpoint * ptcache_data_size[i];
-          uchar *out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
-          ptcache_file_compressed_write(
-              pf, (uchar *)(pm->data[i]), in_len, out, pid->cache->compression);
-          MEM_freeN(out);
+          const CompressedData &data = compressed_data[i];
+          if (!error && !ptcache_file_compressed_buffer_write(pf,
+                                                             (uchar *)(pm->data[i]),
+                                                             pm->totpoint * ptcache_data_size[i],
+                                                             data.compressed,
+                                                             data.out,
+                                                             data.out_len,
+                                                             data.props,
+                                                             data.props_len))
+          {
+            error = 1;
+          }
+          MEM_freeN(data.out);
         }
       }
     }
@@ -2104,8 +2246,11 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
       if (pid->cache->compression) {
         uint in_len = extra->totdata * ptcache_extra_datasize[extra->type];
         uchar *out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
-        ptcache_file_compressed_write(
-            pf, (uchar *)(extra->data), in_len, out, pid->cache->compression);
+        if (!ptcache_file_compressed_write(
+                pf, (uchar *)(extra->data), in_len, out, pid->cache->compression))
+        {
+          error = 1;
+        }
         MEM_freeN(out);
       }
       else {
@@ -11,8 +11,12 @@
 #include "DNA_mesh_types.h"
 #include "DNA_modifier_types.h"
 
+#include "BLI_implicit_sharing_ptr.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
+#include "BKE_customdata.hh"
+#include "BKE_mesh_types.hh"
 #include "BKE_subdiv_modifier.hh"
 
 #include "MEM_guardedalloc.h"
@@ -118,6 +122,7 @@ Subdiv *new_from_converter(const Settings *settings, OpenSubdiv_Converter *conve
   subdiv->topology_refiner = osd_topology_refiner;
   subdiv->evaluator = nullptr;
   subdiv->displacement_evaluator = nullptr;
+  subdiv->source_mesh_key = nullptr;
   stats_end(&stats, SUBDIV_STATS_TOPOLOGY_REFINER_CREATION_TIME);
   subdiv->stats = stats;
   return subdiv;
@@ -167,12 +172,168 @@ Subdiv *update_from_converter(Subdiv *subdiv,
   return new_from_converter(settings, converter);
 }
 
+/* Creation from mesh, with a fast path for unchanged topology. */
+
+/**
+ * A user is held on every implicitly shared array which is used to construct the topology
+ * refiner. This prevents the arrays from being freed or modified in-place, so a mesh which
+ * references the very same arrays is guaranteed to have the same topology. That is the case
+ * when only positions changed, for example for meshes deformed by an armature, even across
+ * copies of the evaluated mesh.
+ *
+ * The downside is that the held arrays stay in memory after the mesh they came from is freed,
+ * and that modifying them in the original mesh has to make a copy first. To limit that, only
+ * the arrays that the topology refiner is built from are part of the key.
+ */
+struct SourceMeshKey {
+  int verts_num;
+  int edges_num;
+  int faces_num;
+  int corners_num;
+  Vector<const void *> data;
+  Vector<ImplicitSharingPtr<ImplicitSharingInfo>> sharing_infos;
+};
+
+static bool source_mesh_key_add_layer(const CustomDataLayer &layer,
+                                      Vector<const void *> &r_data,
+                                      Vector<const ImplicitSharingInfo *> &r_sharing_infos)
+{
+  if (layer.data == nullptr) {
+    return true;
+  }
+  if (layer.sharing_info == nullptr) {
+    return false;
+  }
+  r_data.append(layer.data);
+  r_sharing_infos.append(layer.sharing_info);
+  return true;
+}
+
+static bool source_mesh_key_add_named_layer(const CustomData &data,
+                                            const eCustomDataType type,
+                                            const char *name,
+                                            Vector<const void *> &r_data,
+                                            Vector<const ImplicitSharingInfo *> &r_sharing_infos)
+{
+  const int layer_index = CustomData_get_named_layer_index(&data, type, name);
+  if (layer_index == -1) {
+    return true;
+  }
+  return source_mesh_key_add_layer(data.layers[layer_index], r_data, r_sharing_infos);
+}
+
+/**
+ * Gather the arrays which the topology refiner is built from: face offsets, edges, corner
+ * vertices and edges, UV maps and, when enabled, the creases.
+ *
+ * \return False when some of the data is not implicitly shared and can not be used as a key.
+ */
+static bool source_mesh_key_gather(const Mesh &mesh,
+                                   const Settings &settings,
+                                   Vector<const void *> &r_data,
+                                   Vector<const ImplicitSharingInfo *> &r_sharing_infos)
+{
+  if (mesh.faces_num > 0) {
+    if (mesh.runtime->face_offsets_sharing_info == nullptr) {
+      return false;
+    }
+    r_data.append(mesh.face_offset_indices);
+    r_sharing_infos.append(mesh.runtime->face_offsets_sharing_info);
+  }
+  if (!source_mesh_key_add_named_layer(
+          mesh.edge_data, CD_PROP_INT32_2D, ".edge_verts", r_data, r_sharing_infos) ||
+      !source_mesh_key_add_named_layer(
+          mesh.corner_data, CD_PROP_INT32, ".corner_vert", r_data, r_sharing_infos) ||
+      !source_mesh_key_add_named_layer(
+          mesh.corner_data, CD_PROP_INT32, ".corner_edge", r_data, r_sharing_infos))
+  {
+    return false;
+  }
+  for (const CustomDataLayer &layer : Span(mesh.corner_data.layers, mesh.corner_data.totlayer)) {
+    if (layer.type == CD_PROP_FLOAT2) {
+      if (!source_mesh_key_add_layer(layer, r_data, r_sharing_infos)) {
+        return false;
+      }
+    }
+  }
+  if (settings.use_creases) {
+    if (!source_mesh_key_add_named_layer(
+            mesh.vert_data, CD_PROP_FLOAT, "crease_vert", r_data, r_sharing_infos) ||
+        !source_mesh_key_add_named_layer(
+            mesh.edge_data, CD_PROP_FLOAT, "crease_edge", r_data, r_sharing_infos))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool source_mesh_key_matches(const SourceMeshKey *key,
+                                    const Settings &settings,
+                                    const Mesh &mesh)
+{
+  if (key == nullptr) {
+    return false;
+  }
+  if (key->verts_num != mesh.verts_num || key->edges_num != mesh.edges_num ||
+      key->faces_num != mesh.faces_num || key->corners_num != mesh.corners_num)
+  {
+    return false;
+  }
+  Vector<const void *> data;
+  Vector<const ImplicitSharingInfo *> sharing_infos;
+  if (!source_mesh_key_gather(mesh, settings, data, sharing_infos)) {
+    return false;
+  }
+  if (data.as_span() != key->data.as_span()) {
+    return false;
+  }
+  for (const int i : sharing_infos.index_range()) {
+    if (sharing_infos[i] != key->sharing_infos[i].get()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void source_mesh_key_update(Subdiv *subdiv, const Mesh &mesh)
+{
+  MEM_delete(subdiv->source_mesh_key);
+  subdiv->source_mesh_key = nullptr;
+
+  Vector<const void *> data;
+  Vector<const ImplicitSharingInfo *> sharing_infos;
+  if (!source_mesh_key_gather(mesh, subdiv->settings, data, sharing_infos)) {
+    return;
+  }
+  SourceMeshKey *key = MEM_new<SourceMeshKey>(__func__);
+  key->verts_num = mesh.verts_num;
+  key->edges_num = mesh.edges_num;
+  key->faces_num = mesh.faces_num;
+  key->corners_num = mesh.corners_num;
+  key->data = std::move(data);
+  for (const ImplicitSharingInfo *sharing_info : sharing_infos) {
+    sharing_info->add_user();
+    key->sharing_infos.append(ImplicitSharingPtr<ImplicitSharingInfo>(sharing_info));
+  }
+  subdiv->source_mesh_key = key;
+}
+
 Subdiv *update_from_mesh(Subdiv *subdiv, const Settings *settings, const Mesh *mesh)
 {
+  if (subdiv != nullptr && subdiv->topology_refiner != nullptr &&
+      settings_equal(&subdiv->settings, settings) &&
+      source_mesh_key_matches(subdiv->source_mesh_key, *settings, *mesh))
+  {
+    return subdiv;
+  }
   OpenSubdiv_Converter converter;
   converter_init_for_mesh(&converter, settings, mesh);
   subdiv = update_from_converter(subdiv, settings, &converter);
   converter_free(&converter);
+  if (subdiv != nullptr) {
+    source_mesh_key_update(subdiv, *mesh);
+  }
   return subdiv;
 }
 
@@ -196,6 +357,7 @@ void free(Subdiv *subdiv)
   if (subdiv->cache_.face_ptex_offset != nullptr) {
     MEM_freeN(subdiv->cache_.face_ptex_offset);
   }
+  MEM_delete(subdiv->source_mesh_key);
   MEM_freeN(subdiv);
 }
 
@@ -15,7 +15,6 @@
 #include "BLI_math_bits.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
-#include "BLI_set.hh"
 #include "BLI_task.hh"
 #include "BLI_vector_set.hh"
 
@@ -914,64 +913,70 @@ static void subdiv_ccg_average_corners(SubdivCCG &subdiv_ccg,
 
 void BKE_subdiv_ccg_average_grids(SubdivCCG &subdiv_ccg)
 {
-#ifdef WITH_OPENSUBDIV
-  using namespace blender;
-  const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
   /* Average inner boundaries of grids (within one face), across faces
    * from different face-corners. */
   BKE_subdiv_ccg_average_stitch_faces(subdiv_ccg, subdiv_ccg.faces.index_range());
-  subdiv_ccg_average_boundaries(subdiv_ccg, key, subdiv_ccg.adjacent_edges.index_range());
-  subdiv_ccg_average_corners(subdiv_ccg, key, subdiv_ccg.adjacent_verts.index_range());
-#else
-  UNUSED_VARS(subdiv_ccg);
-#endif
 }
 
 #ifdef WITH_OPENSUBDIV
 
-static void subdiv_ccg_affected_face_adjacency(SubdivCCG &subdiv_ccg,
+/**
+ * Find the edges and vertices with at least one adjacent face in the mask. Every edge and vertex
+ * checks its own adjacent faces, so this runs in parallel without any synchronization.
+ */
+static void subdiv_ccg_affected_face_adjacency(const SubdivCCG &subdiv_ccg,
                                                const IndexMask &face_mask,
-                                               blender::Set<int> &adjacent_verts,
-                                               blender::Set<int> &adjacent_edges)
-{
-  Subdiv *subdiv = subdiv_ccg.subdiv;
-  const OpenSubdiv_TopologyRefiner *topology_refiner = subdiv->topology_refiner;
-
-  Vector<int, 64> face_vertices;
-  Vector<int, 64> face_edges;
-
-  face_mask.foreach_index([&](const int face_index) {
-    const int num_face_grids = subdiv_ccg.faces[face_index].size();
-    face_vertices.reinitialize(num_face_grids);
-    topology_refiner->getFaceVertices(face_index, face_vertices.data());
-    adjacent_verts.add_multiple(face_vertices);
-
-    face_edges.reinitialize(num_face_grids);
-    topology_refiner->getFaceEdges(face_index, face_edges.data());
-    adjacent_edges.add_multiple(face_edges);
-  });
+                                               IndexMaskMemory &memory,
+                                               IndexMask &r_adjacent_verts,
+                                               IndexMask &r_adjacent_edges)
+{
+  Array<bool> affected_faces(subdiv_ccg.faces.size(), false);
+  face_mask.to_bools(affected_faces);
+  const Span<int> grid_to_face_map = subdiv_ccg.grid_to_face_map;
+
+  r_adjacent_edges = IndexMask::from_predicate(
+      subdiv_ccg.adjacent_edges.index_range(), GrainSize(1024), memory, [&](const int i) {
+        const SubdivCCGAdjacentEdge &adjacent_edge = subdiv_ccg.adjacent_edges[i];
+        for (const int face_index : IndexRange(adjacent_edge.num_adjacent_faces)) {
+          const int grid_index = adjacent_edge.boundary_coords[face_index][0].grid_index;
+          if (affected_faces[grid_to_face_map[grid_index]]) {
+            return true;
+          }
+        }
+        return false;
+      });
+
+  r_adjacent_verts = IndexMask::from_predicate(
+      subdiv_ccg.adjacent_verts.index_range(), GrainSize(1024), memory, [&](const int i) {
+        const SubdivCCGAdjacentVertex &adjacent_vert = subdiv_ccg.adjacent_verts[i];
+        for (const int face_index : IndexRange(adjacent_vert.num_adjacent_faces)) {
+          const int grid_index = adjacent_vert.corner_coords[face_index].grid_index;
+          if (affected_faces[grid_to_face_map[grid_index]]) {
+            return true;
+          }
+        }
+        return false;
+      });
 }
 
 void subdiv_ccg_average_faces_boundaries_and_corners(SubdivCCG &subdiv_ccg,
                                                      const CCGKey &key,
                                                      const IndexMask &face_mask)
 {
-  blender::Set<int> adjacent_vert_set;
-  blender::Set<int> adjacent_edge_set;
-  subdiv_ccg_affected_face_adjacency(subdiv_ccg, face_mask, adjacent_vert_set, adjacent_edge_set);
-
-  Vector<int> adjacent_verts(adjacent_vert_set.begin(), adjacent_vert_set.end());
-  Vector<int> adjacent_edges(adjacent_edge_set.begin(), adjacent_edge_set.end());
-
-  std::sort(adjacent_verts.begin(), adjacent_verts.end());
-  std::sort(adjacent_edges.begin(), adjacent_edges.end());
+  if (face_mask.size() == subdiv_ccg.faces.size()) {
+    subdiv_ccg_average_boundaries(subdiv_ccg, key, subdiv_ccg.adjacent_edges.index_range());
+    subdiv_ccg_average_corners(subdiv_ccg, key, subdiv_ccg.adjacent_verts.index_range());
+    return;
+  }
 
   IndexMaskMemory memory;
-  subdiv_ccg_average_boundaries(
-      subdiv_ccg, key, IndexMask::from_indices(adjacent_edges.as_span(), memory));
+  IndexMask adjacent_verts;
+  IndexMask adjacent_edges;
+  subdiv_ccg_affected_face_adjacency(
+      subdiv_ccg, face_mask, memory, adjacent_verts, adjacent_edges);
 
-  subdiv_ccg_average_corners(
-      subdiv_ccg, key, IndexMask::from_indices(adjacent_verts.as_span(), memory));
+  subdiv_ccg_average_boundaries(subdiv_ccg, key, adjacent_edges);
+  subdiv_ccg_average_corners(subdiv_ccg, key, adjacent_verts);
 }
 
 #endif
@@ -984,10 +989,8 @@ void BKE_subdiv_ccg_average_stitch_faces(SubdivCCG &subdiv_ccg, const IndexMask
   face_mask.foreach_index(GrainSize(512), [&](const int face_index) {
     subdiv_ccg_average_inner_face_grids(subdiv_ccg, key, subdiv_ccg.faces[face_index]);
   });
-  /* TODO(sergey): Only average elements which are adjacent to modified
-   * faces. */
-  subdiv_ccg_average_boundaries(subdiv_ccg, key, subdiv_ccg.adjacent_edges.index_range());
-  subdiv_ccg_average_corners(subdiv_ccg, key, subdiv_ccg.adjacent_verts.index_range());
+  /* Only the boundaries and corners adjacent to the modified faces can be out of sync. */
+  subdiv_ccg_average_faces_boundaries_and_corners(subdiv_ccg, key, face_mask);
 #else
   UNUSED_VARS(subdiv_ccg, face_mask);
 #endif
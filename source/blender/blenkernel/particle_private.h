@@ -55,6 +55,9 @@ void do_child_modifiers(const ParticleChildModifierContext *modifier_ctx,
                         ParticleKey *state,
                         float t);
 
+/** Whether the Newtonian solver of #dynamics_step can integrate particles in parallel. */
+bool psys_dynamics_step_newton_use_threading(ParticleSimulationData *sim);
+
 #ifdef __cplusplus
 }
 #endif
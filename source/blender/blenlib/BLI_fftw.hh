@@ -6,6 +6,8 @@
 
 #pragma once
 
+struct fftw_plan_s;
+
 namespace blender::fftw {
 
 /**
@@ -23,4 +25,19 @@ int2 optimal_size_for_real_transform(int2 size);
  */
 void initialize_float();
 
+/**
+ * Alignment of arrays passed to the plans returned by #plan_c2r_2d_get. FFTW only allows executing
+ * a plan on new arrays that have the same SIMD alignment as the arrays it was created for, which
+ * is guaranteed for arrays allocated with #MEM_mallocN_aligned using this alignment.
+ */
+constexpr int plan_alignment = 64;
+
+/**
+ * Get an out of place double precision 2D complex to real plan for the given real size. Plans are
+ * created once and shared by the whole process, execute them with `fftw_execute_dft_c2r` on arrays
+ * aligned to #plan_alignment. Executing a plan is thread safe, so the same plan can be used for
+ * many transforms at once.
+ */
+fftw_plan_s *plan_c2r_2d_get(int2 size);
+
 }  // namespace blender::fftw
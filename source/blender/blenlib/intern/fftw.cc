@@ -2,12 +2,15 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
-#if defined(WITH_FFTW3_THREADS_F_SUPPORT)
+#if defined(WITH_FFTW3)
 #  include <fftw3.h>
 #endif
 
+#include <mutex>
+
 #include "BLI_fftw.hh"
 #include "BLI_index_range.hh"
+#include "BLI_map.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_task.hh"
 #include "BLI_threads.h"
@@ -91,4 +94,31 @@ void initialize_float()
 #endif
 }
 
+#if defined(WITH_FFTW3)
+
+fftw_plan_s *plan_c2r_2d_get(const int2 size)
+{
+  static std::mutex mutex;
+  /* Plans are never destroyed, there is only a handful of sizes in practice. */
+  static Map<int2, fftw_plan> plans;
+
+  std::lock_guard lock(mutex);
+  return plans.lookup_or_add_cb(size, [&]() {
+    const int64_t complex_size = int64_t(size.x) * (size.y / 2 + 1);
+    fftw_complex *in = fftw_alloc_complex(size_t(complex_size));
+    double *out = fftw_alloc_real(size_t(size.x) * size_t(size.y));
+
+    /* The FFTW planner is not thread safe. */
+    BLI_thread_lock(LOCK_FFTW);
+    fftw_plan plan = fftw_plan_dft_c2r_2d(size.x, size.y, in, out, FFTW_ESTIMATE);
+    BLI_thread_unlock(LOCK_FFTW);
+
+    fftw_free(in);
+    fftw_free(out);
+    return plan;
+  });
+}
+
+#endif
+
 }  // namespace blender::fftw
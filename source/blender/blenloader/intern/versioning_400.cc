@@ -4299,6 +4299,23 @@ void blo_do_versions_400(FileData *fd, Library * /*lib*/, Main *bmain)
     }
   }
 
+  if (!MAIN_VERSION_FILE_ATLEAST(bmain, 403, 7)) {
+    const bool has_face_target = DNA_struct_member_exists(
+        fd->filesdna, "DecimateModifierData", "int", "face_target");
+    const DecimateModifierData *default_dmd = DNA_struct_default_get(DecimateModifierData);
+    LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
+      LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
+        if (md->type != eModifierType_Decimate) {
+          continue;
+        }
+        DecimateModifierData *dmd = reinterpret_cast<DecimateModifierData *>(md);
+        if (!has_face_target || dmd->face_target == 0) {
+          dmd->face_target = default_dmd->face_target;
+        }
+      }
+    }
+  }
+
   /**
    * Always bump subversion in BKE_blender_version.h when adding versioning
    * code here, and wrap it inside a MAIN_VERSION_FILE_ATLEAST check.
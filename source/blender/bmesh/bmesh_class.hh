@@ -345,6 +345,18 @@ typedef struct BMesh {
   struct MLoopNorSpaceArray *lnor_spacearr;
   char spacearr_dirty;
 
+  /**
+   * Changes made since the last #BM_mesh_bm_to_me_for_eval_sync, a combination of `BM_SYNC_*`
+   * flags. Unless #BM_SYNC_VALID is set the changes are unknown, which requires a full
+   * conversion. Only tools that know they don't touch anything else declare their changes,
+   * see #BM_mesh_sync_tag_changes.
+   */
+  char sync_flag;
+  /** Range of vertex indices with changed positions, when #BM_SYNC_VERT_POSITIONS is set. */
+  int sync_vert_start, sync_vert_end;
+  /** Incremented by every #BM_mesh_bm_to_me_for_eval_sync. */
+  int sync_count;
+
   /* Should be copy of scene select mode. */
   /* Stored in #BMEditMesh too, this is a bit confusing,
    * make sure they're in sync!
@@ -382,6 +394,21 @@ typedef struct BMesh {
   void *py_handle;
 } BMesh;
 
+/** #BMesh.sync_flag */
+enum {
+  /** The other flags describe all changes since the last synchronization. */
+  BM_SYNC_VALID = (1 << 0),
+  /** Vertex positions in the #BMesh.sync_vert_start, #BMesh.sync_vert_end range changed. */
+  BM_SYNC_VERT_POSITIONS = (1 << 1),
+  /** Face corner custom-data changed (UV maps for example). */
+  BM_SYNC_CORNER_DATA = (1 << 2),
+  /**
+   * Changes were made that weren't declared, see #BM_mesh_sync_tag_unknown. Only cleared by the
+   * next synchronization, declaring changes afterwards doesn't make them known.
+   */
+  BM_SYNC_UNKNOWN = (1 << 3),
+};
+
 /** #BMHeader.htype (char) */
 enum {
   BM_VERT = 1,
@@ -15,14 +15,19 @@
  * - Moving vertices
  * - Setting vertex paint-mask values
  * - Setting vertex hflags
+ *
+ * The records of each entry are allocated from an append-only arena. When a stroke is finished,
+ * #BM_log_entry_compact removes records that don't change anything and packs the remaining ones
+ * into flat arrays, so long sessions don't keep the memory of every intermediate state.
  */
 
 #include "MEM_guardedalloc.h"
 
 #include "BLI_ghash.h"
+#include "BLI_linear_allocator.hh"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_math_vector.h"
-#include "BLI_mempool.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_customdata.hh"
@@ -33,24 +38,45 @@
 
 #include "BLI_strict_flags.h" /* Keep last. */
 
+struct BMLogVert {
+  float co[3];
+  float no[3];
+  char hflag;
+  float mask;
+};
+
+struct BMLogFace {
+  uint v_ids[3];
+  char hflag;
+};
+
+using BMLogVertMap = blender::Map<uint, BMLogVert *>;
+using BMLogFaceMap = blender::Map<uint, BMLogFace *>;
+
 struct BMLogEntry {
   BMLogEntry *next, *prev;
 
-  /* The following #GHash members map from an element ID to one of the log types above. */
+  /* The following maps go from an element ID to one of the log types above. */
 
   /** Elements that were in the previous entry, but have been deleted. */
-  GHash *deleted_verts;
-  GHash *deleted_faces;
+  BMLogVertMap deleted_verts;
+  BMLogFaceMap deleted_faces;
   /** Elements that were not in the previous entry, but are in the result of this entry. */
-  GHash *added_verts;
-  GHash *added_faces;
+  BMLogVertMap added_verts;
+  BMLogFaceMap added_faces;
 
   /** Vertices whose coordinates, mask value, or hflag have changed. */
-  GHash *modified_verts;
-  GHash *modified_faces;
+  BMLogVertMap modified_verts;
+  BMLogFaceMap modified_faces;
 
-  BLI_mempool *pool_verts;
-  BLI_mempool *pool_faces;
+  /**
+   * Storage of the records referenced by the maps above. Records are only ever appended,
+   * removing them from a map leaves them here until #BM_log_entry_compact is called.
+   */
+  std::unique_ptr<blender::LinearAllocator<>> allocator =
+      std::make_unique<blender::LinearAllocator<>>();
+  /** Number of bytes of records allocated from #allocator. */
+  size_t records_size = 0;
 
   /**
    * This is only needed for dropping BMLogEntries while still in
@@ -60,7 +86,7 @@ struct BMLogEntry {
    * This field is not guaranteed to be valid, any use of it should
    * check for nullptr.
    */
-  BMLog *log;
+  BMLog *log = nullptr;
 };
 
 struct BMLog {
@@ -95,18 +121,6 @@ struct BMLog {
   BMLogEntry *current_entry;
 };
 
-struct BMLogVert {
-  float co[3];
-  float no[3];
-  char hflag;
-  float mask;
-};
-
-struct BMLogFace {
-  uint v_ids[3];
-  char hflag;
-};
-
 /************************* Get/set element IDs ************************/
 
 /* bypass actual hashing, the keys don't overlap */
@@ -197,7 +211,8 @@ static void bm_log_vert_bmvert_copy(BMLogVert *lv, BMVert *v, const int cd_vert_
 static BMLogVert *bm_log_vert_alloc(BMLog *log, BMVert *v, const int cd_vert_mask_offset)
 {
   BMLogEntry *entry = log->current_entry;
-  BMLogVert *lv = static_cast<BMLogVert *>(BLI_mempool_alloc(entry->pool_verts));
+  BMLogVert *lv = entry->allocator->allocate<BMLogVert>();
+  entry->records_size += sizeof(BMLogVert);
 
   bm_log_vert_bmvert_copy(lv, v, cd_vert_mask_offset);
 
@@ -208,7 +223,8 @@ static BMLogVert *bm_log_vert_alloc(BMLog *log, BMVert *v, const int cd_vert_mas
 static BMLogFace *bm_log_face_alloc(BMLog *log, BMFace *f)
 {
   BMLogEntry *entry = log->current_entry;
-  BMLogFace *lf = static_cast<BMLogFace *>(BLI_mempool_alloc(entry->pool_faces));
+  BMLogFace *lf = entry->allocator->allocate<BMLogFace>();
+  entry->records_size += sizeof(BMLogFace);
   BMVert *v[3];
 
   BLI_assert(f->len == 3);
@@ -226,17 +242,14 @@ static BMLogFace *bm_log_face_alloc(BMLog *log, BMFace *f)
 
 /************************ Helpers for undo/redo ***********************/
 
-static void bm_log_verts_unmake(BMesh *bm, BMLog *log, GHash *verts)
+static void bm_log_verts_unmake(BMesh *bm, BMLog *log, const BMLogVertMap &verts)
 {
   const int cd_vert_mask_offset = CustomData_get_offset_named(
       &bm->vdata, CD_PROP_FLOAT, ".sculpt_mask");
 
-  GHashIterator gh_iter;
-  GHASH_ITER (gh_iter, verts) {
-    void *key = BLI_ghashIterator_getKey(&gh_iter);
-    BMLogVert *lv = static_cast<BMLogVert *>(BLI_ghashIterator_getValue(&gh_iter));
-    uint id = POINTER_AS_UINT(key);
-    BMVert *v = bm_log_vert_from_id(log, id);
+  for (const auto item : verts.items()) {
+    BMLogVert *lv = item.value;
+    BMVert *v = bm_log_vert_from_id(log, item.key);
 
     /* Ensure the log has the final values of the vertex before
      * deleting it */
@@ -246,12 +259,9 @@ static void bm_log_verts_unmake(BMesh *bm, BMLog *log, GHash *verts)
   }
 }
 
-static void bm_log_faces_unmake(BMesh *bm, BMLog *log, GHash *faces)
+static void bm_log_faces_unmake(BMesh *bm, BMLog *log, const BMLogFaceMap &faces)
 {
-  GHashIterator gh_iter;
-  GHASH_ITER (gh_iter, faces) {
-    void *key = BLI_ghashIterator_getKey(&gh_iter);
-    uint id = POINTER_AS_UINT(key);
+  for (const uint id : faces.keys()) {
     BMFace *f = bm_log_face_from_id(log, id);
     BMEdge *e_tri[3];
     BMLoop *l_iter;
@@ -272,32 +282,28 @@ static void bm_log_faces_unmake(BMesh *bm, BMLog *log, GHash *faces)
   }
 }
 
-static void bm_log_verts_restore(BMesh *bm, BMLog *log, GHash *verts)
+static void bm_log_verts_restore(BMesh *bm, BMLog *log, const BMLogVertMap &verts)
 {
   const int cd_vert_mask_offset = CustomData_get_offset_named(
       &bm->vdata, CD_PROP_FLOAT, ".sculpt_mask");
 
-  GHashIterator gh_iter;
-  GHASH_ITER (gh_iter, verts) {
-    void *key = BLI_ghashIterator_getKey(&gh_iter);
-    BMLogVert *lv = static_cast<BMLogVert *>(BLI_ghashIterator_getValue(&gh_iter));
+  for (const auto item : verts.items()) {
+    const BMLogVert *lv = item.value;
     BMVert *v = BM_vert_create(bm, lv->co, nullptr, BM_CREATE_NOP);
     vert_mask_set(v, lv->mask, cd_vert_mask_offset);
     v->head.hflag = lv->hflag;
     copy_v3_v3(v->no, lv->no);
-    bm_log_vert_id_set(log, v, POINTER_AS_UINT(key));
+    bm_log_vert_id_set(log, v, item.key);
   }
 }
 
-static void bm_log_faces_restore(BMesh *bm, BMLog *log, GHash *faces)
+static void bm_log_faces_restore(BMesh *bm, BMLog *log, const BMLogFaceMap &faces)
 {
-  GHashIterator gh_iter;
   const int cd_face_sets = CustomData_get_offset_named(
       &bm->pdata, CD_PROP_INT32, ".sculpt_face_set");
 
-  GHASH_ITER (gh_iter, faces) {
-    void *key = BLI_ghashIterator_getKey(&gh_iter);
-    BMLogFace *lf = static_cast<BMLogFace *>(BLI_ghashIterator_getValue(&gh_iter));
+  for (const auto item : faces.items()) {
+    const BMLogFace *lf = item.value;
     BMVert *v[3] = {
         bm_log_vert_from_id(log, lf->v_ids[0]),
         bm_log_vert_from_id(log, lf->v_ids[1]),
@@ -307,7 +313,7 @@ static void bm_log_faces_restore(BMesh *bm, BMLog *log, GHash *faces)
 
     f = BM_face_create_verts(bm, v, 3, nullptr, BM_CREATE_NOP, true);
     f->head.hflag = lf->hflag;
-    bm_log_face_id_set(log, f, POINTER_AS_UINT(key));
+    bm_log_face_id_set(log, f, item.key);
 
     /* Ensure face sets have valid values.  Fixes #80174. */
     if (cd_face_sets != -1) {
@@ -316,17 +322,14 @@ static void bm_log_faces_restore(BMesh *bm, BMLog *log, GHash *faces)
   }
 }
 
-static void bm_log_vert_values_swap(BMesh *bm, BMLog *log, GHash *verts)
+static void bm_log_vert_values_swap(BMesh *bm, BMLog *log, const BMLogVertMap &verts)
 {
   const int cd_vert_mask_offset = CustomData_get_offset_named(
       &bm->vdata, CD_PROP_FLOAT, ".sculpt_mask");
 
-  GHashIterator gh_iter;
-  GHASH_ITER (gh_iter, verts) {
-    void *key = BLI_ghashIterator_getKey(&gh_iter);
-    BMLogVert *lv = static_cast<BMLogVert *>(BLI_ghashIterator_getValue(&gh_iter));
-    uint id = POINTER_AS_UINT(key);
-    BMVert *v = bm_log_vert_from_id(log, id);
+  for (const auto item : verts.items()) {
+    BMLogVert *lv = item.value;
+    BMVert *v = bm_log_vert_from_id(log, item.key);
     float mask;
 
     swap_v3_v3(v->co, lv->co);
@@ -338,14 +341,11 @@ static void bm_log_vert_values_swap(BMesh *bm, BMLog *log, GHash *verts)
   }
 }
 
-static void bm_log_face_values_swap(BMLog *log, GHash *faces)
+static void bm_log_face_values_swap(BMLog *log, const BMLogFaceMap &faces)
 {
-  GHashIterator gh_iter;
-  GHASH_ITER (gh_iter, faces) {
-    void *key = BLI_ghashIterator_getKey(&gh_iter);
-    BMLogFace *lf = static_cast<BMLogFace *>(BLI_ghashIterator_getValue(&gh_iter));
-    uint id = POINTER_AS_UINT(key);
-    BMFace *f = bm_log_face_from_id(log, id);
+  for (const auto item : faces.items()) {
+    BMLogFace *lf = item.value;
+    BMFace *f = bm_log_face_from_id(log, item.key);
 
     std::swap(f->head.hflag, lf->hflag);
   }
@@ -376,49 +376,71 @@ static void bm_log_assign_ids(BMesh *bm, BMLog *log)
 /* Allocate an empty log entry */
 static BMLogEntry *bm_log_entry_create()
 {
-  BMLogEntry *entry = static_cast<BMLogEntry *>(MEM_callocN(sizeof(BMLogEntry), __func__));
-
-  entry->deleted_verts = BLI_ghash_new(logkey_hash, logkey_cmp, __func__);
-  entry->deleted_faces = BLI_ghash_new(logkey_hash, logkey_cmp, __func__);
-  entry->added_verts = BLI_ghash_new(logkey_hash, logkey_cmp, __func__);
-  entry->added_faces = BLI_ghash_new(logkey_hash, logkey_cmp, __func__);
-  entry->modified_verts = BLI_ghash_new(logkey_hash, logkey_cmp, __func__);
-  entry->modified_faces = BLI_ghash_new(logkey_hash, logkey_cmp, __func__);
-
-  entry->pool_verts = BLI_mempool_create(sizeof(BMLogVert), 0, 64, BLI_MEMPOOL_NOP);
-  entry->pool_faces = BLI_mempool_create(sizeof(BMLogFace), 0, 64, BLI_MEMPOOL_NOP);
-
-  return entry;
+  return MEM_new<BMLogEntry>(__func__);
 }
 
-/* Free the data in a log entry
- *
- * NOTE: does not free the log entry itself. */
+/* Free a log entry, it must already be unlinked from the list of entries. */
 static void bm_log_entry_free(BMLogEntry *entry)
 {
-  BLI_ghash_free(entry->deleted_verts, nullptr, nullptr);
-  BLI_ghash_free(entry->deleted_faces, nullptr, nullptr);
-  BLI_ghash_free(entry->added_verts, nullptr, nullptr);
-  BLI_ghash_free(entry->added_faces, nullptr, nullptr);
-  BLI_ghash_free(entry->modified_verts, nullptr, nullptr);
-  BLI_ghash_free(entry->modified_faces, nullptr, nullptr);
-
-  BLI_mempool_destroy(entry->pool_verts);
-  BLI_mempool_destroy(entry->pool_faces);
+  MEM_delete(entry);
 }
 
-static void bm_log_id_ghash_retake(RangeTreeUInt *unused_ids, GHash *id_ghash)
+template<typename T>
+static void bm_log_id_map_retake(RangeTreeUInt *unused_ids, const blender::Map<uint, T *> &map)
 {
-  GHashIterator gh_iter;
+  for (const uint id : map.keys()) {
+    range_tree_uint_retake(unused_ids, id);
+  }
+}
 
-  GHASH_ITER (gh_iter, id_ghash) {
-    void *key = BLI_ghashIterator_getKey(&gh_iter);
-    uint id = POINTER_AS_UINT(key);
+static void bm_log_entry_ids_retake(RangeTreeUInt *unused_ids, const BMLogEntry *entry)
+{
+  bm_log_id_map_retake(unused_ids, entry->deleted_verts);
+  bm_log_id_map_retake(unused_ids, entry->deleted_faces);
+  bm_log_id_map_retake(unused_ids, entry->added_verts);
+  bm_log_id_map_retake(unused_ids, entry->added_faces);
+  bm_log_id_map_retake(unused_ids, entry->modified_verts);
+  bm_log_id_map_retake(unused_ids, entry->modified_faces);
+}
 
-    range_tree_uint_retake(unused_ids, id);
+/**
+ * Copy the records of \a maps into one contiguous array allocated from \a allocator, and rebuild
+ * the maps so they don't keep the capacity of removed records.
+ */
+template<typename T>
+static void bm_log_records_pack(blender::LinearAllocator<> &allocator,
+                                const blender::Span<blender::Map<uint, T *> *> maps,
+                                size_t &r_records_size)
+{
+  int64_t records_num = 0;
+  for (const blender::Map<uint, T *> *map : maps) {
+    records_num += map->size();
+  }
+  blender::MutableSpan<T> records = allocator.allocate_array<T>(records_num);
+  r_records_size += size_t(records.size_in_bytes());
+
+  int64_t index = 0;
+  for (blender::Map<uint, T *> *map : maps) {
+    blender::Map<uint, T *> packed;
+    packed.reserve(map->size());
+    for (const auto item : map->items()) {
+      records[index] = *item.value;
+      packed.add_new(item.key, &records[index]);
+      index++;
+    }
+    *map = std::move(packed);
   }
 }
 
+static bool bm_log_vert_is_unchanged(const BMLogVert *lv,
+                                     const BMVert *v,
+                                     const int cd_vert_mask_offset)
+{
+  return equals_v3v3(lv->co, v->co) && equals_v3v3(lv->no, v->no) &&
+         lv->hflag == v->head.hflag &&
+         lv->mask == vert_mask_get(const_cast<BMVert *>(v), cd_vert_mask_offset);
+}
+
 static int uint_compare(const void *a_v, const void *b_v)
 {
   const uint *a = static_cast<const uint *>(a_v);
@@ -450,14 +472,11 @@ static GHash *bm_log_compress_ids_to_indices(uint *ids, uint totid)
   return map;
 }
 
-/* Release all ID keys in id_ghash */
-static void bm_log_id_ghash_release(BMLog *log, GHash *id_ghash)
+/* Release all ID keys in the map */
+template<typename T>
+static void bm_log_id_map_release(BMLog *log, const blender::Map<uint, T *> &map)
 {
-  GHashIterator gh_iter;
-
-  GHASH_ITER (gh_iter, id_ghash) {
-    void *key = BLI_ghashIterator_getKey(&gh_iter);
-    uint id = POINTER_AS_UINT(key);
+  for (const uint id : map.keys()) {
     range_tree_uint_release(log->unused_ids, id);
   }
 }
@@ -485,19 +504,14 @@ void BM_log_cleanup_entry(BMLogEntry *entry)
 
   if (log) {
     /* Take all used IDs */
-    bm_log_id_ghash_retake(log->unused_ids, entry->deleted_verts);
-    bm_log_id_ghash_retake(log->unused_ids, entry->deleted_faces);
-    bm_log_id_ghash_retake(log->unused_ids, entry->added_verts);
-    bm_log_id_ghash_retake(log->unused_ids, entry->added_faces);
-    bm_log_id_ghash_retake(log->unused_ids, entry->modified_verts);
-    bm_log_id_ghash_retake(log->unused_ids, entry->modified_faces);
+    bm_log_entry_ids_retake(log->unused_ids, entry);
 
     /* delete entries to avoid releasing ids in node cleanup */
-    BLI_ghash_clear(entry->deleted_verts, nullptr, nullptr);
-    BLI_ghash_clear(entry->deleted_faces, nullptr, nullptr);
-    BLI_ghash_clear(entry->added_verts, nullptr, nullptr);
-    BLI_ghash_clear(entry->added_faces, nullptr, nullptr);
-    BLI_ghash_clear(entry->modified_verts, nullptr, nullptr);
+    entry->deleted_verts.clear();
+    entry->deleted_faces.clear();
+    entry->added_verts.clear();
+    entry->added_faces.clear();
+    entry->modified_verts.clear();
   }
 }
 
@@ -531,12 +545,7 @@ BMLog *BM_log_from_existing_entries_create(BMesh *bm, BMLogEntry *entry)
     entry->log = log;
 
     /* Take all used IDs */
-    bm_log_id_ghash_retake(log->unused_ids, entry->deleted_verts);
-    bm_log_id_ghash_retake(log->unused_ids, entry->deleted_faces);
-    bm_log_id_ghash_retake(log->unused_ids, entry->added_verts);
-    bm_log_id_ghash_retake(log->unused_ids, entry->added_faces);
-    bm_log_id_ghash_retake(log->unused_ids, entry->modified_verts);
-    bm_log_id_ghash_retake(log->unused_ids, entry->modified_faces);
+    bm_log_entry_ids_retake(log->unused_ids, entry);
   }
 
   return log;
@@ -625,22 +634,8 @@ BMLogEntry *BM_log_entry_add(BMLog *log)
 {
   /* WARNING: this is now handled by the UndoSystem: BKE_UNDOSYS_TYPE_SCULPT
    * freeing here causes unnecessary complications. */
-  BMLogEntry *entry;
-#if 0
-  /* Delete any entries after the current one */
-  entry = log->current_entry;
-  if (entry) {
-    BMLogEntry *next;
-    for (entry = entry->next; entry; entry = next) {
-      next = entry->next;
-      bm_log_entry_free(entry);
-      BLI_freelinkN(&log->entries, entry);
-    }
-  }
-#endif
-
   /* Create and append the new entry */
-  entry = bm_log_entry_create();
+  BMLogEntry *entry = bm_log_entry_create();
   BLI_addtail(&log->entries, entry);
   entry->log = log;
   log->current_entry = entry;
@@ -663,7 +658,6 @@ void BM_log_entry_drop(BMLogEntry *entry)
     }
 
     bm_log_entry_free(entry);
-    MEM_freeN(entry);
     return;
   }
 
@@ -691,16 +685,16 @@ void BM_log_entry_drop(BMLogEntry *entry)
      * Also, design wise, a first entry should not have any deleted vertices since it
      * should not have anything to delete them -from-
      */
-    // bm_log_id_ghash_release(log, entry->deleted_faces);
-    // bm_log_id_ghash_release(log, entry->deleted_verts);
+    // bm_log_id_map_release(log, entry->deleted_faces);
+    // bm_log_id_map_release(log, entry->deleted_verts);
   }
   else if (!entry->next) {
     /* Release IDs of elements that are added by this entry. Since
      * the entry is at the end of the undo stack, and it's being
      * deleted, those elements can never be restored. Their IDs
      * can go back into the pool. */
-    bm_log_id_ghash_release(log, entry->added_faces);
-    bm_log_id_ghash_release(log, entry->added_verts);
+    bm_log_id_map_release(log, entry->added_faces);
+    bm_log_id_map_release(log, entry->added_verts);
   }
   else {
     BLI_assert_msg(0, "Cannot drop BMLogEntry from middle");
@@ -710,8 +704,63 @@ void BM_log_entry_drop(BMLogEntry *entry)
     log->current_entry = entry->prev;
   }
 
+  BLI_remlink(&log->entries, entry);
   bm_log_entry_free(entry);
-  BLI_freelinkN(&log->entries, entry);
+}
+
+void BM_log_entry_compact(BMesh *bm, BMLog *log)
+{
+  BMLogEntry *entry = log->current_entry;
+  if (!entry) {
+    return;
+  }
+
+  const int cd_vert_mask_offset = CustomData_get_offset_named(
+      &bm->vdata, CD_PROP_FLOAT, ".sculpt_mask");
+
+  /* Vertices that were logged before being modified but still have their original values. This is
+   * common since whole nodes are logged, while brushes only change the vertices they touch.
+   * Elements deleted in this entry are not in the mesh anymore and their original values are
+   * stored in the deleted records, so their modification records are dropped as well. */
+  entry->modified_verts.remove_if([&](const auto item) {
+    if (entry->deleted_verts.contains(item.key)) {
+      return true;
+    }
+    const BMVert *v = bm_log_vert_from_id(log, item.key);
+    return bm_log_vert_is_unchanged(item.value, v, cd_vert_mask_offset);
+  });
+  entry->modified_faces.remove_if([&](const auto item) {
+    if (entry->deleted_faces.contains(item.key)) {
+      return true;
+    }
+    return item.value->hflag == bm_log_face_from_id(log, item.key)->head.hflag;
+  });
+
+  /* Pack the remaining records, dropping the ones that were removed during the stroke. */
+  auto allocator = std::make_unique<blender::LinearAllocator<>>();
+  size_t records_size = 0;
+  bm_log_records_pack<BMLogVert>(
+      *allocator,
+      {&entry->deleted_verts, &entry->added_verts, &entry->modified_verts},
+      records_size);
+  bm_log_records_pack<BMLogFace>(
+      *allocator,
+      {&entry->deleted_faces, &entry->added_faces, &entry->modified_faces},
+      records_size);
+  entry->allocator = std::move(allocator);
+  entry->records_size = records_size;
+}
+
+size_t BM_log_entry_size_in_bytes(const BMLogEntry *entry)
+{
+  size_t size = sizeof(BMLogEntry) + entry->records_size;
+  size += size_t(entry->deleted_verts.size_in_bytes());
+  size += size_t(entry->deleted_faces.size_in_bytes());
+  size += size_t(entry->added_verts.size_in_bytes());
+  size += size_t(entry->added_faces.size_in_bytes());
+  size += size_t(entry->modified_verts.size_in_bytes());
+  size += size_t(entry->modified_faces.size_in_bytes());
+  return size;
 }
 
 void BM_log_undo(BMesh *bm, BMLog *log)
@@ -772,18 +821,15 @@ void BM_log_redo(BMesh *bm, BMLog *log)
 void BM_log_vert_before_modified(BMLog *log, BMVert *v, const int cd_vert_mask_offset)
 {
   BMLogEntry *entry = log->current_entry;
-  BMLogVert *lv;
   uint v_id = bm_log_vert_id_get(log, v);
-  void *key = POINTER_FROM_UINT(v_id);
-  void **val_p;
 
   /* Find or create the BMLogVert entry */
-  if ((lv = static_cast<BMLogVert *>(BLI_ghash_lookup(entry->added_verts, key)))) {
+  if (BMLogVert *lv = entry->added_verts.lookup_default(v_id, nullptr)) {
     bm_log_vert_bmvert_copy(lv, v, cd_vert_mask_offset);
   }
-  else if (!BLI_ghash_ensure_p(entry->modified_verts, key, &val_p)) {
-    lv = bm_log_vert_alloc(log, v, cd_vert_mask_offset);
-    *val_p = lv;
+  else {
+    entry->modified_verts.lookup_or_add_cb(
+        v_id, [&]() { return bm_log_vert_alloc(log, v, cd_vert_mask_offset); });
   }
 }
 
@@ -791,61 +837,52 @@ void BM_log_vert_added(BMLog *log, BMVert *v, const int cd_vert_mask_offset)
 {
   BMLogVert *lv;
   uint v_id = range_tree_uint_take_any(log->unused_ids);
-  void *key = POINTER_FROM_UINT(v_id);
 
   bm_log_vert_id_set(log, v, v_id);
   lv = bm_log_vert_alloc(log, v, cd_vert_mask_offset);
-  BLI_ghash_insert(log->current_entry->added_verts, key, lv);
+  log->current_entry->added_verts.add_new(v_id, lv);
 }
 
 void BM_log_face_modified(BMLog *log, BMFace *f)
 {
   BMLogFace *lf;
   uint f_id = bm_log_face_id_get(log, f);
-  void *key = POINTER_FROM_UINT(f_id);
 
   lf = bm_log_face_alloc(log, f);
-  BLI_ghash_insert(log->current_entry->modified_faces, key, lf);
+  log->current_entry->modified_faces.add(f_id, lf);
 }
 
 void BM_log_face_added(BMLog *log, BMFace *f)
 {
   BMLogFace *lf;
   uint f_id = range_tree_uint_take_any(log->unused_ids);
-  void *key = POINTER_FROM_UINT(f_id);
 
   /* Only triangles are supported for now */
   BLI_assert(f->len == 3);
 
   bm_log_face_id_set(log, f, f_id);
   lf = bm_log_face_alloc(log, f);
-  BLI_ghash_insert(log->current_entry->added_faces, key, lf);
+  log->current_entry->added_faces.add_new(f_id, lf);
 }
 
 void BM_log_vert_removed(BMLog *log, BMVert *v, const int cd_vert_mask_offset)
 {
   BMLogEntry *entry = log->current_entry;
   uint v_id = bm_log_vert_id_get(log, v);
-  void *key = POINTER_FROM_UINT(v_id);
-
-  /* if it has a key, it shouldn't be nullptr */
-  BLI_assert(!!BLI_ghash_lookup(entry->added_verts, key) ==
-             !!BLI_ghash_haskey(entry->added_verts, key));
 
-  if (BLI_ghash_remove(entry->added_verts, key, nullptr, nullptr)) {
+  if (entry->added_verts.remove(v_id)) {
     range_tree_uint_release(log->unused_ids, v_id);
   }
   else {
-    BMLogVert *lv, *lv_mod;
+    BMLogVert *lv;
 
     lv = bm_log_vert_alloc(log, v, cd_vert_mask_offset);
-    BLI_ghash_insert(entry->deleted_verts, key, lv);
+    entry->deleted_verts.add(v_id, lv);
 
     /* If the vertex was modified before deletion, ensure that the
      * original vertex values are stored */
-    if ((lv_mod = static_cast<BMLogVert *>(BLI_ghash_lookup(entry->modified_verts, key)))) {
-      (*lv) = (*lv_mod);
-      BLI_ghash_remove(entry->modified_verts, key, nullptr, nullptr);
+    if (const std::optional<BMLogVert *> lv_mod = entry->modified_verts.pop_try(v_id)) {
+      (*lv) = **lv_mod;
     }
   }
 }
@@ -854,20 +891,21 @@ void BM_log_face_removed(BMLog *log, BMFace *f)
 {
   BMLogEntry *entry = log->current_entry;
   uint f_id = bm_log_face_id_get(log, f);
-  void *key = POINTER_FROM_UINT(f_id);
 
-  /* if it has a key, it shouldn't be nullptr */
-  BLI_assert(!!BLI_ghash_lookup(entry->added_faces, key) ==
-             !!BLI_ghash_haskey(entry->added_faces, key));
-
-  if (BLI_ghash_remove(entry->added_faces, key, nullptr, nullptr)) {
+  if (entry->added_faces.remove(f_id)) {
     range_tree_uint_release(log->unused_ids, f_id);
   }
   else {
     BMLogFace *lf;
 
     lf = bm_log_face_alloc(log, f);
-    BLI_ghash_insert(entry->deleted_faces, key, lf);
+    entry->deleted_faces.add(f_id, lf);
+
+    /* If the face was modified before deletion, ensure that the
+     * original face values are stored */
+    if (const std::optional<BMLogFace *> lf_mod = entry->modified_faces.pop_try(f_id)) {
+      lf->hflag = (*lf_mod)->hflag;
+    }
   }
 }
 
@@ -880,12 +918,12 @@ void BM_log_all_added(BMesh *bm, BMLog *log)
   BMFace *f;
 
   /* avoid unnecessary resizing on initialization */
-  if (BLI_ghash_len(log->current_entry->added_verts) == 0) {
-    BLI_ghash_reserve(log->current_entry->added_verts, uint(bm->totvert));
+  if (log->current_entry->added_verts.is_empty()) {
+    log->current_entry->added_verts.reserve(bm->totvert);
   }
 
-  if (BLI_ghash_len(log->current_entry->added_faces) == 0) {
-    BLI_ghash_reserve(log->current_entry->added_faces, uint(bm->totface));
+  if (log->current_entry->added_faces.is_empty()) {
+    log->current_entry->added_faces.reserve(bm->totface);
   }
 
   /* Log all vertices as newly created */
@@ -923,9 +961,8 @@ const float *BM_log_find_original_vert_co(BMLog *log, BMVert *v)
   BMLogEntry *entry = log->current_entry;
   const BMLogVert *lv;
   uint v_id = bm_log_vert_id_get(log, v);
-  void *key = POINTER_FROM_UINT(v_id);
 
-  lv = static_cast<const BMLogVert *>(BLI_ghash_lookup(entry->modified_verts, key));
+  lv = entry->modified_verts.lookup_default(v_id, nullptr);
   return lv == nullptr ? nullptr : lv->co;
 }
 
@@ -934,13 +971,10 @@ const float *BM_log_original_vert_co(BMLog *log, BMVert *v)
   BMLogEntry *entry = log->current_entry;
   const BMLogVert *lv;
   uint v_id = bm_log_vert_id_get(log, v);
-  void *key = POINTER_FROM_UINT(v_id);
 
   BLI_assert(entry);
 
-  BLI_assert(BLI_ghash_haskey(entry->modified_verts, key));
-
-  lv = static_cast<const BMLogVert *>(BLI_ghash_lookup(entry->modified_verts, key));
+  lv = entry->modified_verts.lookup(v_id);
   return lv->co;
 }
 
@@ -949,13 +983,10 @@ const float *BM_log_original_vert_no(BMLog *log, BMVert *v)
   BMLogEntry *entry = log->current_entry;
   const BMLogVert *lv;
   uint v_id = bm_log_vert_id_get(log, v);
-  void *key = POINTER_FROM_UINT(v_id);
 
   BLI_assert(entry);
 
-  BLI_assert(BLI_ghash_haskey(entry->modified_verts, key));
-
-  lv = static_cast<const BMLogVert *>(BLI_ghash_lookup(entry->modified_verts, key));
+  lv = entry->modified_verts.lookup(v_id);
   return lv->no;
 }
 
@@ -964,13 +995,10 @@ float BM_log_original_mask(BMLog *log, BMVert *v)
   BMLogEntry *entry = log->current_entry;
   const BMLogVert *lv;
   uint v_id = bm_log_vert_id_get(log, v);
-  void *key = POINTER_FROM_UINT(v_id);
 
   BLI_assert(entry);
 
-  BLI_assert(BLI_ghash_haskey(entry->modified_verts, key));
-
-  lv = static_cast<const BMLogVert *>(BLI_ghash_lookup(entry->modified_verts, key));
+  lv = entry->modified_verts.lookup(v_id);
   return lv->mask;
 }
 
@@ -979,13 +1007,10 @@ void BM_log_original_vert_data(BMLog *log, BMVert *v, const float **r_co, const
   BMLogEntry *entry = log->current_entry;
   const BMLogVert *lv;
   uint v_id = bm_log_vert_id_get(log, v);
-  void *key = POINTER_FROM_UINT(v_id);
 
   BLI_assert(entry);
 
-  BLI_assert(BLI_ghash_haskey(entry->modified_verts, key));
-
-  lv = static_cast<const BMLogVert *>(BLI_ghash_lookup(entry->modified_verts, key));
+  lv = entry->modified_verts.lookup(v_id);
   *r_co = lv->co;
   *r_no = lv->no;
 }
@@ -1038,12 +1063,13 @@ void BM_log_print_entry(BMesh *bm, BMLogEntry *entry)
   }
 
   printf("v | added: %d, removed: %d, modified: %d\n",
-         int(BLI_ghash_len(entry->added_verts)),
-         int(BLI_ghash_len(entry->deleted_verts)),
-         int(BLI_ghash_len(entry->modified_verts)));
+         int(entry->added_verts.size()),
+         int(entry->deleted_verts.size()),
+         int(entry->modified_verts.size()));
   printf("f | added: %d, removed: %d, modified: %d\n",
-         int(BLI_ghash_len(entry->added_faces)),
-         int(BLI_ghash_len(entry->deleted_faces)),
-         int(BLI_ghash_len(entry->modified_faces)));
+         int(entry->added_faces.size()),
+         int(entry->deleted_faces.size()),
+         int(entry->modified_faces.size()));
+  printf("size: %zu bytes\n", BM_log_entry_size_in_bytes(entry));
   printf("}\n");
 }
@@ -8,6 +8,8 @@
  * \ingroup bmesh
  */
 
+#include <cstddef>
+
 struct BMFace;
 struct BMVert;
 struct BMesh;
@@ -27,7 +29,7 @@ BMLog *BM_log_create(BMesh *bm);
  * will be followed back to find the first entry.
  *
  * The unused IDs field of the log will be initialized by taking all
- * keys from all GHashes in the log entry.
+ * keys from all maps in the log entry.
  */
 BMLog *BM_log_from_existing_entries_create(BMesh *bm, BMLogEntry *entry);
 
@@ -71,6 +73,16 @@ void BM_log_cleanup_entry(BMLogEntry *entry);
  */
 void BM_log_entry_drop(BMLogEntry *entry);
 
+/**
+ * Reduce the memory used by the current log entry once no more changes will be logged to it,
+ * e.g. at the end of a stroke: records of elements that ended up with their original values are
+ * removed and the remaining records are packed together.
+ */
+void BM_log_entry_compact(BMesh *bm, BMLog *log);
+
+/** Get the memory used by a log entry, for undo memory limits. */
+size_t BM_log_entry_size_in_bytes(const BMLogEntry *entry);
+
 /**
  * Undo one #BMLogEntry.
  *
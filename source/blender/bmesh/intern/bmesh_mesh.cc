@@ -12,9 +12,13 @@
 
 #include "DNA_listBase.h"
 
+#include "BLI_array_utils.hh"
+#include "BLI_bounds.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
+#include "BLI_sort.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_customdata.hh"
@@ -1039,103 +1043,22 @@ void BM_mesh_remap(BMesh *bm, const uint *vert_idx, const uint *edge_idx, const
   }
 }
 
-void BM_mesh_rebuild(BMesh *bm,
-                     const BMeshCreateParams *params,
-                     BLI_mempool *vpool_dst,
-                     BLI_mempool *epool_dst,
-                     BLI_mempool *lpool_dst,
-                     BLI_mempool *fpool_dst)
+/**
+ * Second half of #BM_mesh_rebuild: the elements have been copied into the destination tables
+ * and the index of every source element is its index in the destination table.
+ * Update all pointers between elements to the new copies and replace the memory pools.
+ */
+static void bm_mesh_rebuild_remap(BMesh *bm,
+                                  const char remap,
+                                  BMVert **vtable_dst,
+                                  BMEdge **etable_dst,
+                                  BMLoop **ltable_dst,
+                                  BMFace **ftable_dst,
+                                  BLI_mempool *vpool_dst,
+                                  BLI_mempool *epool_dst,
+                                  BLI_mempool *lpool_dst,
+                                  BLI_mempool *fpool_dst)
 {
-  const char remap = (vpool_dst ? BM_VERT : 0) | (epool_dst ? BM_EDGE : 0) |
-                     (lpool_dst ? BM_LOOP : 0) | (fpool_dst ? BM_FACE : 0);
-
-  BMVert **vtable_dst = (remap & BM_VERT) ? static_cast<BMVert **>(MEM_mallocN(
-                                                sizeof(BMVert *) * bm->totvert, __func__)) :
-                                            nullptr;
-  BMEdge **etable_dst = (remap & BM_EDGE) ? static_cast<BMEdge **>(MEM_mallocN(
-                                                sizeof(BMEdge *) * bm->totedge, __func__)) :
-                                            nullptr;
-  BMLoop **ltable_dst = (remap & BM_LOOP) ? static_cast<BMLoop **>(MEM_mallocN(
-                                                sizeof(BMLoop *) * bm->totloop, __func__)) :
-                                            nullptr;
-  BMFace **ftable_dst = (remap & BM_FACE) ? static_cast<BMFace **>(MEM_mallocN(
-                                                sizeof(BMFace *) * bm->totface, __func__)) :
-                                            nullptr;
-
-  const bool use_toolflags = params->use_toolflags;
-
-  if (remap & BM_VERT) {
-    BMIter iter;
-    int index;
-    BMVert *v_src;
-    BM_ITER_MESH_INDEX (v_src, &iter, bm, BM_VERTS_OF_MESH, index) {
-      BMVert *v_dst = static_cast<BMVert *>(BLI_mempool_alloc(vpool_dst));
-      memcpy(v_dst, v_src, sizeof(BMVert));
-      if (use_toolflags) {
-        ((BMVert_OFlag *)v_dst)->oflags = bm->vtoolflagpool ?
-                                              static_cast<BMFlagLayer *>(
-                                                  BLI_mempool_calloc(bm->vtoolflagpool)) :
-                                              nullptr;
-      }
-
-      vtable_dst[index] = v_dst;
-      BM_elem_index_set(v_src, index); /* set_ok */
-    }
-  }
-
-  if (remap & BM_EDGE) {
-    BMIter iter;
-    int index;
-    BMEdge *e_src;
-    BM_ITER_MESH_INDEX (e_src, &iter, bm, BM_EDGES_OF_MESH, index) {
-      BMEdge *e_dst = static_cast<BMEdge *>(BLI_mempool_alloc(epool_dst));
-      memcpy(e_dst, e_src, sizeof(BMEdge));
-      if (use_toolflags) {
-        ((BMEdge_OFlag *)e_dst)->oflags = bm->etoolflagpool ?
-                                              static_cast<BMFlagLayer *>(
-                                                  BLI_mempool_calloc(bm->etoolflagpool)) :
-                                              nullptr;
-      }
-
-      etable_dst[index] = e_dst;
-      BM_elem_index_set(e_src, index); /* set_ok */
-    }
-  }
-
-  if (remap & (BM_LOOP | BM_FACE)) {
-    BMIter iter;
-    int index, index_loop = 0;
-    BMFace *f_src;
-    BM_ITER_MESH_INDEX (f_src, &iter, bm, BM_FACES_OF_MESH, index) {
-
-      if (remap & BM_FACE) {
-        BMFace *f_dst = static_cast<BMFace *>(BLI_mempool_alloc(fpool_dst));
-        memcpy(f_dst, f_src, sizeof(BMFace));
-        if (use_toolflags) {
-          ((BMFace_OFlag *)f_dst)->oflags = bm->ftoolflagpool ?
-                                                static_cast<BMFlagLayer *>(
-                                                    BLI_mempool_calloc(bm->ftoolflagpool)) :
-                                                nullptr;
-        }
-
-        ftable_dst[index] = f_dst;
-        BM_elem_index_set(f_src, index); /* set_ok */
-      }
-
-      /* handle loops */
-      if (remap & BM_LOOP) {
-        BMLoop *l_iter_src, *l_first_src;
-        l_iter_src = l_first_src = BM_FACE_FIRST_LOOP((BMFace *)f_src);
-        do {
-          BMLoop *l_dst = static_cast<BMLoop *>(BLI_mempool_alloc(lpool_dst));
-          memcpy(l_dst, l_iter_src, sizeof(BMLoop));
-          ltable_dst[index_loop] = l_dst;
-          BM_elem_index_set(l_iter_src, index_loop++); /* set_ok */
-        } while ((l_iter_src = l_iter_src->next) != l_first_src);
-      }
-    }
-  }
-
 #define MAP_VERT(ele) vtable_dst[BM_elem_index_get(ele)]
 #define MAP_EDGE(ele) etable_dst[BM_elem_index_get(ele)]
 #define MAP_LOOP(ele) ltable_dst[BM_elem_index_get(ele)]
@@ -1297,6 +1220,388 @@ void BM_mesh_rebuild(BMesh *bm,
   }
 }
 
+void BM_mesh_rebuild(BMesh *bm,
+                     const BMeshCreateParams *params,
+                     BLI_mempool *vpool_dst,
+                     BLI_mempool *epool_dst,
+                     BLI_mempool *lpool_dst,
+                     BLI_mempool *fpool_dst)
+{
+  const char remap = (vpool_dst ? BM_VERT : 0) | (epool_dst ? BM_EDGE : 0) |
+                     (lpool_dst ? BM_LOOP : 0) | (fpool_dst ? BM_FACE : 0);
+
+  BMVert **vtable_dst = (remap & BM_VERT) ? static_cast<BMVert **>(MEM_mallocN(
+                                                sizeof(BMVert *) * bm->totvert, __func__)) :
+                                            nullptr;
+  BMEdge **etable_dst = (remap & BM_EDGE) ? static_cast<BMEdge **>(MEM_mallocN(
+                                                sizeof(BMEdge *) * bm->totedge, __func__)) :
+                                            nullptr;
+  BMLoop **ltable_dst = (remap & BM_LOOP) ? static_cast<BMLoop **>(MEM_mallocN(
+                                                sizeof(BMLoop *) * bm->totloop, __func__)) :
+                                            nullptr;
+  BMFace **ftable_dst = (remap & BM_FACE) ? static_cast<BMFace **>(MEM_mallocN(
+                                                sizeof(BMFace *) * bm->totface, __func__)) :
+                                            nullptr;
+
+  const bool use_toolflags = params->use_toolflags;
+
+  if (remap & BM_VERT) {
+    BMIter iter;
+    int index;
+    BMVert *v_src;
+    BM_ITER_MESH_INDEX (v_src, &iter, bm, BM_VERTS_OF_MESH, index) {
+      BMVert *v_dst = static_cast<BMVert *>(BLI_mempool_alloc(vpool_dst));
+      memcpy(v_dst, v_src, sizeof(BMVert));
+      if (use_toolflags) {
+        ((BMVert_OFlag *)v_dst)->oflags = bm->vtoolflagpool ?
+                                              static_cast<BMFlagLayer *>(
+                                                  BLI_mempool_calloc(bm->vtoolflagpool)) :
+                                              nullptr;
+      }
+
+      vtable_dst[index] = v_dst;
+      BM_elem_index_set(v_src, index); /* set_ok */
+    }
+  }
+
+  if (remap & BM_EDGE) {
+    BMIter iter;
+    int index;
+    BMEdge *e_src;
+    BM_ITER_MESH_INDEX (e_src, &iter, bm, BM_EDGES_OF_MESH, index) {
+      BMEdge *e_dst = static_cast<BMEdge *>(BLI_mempool_alloc(epool_dst));
+      memcpy(e_dst, e_src, sizeof(BMEdge));
+      if (use_toolflags) {
+        ((BMEdge_OFlag *)e_dst)->oflags = bm->etoolflagpool ?
+                                              static_cast<BMFlagLayer *>(
+                                                  BLI_mempool_calloc(bm->etoolflagpool)) :
+                                              nullptr;
+      }
+
+      etable_dst[index] = e_dst;
+      BM_elem_index_set(e_src, index); /* set_ok */
+    }
+  }
+
+  if (remap & (BM_LOOP | BM_FACE)) {
+    BMIter iter;
+    int index, index_loop = 0;
+    BMFace *f_src;
+    BM_ITER_MESH_INDEX (f_src, &iter, bm, BM_FACES_OF_MESH, index) {
+
+      if (remap & BM_FACE) {
+        BMFace *f_dst = static_cast<BMFace *>(BLI_mempool_alloc(fpool_dst));
+        memcpy(f_dst, f_src, sizeof(BMFace));
+        if (use_toolflags) {
+          ((BMFace_OFlag *)f_dst)->oflags = bm->ftoolflagpool ?
+                                                static_cast<BMFlagLayer *>(
+                                                    BLI_mempool_calloc(bm->ftoolflagpool)) :
+                                                nullptr;
+        }
+
+        ftable_dst[index] = f_dst;
+        BM_elem_index_set(f_src, index); /* set_ok */
+      }
+
+      /* handle loops */
+      if (remap & BM_LOOP) {
+        BMLoop *l_iter_src, *l_first_src;
+        l_iter_src = l_first_src = BM_FACE_FIRST_LOOP((BMFace *)f_src);
+        do {
+          BMLoop *l_dst = static_cast<BMLoop *>(BLI_mempool_alloc(lpool_dst));
+          memcpy(l_dst, l_iter_src, sizeof(BMLoop));
+          ltable_dst[index_loop] = l_dst;
+          BM_elem_index_set(l_iter_src, index_loop++); /* set_ok */
+        } while ((l_iter_src = l_iter_src->next) != l_first_src);
+      }
+    }
+  }
+
+  bm_mesh_rebuild_remap(bm,
+                        remap,
+                        vtable_dst,
+                        etable_dst,
+                        ltable_dst,
+                        ftable_dst,
+                        vpool_dst,
+                        epool_dst,
+                        lpool_dst,
+                        fpool_dst);
+}
+
+/** Spread the lower 10 bits of \a x so there are two zero bits between each of them. */
+static uint32_t bm_morton_spread_bits(uint32_t x)
+{
+  x &= 0x3ff;
+  x = (x | (x << 16)) & 0x030000ff;
+  x = (x | (x << 8)) & 0x0300f00f;
+  x = (x | (x << 4)) & 0x030c30c3;
+  x = (x | (x << 2)) & 0x09249249;
+  return x;
+}
+
+/**
+ * Order faces along a Morton (Z-order) curve through their centers,
+ * so faces that are close in space are close in memory too.
+ */
+static Array<int> bm_mesh_face_order_spatial(BMesh *bm)
+{
+  using namespace blender;
+  Array<float3> centers(bm->totface);
+  threading::parallel_for(IndexRange(bm->totface), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BM_face_calc_center_median(bm->ftable[i], centers[i]);
+    }
+  });
+
+  Array<int> face_order(bm->totface);
+  array_utils::fill_index_range<int>(face_order);
+  const std::optional<Bounds<float3>> bounds = bounds::min_max(centers.as_span());
+  if (!bounds) {
+    return face_order;
+  }
+  const float3 size = bounds->max - bounds->min;
+  const float scale = 1023.0f / std::max({size.x, size.y, size.z, FLT_EPSILON});
+
+  Array<uint32_t> codes(bm->totface);
+  threading::parallel_for(IndexRange(bm->totface), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const float3 co = (centers[i] - bounds->min) * scale;
+      codes[i] = bm_morton_spread_bits(uint32_t(co.x)) |
+                 (bm_morton_spread_bits(uint32_t(co.y)) << 1) |
+                 (bm_morton_spread_bits(uint32_t(co.z)) << 2);
+    }
+  });
+
+  parallel_sort(face_order.begin(), face_order.end(), [&](const int a, const int b) {
+    return codes[a] < codes[b] || (codes[a] == codes[b] && a < b);
+  });
+  return face_order;
+}
+
+/** Copy an element and its custom-data block into the new memory pools. */
+static void *bm_elem_copy_to_pool(const BMElem *ele_src,
+                                  const size_t ele_size,
+                                  BLI_mempool *pool_dst,
+                                  const CustomData &data,
+                                  BLI_mempool *data_pool_dst)
+{
+  BMElem *ele_dst = static_cast<BMElem *>(BLI_mempool_alloc(pool_dst));
+  memcpy(ele_dst, ele_src, ele_size);
+  if (data_pool_dst && ele_src->head.data) {
+    ele_dst->head.data = BLI_mempool_alloc(data_pool_dst);
+    memcpy(ele_dst->head.data, ele_src->head.data, data.totsize);
+  }
+  return ele_dst;
+}
+
+bool BM_mesh_is_fragmented(BMesh *bm)
+{
+  /* Small meshes fit in the caches anyway. */
+  if (bm->totface < 10000) {
+    return false;
+  }
+  /* Count the faces whose loops are far from the loops of the previous face in memory. New and
+   * defragmented meshes allocate the loops of consecutive faces next to each other. */
+  const intptr_t max_distance = intptr_t(sizeof(BMLoop) * 64);
+  int jumps_num = 0;
+  const BMLoop *l_prev = nullptr;
+  BMIter iter;
+  BMFace *f;
+  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+    const BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+    if (l_prev && std::abs(intptr_t(l_first) - intptr_t(l_prev)) > max_distance) {
+      jumps_num++;
+    }
+    l_prev = l_first;
+  }
+  return jumps_num > bm->totface / 4;
+}
+
+bool BM_mesh_defragment(BMesh *bm)
+{
+  using namespace blender;
+
+  /* Python element wrappers point to the elements and can't be updated from here. */
+  if (CustomData_has_layer(&bm->vdata, CD_BM_ELEM_PYPTR) ||
+      CustomData_has_layer(&bm->edata, CD_BM_ELEM_PYPTR) ||
+      CustomData_has_layer(&bm->ldata, CD_BM_ELEM_PYPTR) ||
+      CustomData_has_layer(&bm->pdata, CD_BM_ELEM_PYPTR))
+  {
+    return false;
+  }
+
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+
+  const Array<int> face_order = bm_mesh_face_order_spatial(bm);
+
+  /* Vertices and edges follow the order they are first used by the faces,
+   * loose elements are kept in their current order after them. */
+  Array<int> vert_map(bm->totvert, -1);
+  Array<int> edge_map(bm->totedge, -1);
+  Array<int> face_map(bm->totface);
+  Array<int> loop_map(bm->totloop);
+  Array<int> vert_order(bm->totvert);
+  Array<int> edge_order(bm->totedge);
+  Array<BMLoop *> loop_order(bm->totloop);
+  int vert_dst = 0, edge_dst = 0, loop_dst = 0;
+  for (const int face_dst : face_order.index_range()) {
+    BMFace *f = bm->ftable[face_order[face_dst]];
+    face_map[face_order[face_dst]] = face_dst;
+    BMLoop *l_iter, *l_first;
+    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+    do {
+      int &v_index = vert_map[BM_elem_index_get(l_iter->v)];
+      if (v_index == -1) {
+        vert_order[vert_dst] = BM_elem_index_get(l_iter->v);
+        v_index = vert_dst++;
+      }
+      int &e_index = edge_map[BM_elem_index_get(l_iter->e)];
+      if (e_index == -1) {
+        edge_order[edge_dst] = BM_elem_index_get(l_iter->e);
+        e_index = edge_dst++;
+      }
+      loop_order[loop_dst++] = l_iter;
+    } while ((l_iter = l_iter->next) != l_first);
+  }
+  for (const int i : vert_map.index_range()) {
+    if (vert_map[i] == -1) {
+      vert_order[vert_dst] = i;
+      vert_map[i] = vert_dst++;
+    }
+  }
+  for (const int i : edge_map.index_range()) {
+    if (edge_map[i] == -1) {
+      edge_order[edge_dst] = i;
+      edge_map[i] = edge_dst++;
+    }
+  }
+
+  const BMAllocTemplate allocsize = BMALLOC_TEMPLATE_FROM_BM(bm);
+  BLI_mempool *vpool_dst, *epool_dst, *lpool_dst, *fpool_dst;
+  bm_mempool_init_ex(
+      &allocsize, bm->use_toolflags, &vpool_dst, &epool_dst, &lpool_dst, &fpool_dst);
+
+  /* Custom-data blocks are fragmented the same way, give them new pools too. */
+  CustomData *cdata[4] = {&bm->vdata, &bm->edata, &bm->ldata, &bm->pdata};
+  const char cdata_htype[4] = {BM_VERT, BM_EDGE, BM_LOOP, BM_FACE};
+  const int cdata_totelem[4] = {
+      allocsize.totvert, allocsize.totedge, allocsize.totloop, allocsize.totface};
+  BLI_mempool *cdata_pool_src[4];
+  BLI_mempool *cdata_pool_dst[4];
+  for (int i = 0; i < 4; i++) {
+    cdata_pool_src[i] = cdata[i]->pool;
+    cdata_pool_dst[i] = nullptr;
+    if (cdata_pool_src[i]) {
+      cdata[i]->pool = nullptr;
+      CustomData_bmesh_init_pool(cdata[i], cdata_totelem[i], cdata_htype[i]);
+      cdata_pool_dst[i] = cdata[i]->pool;
+      cdata[i]->pool = cdata_pool_src[i];
+    }
+  }
+
+  const bool use_toolflags = bm->use_toolflags;
+  BMVert **vtable_dst = static_cast<BMVert **>(
+      MEM_mallocN(sizeof(BMVert *) * bm->totvert, __func__));
+  BMEdge **etable_dst = static_cast<BMEdge **>(
+      MEM_mallocN(sizeof(BMEdge *) * bm->totedge, __func__));
+  BMLoop **ltable_dst = static_cast<BMLoop **>(
+      MEM_mallocN(sizeof(BMLoop *) * bm->totloop, __func__));
+  BMFace **ftable_dst = static_cast<BMFace **>(
+      MEM_mallocN(sizeof(BMFace *) * bm->totface, __func__));
+
+  /* Allocate in the new order, so iterating over the pools follows it. */
+  for (const int i : vert_order.index_range()) {
+    vtable_dst[i] = static_cast<BMVert *>(
+        bm_elem_copy_to_pool((BMElem *)bm->vtable[vert_order[i]],
+                             use_toolflags ? sizeof(BMVert_OFlag) : sizeof(BMVert),
+                             vpool_dst,
+                             bm->vdata,
+                             cdata_pool_dst[0]));
+  }
+  for (const int i : edge_order.index_range()) {
+    etable_dst[i] = static_cast<BMEdge *>(
+        bm_elem_copy_to_pool((BMElem *)bm->etable[edge_order[i]],
+                             use_toolflags ? sizeof(BMEdge_OFlag) : sizeof(BMEdge),
+                             epool_dst,
+                             bm->edata,
+                             cdata_pool_dst[1]));
+  }
+  for (const int i : loop_order.index_range()) {
+    ltable_dst[i] = static_cast<BMLoop *>(bm_elem_copy_to_pool(
+        (BMElem *)loop_order[i], sizeof(BMLoop), lpool_dst, bm->ldata, cdata_pool_dst[2]));
+  }
+  for (const int i : face_order.index_range()) {
+    ftable_dst[i] = static_cast<BMFace *>(
+        bm_elem_copy_to_pool((BMElem *)bm->ftable[face_order[i]],
+                             use_toolflags ? sizeof(BMFace_OFlag) : sizeof(BMFace),
+                             fpool_dst,
+                             bm->pdata,
+                             cdata_pool_dst[3]));
+  }
+
+  /* The remapping reads the destination index from the source elements. */
+  for (const int i : vert_map.index_range()) {
+    BM_elem_index_set(bm->vtable[i], vert_map[i]); /* set_ok */
+  }
+  for (const int i : edge_map.index_range()) {
+    BM_elem_index_set(bm->etable[i], edge_map[i]); /* set_ok */
+  }
+  for (const int i : loop_order.index_range()) {
+    BM_elem_index_set(loop_order[i], i); /* set_ok */
+  }
+  for (const int i : face_map.index_range()) {
+    BM_elem_index_set(bm->ftable[i], face_map[i]); /* set_ok */
+  }
+  /* The new elements were copied with their old indices, give them their position in the new
+   * tables. */
+  for (const int i : vert_order.index_range()) {
+    BM_elem_index_set(vtable_dst[i], i); /* set_ok */
+  }
+  for (const int i : edge_order.index_range()) {
+    BM_elem_index_set(etable_dst[i], i); /* set_ok */
+  }
+  for (const int i : loop_order.index_range()) {
+    BM_elem_index_set(ltable_dst[i], i); /* set_ok */
+  }
+  for (const int i : face_order.index_range()) {
+    BM_elem_index_set(ftable_dst[i], i); /* set_ok */
+  }
+
+  bm_mesh_rebuild_remap(bm,
+                        BM_VERT | BM_EDGE | BM_LOOP | BM_FACE,
+                        vtable_dst,
+                        etable_dst,
+                        ltable_dst,
+                        ftable_dst,
+                        vpool_dst,
+                        epool_dst,
+                        lpool_dst,
+                        fpool_dst);
+
+  for (int i = 0; i < 4; i++) {
+    if (cdata_pool_src[i]) {
+      BLI_mempool_destroy(cdata_pool_src[i]);
+      cdata[i]->pool = cdata_pool_dst[i];
+    }
+  }
+
+  /* The loop normal spaces store loop pointers. */
+  if (bm->lnor_spacearr) {
+    BKE_lnor_spacearr_free(bm->lnor_spacearr);
+    MEM_freeN(bm->lnor_spacearr);
+    bm->lnor_spacearr = nullptr;
+    bm->spacearr_dirty |= BM_SPACEARR_DIRTY_ALL;
+  }
+
+  /* Indices and tables now match the new memory order. */
+  bm->elem_index_dirty &= ~(BM_VERT | BM_EDGE | BM_LOOP | BM_FACE);
+  /* Data converted from the mesh before uses the old indices. */
+  BM_mesh_sync_tag_unknown(*bm);
+  return true;
+}
+
 void BM_mesh_toolflags_set(BMesh *bm, bool use_toolflags)
 {
   if (bm->use_toolflags == use_toolflags) {
@@ -171,6 +171,26 @@ void BM_mesh_rebuild(BMesh *bm,
                      BLI_mempool *lpool,
                      BLI_mempool *fpool);
 
+/**
+ * Rebuild the element and custom-data memory pools in a spatially coherent order to restore
+ * cache locality after long editing sessions scattered the elements over the pools.
+ * Faces are ordered along a Morton curve through their centers, loops follow their faces and
+ * vertices and edges are ordered by their first use in a face.
+ *
+ * \warning All pointers to elements held outside of the #BMesh are invalidated,
+ * including #BMEditMesh.looptris, so this should only run between operators.
+ * Element indices change as well, which breaks data stored by index outside of the mesh
+ * (modifier binds, mesh caches, custom element orders...), so only run it when requested.
+ * \return False when the mesh is referenced by Python wrappers, which can't be remapped.
+ */
+bool BM_mesh_defragment(BMesh *bm);
+
+/**
+ * Check whether iterating over the mesh jumps around in memory enough for #BM_mesh_defragment
+ * to be worthwhile. Linear in the number of faces, but much cheaper than defragmenting.
+ */
+bool BM_mesh_is_fragmented(BMesh *bm);
+
 struct BMAllocTemplate {
   int totvert, totedge, totloop, totface;
 };
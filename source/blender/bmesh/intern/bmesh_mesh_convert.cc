@@ -1810,3 +1810,117 @@ void BM_mesh_bm_to_me_for_eval(BMesh &bm, Mesh &mesh, const CustomData_MeshMasks
 
   BM_mesh_bm_to_me_compact(bm, mesh, &mask, true);
 }
+
+namespace blender {
+
+/**
+ * Copy the changes declared in #BMesh.sync_flag into a mesh converted from the same #BMesh.
+ * \return False when the changes aren't known or the mesh doesn't match the #BMesh anymore.
+ */
+static bool bm_to_mesh_sync_patch(BMesh &bm, Mesh &mesh)
+{
+  if ((bm.sync_flag & (BM_SYNC_VALID | BM_SYNC_UNKNOWN)) != BM_SYNC_VALID) {
+    return false;
+  }
+  /* Elements were added or removed, the declared changes can't be the only ones. The tables are
+   * ensured by every synchronization, so they are only dirty after topology changes. */
+  if ((bm.elem_index_dirty & (BM_VERT | BM_EDGE | BM_FACE | BM_LOOP)) ||
+      (bm.elem_table_dirty & (BM_VERT | BM_EDGE | BM_FACE)))
+  {
+    return false;
+  }
+  if (mesh.verts_num != bm.totvert || mesh.edges_num != bm.totedge ||
+      mesh.faces_num != bm.totface || mesh.corners_num != bm.totloop)
+  {
+    return false;
+  }
+
+  if (bm.sync_flag & BM_SYNC_VERT_POSITIONS) {
+    const IndexRange range = IndexRange::from_begin_end(
+        std::clamp(bm.sync_vert_start, 0, bm.totvert),
+        std::clamp(bm.sync_vert_end, bm.sync_vert_start, bm.totvert));
+    if (!range.is_empty()) {
+      BM_mesh_elem_table_ensure(&bm, BM_VERT);
+      MutableSpan<float3> positions = mesh.vert_positions_for_write();
+      threading::parallel_for(range, 2048, [&](const IndexRange sub_range) {
+        for (const int vert_i : sub_range) {
+          positions[vert_i] = bm.vtable[vert_i]->co;
+        }
+      });
+      mesh.tag_positions_changed();
+    }
+  }
+
+  if (bm.sync_flag & BM_SYNC_CORNER_DATA) {
+    CustomData_ensure_layers_are_mutable(&mesh.corner_data, mesh.corners_num);
+    const Vector<BMeshToMeshLayerInfo> info = bm_to_mesh_copy_info_calc(bm.ldata,
+                                                                        mesh.corner_data);
+    BM_mesh_elem_table_ensure(&bm, BM_FACE);
+    threading::parallel_for(IndexRange(bm.totface), 1024, [&](const IndexRange range) {
+      for (const int face_i : range) {
+        const BMLoop *l_first = BM_FACE_FIRST_LOOP(bm.ftable[face_i]);
+        const BMLoop *l_iter = l_first;
+        do {
+          bmesh_block_copy_to_mesh_attributes(info, BM_elem_index_get(l_iter), l_iter->head.data);
+        } while ((l_iter = l_iter->next) != l_first);
+      }
+    });
+  }
+
+  return true;
+}
+
+}  // namespace blender
+
+void BM_mesh_bm_to_me_for_eval_sync(BMesh &bm,
+                                    Mesh &mesh,
+                                    const CustomData_MeshMasks *cd_mask_extra,
+                                    const bool mesh_is_synced)
+{
+  if (!(mesh_is_synced && blender::bm_to_mesh_sync_patch(bm, mesh))) {
+    BKE_mesh_clear_geometry(&mesh);
+    BM_mesh_bm_to_me_for_eval(bm, mesh, cd_mask_extra);
+  }
+  BM_mesh_elem_table_ensure(&bm, BM_VERT | BM_EDGE | BM_FACE);
+
+  /* Edits after this point are unknown until a tool declares them again. */
+  bm.sync_flag = 0;
+  bm.sync_count++;
+}
+
+void BM_mesh_sync_tag_changes(BMesh &bm,
+                              const char sync_flag,
+                              const int vert_start,
+                              const int vert_end,
+                              int *last_sync_count)
+{
+  if (bm.sync_flag & BM_SYNC_UNKNOWN) {
+    /* Some other change wasn't declared, the next synchronization has to convert everything. */
+  }
+  else if (*last_sync_count != -1 && *last_sync_count != bm.sync_count) {
+    /* The mesh was synchronized after the previous call of the tool, and nothing tagged
+     * undeclared changes since, so the declared changes are complete. */
+    bm.sync_flag = BM_SYNC_VALID | sync_flag;
+    bm.sync_vert_start = vert_start;
+    bm.sync_vert_end = vert_end;
+  }
+  else if (bm.sync_flag & BM_SYNC_VALID) {
+    if (sync_flag & BM_SYNC_VERT_POSITIONS) {
+      if (bm.sync_flag & BM_SYNC_VERT_POSITIONS) {
+        bm.sync_vert_start = std::min(bm.sync_vert_start, vert_start);
+        bm.sync_vert_end = std::max(bm.sync_vert_end, vert_end);
+      }
+      else {
+        bm.sync_vert_start = vert_start;
+        bm.sync_vert_end = vert_end;
+      }
+    }
+    bm.sync_flag |= sync_flag;
+  }
+  *last_sync_count = bm.sync_count;
+}
+
+void BM_mesh_sync_tag_unknown(BMesh &bm)
+{
+  bm.sync_flag = BM_SYNC_UNKNOWN;
+}
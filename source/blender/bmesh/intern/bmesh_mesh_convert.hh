@@ -91,6 +91,39 @@ void BM_mesh_bm_to_me(struct Main *bmain, BMesh *bm, Mesh *mesh, const BMeshToMe
  */
 void BM_mesh_bm_to_me_for_eval(BMesh &bm, Mesh &mesh, const CustomData_MeshMasks *cd_mask_extra);
 
+/**
+ * Incremental version of #BM_mesh_bm_to_me_for_eval for meshes that are converted repeatedly
+ * while editing.
+ *
+ * When \a mesh_is_synced is true, \a mesh must be the result of the previous call for this
+ * #BMesh (with the same \a cd_mask_extra). If the only changes since then were declared with
+ * #BM_mesh_sync_tag_changes, they are patched into the existing mesh arrays in place.
+ * Otherwise (topology changes or unknown edits) the mesh is cleared and converted from scratch.
+ */
+void BM_mesh_bm_to_me_for_eval_sync(BMesh &bm,
+                                    Mesh &mesh,
+                                    const CustomData_MeshMasks *cd_mask_extra,
+                                    bool mesh_is_synced);
+
+/**
+ * Declare the changes a tool made to \a bm since its previous call,
+ * so they can be synchronized without a full conversion.
+ *
+ * \param sync_flag: `BM_SYNC_*` flags describing the changes.
+ * \param vert_start, vert_end: Range of vertex indices with changed positions.
+ * \param last_sync_count: #BMesh.sync_count from the previous call of the tool, -1 initially.
+ * Changes from before the first call are unknown to the tool, so they are never declared.
+ */
+void BM_mesh_sync_tag_changes(
+    BMesh &bm, char sync_flag, int vert_start, int vert_end, int *last_sync_count);
+
+/**
+ * Tag that \a bm was modified without declaring the changes, so the next synchronization converts
+ * the whole mesh even if a tool declares its changes afterwards. Called by #EDBM_update, every
+ * other code modifying an edit-mesh without going through that must call this.
+ */
+void BM_mesh_sync_tag_unknown(BMesh &bm);
+
 /**
  * A version of #BM_mesh_bm_to_me_for_eval but copying data layers and Mesh attributes is optional.
  * It also allows shape-keys but don't re-assigns shape-key indices.
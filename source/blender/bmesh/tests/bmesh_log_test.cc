@@ -0,0 +1,62 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "bmesh.hh"
+#include "intern/bmesh_log.hh"
+
+namespace blender::bmesh::tests {
+
+static BMesh *two_triangles_create(BMFace *r_faces[2])
+{
+  BMeshCreateParams params{};
+  params.use_toolflags = true;
+  BMesh *bm = BM_mesh_create(&bm_mesh_allocsize_default, &params);
+  const float co[4][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+  BMVert *verts[4];
+  for (const int i : IndexRange(4)) {
+    verts[i] = BM_vert_create(bm, co[i], nullptr, BM_CREATE_NOP);
+  }
+  BMVert *tri_a[3] = {verts[0], verts[1], verts[2]};
+  BMVert *tri_b[3] = {verts[0], verts[2], verts[3]};
+  r_faces[0] = BM_face_create_verts(bm, tri_a, 3, nullptr, BM_CREATE_NOP, true);
+  r_faces[1] = BM_face_create_verts(bm, tri_b, 3, nullptr, BM_CREATE_NOP, true);
+  return bm;
+}
+
+TEST(bmesh_log, CompactDeletedModifiedFace)
+{
+  BMFace *faces[2];
+  BMesh *bm = two_triangles_create(faces);
+  BMLog *log = BM_log_create(bm);
+  BMLogEntry *entry = BM_log_entry_add(log);
+
+  /* Modify a face, then delete it within the same entry. */
+  BM_log_face_modified(log, faces[0]);
+  BM_elem_flag_enable(faces[0], BM_ELEM_HIDDEN);
+  BM_log_face_modified(log, faces[1]);
+  BM_log_face_removed(log, faces[0]);
+  BM_face_kill(bm, faces[0]);
+  EXPECT_EQ(bm->totface, 1);
+
+  const size_t size_before = BM_log_entry_size_in_bytes(entry);
+  BM_log_entry_compact(bm, log);
+  EXPECT_LT(BM_log_entry_size_in_bytes(entry), size_before);
+
+  /* Undo restores the deleted face with its values from before the modification. */
+  BM_log_undo(bm, log);
+  EXPECT_EQ(bm->totface, 2);
+  BMIter iter;
+  BMFace *f;
+  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+    EXPECT_FALSE(BM_elem_flag_test(f, BM_ELEM_HIDDEN));
+  }
+
+  BM_log_free(log);
+  BM_log_entry_drop(entry);
+  BM_mesh_free(bm);
+}
+
+}  // namespace blender::bmesh::tests
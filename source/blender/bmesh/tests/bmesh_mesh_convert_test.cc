@@ -0,0 +1,99 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_math_vector_types.hh"
+
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
+
+#include "bmesh.hh"
+
+namespace blender::bmesh::tests {
+
+static BMesh *two_triangles_create()
+{
+  BMeshCreateParams params{};
+  BMesh *bm = BM_mesh_create(&bm_mesh_allocsize_default, &params);
+  const float co[4][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+  BMVert *verts[4];
+  for (const int i : IndexRange(4)) {
+    verts[i] = BM_vert_create(bm, co[i], nullptr, BM_CREATE_NOP);
+  }
+  BMVert *tri_a[3] = {verts[0], verts[1], verts[2]};
+  BMVert *tri_b[3] = {verts[0], verts[2], verts[3]};
+  BM_face_create_verts(bm, tri_a, 3, nullptr, BM_CREATE_NOP, true);
+  BM_face_create_verts(bm, tri_b, 3, nullptr, BM_CREATE_NOP, true);
+  return bm;
+}
+
+/** Synchronize like a tool calling #BM_mesh_sync_tag_changes before each update would. */
+struct SyncTestContext {
+  BMesh *bm;
+  Mesh *mesh;
+  int last_sync_count = -1;
+
+  SyncTestContext()
+  {
+    BKE_idtype_init();
+    bm = two_triangles_create();
+    mesh = BKE_mesh_new_nomain(0, 0, 0, 0);
+    BM_mesh_bm_to_me_for_eval_sync(*bm, *mesh, nullptr, false);
+  }
+  ~SyncTestContext()
+  {
+    BKE_id_free(nullptr, mesh);
+    BM_mesh_free(bm);
+  }
+
+  void tool_update(const int vert_start, const int vert_end)
+  {
+    BM_mesh_sync_tag_changes(*bm, BM_SYNC_VERT_POSITIONS, vert_start, vert_end, &last_sync_count);
+    BM_mesh_bm_to_me_for_eval_sync(*bm, *mesh, nullptr, true);
+  }
+};
+
+TEST(bmesh_mesh_convert, SyncDeclaredChanges)
+{
+  SyncTestContext ctx;
+  ctx.tool_update(0, 0);
+
+  BM_mesh_elem_table_ensure(ctx.bm, BM_VERT);
+  BM_vert_at_index(ctx.bm, 1)->co[2] = 1.0f;
+  BM_mesh_sync_tag_changes(*ctx.bm, BM_SYNC_VERT_POSITIONS, 1, 2, &ctx.last_sync_count);
+  EXPECT_TRUE(ctx.bm->sync_flag & BM_SYNC_VALID);
+
+  /* The declared change is patched into the existing arrays. */
+  const float3 *positions_prev = ctx.mesh->vert_positions().data();
+  BM_mesh_bm_to_me_for_eval_sync(*ctx.bm, *ctx.mesh, nullptr, true);
+  EXPECT_EQ(ctx.mesh->vert_positions().data(), positions_prev);
+  EXPECT_EQ(ctx.mesh->vert_positions()[1], float3(1, 0, 1));
+}
+
+TEST(bmesh_mesh_convert, SyncUndeclaredChanges)
+{
+  SyncTestContext ctx;
+  ctx.tool_update(0, 0);
+
+  /* An operator moves a vertex without declaring it, then the tool declares its own change. */
+  BM_mesh_elem_table_ensure(ctx.bm, BM_VERT);
+  BM_vert_at_index(ctx.bm, 0)->co[2] = 2.0f;
+  BM_mesh_sync_tag_unknown(*ctx.bm);
+  BM_vert_at_index(ctx.bm, 3)->co[2] = 3.0f;
+  ctx.tool_update(3, 4);
+  EXPECT_EQ(ctx.mesh->vert_positions()[0], float3(0, 0, 2));
+  EXPECT_EQ(ctx.mesh->vert_positions()[3], float3(0, 1, 3));
+
+  /* Topology changes are detected even when nothing tagged them. */
+  ctx.tool_update(0, 0);
+  BMFace *f = static_cast<BMFace *>(BM_iter_at_index(ctx.bm, BM_FACES_OF_MESH, nullptr, 0));
+  BM_face_kill(ctx.bm, f);
+  ctx.tool_update(0, 0);
+  EXPECT_EQ(ctx.mesh->faces_num, 1);
+  EXPECT_EQ(ctx.mesh->corners_num, 3);
+}
+
+}  // namespace blender::bmesh::tests
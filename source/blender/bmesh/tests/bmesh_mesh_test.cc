@@ -0,0 +1,233 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_map.hh"
+#include "BLI_rand.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_customdata.hh"
+
+#include "bmesh.hh"
+
+namespace blender::bmesh::tests {
+
+/**
+ * Create a grid of quads with integer ids on vertices and faces, then delete and re-create a
+ * random part of the faces so that the element pools end up fragmented like after editing.
+ */
+static BMesh *fragmented_grid_create(const int size)
+{
+  BMeshCreateParams params{};
+  params.use_toolflags = true;
+  BMesh *bm = BM_mesh_create(&bm_mesh_allocsize_default, &params);
+  BM_data_layer_add_named(bm, &bm->vdata, CD_PROP_INT32, "id");
+  BM_data_layer_add_named(bm, &bm->pdata, CD_PROP_INT32, "id");
+  const int cd_vert_id = CustomData_get_offset_named(&bm->vdata, CD_PROP_INT32, "id");
+  const int cd_face_id = CustomData_get_offset_named(&bm->pdata, CD_PROP_INT32, "id");
+
+  Vector<BMVert *> verts;
+  for (const int y : IndexRange(size + 1)) {
+    for (const int x : IndexRange(size + 1)) {
+      const float co[3] = {float(x), float(y), 0.0f};
+      BMVert *v = BM_vert_create(bm, co, nullptr, BM_CREATE_NOP);
+      BM_ELEM_CD_SET_INT(v, cd_vert_id, int(verts.size()));
+      verts.append(v);
+    }
+  }
+
+  auto face_create = [&](const int x, const int y) {
+    BMVert *quad[4] = {verts[y * (size + 1) + x],
+                       verts[y * (size + 1) + x + 1],
+                       verts[(y + 1) * (size + 1) + x + 1],
+                       verts[(y + 1) * (size + 1) + x]};
+    BMFace *f = BM_face_create_verts(bm, quad, 4, nullptr, BM_CREATE_NOP, true);
+    BM_ELEM_CD_SET_INT(f, cd_face_id, y * size + x);
+    return f;
+  };
+
+  Vector<BMFace *> faces;
+  for (const int y : IndexRange(size)) {
+    for (const int x : IndexRange(size)) {
+      faces.append(face_create(x, y));
+    }
+  }
+
+  RandomNumberGenerator rng(0);
+  for (const int i : faces.index_range()) {
+    if (rng.get_float() < 0.5f) {
+      BM_face_kill(bm, faces[i]);
+      faces[i] = nullptr;
+    }
+  }
+  for (const int i : faces.index_range()) {
+    if (faces[i] == nullptr) {
+      faces[i] = face_create(i % size, i / size);
+    }
+  }
+  return bm;
+}
+
+/** Vertex ids of every face in loop order, by face id. */
+static Map<int, Vector<int>> face_vert_ids_get(BMesh *bm)
+{
+  const int cd_vert_id = CustomData_get_offset_named(&bm->vdata, CD_PROP_INT32, "id");
+  const int cd_face_id = CustomData_get_offset_named(&bm->pdata, CD_PROP_INT32, "id");
+  Map<int, Vector<int>> result;
+  BMIter iter;
+  BMFace *f;
+  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+    Vector<int> ids;
+    BMLoop *l_iter, *l_first;
+    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+    do {
+      ids.append(BM_ELEM_CD_GET_INT(l_iter->v, cd_vert_id));
+    } while ((l_iter = l_iter->next) != l_first);
+    result.add(BM_ELEM_CD_GET_INT(f, cd_face_id), std::move(ids));
+  }
+  return result;
+}
+
+TEST(bmesh_mesh, Defragment)
+{
+  BMesh *bm = fragmented_grid_create(128);
+  EXPECT_TRUE(BM_mesh_is_fragmented(bm));
+  const Map<int, Vector<int>> faces_before = face_vert_ids_get(bm);
+  const int totvert = bm->totvert;
+  const int totedge = bm->totedge;
+  const int totloop = bm->totloop;
+
+  EXPECT_TRUE(BM_mesh_defragment(bm));
+  EXPECT_FALSE(BM_mesh_is_fragmented(bm));
+
+  EXPECT_EQ(bm->totvert, totvert);
+  EXPECT_EQ(bm->totedge, totedge);
+  EXPECT_EQ(bm->totloop, totloop);
+  EXPECT_EQ(BM_mesh_elem_count(bm, BM_VERT), totvert);
+  EXPECT_EQ(BM_mesh_elem_count(bm, BM_EDGE), totedge);
+
+  const Map<int, Vector<int>> faces_after = face_vert_ids_get(bm);
+  EXPECT_EQ(faces_after.size(), faces_before.size());
+  for (const auto item : faces_before.items()) {
+    EXPECT_EQ(faces_after.lookup(item.key), item.value);
+  }
+
+  /* Check the connectivity between elements was remapped consistently. */
+  BMIter iter;
+  BMFace *f;
+  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+    BMLoop *l_iter, *l_first;
+    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+    do {
+      EXPECT_EQ(l_iter->f, f);
+      EXPECT_EQ(l_iter->next->prev, l_iter);
+      EXPECT_EQ(l_iter->radial_next->radial_prev, l_iter);
+      EXPECT_EQ(l_iter->radial_next->e, l_iter->e);
+      EXPECT_TRUE(BM_vert_in_edge(l_iter->e, l_iter->v));
+      EXPECT_TRUE(BM_vert_in_edge(l_iter->e, l_iter->next->v));
+    } while ((l_iter = l_iter->next) != l_first);
+  }
+  BMEdge *e;
+  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
+    EXPECT_TRUE(BM_edge_in_face(e, e->l->f));
+    EXPECT_TRUE(BM_vert_in_edge(e, e->v1) && BM_vert_in_edge(e, e->v2));
+  }
+
+  /* Indices are not tagged dirty, so they must match the tables and the iteration order. */
+  EXPECT_EQ(bm->elem_index_dirty & (BM_VERT | BM_EDGE | BM_LOOP | BM_FACE), 0);
+  EXPECT_EQ(bm->elem_table_dirty & (BM_VERT | BM_EDGE | BM_FACE), 0);
+  int index;
+  BMVert *v;
+  BM_ITER_MESH_INDEX (v, &iter, bm, BM_VERTS_OF_MESH, index) {
+    EXPECT_EQ(BM_elem_index_get(v), index);
+    EXPECT_EQ(bm->vtable[index], v);
+  }
+  BM_ITER_MESH_INDEX (e, &iter, bm, BM_EDGES_OF_MESH, index) {
+    EXPECT_EQ(BM_elem_index_get(e), index);
+    EXPECT_EQ(bm->etable[index], e);
+  }
+  int loop_index = 0;
+  BM_ITER_MESH_INDEX (f, &iter, bm, BM_FACES_OF_MESH, index) {
+    EXPECT_EQ(BM_elem_index_get(f), index);
+    EXPECT_EQ(bm->ftable[index], f);
+    BMLoop *l_iter, *l_first;
+    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+    do {
+      EXPECT_EQ(BM_elem_index_get(l_iter), loop_index++);
+    } while ((l_iter = l_iter->next) != l_first);
+  }
+
+  BM_mesh_free(bm);
+}
+
+/** Sum of the vertex coordinates of all face corners, iterated like most tools do. */
+static double face_corners_iterate(BMesh *bm)
+{
+  double sum = 0.0;
+  BMIter iter;
+  BMFace *f;
+  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+    BMLoop *l_iter, *l_first;
+    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+    do {
+      sum += l_iter->v->co[0];
+    } while ((l_iter = l_iter->next) != l_first);
+  }
+  return sum;
+}
+
+/** Sum of the edge lengths around every vertex, iterated through the disk cycles. */
+static double vert_edges_iterate(BMesh *bm)
+{
+  double sum = 0.0;
+  BMIter iter;
+  BMVert *v;
+  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
+    BMIter iter_edge;
+    BMEdge *e;
+    BM_ITER_ELEM (e, &iter_edge, v, BM_EDGES_OF_VERT) {
+      sum += BM_edge_calc_length(e);
+    }
+  }
+  return sum;
+}
+
+/** Compare iterating over a fragmented mesh before and after defragmenting. */
+TEST(bmesh_mesh_performance, defragment_iteration)
+{
+  BMesh *bm = fragmented_grid_create(512);
+
+  auto iterate = [&](const char *name, double r_sums[2]) {
+    {
+      SCOPED_TIMER(std::string(name) + " face corners");
+      for ([[maybe_unused]] const int i : IndexRange(10)) {
+        r_sums[0] = face_corners_iterate(bm);
+      }
+    }
+    {
+      SCOPED_TIMER(std::string(name) + " vertex edges");
+      for ([[maybe_unused]] const int i : IndexRange(10)) {
+        r_sums[1] = vert_edges_iterate(bm);
+      }
+    }
+  };
+
+  double sums_before[2], sums_after[2];
+  iterate("fragmented", sums_before);
+  {
+    SCOPED_TIMER("defragment");
+    EXPECT_TRUE(BM_mesh_defragment(bm));
+  }
+  iterate("defragmented", sums_after);
+
+  /* The order of the sums changes, so small differences are expected. */
+  EXPECT_NEAR(sums_before[0], sums_after[0], sums_before[0] * 1e-9);
+  EXPECT_NEAR(sums_before[1], sums_after[1], sums_before[1] * 1e-9);
+
+  BM_mesh_free(bm);
+}
+
+}  // namespace blender::bmesh::tests
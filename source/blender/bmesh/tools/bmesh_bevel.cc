@@ -20,6 +20,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_memarena.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
 
@@ -2140,17 +2141,12 @@ static void calculate_profile_segments(const Profile *profile,
 }
 
 /**
- * Calculate the actual coordinate values for bndv's profile.
- * This is only needed if bp->seg > 1.
- * Allocate the space for them if that hasn't been done already.
- * If bp->seg is not a power of 2, also need to calculate
- * the coordinate values for the power of 2 >= bp->seg, because the ADJ pattern needs power-of-2
- * boundaries during construction.
+ * Allocate the space for the coordinate values of bndv's profile if that hasn't been done already.
+ * The memory arena isn't thread-safe, so this is separate from #calculate_profile.
  */
-static void calculate_profile(BevelParams *bp, BoundVert *bndv, bool reversed, bool miter)
+static void profile_coords_ensure(BevelParams *bp, BoundVert *bndv)
 {
   Profile *pro = &bndv->profile;
-  ProfileSpacing *pro_spacing = (miter) ? &bp->pro_spacing_miter : &bp->pro_spacing;
 
   if (bp->seg == 1) {
     return;
@@ -2167,6 +2163,27 @@ static void calculate_profile(BevelParams *bp, BoundVert *bndv, bool reversed, b
       pro->prof_co_2 = pro->prof_co;
     }
   }
+}
+
+/**
+ * Calculate the actual coordinate values for bndv's profile.
+ * This is only needed if bp->seg > 1.
+ * Allocate the space for them if that hasn't been done already.
+ * If bp->seg is not a power of 2, also need to calculate
+ * the coordinate values for the power of 2 >= bp->seg, because the ADJ pattern needs power-of-2
+ * boundaries during construction.
+ */
+static void calculate_profile(BevelParams *bp, BoundVert *bndv, bool reversed, bool miter)
+{
+  Profile *pro = &bndv->profile;
+  ProfileSpacing *pro_spacing = (miter) ? &bp->pro_spacing_miter : &bp->pro_spacing;
+
+  if (bp->seg == 1) {
+    return;
+  }
+
+  bool need_2 = bp->seg != bp->pro_spacing.seg_2;
+  profile_coords_ensure(bp, bndv);
 
   bool use_map;
   float map[4][4];
@@ -5920,13 +5937,39 @@ static void bevel_vert_two_edges(BevelParams *bp, BMesh *bm, BevVert *bv)
   }
 }
 
-/* Given that the boundary is built, now make the actual BMVerts
- * for the boundary and the interior of the vertex mesh. */
-static void build_vmesh(BevelParams *bp, BMesh *bm, BevVert *bv)
+/**
+ * Special case: just two beveled edges welded together.
+ * \return true and the two BoundVerts involved in the weld if this is that case.
+ */
+static bool build_vmesh_weld_find(BevVert *bv, BoundVert **r_weld1, BoundVert **r_weld2)
 {
   VMesh *vm = bv->vmesh;
-  float co[3];
+  *r_weld1 = nullptr;
+  *r_weld2 = nullptr;
+  if (!((bv->selcount == 2) && (vm->count == 2))) {
+    return false;
+  }
+  BoundVert *bndv = vm->boundstart;
+  do {
+    if (bndv->ebev) {
+      if (!*r_weld1) {
+        *r_weld1 = bndv;
+      }
+      else { /* Get the last of the two BoundVerts. */
+        *r_weld2 = bndv;
+      }
+    }
+  } while ((bndv = bndv->next) != vm->boundstart);
+  return true;
+}
 
+/**
+ * Allocate the vertex mesh and the profile coordinates of a BevVert from the memory arena,
+ * so that #build_vmesh_profiles can run for many BevVerts in parallel.
+ */
+static void build_vmesh_alloc(BevelParams *bp, BevVert *bv)
+{
+  VMesh *vm = bv->vmesh;
   int n = vm->count;
   int ns = vm->seg;
   int ns2 = ns / 2;
@@ -5934,10 +5977,46 @@ static void build_vmesh(BevelParams *bp, BMesh *bm, BevVert *bv)
   vm->mesh = (NewVert *)BLI_memarena_alloc(bp->mem_arena,
                                            sizeof(NewVert) * n * (ns2 + 1) * (ns + 1));
 
-  /* Special case: just two beveled edges welded together. */
-  const bool weld = (bv->selcount == 2) && (vm->count == 2);
-  BoundVert *weld1 = nullptr; /* Will hold two BoundVerts involved in weld. */
-  BoundVert *weld2 = nullptr;
+  BoundVert *bndv = vm->boundstart;
+  do {
+    profile_coords_ensure(bp, bndv);
+  } while ((bndv = bndv->next) != vm->boundstart);
+}
+
+/**
+ * Calculate the profiles of the BoundVerts of a BevVert now that their positions are final.
+ * This only changes data owned by \a bv, so it's safe to call for different BevVerts in parallel.
+ */
+static void build_vmesh_profiles(BevelParams *bp, BevVert *bv)
+{
+  VMesh *vm = bv->vmesh;
+
+  /* Move profile planes if this is a weld case. */
+  BoundVert *weld1, *weld2;
+  if (build_vmesh_weld_find(bv, &weld1, &weld2) && weld2) {
+    set_profile_params(bp, bv, weld1);
+    set_profile_params(bp, bv, weld2);
+    move_weld_profile_planes(bv, weld1, weld2);
+  }
+
+  /* It's simpler to calculate all profiles only once at a single moment, so keep just a single
+   * profile calculation here, the last point before actual mesh verts are created. */
+  calculate_vm_profiles(bp, bv, vm);
+}
+
+/* Given that the boundary is built and #build_vmesh_profiles has been called,
+ * now make the actual BMVerts for the boundary and the interior of the vertex mesh. */
+static void build_vmesh(BevelParams *bp, BMesh *bm, BevVert *bv)
+{
+  VMesh *vm = bv->vmesh;
+  float co[3];
+
+  int n = vm->count;
+  int ns = vm->seg;
+
+  BoundVert *weld1; /* Will hold two BoundVerts involved in weld. */
+  BoundVert *weld2;
+  const bool weld = build_vmesh_weld_find(bv, &weld1, &weld2);
 
   /* Make (i, 0, 0) mesh verts for all i boundverts. */
   BoundVert *bndv = vm->boundstart;
@@ -5946,25 +6025,8 @@ static void build_vmesh(BevelParams *bp, BMesh *bm, BevVert *bv)
     copy_v3_v3(mesh_vert(vm, i, 0, 0)->co, bndv->nv.co); /* Mesh NewVert to boundary NewVert. */
     create_mesh_bmvert(bm, vm, i, 0, 0, bv->v);          /* Create BMVert for that NewVert. */
     bndv->nv.v = mesh_vert(vm, i, 0, 0)->v; /* Use the BMVert for the BoundVert's NewVert. */
-
-    /* Find boundverts and move profile planes if this is a weld case. */
-    if (weld && bndv->ebev) {
-      if (!weld1) {
-        weld1 = bndv;
-      }
-      else { /* Get the last of the two BoundVerts. */
-        weld2 = bndv;
-        set_profile_params(bp, bv, weld1);
-        set_profile_params(bp, bv, weld2);
-        move_weld_profile_planes(bv, weld1, weld2);
-      }
-    }
   } while ((bndv = bndv->next) != vm->boundstart);
 
-  /* It's simpler to calculate all profiles only once at a single moment, so keep just a single
-   * profile calculation here, the last point before actual mesh verts are created. */
-  calculate_vm_profiles(bp, bv, vm);
-
   /* Create new vertices and place them based on the profiles. */
   /* Copy other ends to (i, 0, ns) for all i, and fill in profiles for edges. */
   bndv = vm->boundstart;
@@ -7640,35 +7702,30 @@ static float vertex_collide_offset(BevelParams *bp, EdgeHalf *ea)
  * before geometry collisions happen. If the offset changes as a result of this, adjust the current
  * edge offset specs to reflect this clamping, and store the new offset in bp.offset.
  */
-static void bevel_limit_offset(BevelParams *bp, BMesh *bm)
-{
-  float limited_offset = bp->offset;
-  BMIter iter;
-  BMVert *bmv;
-  BM_ITER_MESH (bmv, &iter, bm, BM_VERTS_OF_MESH) {
-    if (!BM_elem_flag_test(bmv, BM_ELEM_TAG)) {
-      continue;
-    }
-    BevVert *bv = find_bevvert(bp, bmv);
-    if (!bv) {
-      continue;
-    }
-    for (int i = 0; i < bv->edgecount; i++) {
-      EdgeHalf *eh = &bv->edges[i];
-      if (bp->affect_type == BEVEL_AFFECT_VERTICES) {
-        float collision_offset = vertex_collide_offset(bp, eh);
-        if (collision_offset < limited_offset) {
-          limited_offset = collision_offset;
-        }
-      }
-      else {
-        float collision_offset = geometry_collide_offset(bp, eh);
-        if (collision_offset < limited_offset) {
-          limited_offset = collision_offset;
+static void bevel_limit_offset(BevelParams *bp, const blender::Span<BevVert *> bevverts)
+{
+  using namespace blender;
+  /* The collision offsets only read the mesh and the edge specs, so they can be calculated in
+   * parallel. Taking the minimum doesn't depend on the order. */
+  const float limited_offset = threading::parallel_reduce(
+      bevverts.index_range(),
+      512,
+      bp->offset,
+      [&](const IndexRange range, float limit) {
+        for (BevVert *bv : bevverts.slice(range)) {
+          for (int i = 0; i < bv->edgecount; i++) {
+            EdgeHalf *eh = &bv->edges[i];
+            if (bp->affect_type == BEVEL_AFFECT_VERTICES) {
+              limit = min_ff(limit, vertex_collide_offset(bp, eh));
+            }
+            else {
+              limit = min_ff(limit, geometry_collide_offset(bp, eh));
+            }
+          }
         }
-      }
-    }
-  }
+        return limit;
+      },
+      [](const float a, const float b) { return min_ff(a, b); });
 
   if (limited_offset < bp->offset) {
     /* All current offset specs have some number times bp->offset,
@@ -7677,22 +7734,17 @@ static void bevel_limit_offset(BevelParams *bp, BMesh *bm)
      * with the new limited_offset.
      */
     float offset_factor = limited_offset / bp->offset;
-    BM_ITER_MESH (bmv, &iter, bm, BM_VERTS_OF_MESH) {
-      if (!BM_elem_flag_test(bmv, BM_ELEM_TAG)) {
-        continue;
-      }
-      BevVert *bv = find_bevvert(bp, bmv);
-      if (!bv) {
-        continue;
-      }
-      for (int i = 0; i < bv->edgecount; i++) {
-        EdgeHalf *eh = &bv->edges[i];
-        eh->offset_l_spec *= offset_factor;
-        eh->offset_r_spec *= offset_factor;
-        eh->offset_l *= offset_factor;
-        eh->offset_r *= offset_factor;
+    threading::parallel_for(bevverts.index_range(), 1024, [&](const IndexRange range) {
+      for (BevVert *bv : bevverts.slice(range)) {
+        for (int i = 0; i < bv->edgecount; i++) {
+          EdgeHalf *eh = &bv->edges[i];
+          eh->offset_l_spec *= offset_factor;
+          eh->offset_r_spec *= offset_factor;
+          eh->offset_l *= offset_factor;
+          eh->offset_r *= offset_factor;
+        }
       }
-    }
+    });
     bp->offset = limited_offset;
   }
 }
@@ -7810,28 +7862,29 @@ void BM_mesh_bevel(BMesh *bm,
 
   math_layer_info_init(&bp, bm);
 
+  /* All the BevVerts in the order of the mesh vertices. */
+  blender::Vector<BevVert *> bevverts;
+
   /* Analyze input vertices, sorting edges and assigning initial new vertex positions. */
   BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
     if (BM_elem_flag_test(v, BM_ELEM_TAG)) {
       bv = bevel_vert_construct(bm, &bp, v);
-      if (!limit_offset && bv) {
-        build_boundary(&bp, bv, true);
+      if (bv) {
+        bevverts.append(bv);
+        if (!limit_offset) {
+          build_boundary(&bp, bv, true);
+        }
       }
     }
   }
 
   /* Perhaps clamp offset to avoid geometry collisions. */
   if (limit_offset) {
-    bevel_limit_offset(&bp, bm);
+    bevel_limit_offset(&bp, bevverts);
 
     /* Assign initial new vertex positions. */
-    BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
-      if (BM_elem_flag_test(v, BM_ELEM_TAG)) {
-        bv = find_bevvert(&bp, v);
-        if (bv) {
-          build_boundary(&bp, bv, true);
-        }
-      }
+    for (BevVert *bevvert : bevverts) {
+      build_boundary(&bp, bevvert, true);
     }
   }
 
@@ -7849,14 +7902,20 @@ void BM_mesh_bevel(BMesh *bm,
     }
   }
 
-  /* Build the meshes around vertices, now that positions are final. */
-  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
-    if (BM_elem_flag_test(v, BM_ELEM_TAG)) {
-      bv = find_bevvert(&bp, v);
-      if (bv) {
-        build_vmesh(&bp, bm, bv);
-      }
-    }
+  /* Build the meshes around vertices, now that positions are final.
+   * The profiles only depend on each vertex's own boundary so they are calculated in parallel,
+   * creating the geometry is done afterwards in the same order as the vertices. */
+  for (BevVert *bevvert : bevverts) {
+    build_vmesh_alloc(&bp, bevvert);
+  }
+  blender::threading::parallel_for(
+      bevverts.index_range(), 256, [&](const blender::IndexRange range) {
+        for (BevVert *bevvert : bevverts.as_span().slice(range)) {
+          build_vmesh_profiles(&bp, bevvert);
+        }
+      });
+  for (BevVert *bevvert : bevverts) {
+    build_vmesh(&bp, bm, bevvert);
   }
 
   /* Build polygons for edges. */
@@ -13,6 +13,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_alloca.h"
+#include "BLI_array.hh"
 #include "BLI_heap.h"
 #include "BLI_linklist.h"
 #include "BLI_math_geom.h"
@@ -21,6 +22,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_quadric.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines_stack.h"
 
 #include "BKE_customdata.hh"
@@ -66,60 +68,94 @@ ENUM_OPERATORS(CD_UseFlag, CD_DO_LOOP)
 /* BMesh Helper Functions
  * ********************** */
 
+/** Quadric of the plane of \a f. */
+static Quadric bm_decim_face_quadric(const BMFace *f)
+{
+  float center[3];
+  double plane_db[4];
+  Quadric q;
+
+  BM_face_calc_center_median(f, center);
+  copy_v3db_v3fl(plane_db, f->no);
+  plane_db[3] = -dot_v3db_v3fl(plane_db, center);
+
+  BLI_quadric_from_plane(&q, plane_db);
+  return q;
+}
+
 /**
- * \param vquadrics: must be calloc'd
+ * Quadric of the plane perpendicular to the face of the boundary edge \a e.
+ * \return false when the plane can't be calculated.
  */
-static void bm_decim_build_quadrics(BMesh *bm, Quadric *vquadrics)
+static bool bm_decim_boundary_edge_quadric(const BMEdge *e, Quadric *r_q)
 {
-  BMIter iter;
-  BMFace *f;
-  BMEdge *e;
+  float edge_vector[3];
+  float edge_plane[3];
+  double edge_plane_db[4];
+  sub_v3_v3v3(edge_vector, e->v2->co, e->v1->co);
+  const BMFace *f = e->l->f;
 
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-    BMLoop *l_first;
-    BMLoop *l_iter;
+  cross_v3_v3v3(edge_plane, edge_vector, f->no);
+  copy_v3db_v3fl(edge_plane_db, edge_plane);
 
+  if (normalize_v3_db(edge_plane_db) > double(FLT_EPSILON)) {
     float center[3];
-    double plane_db[4];
-    Quadric q;
 
-    BM_face_calc_center_median(f, center);
-    copy_v3db_v3fl(plane_db, f->no);
-    plane_db[3] = -dot_v3db_v3fl(plane_db, center);
+    mid_v3_v3v3(center, e->v1->co, e->v2->co);
+
+    edge_plane_db[3] = -dot_v3db_v3fl(edge_plane_db, center);
+    BLI_quadric_from_plane(r_q, edge_plane_db);
+    BLI_quadric_mul(r_q, BOUNDARY_PRESERVE_WEIGHT);
+    return true;
+  }
+  return false;
+}
+
+/**
+ * \param vquadrics: must be calloc'd
+ *
+ * The plane quadrics are calculated in parallel, then accumulated into the vertices in the
+ * same order as a serial loop over the elements, so the result doesn't depend on threading.
+ */
+static void bm_decim_build_quadrics(BMesh *bm, Quadric *vquadrics)
+{
+  using namespace blender;
+
+  BM_mesh_elem_table_ensure(bm, BM_EDGE | BM_FACE);
 
-    BLI_quadric_from_plane(&q, plane_db);
+  Array<Quadric> face_quadrics(bm->totface);
+  threading::parallel_for(IndexRange(bm->totface), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      face_quadrics[i] = bm_decim_face_quadric(bm->ftable[i]);
+    }
+  });
 
+  for (const int i : IndexRange(bm->totface)) {
+    const BMFace *f = bm->ftable[i];
+    BMLoop *l_first;
+    BMLoop *l_iter;
     l_iter = l_first = BM_FACE_FIRST_LOOP(f);
     do {
-      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(l_iter->v)], &q);
+      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(l_iter->v)], &face_quadrics[i]);
     } while ((l_iter = l_iter->next) != l_first);
   }
 
   /* boundary edges */
-  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
-    if (UNLIKELY(BM_edge_is_boundary(e))) {
-      float edge_vector[3];
-      float edge_plane[3];
-      double edge_plane_db[4];
-      sub_v3_v3v3(edge_vector, e->v2->co, e->v1->co);
-      f = e->l->f;
-
-      cross_v3_v3v3(edge_plane, edge_vector, f->no);
-      copy_v3db_v3fl(edge_plane_db, edge_plane);
-
-      if (normalize_v3_db(edge_plane_db) > double(FLT_EPSILON)) {
-        Quadric q;
-        float center[3];
-
-        mid_v3_v3v3(center, e->v1->co, e->v2->co);
-
-        edge_plane_db[3] = -dot_v3db_v3fl(edge_plane_db, center);
-        BLI_quadric_from_plane(&q, edge_plane_db);
-        BLI_quadric_mul(&q, BOUNDARY_PRESERVE_WEIGHT);
+  Array<Quadric> edge_quadrics(bm->totedge);
+  Array<bool> edge_quadrics_valid(bm->totedge);
+  threading::parallel_for(IndexRange(bm->totedge), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      const BMEdge *e = bm->etable[i];
+      edge_quadrics_valid[i] = UNLIKELY(BM_edge_is_boundary(e)) &&
+                               bm_decim_boundary_edge_quadric(e, &edge_quadrics[i]);
+    }
+  });
 
-        BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(e->v1)], &q);
-        BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(e->v2)], &q);
-      }
+  for (const int i : IndexRange(bm->totedge)) {
+    if (edge_quadrics_valid[i]) {
+      const BMEdge *e = bm->etable[i];
+      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(e->v1)], &edge_quadrics[i]);
+      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(e->v2)], &edge_quadrics[i]);
     }
   }
 }
@@ -227,19 +263,22 @@ static float bm_decim_build_edge_cost_single__topology(BMEdge *e)
 
 #endif /* USE_TOPOLOGY_FALLBACK */
 
-static void bm_decim_build_edge_cost_single(BMEdge *e,
-                                            const Quadric *vquadrics,
-                                            const float *vweights,
-                                            const float vweight_factor,
-                                            Heap *eheap,
-                                            HeapNode **eheap_table)
+/**
+ * Calculate the cost of collapsing \a e.
+ * \return false when the edge shouldn't be collapsed at all.
+ */
+static bool bm_decim_edge_cost_calc(BMEdge *e,
+                                    const Quadric *vquadrics,
+                                    const float *vweights,
+                                    const float vweight_factor,
+                                    float *r_cost)
 {
   float cost;
 
   if (UNLIKELY(vweights && ((vweights[BM_elem_index_get(e->v1)] == 0.0f) ||
                             (vweights[BM_elem_index_get(e->v2)] == 0.0f))))
   {
-    goto clear;
+    return false;
   }
 
   /* Check we can collapse, some edges we better not touch. */
@@ -249,7 +288,7 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* Only collapse triangles. */
-      goto clear;
+      return false;
     }
   }
   else if (BM_edge_is_manifold(e)) {
@@ -258,11 +297,11 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* Only collapse triangles. */
-      goto clear;
+      return false;
     }
   }
   else {
-    goto clear;
+    return false;
   }
   /* End sanity check. */
 
@@ -315,10 +354,23 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
   }
 
-  BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
-  return;
+  *r_cost = cost;
+  return true;
+}
+
+static void bm_decim_build_edge_cost_single(BMEdge *e,
+                                            const Quadric *vquadrics,
+                                            const float *vweights,
+                                            const float vweight_factor,
+                                            Heap *eheap,
+                                            HeapNode **eheap_table)
+{
+  float cost;
+  if (bm_decim_edge_cost_calc(e, vquadrics, vweights, vweight_factor, &cost)) {
+    BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
+    return;
+  }
 
-clear:
   if (eheap_table[BM_elem_index_get(e)]) {
     BLI_heap_remove(eheap, eheap_table[BM_elem_index_get(e)]);
   }
@@ -340,14 +392,24 @@ static void bm_decim_build_edge_cost(BMesh *bm,
                                      Heap *eheap,
                                      HeapNode **eheap_table)
 {
-  BMIter iter;
-  BMEdge *e;
-  uint i;
+  using namespace blender;
+
+  /* Solving the quadrics of every edge is the expensive part, do it in parallel.
+   * Then fill the heap in edge order so the collapse order doesn't depend on threading. */
+  BM_mesh_elem_table_ensure(bm, BM_EDGE);
+  Array<float> costs(bm->totedge);
+  Array<bool> costs_valid(bm->totedge);
+  threading::parallel_for(IndexRange(bm->totedge), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      costs_valid[i] = bm_decim_edge_cost_calc(
+          bm->etable[i], vquadrics, vweights, vweight_factor, &costs[i]);
+    }
+  });
 
-  BM_ITER_MESH_INDEX (e, &iter, bm, BM_EDGES_OF_MESH, i) {
-    /* keep sanity check happy */
-    eheap_table[i] = nullptr;
-    bm_decim_build_edge_cost_single(e, vquadrics, vweights, vweight_factor, eheap, eheap_table);
+  for (const int i : IndexRange(bm->totedge)) {
+    BMEdge *e = bm->etable[i];
+    BLI_assert(BM_elem_index_get(e) == i);
+    eheap_table[i] = costs_valid[i] ? BLI_heap_insert(eheap, costs[i], e) : nullptr;
   }
 }
 
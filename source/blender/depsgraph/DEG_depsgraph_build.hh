@@ -72,6 +72,17 @@ void DEG_graph_relations_update(Depsgraph *graph);
 /** Tag all relations in the database for update. */
 void DEG_relations_tag_update(Main *bmain);
 
+/**
+ * Tag relations for update after a change which only affects the relations of the given ID,
+ * like adding a modifier or a constraint to an object.
+ *
+ * Only graphs which contain the ID are rebuilt: a graph which does not depend on the ID can not
+ * depend on any of its relations either. This only helps when there are several graphs, like
+ * multiple view layers or scenes. A graph which contains the ID is still rebuilt entirely, the
+ * relations of the ID are not updated in place.
+ */
+void DEG_relations_tag_update_for_id(Main *bmain, ID *id);
+
 /* Add Dependencies  ----------------------------- */
 
 /**
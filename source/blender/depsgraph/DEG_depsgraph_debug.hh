@@ -63,3 +63,17 @@ bool DEG_debug_graph_relations_validate(Depsgraph *graph,
 
 /** Perform consistency check on the graph. */
 bool DEG_debug_consistency_check(Depsgraph *graph);
+
+/* ************************************************ */
+/* Evaluation Profiling */
+
+/**
+ * Open the file which receives statistics of every following depsgraph evaluation as CSV: time,
+ * thread and memory change of every evaluated operation, as well as totals per ID and per graph.
+ * Records are only written while #G_DEBUG_DEPSGRAPH_PROFILE is set.
+ *
+ * \return false if the file could not be opened.
+ */
+bool DEG_debug_profile_begin(const char *filepath);
+/** Close the file opened by #DEG_debug_profile_begin. */
+void DEG_debug_profile_end();
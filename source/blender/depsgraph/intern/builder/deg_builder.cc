@@ -18,6 +18,7 @@
 #include "DNA_object_types.h"
 
 #include "BLI_stack.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_action.h"
@@ -181,12 +182,19 @@ void deg_graph_build_finalize(Main *bmain, Depsgraph *graph)
   deg_graph_flush_visibility_flags(graph);
   deg_graph_remove_unused_noops(graph);
 
+  /* Finalizing the build of an ID node only touches its own components, so it is done in parallel
+   * before any of the update tags below are applied. */
+  threading::parallel_for(graph->id_nodes.index_range(), 64, [&](const IndexRange range) {
+    for (const int i : range) {
+      graph->id_nodes[i]->finalize_build(graph);
+    }
+  });
+
   /* Re-tag IDs for update if it was tagged before the relations
    * update tag. */
   for (IDNode *id_node : graph->id_nodes) {
     const ID_Type id_type = id_node->id_type;
     ID *id_orig = id_node->id_orig;
-    id_node->finalize_build(graph);
     int flag = 0;
     /* Tag rebuild if special evaluation flags changed. */
     if (id_node->eval_flags != id_node->previous_eval_flags) {
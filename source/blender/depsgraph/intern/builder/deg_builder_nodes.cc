@@ -15,9 +15,11 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_span.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_action_types.h"
@@ -426,22 +428,17 @@ void DepsgraphNodeBuilder::begin_build()
  * properly remapped.
  *
  * NOTE: This is split in two, a static function and a public method of the node builder, to allow
- * the code to access the builder's data more easily. */
+ * the code to access the builder's data more easily. The check only reads the graph, the actual
+ * tagging is done by the caller. */
 
-int DepsgraphNodeBuilder::foreach_id_cow_detect_need_for_update_callback(ID *id_cow_self,
-                                                                         ID *id_pointer)
+bool DepsgraphNodeBuilder::foreach_id_cow_detect_need_for_update_callback(ID *id_pointer)
 {
   if (id_pointer->orig_id == nullptr) {
     /* `id_cow_self` uses a non-cow ID, if that ID has an evaluated copy in current depsgraph its
      * owner needs to be remapped, i.e. copy-on-eval-flushed. */
     IDNode *id_node = find_id_node(id_pointer);
     if (id_node != nullptr && id_node->id_cow != nullptr) {
-      graph_id_tag_update(bmain_,
-                          graph_,
-                          id_cow_self->orig_id,
-                          ID_RECALC_SYNC_TO_EVAL,
-                          DEG_UPDATE_SOURCE_RELATIONS);
-      return IDWALK_RET_STOP_ITER;
+      return true;
     }
   }
   else {
@@ -452,17 +449,17 @@ int DepsgraphNodeBuilder::foreach_id_cow_detect_need_for_update_callback(ID *id_
      * destruction of the builder itself). */
     IDNode *id_node = find_id_node(id_pointer->orig_id);
     if (id_node == nullptr) {
-      graph_id_tag_update(bmain_,
-                          graph_,
-                          id_cow_self->orig_id,
-                          ID_RECALC_SYNC_TO_EVAL,
-                          DEG_UPDATE_SOURCE_RELATIONS);
-      return IDWALK_RET_STOP_ITER;
+      return true;
     }
   }
-  return IDWALK_RET_NOP;
+  return false;
 }
 
+struct CowDetectNeedForUpdateData {
+  DepsgraphNodeBuilder *builder;
+  bool need_update;
+};
+
 static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackData *cb_data)
 {
   ID *id = *cb_data->id_pointer;
@@ -475,10 +472,13 @@ static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackD
     return IDWALK_RET_NOP;
   }
 
-  DepsgraphNodeBuilder *builder = static_cast<DepsgraphNodeBuilder *>(cb_data->user_data);
-  ID *id_cow_self = cb_data->self_id;
-
-  return builder->foreach_id_cow_detect_need_for_update_callback(id_cow_self, id);
+  CowDetectNeedForUpdateData *data = static_cast<CowDetectNeedForUpdateData *>(
+      cb_data->user_data);
+  if (data->builder->foreach_id_cow_detect_need_for_update_callback(id)) {
+    data->need_update = true;
+    return IDWALK_RET_STOP_ITER;
+  }
+  return IDWALK_RET_NOP;
 }
 
 void DepsgraphNodeBuilder::update_invalid_cow_pointers()
@@ -491,46 +491,73 @@ void DepsgraphNodeBuilder::update_invalid_cow_pointers()
    *
    * NOTE: This mechanism may also 'fix' some missing update tagging from non-depsgraph code in
    * some cases. This is slightly unfortunate (as it may hide issues in other parts of Blender
-   * code), but cannot really be avoided currently. */
-
-  for (const IDNode *id_node : graph_->id_nodes) {
-    if (id_node->previously_visible_components_mask == 0) {
-      /* Newly added node/ID, no need to check it. */
-      continue;
+   * code), but cannot really be avoided currently.
+   *
+   * Looking up the ID pointers of every evaluated ID only reads the graph, so it is done in
+   * parallel. The update tags are then applied in the order of the ID nodes. */
+
+  const Span<IDNode *> id_nodes = graph_->id_nodes;
+  Array<bool> need_update(id_nodes.size(), false);
+  threading::parallel_for(id_nodes.index_range(), 32, [&](const IndexRange range) {
+    for (const int i : range) {
+      need_update[i] = id_cow_pointers_need_update(id_nodes[i]);
     }
-    if (ELEM(id_node->id_cow, id_node->id_orig, nullptr)) {
-      /* Node/ID with no copy-on-eval data, no need to check it. */
+  });
+
+  for (const int i : id_nodes.index_range()) {
+    if (!need_update[i]) {
       continue;
     }
+    const IDNode *id_node = id_nodes[i];
     if ((id_node->id_cow->recalc & ID_RECALC_SYNC_TO_EVAL) != 0) {
-      /* Node/ID already tagged for copy-on-eval flush, no need to check it. */
-      continue;
-    }
-    if ((id_node->id_cow->flag & LIB_EMBEDDED_DATA) != 0) {
-      /* For now, we assume embedded data are managed by their owner IDs and do not need to be
-       * checked here.
-       *
-       * NOTE: This exception somewhat weak, and ideally should not be needed. Currently however,
-       * embedded data are handled as full local (private) data of their owner IDs in part of
-       * Blender (like read/write code, including undo/redo), while depsgraph generally treat them
-       * as regular independent IDs. This leads to inconsistencies that can lead to bad level
-       * memory accesses.
-       *
-       * E.g. when undoing creation/deletion of a collection directly child of a scene's master
-       * collection, the scene itself is re-read in place, but its master collection becomes a
-       * completely new different pointer, and the existing copy-on-eval of the old master
-       * collection in the matching deg node is therefore pointing to fully invalid (freed) memory.
-       */
+      /* Already tagged as a side effect of tagging a previous node. */
       continue;
     }
-    BKE_library_foreach_ID_link(nullptr,
-                                id_node->id_cow,
-                                deg::foreach_id_cow_detect_need_for_update_callback,
-                                this,
-                                IDWALK_IGNORE_EMBEDDED_ID | IDWALK_READONLY);
+    graph_id_tag_update(
+        bmain_, graph_, id_node->id_orig, ID_RECALC_SYNC_TO_EVAL, DEG_UPDATE_SOURCE_RELATIONS);
   }
 }
 
+bool DepsgraphNodeBuilder::id_cow_pointers_need_update(const IDNode *id_node)
+{
+  if (id_node->previously_visible_components_mask == 0) {
+    /* Newly added node/ID, no need to check it. */
+    return false;
+  }
+  if (ELEM(id_node->id_cow, id_node->id_orig, nullptr)) {
+    /* Node/ID with no copy-on-eval data, no need to check it. */
+    return false;
+  }
+  if ((id_node->id_cow->recalc & ID_RECALC_SYNC_TO_EVAL) != 0) {
+    /* Node/ID already tagged for copy-on-eval flush, no need to check it. */
+    return false;
+  }
+  if ((id_node->id_cow->flag & LIB_EMBEDDED_DATA) != 0) {
+    /* For now, we assume embedded data are managed by their owner IDs and do not need to be
+     * checked here.
+     *
+     * NOTE: This exception somewhat weak, and ideally should not be needed. Currently however,
+     * embedded data are handled as full local (private) data of their owner IDs in part of
+     * Blender (like read/write code, including undo/redo), while depsgraph generally treat them
+     * as regular independent IDs. This leads to inconsistencies that can lead to bad level
+     * memory accesses.
+     *
+     * E.g. when undoing creation/deletion of a collection directly child of a scene's master
+     * collection, the scene itself is re-read in place, but its master collection becomes a
+     * completely new different pointer, and the existing copy-on-eval of the old master
+     * collection in the matching deg node is therefore pointing to fully invalid (freed) memory.
+     */
+    return false;
+  }
+  CowDetectNeedForUpdateData data = {this, false};
+  BKE_library_foreach_ID_link(nullptr,
+                              id_node->id_cow,
+                              deg::foreach_id_cow_detect_need_for_update_callback,
+                              &data,
+                              IDWALK_IGNORE_EMBEDDED_ID | IDWALK_READONLY);
+  return data.need_update;
+}
+
 void DepsgraphNodeBuilder::tag_previously_tagged_nodes()
 {
   for (const OperationKey &operation_key : saved_entry_tags_) {
@@ -90,10 +90,10 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void end_build();
 
   /**
-   * `id_cow_self` is the user of `id_pointer`,
+   * Whether the evaluated ID using `id_pointer` needs to be copy-on-eval-flushed to remap it,
    * see also `LibraryIDLinkCallbackData` struct definition.
    */
-  int foreach_id_cow_detect_need_for_update_callback(ID *id_cow_self, ID *id_pointer);
+  bool foreach_id_cow_detect_need_for_update_callback(ID *id_pointer);
 
   IDNode *add_id_node(ID *id);
   IDNode *find_id_node(const ID *id);
@@ -316,6 +316,7 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
    * because the depsgraph itself created or removed some of their evaluated dependencies.
    */
   void update_invalid_cow_pointers();
+  bool id_cow_pointers_need_update(const IDNode *id_node);
 
   /* State which demotes currently built entities. */
   Scene *scene_;
@@ -18,6 +18,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_action_types.h"
@@ -3458,8 +3459,17 @@ void DepsgraphRelationBuilder::build_vfont(VFont *vfont)
 
 void DepsgraphRelationBuilder::build_copy_on_write_relations()
 {
-  for (IDNode *id_node : graph_->id_nodes) {
-    build_copy_on_write_relations(id_node);
+  /* Relations from the copy-on-eval operation to the other operations of an ID only touch the
+   * nodes of that ID, so IDs are handled in parallel. Relations between different IDs are added
+   * afterwards from a single thread. */
+  const Span<IDNode *> id_nodes = graph_->id_nodes;
+  threading::parallel_for(id_nodes.index_range(), 32, [&](const IndexRange range) {
+    for (const int i : range) {
+      build_copy_on_write_relations(id_nodes[i]);
+    }
+  });
+  for (IDNode *id_node : id_nodes) {
+    build_object_data_copy_on_write_relation(id_node);
   }
 }
 
@@ -3601,23 +3611,6 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
      * evaluation step needs geometry, it will have transitive dependency
      * to Mesh copy-on-evaluation already. */
   }
-  /* TODO(sergey): This solves crash for now, but causes too many
-   * updates potentially. */
-  if (GS(id_orig->name) == ID_OB) {
-    Object *object = (Object *)id_orig;
-    ID *object_data_id = (ID *)object->data;
-    if (object_data_id != nullptr) {
-      if (deg_eval_copy_is_needed(object_data_id)) {
-        OperationKey data_copy_on_write_key(
-            object_data_id, NodeType::COPY_ON_EVAL, OperationCode::COPY_ON_EVAL);
-        add_relation(
-            data_copy_on_write_key, copy_on_write_key, "Eval Order", RELATION_FLAG_GODMODE);
-      }
-    }
-    else {
-      BLI_assert(object->type == OB_EMPTY);
-    }
-  }
 
 #if 0
   /* NOTE: Relation is disabled since AnimationBackup() is disabled.
@@ -3640,6 +3633,29 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
 #endif
 }
 
+void DepsgraphRelationBuilder::build_object_data_copy_on_write_relation(IDNode *id_node)
+{
+  ID *id_orig = id_node->id_orig;
+  /* TODO(sergey): This solves crash for now, but causes too many
+   * updates potentially. */
+  if (GS(id_orig->name) == ID_OB) {
+    OperationKey copy_on_write_key(id_orig, NodeType::COPY_ON_EVAL, OperationCode::COPY_ON_EVAL);
+    Object *object = (Object *)id_orig;
+    ID *object_data_id = (ID *)object->data;
+    if (object_data_id != nullptr) {
+      if (deg_eval_copy_is_needed(object_data_id)) {
+        OperationKey data_copy_on_write_key(
+            object_data_id, NodeType::COPY_ON_EVAL, OperationCode::COPY_ON_EVAL);
+        add_relation(
+            data_copy_on_write_key, copy_on_write_key, "Eval Order", RELATION_FLAG_GODMODE);
+      }
+    }
+    else {
+      BLI_assert(object->type == OB_EMPTY);
+    }
+  }
+}
+
 /* **** ID traversal callbacks functions **** */
 
 void DepsgraphRelationBuilder::modifier_walk(void *user_data,
@@ -92,6 +92,9 @@ void AbstractBuilderPipeline::build_step_finalize()
 #endif
   /* Relations are up to date. */
   deg_graph_->need_update_relations = false;
+  deg_graph_->need_validate_relations = false;
+  /* Operations are new, their timings have to be sampled again. */
+  deg_graph_->need_update_critical_path = true;
 }
 
 unique_ptr<DepsgraphNodeBuilder> AbstractBuilderPipeline::construct_node_builder()
@@ -27,6 +27,11 @@ bool DepsgraphDebug::do_time_debug() const
   return ((G.debug & G_DEBUG_DEPSGRAPH_TIME) != 0);
 }
 
+bool DepsgraphDebug::do_profile() const
+{
+  return ((G.debug & G_DEBUG_DEPSGRAPH_PROFILE) != 0);
+}
+
 void DepsgraphDebug::begin_graph_evaluation()
 {
   if (!do_time_debug()) {
@@ -16,11 +16,14 @@
 
 namespace blender::deg {
 
+struct Depsgraph;
+
 class DepsgraphDebug {
  public:
   DepsgraphDebug();
 
   bool do_time_debug() const;
+  bool do_profile() const;
 
   void begin_graph_evaluation();
   void end_graph_evaluation();
@@ -63,6 +66,12 @@ class DepsgraphDebug {
     fflush(stderr); \
   } while (0)
 
+/**
+ * Append the statistics of the last evaluation of the graph to the file opened by
+ * #DEG_debug_profile_begin.
+ */
+void deg_debug_profile_write(const Depsgraph *graph, double evaluation_time, int64_t memory_delta);
+
 bool terminal_do_color(void);
 string color_for_pointer(const void *pointer);
 string color_end(void);
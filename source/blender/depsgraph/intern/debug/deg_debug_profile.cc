@@ -0,0 +1,191 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Per-evaluation statistics written as CSV, so that they can be gathered from command line
+ * renders and aggregated across many of them. Every row is one of these records:
+ *
+ * - `operation`: an evaluated operation, with the thread it was evaluated on.
+ * - `id`: the sum of all evaluated operations of an ID.
+ * - `graph`: the whole evaluation of a dependency graph, using wall-clock time.
+ *
+ * Times are in seconds, memory is the change of allocated bytes in guarded allocator.
+ *
+ * NOTE: Memory is measured for the whole process, so with threaded evaluation allocations of
+ * operations running at the same time are mixed. Use `--debug-depsgraph-no-threads` to get exact
+ * numbers per operation and ID.
+ */
+
+#include "intern/debug/deg_debug.h"
+
+#include <cstdio>
+#include <mutex>
+
+#include "BLI_fileops.h"
+#include "BLI_map.hh"
+
+#include "BKE_blender.hh"
+
+#include "DNA_layer_types.h"
+
+#include "intern/depsgraph.hh"
+#include "intern/node/deg_node_component.hh"
+#include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
+
+namespace blender::deg {
+namespace {
+
+std::mutex profile_mutex;
+FILE *profile_file = nullptr;
+bool profile_atexit_registered = false;
+
+struct IDProfile {
+  double time = 0.0;
+  double copy_on_eval_time = 0.0;
+  int64_t memory = 0;
+};
+
+/* Write string as a quoted CSV field. */
+void profile_write_string(FILE *file, const char *str)
+{
+  fputc('"', file);
+  for (const char *c = str; *c; c++) {
+    if (*c == '"') {
+      fputc('"', file);
+    }
+    fputc(*c, file);
+  }
+  fputc('"', file);
+}
+
+void profile_write_record_begin(FILE *file,
+                                const char *record,
+                                const float frame,
+                                const char *name)
+{
+  fprintf(file, "%s,%g,", record, frame);
+  profile_write_string(file, name);
+  fputc(',', file);
+}
+
+void profile_atexit(void * /*user_data*/)
+{
+  DEG_debug_profile_end();
+}
+
+}  // namespace
+
+void deg_debug_profile_write(const Depsgraph *graph,
+                             const double evaluation_time,
+                             const int64_t memory_delta)
+{
+  std::lock_guard lock(profile_mutex);
+  if (profile_file == nullptr) {
+    return;
+  }
+  FILE *file = profile_file;
+
+  const char *graph_name = graph->debug.name.c_str();
+  if (graph->debug.name.empty() && graph->view_layer != nullptr) {
+    graph_name = graph->view_layer->name;
+  }
+
+  Map<const IDNode *, IDProfile> id_profiles;
+  double copy_on_eval_time = 0.0;
+  for (const OperationNode *op_node : graph->operations) {
+    if (op_node->stats.current_thread == -1) {
+      continue;
+    }
+    const ComponentNode *comp_node = op_node->owner;
+    const IDNode *id_node = comp_node->owner;
+    const bool is_copy_on_eval = comp_node->type == NodeType::COPY_ON_EVAL;
+    const double time = op_node->stats.current_time;
+
+    IDProfile &id_profile = id_profiles.lookup_or_add_default(id_node);
+    id_profile.time += time;
+    id_profile.memory += op_node->stats.current_memory;
+    if (is_copy_on_eval) {
+      id_profile.copy_on_eval_time += time;
+      copy_on_eval_time += time;
+    }
+
+    string component_name = nodeTypeAsString(comp_node->type);
+    if (!comp_node->name.empty()) {
+      component_name += "/" + comp_node->name;
+    }
+    profile_write_record_begin(file, "operation", graph->ctime, graph_name);
+    profile_write_string(file, id_node->name.c_str());
+    fputc(',', file);
+    profile_write_string(file, component_name.c_str());
+    fputc(',', file);
+    profile_write_string(file, op_node->identifier().c_str());
+    fprintf(file,
+            ",%d,%f,%f,%lld\n",
+            op_node->stats.current_thread,
+            time,
+            is_copy_on_eval ? time : 0.0,
+            (long long)op_node->stats.current_memory);
+  }
+
+  /* Write IDs in the order of the graph rather than the hash order. */
+  for (const IDNode *id_node : graph->id_nodes) {
+    const IDProfile *id_profile = id_profiles.lookup_ptr(id_node);
+    if (id_profile == nullptr) {
+      continue;
+    }
+    profile_write_record_begin(file, "id", graph->ctime, graph_name);
+    profile_write_string(file, id_node->name.c_str());
+    fprintf(file,
+            ",,,,%f,%f,%lld\n",
+            id_profile->time,
+            id_profile->copy_on_eval_time,
+            (long long)id_profile->memory);
+  }
+
+  profile_write_record_begin(file, "graph", graph->ctime, graph_name);
+  fprintf(file,
+          ",,,,%f,%f,%lld\n",
+          evaluation_time,
+          copy_on_eval_time,
+          (long long)memory_delta);
+
+  /* Keep the file usable when the process gets killed, as happens to stuck farm jobs. */
+  fflush(file);
+}
+
+}  // namespace blender::deg
+
+namespace deg = blender::deg;
+
+bool DEG_debug_profile_begin(const char *filepath)
+{
+  std::lock_guard lock(deg::profile_mutex);
+  if (deg::profile_file != nullptr) {
+    fclose(deg::profile_file);
+  }
+  if (!deg::profile_atexit_registered) {
+    BKE_blender_atexit_register(deg::profile_atexit, nullptr);
+    deg::profile_atexit_registered = true;
+  }
+  deg::profile_file = BLI_fopen(filepath, "w");
+  if (deg::profile_file == nullptr) {
+    return false;
+  }
+  fprintf(deg::profile_file,
+          "record,frame,depsgraph,id,component,operation,thread,time,copy_on_eval_time,memory\n");
+  return true;
+}
+
+void DEG_debug_profile_end()
+{
+  std::lock_guard lock(deg::profile_mutex);
+  if (deg::profile_file == nullptr) {
+    return;
+  }
+  fclose(deg::profile_file);
+  deg::profile_file = nullptr;
+}
@@ -98,6 +98,11 @@ struct Depsgraph {
   /* Indicates whether relations needs to be updated. */
   bool need_update_relations;
 
+  /* Relations update was skipped because the changed ID is not in this graph, see
+   * #DEG_relations_tag_update_for_id(). Used to validate this against a full rebuild when
+   * #G_DEBUG_DEPSGRAPH_VALIDATE is enabled. */
+  bool need_validate_relations;
+
   /* Indicates whether indirect effect of nodes on a directly visible ones needs to be updated. */
   bool need_update_nodes_visibility;
 
@@ -176,6 +181,10 @@ struct Depsgraph {
   /* The number of times this graph has been evaluated. */
   uint64_t update_count;
 
+  /* The critical path time of operations is outdated, because relations were rebuilt or new
+   * operation timings were sampled. See #deg_eval_stats_update_critical_path(). */
+  bool need_update_critical_path;
+
   /**
    * Stores functions that can be called after depsgraph evaluation to writeback some changes to
    * original data. Also see `DEG_depsgraph_writeback_sync.hh`.
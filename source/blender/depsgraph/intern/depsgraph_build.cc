@@ -309,6 +309,11 @@ void DEG_graph_relations_update(Depsgraph *graph)
   deg::Depsgraph *deg_graph = (deg::Depsgraph *)graph;
   if (!deg_graph->need_update_relations) {
     /* Graph is up to date, nothing to do. */
+    if (deg_graph->need_validate_relations) {
+      deg_graph->need_validate_relations = false;
+      DEG_debug_graph_relations_validate(
+          graph, deg_graph->bmain, deg_graph->scene, deg_graph->view_layer);
+    }
     return;
   }
   DEG_graph_build_from_view_layer(graph);
@@ -321,3 +326,21 @@ void DEG_relations_tag_update(Main *bmain)
     DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
   }
 }
+
+void DEG_relations_tag_update_for_id(Main *bmain, ID *id)
+{
+  DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations of %s for update.\n", __func__, id->name);
+  for (deg::Depsgraph *depsgraph : deg::get_all_registered_graphs(bmain)) {
+    if (depsgraph->need_update_relations) {
+      continue;
+    }
+    if (depsgraph->find_id_node(id) == nullptr) {
+      /* Nothing in the graph depends on the ID, so its relations can't affect the graph. */
+      if (G.debug & G_DEBUG_DEPSGRAPH_VALIDATE) {
+        depsgraph->need_validate_relations = true;
+      }
+      continue;
+    }
+    DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
+  }
+}
@@ -8,7 +8,10 @@
  * Implementation of tools for debugging the depsgraph
  */
 
+#include <algorithm>
+
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "DNA_scene_types.h"
 
@@ -25,10 +28,34 @@
 #include "intern/depsgraph_type.hh"
 #include "intern/node/deg_node_component.hh"
 #include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
 #include "intern/node/deg_node_time.hh"
 
 namespace deg = blender::deg;
 
+static std::string deg_debug_node_full_identifier(const deg::Node *node)
+{
+  if (node->get_class() == deg::NodeClass::OPERATION) {
+    return static_cast<const deg::OperationNode *>(node)->full_identifier();
+  }
+  return node->identifier();
+}
+
+/** Sorted identifiers of all relations in the graph, which don't depend on pointers. */
+static blender::Vector<std::string> deg_debug_relation_identifiers(const deg::Depsgraph *graph)
+{
+  blender::Vector<std::string> identifiers;
+  for (const deg::OperationNode *node : graph->operations) {
+    const std::string to = node->full_identifier();
+    for (const deg::Relation *rel : node->inlinks) {
+      identifiers.append(deg_debug_node_full_identifier(rel->from) + " -> " + to + " (" +
+                         rel->name + ")");
+    }
+  }
+  std::sort(identifiers.begin(), identifiers.end());
+  return identifiers;
+}
+
 void DEG_debug_flags_set(Depsgraph *depsgraph, int flags)
 {
   deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(depsgraph);
@@ -59,15 +86,32 @@ bool DEG_debug_compare(const Depsgraph *graph1, const Depsgraph *graph2)
   BLI_assert(graph2 != nullptr);
   const deg::Depsgraph *deg_graph1 = reinterpret_cast<const deg::Depsgraph *>(graph1);
   const deg::Depsgraph *deg_graph2 = reinterpret_cast<const deg::Depsgraph *>(graph2);
+  if (deg_graph1->id_nodes.size() != deg_graph2->id_nodes.size()) {
+    return false;
+  }
   if (deg_graph1->operations.size() != deg_graph2->operations.size()) {
     return false;
   }
-  /* TODO(sergey): Currently we only do real stupid check,
-   * which is fast but which isn't 100% reliable.
-   *
-   * Would be cool to make it more robust, but it's good enough
-   * for now. Also, proper graph check is actually NP-complex
-   * problem. */
+  /* Compare relations by the names of the nodes they connect. This doesn't detect every possible
+   * difference (names of operations are not unique), but a proper graph isomorphism check is an
+   * NP-complete problem. */
+  const blender::Vector<std::string> relations1 = deg_debug_relation_identifiers(deg_graph1);
+  const blender::Vector<std::string> relations2 = deg_debug_relation_identifiers(deg_graph2);
+  if (relations1 != relations2) {
+    if (G.debug & G_DEBUG_DEPSGRAPH_VALIDATE) {
+      for (const std::string &relation : relations1) {
+        if (!std::binary_search(relations2.begin(), relations2.end(), relation)) {
+          fprintf(stderr, "Relation only in first graph: %s\n", relation.c_str());
+        }
+      }
+      for (const std::string &relation : relations2) {
+        if (!std::binary_search(relations1.begin(), relations1.end(), relation)) {
+          fprintf(stderr, "Relation only in second graph: %s\n", relation.c_str());
+        }
+      }
+    }
+    return false;
+  }
   return true;
 }
 
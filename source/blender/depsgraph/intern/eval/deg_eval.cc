@@ -10,6 +10,10 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <utility>
+
+#include "MEM_guardedalloc.h"
+
 #include "BLI_compiler_attrs.h"
 #include "BLI_function_ref.hh"
 #include "BLI_gsqueue.h"
@@ -32,6 +36,7 @@
 
 #include "atomic_ops.h"
 
+#include "intern/debug/deg_debug.h"
 #include "intern/depsgraph.hh"
 #include "intern/depsgraph_relation.hh"
 #include "intern/depsgraph_tag.hh"
@@ -77,9 +82,16 @@ enum class EvaluationStage {
   SINGLE_THREADED_WORKAROUND,
 };
 
+/* Operation timings used to estimate the critical path are only sampled every this many
+ * evaluations, so that most updates don't pay for the timer. */
+constexpr uint64_t CRITICAL_PATH_SAMPLE_INTERVAL = 16;
+
 struct DepsgraphEvalState {
   Depsgraph *graph;
   bool do_stats;
+  bool do_profile;
+  /* Measure the time of every operation to update its average time. */
+  bool do_sample_timing;
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
@@ -92,10 +104,21 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
   /* Perform operation. */
-  if (state->do_stats) {
+  if (state->do_sample_timing) {
+    const size_t start_memory = state->do_profile ? MEM_get_memory_in_use() : 0;
     const double start_time = BLI_time_now_seconds();
     operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += BLI_time_now_seconds() - start_time;
+    const double evaluation_time = BLI_time_now_seconds() - start_time;
+    /* Used to estimate the critical path of the following evaluations. */
+    operation_node->stats.update_average_time(evaluation_time);
+    if (state->do_stats) {
+      operation_node->stats.current_time += evaluation_time;
+    }
+    if (state->do_profile) {
+      operation_node->stats.current_thread = BLI_task_parallel_thread_id(nullptr);
+      operation_node->stats.current_memory += int64_t(MEM_get_memory_in_use()) -
+                                              int64_t(start_memory);
+    }
   }
   else {
     operation_node->evaluate(depsgraph);
@@ -113,14 +136,28 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, [&](OperationNode *node) {
-    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
-  });
+  while (operation_node != nullptr) {
+    /* Evaluate node. */
+    evaluate_node(state, operation_node);
+
+    /* Schedule children. The one with the longest critical path is evaluated next by this task,
+     * which keeps the longest chain of operations going without any synchronization. The others
+     * are pushed to the pool for other threads to pick up. */
+    OperationNode *next_operation_node = nullptr;
+    schedule_children(state, operation_node, [&](OperationNode *node) {
+      if (next_operation_node == nullptr) {
+        next_operation_node = node;
+        return;
+      }
+      if (node->critical_path_time > next_operation_node->critical_path_time) {
+        std::swap(node, next_operation_node);
+      }
+      BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+    });
+    operation_node = next_operation_node;
+  }
 }
 
 bool check_operation_node_visible(const DepsgraphEvalState *state, OperationNode *op_node)
@@ -390,6 +427,10 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
 
   graph->debug.begin_graph_evaluation();
 
+  const bool do_profile = graph->debug.do_profile();
+  const size_t profile_start_memory = do_profile ? MEM_get_memory_in_use() : 0;
+  const double profile_start_time = do_profile ? BLI_time_now_seconds() : 0.0;
+
 #ifdef WITH_PYTHON
   /* Release the GIL so that Python drivers can be evaluated. See #91046. */
   BPy_BEGIN_ALLOW_THREADS;
@@ -401,10 +442,18 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   /* Set up evaluation state. */
   DepsgraphEvalState state;
   state.graph = graph;
-  state.do_stats = graph->debug.do_time_debug();
+  state.do_profile = do_profile;
+  state.do_stats = graph->debug.do_time_debug() || do_profile;
+  /* Sample timings right after relations were rebuilt, and then only every few evaluations. */
+  state.do_sample_timing = state.do_stats || graph->need_update_critical_path ||
+                           (graph->update_count % CRITICAL_PATH_SAMPLE_INTERVAL) == 0;
 
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
+  if (graph->need_update_critical_path) {
+    deg_eval_stats_update_critical_path(graph->operations);
+    graph->need_update_critical_path = false;
+  }
 
   /* Evaluation happens in several incremental steps:
    *
@@ -456,6 +505,9 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  if (state.do_sample_timing) {
+    graph->need_update_critical_path = true;
+  }
 
   /* Clear any uncleared tags. */
   deg_graph_clear_tags(graph);
@@ -466,6 +518,12 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
 #endif
 
   graph->debug.end_graph_evaluation();
+
+  if (do_profile) {
+    deg_debug_profile_write(graph,
+                            BLI_time_now_seconds() - profile_start_time,
+                            int64_t(MEM_get_memory_in_use()) - int64_t(profile_start_memory));
+  }
 }
 
 }  // namespace blender::deg
@@ -8,9 +8,12 @@
 
 #include "intern/eval/deg_eval_stats.h"
 
+#include "BLI_math_base.h"
+#include "BLI_stack.h"
 #include "BLI_utildefines.h"
 
 #include "intern/depsgraph.hh"
+#include "intern/depsgraph_relation.hh"
 
 #include "intern/node/deg_node.hh"
 #include "intern/node/deg_node_component.hh"
@@ -39,4 +42,56 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+static bool is_operation_relation(const Relation *rel)
+{
+  return rel->from->type == NodeType::OPERATION && rel->to->type == NodeType::OPERATION &&
+         (rel->flag & RELATION_FLAG_CYCLIC) == 0;
+}
+
+void deg_eval_stats_update_critical_path(Span<OperationNode *> operations)
+{
+  /* Traverse the operations in reverse topological order, so that the critical path time of all
+   * children is known by the time the parent is handled.
+   *
+   * NOTE: The pending links counter is used for the traversal, it is re-calculated prior to the
+   * evaluation. */
+  BLI_Stack *stack = BLI_stack_new(sizeof(OperationNode *), "DEG critical path stack");
+
+  for (OperationNode *op_node : operations) {
+    op_node->critical_path_time = 0.0;
+    op_node->num_links_pending = 0;
+    for (Relation *rel : op_node->outlinks) {
+      if (is_operation_relation(rel)) {
+        ++op_node->num_links_pending;
+      }
+    }
+    if (op_node->num_links_pending == 0) {
+      BLI_stack_push(stack, &op_node);
+    }
+  }
+
+  while (!BLI_stack_is_empty(stack)) {
+    OperationNode *op_node;
+    BLI_stack_pop(stack, &op_node);
+
+    /* All children are handled, so the maximum of their times is final. */
+    op_node->critical_path_time += op_node->stats.average_time;
+
+    for (Relation *rel : op_node->inlinks) {
+      if (!is_operation_relation(rel)) {
+        continue;
+      }
+      OperationNode *op_from = reinterpret_cast<OperationNode *>(rel->from);
+      op_from->critical_path_time = max_dd(op_from->critical_path_time,
+                                           op_node->critical_path_time);
+      BLI_assert(op_from->num_links_pending > 0);
+      if (--op_from->num_links_pending == 0) {
+        BLI_stack_push(stack, &op_from);
+      }
+    }
+  }
+
+  BLI_stack_free(stack);
+}
+
 }  // namespace blender::deg
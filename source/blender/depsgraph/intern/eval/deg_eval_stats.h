@@ -8,11 +8,19 @@
 
 #pragma once
 
+#include "BLI_span.hh"
+
 namespace blender::deg {
 
 struct Depsgraph;
+struct OperationNode;
 
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Estimate critical path time of the operations, based on the sampled average timing of their
+ * previous evaluations. This doesn't depend on which operations are tagged for update, so it only
+ * needs to be done when relations or timings change. */
+void deg_eval_stats_update_critical_path(Span<OperationNode *> operations);
+
 }  // namespace blender::deg
@@ -0,0 +1,70 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/eval/deg_eval_stats.h"
+
+#include <memory>
+
+#include "BLI_vector.hh"
+
+#include "intern/depsgraph_relation.hh"
+#include "intern/node/deg_node_operation.hh"
+
+#include "testing/testing.h"
+
+namespace blender::deg::tests {
+
+static OperationNode *operation_add(Vector<std::unique_ptr<OperationNode>> &nodes,
+                                    const double average_time)
+{
+  nodes.append(std::make_unique<OperationNode>());
+  OperationNode *node = nodes.last().get();
+  node->type = NodeType::OPERATION;
+  node->flag = DEPSOP_FLAG_NEEDS_UPDATE;
+  node->stats.reset();
+  node->stats.update_average_time(average_time);
+  return node;
+}
+
+TEST(deg_eval_stats, critical_path)
+{
+  /* A cheap root with a cheap leaf and an expensive chain depending on it:
+   *
+   *   root -> leaf
+   *   root -> chain_a -> chain_b
+   *   chain_b -> root (cyclic)
+   *
+   * The critical path doesn't depend on the update tags, so it stays valid between evaluations.
+   * Cyclic relations are ignored. */
+  Vector<std::unique_ptr<OperationNode>> nodes;
+  OperationNode *root = operation_add(nodes, 1.0);
+  OperationNode *leaf = operation_add(nodes, 2.0);
+  OperationNode *chain_a = operation_add(nodes, 1.5);
+  OperationNode *chain_b = operation_add(nodes, 1.5);
+  chain_a->flag = 0;
+  new Relation(root, leaf, "test");
+  new Relation(root, chain_a, "test");
+  new Relation(chain_a, chain_b, "test");
+  Relation *cyclic = new Relation(chain_b, root, "test");
+  cyclic->flag |= RELATION_FLAG_CYCLIC;
+
+  const Vector<OperationNode *> operations = {root, leaf, chain_a, chain_b};
+  deg_eval_stats_update_critical_path(operations);
+  EXPECT_DOUBLE_EQ(root->critical_path_time, 4.0);
+  EXPECT_DOUBLE_EQ(leaf->critical_path_time, 2.0);
+  EXPECT_DOUBLE_EQ(chain_a->critical_path_time, 3.0);
+  EXPECT_DOUBLE_EQ(chain_b->critical_path_time, 1.5);
+
+  /* The average time follows new samples, and the critical path is updated accordingly. */
+  leaf->stats.update_average_time(6.0);
+  deg_eval_stats_update_critical_path(operations);
+  EXPECT_DOUBLE_EQ(leaf->critical_path_time, 3.0);
+  EXPECT_DOUBLE_EQ(root->critical_path_time, 4.0);
+}
+
+}  // namespace blender::deg::tests
@@ -273,12 +273,22 @@ Node::Stats::Stats()
 
 void Node::Stats::reset()
 {
-  current_time = 0.0;
+  reset_current();
+  average_time = 0.0;
 }
 
 void Node::Stats::reset_current()
 {
   current_time = 0.0;
+  current_thread = -1;
+  current_memory = 0;
+}
+
+void Node::Stats::update_average_time(const double time)
+{
+  /* Exponential moving average, so that the estimate follows changes in the scene (for example
+   * a modifier being enabled) within a few evaluations. */
+  average_time = (average_time == 0.0) ? time : (average_time * 0.75 + time * 0.25);
 }
 
 /*******************************************************************************
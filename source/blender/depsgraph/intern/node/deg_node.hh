@@ -166,8 +166,18 @@ struct Node {
     /* Reset counters needed for the current graph evaluation, does not
      * touch averaging accumulators. */
     void reset_current();
+    /* Fold the time of an evaluation into the running average. */
+    void update_average_time(double time);
     /* Time spent on this node during current graph evaluation. */
     double current_time;
+    /* Running average of the time spent on this node in previous sampled evaluations. */
+    double average_time;
+    /* Thread which evaluated this node during current graph evaluation, -1 when the node was not
+     * evaluated. Only gathered when profiling. */
+    int current_thread;
+    /* Change of allocated memory while evaluating this node during current graph evaluation.
+     * Only gathered when profiling. */
+    int64_t current_memory;
   };
   /* Relationships between nodes
    * The reason why all depsgraph nodes are descended from this type (apart
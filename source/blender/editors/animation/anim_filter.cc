@@ -3896,6 +3896,16 @@ size_t ANIM_animdata_filter(bAnimContext *ac,
     items = animdata_filter_remove_duplis(anim_data);
   }
 
+  /* Keyframes of channels filtered for editing are about to be changed, stop sharing them with
+   * evaluated copies of the F-Curves. */
+  if (filter_mode & ANIMFILTER_FOREDIT) {
+    LISTBASE_FOREACH (bAnimListElem *, ale, anim_data) {
+      if (ELEM(ale->type, ANIMTYPE_FCURVE, ANIMTYPE_NLACURVE)) {
+        BKE_fcurve_bezt_ensure_mutable(static_cast<FCurve *>(ale->data));
+      }
+    }
+  }
+
   return items;
 }
 
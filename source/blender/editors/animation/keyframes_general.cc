@@ -60,6 +60,7 @@ bool duplicate_fcurve_keys(FCurve *fcu)
   if (ELEM(nullptr, fcu, fcu->bezt)) {
     return changed;
   }
+  BKE_fcurve_bezt_ensure_mutable(fcu);
 
   for (int i = 0; i < fcu->totvert; i++) {
     /* If a key is selected */
@@ -111,6 +112,7 @@ void clean_fcurve(bAnimContext *ac,
   }
 
   /* make a copy of the old BezTriples, and clear F-Curve */
+  BKE_fcurve_bezt_ensure_mutable(fcu);
   old_bezts = fcu->bezt;
   totCount = fcu->totvert;
   fcu->bezt = nullptr;
@@ -1072,6 +1074,7 @@ bool decimate_fcurve(bAnimListElem *ale, float remove_ratio, float error_sq_max)
     return true;
   }
 
+  BKE_fcurve_bezt_ensure_mutable(fcu);
   BezTriple *old_bezts = fcu->bezt;
 
   bool can_decimate_all_selected = true;
@@ -118,6 +118,7 @@ void ED_keyframes_add(FCurve *fcu, int num_keys_to_add)
     return;
   }
 
+  BKE_fcurve_bezt_ensure_mutable(fcu);
   fcu->bezt = static_cast<BezTriple *>(
       MEM_recallocN(fcu->bezt, sizeof(BezTriple) * (fcu->totvert + num_keys_to_add)));
   BezTriple *bezt = fcu->bezt + fcu->totvert; /* Pointer to the first new one. '*/
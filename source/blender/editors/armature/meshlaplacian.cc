@@ -11,20 +11,32 @@
 
 #include "DNA_mesh_types.h"
 #include "DNA_object_types.h"
+#include "DNA_windowmanager_types.h"
 
+#include <atomic>
+
+#include "BLI_array.hh"
+#include "BLI_enumerable_thread_specific.hh"
 #include "BLI_map.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_memarena.h"
+#include "BLI_offset_indices.hh"
 #include "BLI_ordered_edge.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
+#include "BLI_task.hh"
+#include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_bvhutils.hh"
+#include "BKE_global.hh"
+#include "BKE_main.hh"
 #include "BKE_mesh.hh"
 #include "BKE_mesh_wrapper.hh"
 #include "BKE_modifier.hh"
@@ -33,21 +45,48 @@
 #include "ED_mesh.hh"
 #include "ED_object_vgroup.hh"
 
+#include "WM_api.hh"
+
 #include "eigen_capi.h"
 
 #include "meshlaplacian.h"
 
 /* ************* XXX *************** */
 static void waitcursor(int /*val*/) {}
-static void progress_bar(int /*dummy_val*/, const char * /*dummy*/) {}
-static void start_progress_bar() {}
-static void end_progress_bar() {}
 static void error(const char *str)
 {
   printf("error: %s\n", str);
 }
 /* ************* XXX *************** */
 
+/**
+ * Binding runs on the main thread from the bind operator, without a job. Show progress as a
+ * percentage in the cursor of the active window, the message is only used for debugging.
+ */
+static wmWindow *progress_window()
+{
+  const wmWindowManager *wm = static_cast<const wmWindowManager *>(G_MAIN->wm.first);
+  return wm ? wm->winactive : nullptr;
+}
+
+static void start_progress_bar() {}
+
+static void progress_bar(const float progress, const char * /*message*/)
+{
+  if (wmWindow *win = progress_window()) {
+    WM_cursor_time(win, int(progress * 100.0f));
+    WM_progress_set(win, progress);
+  }
+}
+
+static void end_progress_bar()
+{
+  if (wmWindow *win = progress_window()) {
+    WM_cursor_modal_restore(win);
+    WM_progress_clear(win);
+  }
+}
+
 /************************** Laplacian System *****************************/
 
 struct LaplacianSystem {
@@ -857,6 +896,8 @@ void heat_bone_weighting(Object *ob,
 #define MESHDEFORM_LEN_THRESHOLD 1e-6f
 
 #define MESHDEFORM_MIN_INFLUENCE 0.0005f
+/* Same threshold as #BKE_modifier_mdef_compact_influences uses for static binding. */
+#define MESHDEFORM_MIN_BIND_WEIGHT 0.00001f
 
 static const int MESHDEFORM_OFFSET[7][3] = {
     {0, 0, 0},
@@ -904,11 +945,9 @@ struct MeshDeformBind {
   MDefBoundIsect *(*boundisect)[6];
   int *semibound;
   int *tag;
-  float *phi, *totalphi;
 
   /* mesh stuff */
   int *inside;
-  float *weights;
   MDefBindInfluence **dyngrid;
   float cagemat[4][4];
 
@@ -1234,10 +1273,7 @@ static float meshdeform_boundary_phi(const MeshDeformBind *mdb,
   return 0.0f;
 }
 
-static float meshdeform_interp_w(MeshDeformBind *mdb,
-                                 const float *gridvec,
-                                 float * /*vec*/,
-                                 int /*cagevert*/)
+static float meshdeform_interp_w(MeshDeformBind *mdb, const float *phi, const float *gridvec)
 {
   float dvec[3], ivec[3], result = 0.0f;
   float totweight = 0.0f;
@@ -1284,7 +1320,7 @@ static float meshdeform_interp_w(MeshDeformBind *mdb,
 
     int a = meshdeform_index(mdb, x, y, z, 0);
     float weight = wx * wy * wz;
-    result += weight * mdb->phi[a];
+    result += weight * phi[a];
     totweight += weight;
   }
 
@@ -1370,7 +1406,7 @@ static void meshdeform_matrix_add_cell(
 }
 
 static void meshdeform_matrix_add_rhs(
-    MeshDeformBind *mdb, LinearSolver *context, int x, int y, int z, int cagevert)
+    MeshDeformBind *mdb, double *rhs_vec, int x, int y, int z, int cagevert)
 {
   MDefBoundIsect *isect;
   float rhs, weight, totweight;
@@ -1393,13 +1429,13 @@ static void meshdeform_matrix_add_rhs(
     if (isect) {
       weight = (1.0f / isect->len) / totweight;
       rhs = weight * meshdeform_boundary_phi(mdb, isect, cagevert);
-      EIG_linear_solver_right_hand_side_add(context, 0, mdb->varidx[acenter], rhs);
+      rhs_vec[mdb->varidx[acenter]] += rhs;
     }
   }
 }
 
 static void meshdeform_matrix_add_semibound_phi(
-    MeshDeformBind *mdb, int x, int y, int z, int cagevert)
+    MeshDeformBind *mdb, float *phi, int x, int y, int z, int cagevert)
 {
   MDefBoundIsect *isect;
   float rhs, weight, totweight;
@@ -1410,7 +1446,7 @@ static void meshdeform_matrix_add_semibound_phi(
     return;
   }
 
-  mdb->phi[a] = 0.0f;
+  phi[a] = 0.0f;
 
   totweight = meshdeform_boundary_total_weight(mdb, x, y, z);
   for (i = 1; i <= 6; i++) {
@@ -1419,15 +1455,15 @@ static void meshdeform_matrix_add_semibound_phi(
     if (isect) {
       weight = (1.0f / isect->len) / totweight;
       rhs = weight * meshdeform_boundary_phi(mdb, isect, cagevert);
-      mdb->phi[a] += rhs;
+      phi[a] += rhs;
     }
   }
 }
 
 static void meshdeform_matrix_add_exterior_phi(
-    MeshDeformBind *mdb, int x, int y, int z, int /*cagevert*/)
+    MeshDeformBind *mdb, float *phi, int x, int y, int z)
 {
-  float phi, totweight;
+  float totphi, totweight;
   int i, a, acenter;
 
   acenter = meshdeform_index(mdb, x, y, z, 0);
@@ -1435,28 +1471,171 @@ static void meshdeform_matrix_add_exterior_phi(
     return;
   }
 
-  phi = 0.0f;
+  totphi = 0.0f;
   totweight = 0.0f;
   for (i = 1; i <= 6; i++) {
     a = meshdeform_index(mdb, x, y, z, i);
 
     if (a != -1 && mdb->semibound[a]) {
-      phi += mdb->phi[a];
+      totphi += phi[a];
       totweight += 1.0f;
     }
   }
 
   if (totweight != 0.0f) {
-    mdb->phi[acenter] = phi / totweight;
+    phi[acenter] = totphi / totweight;
+  }
+}
+
+/** Harmonic coordinates of a single cage vertex, computed by #meshdeform_solve_cage_vert. */
+struct MeshDeformBindWeight {
+  /** Mesh vertex for static binding, grid cell for dynamic binding. */
+  int index;
+  float weight;
+};
+
+/** Per thread buffers for solving the harmonic coordinates of cage vertices. */
+struct MeshDeformSolveBuffers {
+  blender::Array<double> rhs;
+  blender::Array<double> solution;
+  blender::Array<float> phi;
+};
+
+static bool meshdeform_solve_cage_vert(MeshDeformBind *mdb,
+                                       const LinearSolver *context,
+                                       MeshDeformSolveBuffers &buffers,
+                                       const int cagevert,
+                                       blender::Vector<MeshDeformBindWeight> &r_weights)
+{
+  int b, x, y, z;
+
+  /* fill in right hand side and solve */
+  buffers.rhs.fill(0.0);
+  for (z = 0; z < mdb->size; z++) {
+    for (y = 0; y < mdb->size; y++) {
+      for (x = 0; x < mdb->size; x++) {
+        meshdeform_matrix_add_rhs(mdb, buffers.rhs.data(), x, y, z, cagevert);
+      }
+    }
+  }
+
+  if (!EIG_linear_solver_solve_vector(context, buffers.rhs.data(), buffers.solution.data())) {
+    return false;
+  }
+
+  float *phi = buffers.phi.data();
+  for (z = 0; z < mdb->size; z++) {
+    for (y = 0; y < mdb->size; y++) {
+      for (x = 0; x < mdb->size; x++) {
+        meshdeform_matrix_add_semibound_phi(mdb, phi, x, y, z, cagevert);
+      }
+    }
+  }
+
+  for (z = 0; z < mdb->size; z++) {
+    for (y = 0; y < mdb->size; y++) {
+      for (x = 0; x < mdb->size; x++) {
+        meshdeform_matrix_add_exterior_phi(mdb, phi, x, y, z);
+      }
+    }
+  }
+
+  for (b = 0; b < mdb->size3; b++) {
+    if (mdb->tag[b] != MESHDEFORM_TAG_EXTERIOR) {
+      phi[b] = float(buffers.solution[mdb->varidx[b]]);
+    }
+  }
+
+  if (mdb->dyngrid) {
+    /* dynamic bind */
+    for (b = 0; b < mdb->size3; b++) {
+      if (phi[b] >= MESHDEFORM_MIN_INFLUENCE) {
+        r_weights.append({b, phi[b]});
+      }
+    }
+  }
+  else {
+    /* static bind : compute weights for each vertex */
+    for (b = 0; b < mdb->verts_num; b++) {
+      if (mdb->inside[b]) {
+        float gridvec[3];
+        gridvec[0] = (mdb->vertexcos[b][0] - mdb->min[0] - mdb->halfwidth[0]) / mdb->width[0];
+        gridvec[1] = (mdb->vertexcos[b][1] - mdb->min[1] - mdb->halfwidth[1]) / mdb->width[1];
+        gridvec[2] = (mdb->vertexcos[b][2] - mdb->min[2] - mdb->halfwidth[2]) / mdb->width[2];
+
+        const float weight = meshdeform_interp_w(mdb, phi, gridvec);
+        if (weight > MESHDEFORM_MIN_BIND_WEIGHT) {
+          r_weights.append({b, weight});
+        }
+      }
+    }
   }
+
+  return true;
 }
 
-static void meshdeform_matrix_solve(MeshDeformModifierData *mmd, MeshDeformBind *mdb)
+/**
+ * Store the static bind weights as normalized influences per mesh vertex, in the compact format
+ * evaluated by the modifier.
+ */
+static void meshdeform_static_bind_influences(
+    MeshDeformModifierData *mmd,
+    MeshDeformBind *mdb,
+    const blender::Span<blender::Vector<MeshDeformBindWeight>> cage_vert_weights)
 {
+  int *offsets = static_cast<int *>(
+      MEM_calloc_arrayN(mdb->verts_num + 1, sizeof(int), "MDefBindOffsets"));
+  for (const blender::Span<MeshDeformBindWeight> weights : cage_vert_weights) {
+    for (const MeshDeformBindWeight &weight : weights) {
+      offsets[weight.index]++;
+    }
+  }
+  blender::offset_indices::accumulate_counts_to_offsets(
+      blender::MutableSpan<int>(offsets, mdb->verts_num + 1));
+  const int influences_num = offsets[mdb->verts_num];
+
+  MDefInfluence *influences = static_cast<MDefInfluence *>(
+      MEM_calloc_arrayN(influences_num, sizeof(MDefInfluence), "MDefBindInfluences"));
+
+  /* Cage vertices are added in ascending order for every mesh vertex. */
+  blender::Array<int> fill_counts(mdb->verts_num, 0);
+  for (const int cagevert : cage_vert_weights.index_range()) {
+    for (const MeshDeformBindWeight &weight : cage_vert_weights[cagevert]) {
+      MDefInfluence &influence = influences[offsets[weight.index] + fill_counts[weight.index]++];
+      influence.weight = weight.weight;
+      influence.vertex = cagevert;
+    }
+  }
+
+  blender::threading::parallel_for(
+      blender::IndexRange(mdb->verts_num), 1024, [&](const blender::IndexRange range) {
+        for (const int b : range) {
+          float totweight = 0.0f;
+          for (int i = offsets[b]; i < offsets[b + 1]; i++) {
+            totweight += influences[i].weight;
+          }
+          for (int i = offsets[b]; i < offsets[b + 1]; i++) {
+            influences[i].weight /= totweight;
+          }
+        }
+      });
+
+  mmd->bindinfluences = influences;
+  mmd->bindoffsets = offsets;
+  mmd->influences_num = influences_num;
+}
+
+/**
+ * \return False when the bind was cancelled, in which case the weights are incomplete.
+ */
+static bool meshdeform_matrix_solve(
+    MeshDeformModifierData *mmd,
+    MeshDeformBind *mdb,
+    blender::MutableSpan<blender::Vector<MeshDeformBindWeight>> cage_vert_weights)
+{
+  using namespace blender;
   LinearSolver *context;
-  float vec[3], gridvec[3];
-  int a, b, x, y, z, totvar;
-  char message[256];
+  int a, x, y, z, totvar;
 
   /* setup variable indices */
   mdb->varidx = static_cast<int *>(MEM_callocN(sizeof(int) * mdb->size3, "MeshDeformDSvaridx"));
@@ -1466,7 +1645,7 @@ static void meshdeform_matrix_solve(MeshDeformModifierData *mmd, MeshDeformBind
 
   if (totvar == 0) {
     MEM_freeN(mdb->varidx);
-    return;
+    return true;
   }
 
   progress_bar(0, "Starting mesh deform solve");
@@ -1483,103 +1662,85 @@ static void meshdeform_matrix_solve(MeshDeformModifierData *mmd, MeshDeformBind
     }
   }
 
-  /* solve for each cage vert */
-  for (a = 0; a < mdb->cage_verts_num; a++) {
-    /* fill in right hand side and solve */
-    for (z = 0; z < mdb->size; z++) {
-      for (y = 0; y < mdb->size; y++) {
-        for (x = 0; x < mdb->size; x++) {
-          meshdeform_matrix_add_rhs(mdb, context, x, y, z, a);
-        }
-      }
-    }
-
-    if (EIG_linear_solver_solve(context)) {
-      for (z = 0; z < mdb->size; z++) {
-        for (y = 0; y < mdb->size; y++) {
-          for (x = 0; x < mdb->size; x++) {
-            meshdeform_matrix_add_semibound_phi(mdb, x, y, z, a);
-          }
-        }
-      }
-
-      for (z = 0; z < mdb->size; z++) {
-        for (y = 0; y < mdb->size; y++) {
-          for (x = 0; x < mdb->size; x++) {
-            meshdeform_matrix_add_exterior_phi(mdb, x, y, z, a);
-          }
-        }
-      }
-
-      for (b = 0; b < mdb->size3; b++) {
-        if (mdb->tag[b] != MESHDEFORM_TAG_EXTERIOR) {
-          mdb->phi[b] = EIG_linear_solver_variable_get(context, 0, mdb->varidx[b]);
-        }
-        mdb->totalphi[b] += mdb->phi[b];
-      }
-
-      if (mdb->weights) {
-        /* static bind : compute weights for each vertex */
-        for (b = 0; b < mdb->verts_num; b++) {
-          if (mdb->inside[b]) {
-            copy_v3_v3(vec, mdb->vertexcos[b]);
-            gridvec[0] = (vec[0] - mdb->min[0] - mdb->halfwidth[0]) / mdb->width[0];
-            gridvec[1] = (vec[1] - mdb->min[1] - mdb->halfwidth[1]) / mdb->width[1];
-            gridvec[2] = (vec[2] - mdb->min[2] - mdb->halfwidth[2]) / mdb->width[2];
-
-            mdb->weights[b * mdb->cage_verts_num + a] = meshdeform_interp_w(mdb, gridvec, vec, a);
+  /* The matrix is the same for all cage vertices, only the right hand side differs. Factorize it
+   * once, then solve for all cage vertices in parallel. */
+  std::atomic<bool> success = EIG_linear_solver_factorize(context);
+  std::atomic<bool> cancelled = false;
+
+  if (success) {
+    threading::EnumerableThreadSpecific<MeshDeformSolveBuffers> all_buffers([&]() {
+      MeshDeformSolveBuffers buffers;
+      buffers.rhs.reinitialize(totvar);
+      buffers.solution.reinitialize(totvar);
+      buffers.phi = Array<float>(mdb->size3, 0.0f);
+      return buffers;
+    });
+    std::atomic<int> solved_num = 0;
+    std::atomic<bool> finished = false;
+    auto solve_fn = [&]() {
+      threading::parallel_for(IndexRange(mdb->cage_verts_num), 1, [&](const IndexRange range) {
+        MeshDeformSolveBuffers &buffers = all_buffers.local();
+        for (const int cagevert : range) {
+          if (!success || cancelled) {
+            return;
           }
-        }
-      }
-      else {
-        MDefBindInfluence *inf;
-
-        /* dynamic bind */
-        for (b = 0; b < mdb->size3; b++) {
-          if (mdb->phi[b] >= MESHDEFORM_MIN_INFLUENCE) {
-            inf = static_cast<MDefBindInfluence *>(
-                BLI_memarena_alloc(mdb->memarena, sizeof(*inf)));
-            inf->vertex = a;
-            inf->weight = mdb->phi[b];
-            inf->next = mdb->dyngrid[b];
-            mdb->dyngrid[b] = inf;
+          if (!meshdeform_solve_cage_vert(
+                  mdb, context, buffers, cagevert, cage_vert_weights[cagevert]))
+          {
+            success = false;
           }
+          solved_num++;
         }
+      });
+      finished = true;
+    };
+    FunctionRef<void()> solve_fn_ref = solve_fn;
+
+    /* Solve in a background task, so that the main thread can report progress (the window
+     * manager can only be accessed from the main thread) and check whether to cancel. */
+    TaskPool *pool = BLI_task_pool_create_background(&solve_fn_ref, TASK_PRIORITY_HIGH);
+    BLI_task_pool_push(
+        pool,
+        [](TaskPool *__restrict pool, void * /*taskdata*/) {
+          (*static_cast<FunctionRef<void()> *>(BLI_task_pool_user_data(pool)))();
+        },
+        nullptr,
+        false,
+        nullptr);
+    while (!finished) {
+      char message[256];
+      SNPRINTF(message, "Mesh deform solve %d / %d", int(solved_num), mdb->cage_verts_num);
+      progress_bar(float(solved_num) / float(mdb->cage_verts_num), message);
+      /* NOTE: this won't check for the escape key being pressed, as events are not handled while
+       * binding, but it allows cancelling from anything else that sets the break flag. */
+      if (G.is_break) {
+        cancelled = true;
       }
+      BLI_time_sleep_ms(50);
     }
-    else {
-      BKE_modifier_set_error(
-          mmd->object, &mmd->modifier, "Failed to find bind solution (increase precision?)");
-      error("Mesh Deform: failed to find bind solution.");
-      break;
-    }
-
-    SNPRINTF(message, "Mesh deform solve %d / %d       |||", a + 1, mdb->cage_verts_num);
-    progress_bar(float(a + 1) / float(mdb->cage_verts_num), message);
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
   }
 
-#if 0
-  /* sanity check */
-  for (b = 0; b < mdb->size3; b++) {
-    if (mdb->tag[b] != MESHDEFORM_TAG_EXTERIOR) {
-      if (fabsf(mdb->totalphi[b] - 1.0f) > 1e-4f) {
-        printf("totalphi deficiency [%s|%d] %d: %.10f\n",
-               (mdb->tag[b] == MESHDEFORM_TAG_INTERIOR) ? "interior" : "boundary",
-               mdb->semibound[b],
-               mdb->varidx[b],
-               mdb->totalphi[b]);
-      }
-    }
+  if (cancelled) {
+    BKE_modifier_set_error(mmd->object, &mmd->modifier, "Bind cancelled");
+  }
+  else if (!success) {
+    BKE_modifier_set_error(
+        mmd->object, &mmd->modifier, "Failed to find bind solution (increase precision?)");
+    error("Mesh Deform: failed to find bind solution.");
   }
-#endif
 
   /* free */
   MEM_freeN(mdb->varidx);
 
   EIG_linear_solver_delete(context);
+
+  return !cancelled;
 }
 
-static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBind *mdb)
+/** \return False when the bind was cancelled and nothing was assigned to the modifier. */
+static bool harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBind *mdb)
 {
   MDefBindInfluence *inf;
   MDefInfluence *mdinf;
@@ -1598,9 +1759,6 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
   mdb->size = (2 << (mmd->gridsize - 1)) + 2;
   mdb->size3 = mdb->size * mdb->size * mdb->size;
   mdb->tag = static_cast<int *>(MEM_callocN(sizeof(int) * mdb->size3, "MeshDeformBindTag"));
-  mdb->phi = static_cast<float *>(MEM_callocN(sizeof(float) * mdb->size3, "MeshDeformBindPhi"));
-  mdb->totalphi = static_cast<float *>(
-      MEM_callocN(sizeof(float) * mdb->size3, "MeshDeformBindTotalPhi"));
   mdb->boundisect = static_cast<MDefBoundIsect *(*)[6]>(
       MEM_callocN(sizeof(*mdb->boundisect) * mdb->size3, "MDefBoundIsect"));
   mdb->semibound = static_cast<int *>(MEM_callocN(sizeof(int) * mdb->size3, "MDefSemiBound"));
@@ -1612,10 +1770,6 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
     mdb->dyngrid = static_cast<MDefBindInfluence **>(
         MEM_callocN(sizeof(MDefBindInfluence *) * mdb->size3, "MDefDynGrid"));
   }
-  else {
-    mdb->weights = static_cast<float *>(
-        MEM_callocN(sizeof(float) * mdb->verts_num * mdb->cage_verts_num, "MDefWeights"));
-  }
 
   mdb->memarena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, "harmonic coords arena");
   BLI_memarena_use_calloc(mdb->memarena);
@@ -1694,10 +1848,26 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
   }
 
   /* solve */
-  meshdeform_matrix_solve(mmd, mdb);
+  blender::Array<blender::Vector<MeshDeformBindWeight>> cage_vert_weights(mdb->cage_verts_num);
+  const bool solved = meshdeform_matrix_solve(mmd, mdb, cage_vert_weights);
 
   /* assign results */
-  if (mmd->flag & MOD_MDEF_DYNAMIC_BIND) {
+  if (!solved) {
+    MEM_SAFE_FREE(mdb->dyngrid);
+    MEM_freeN(mdb->inside);
+  }
+  else if (mmd->flag & MOD_MDEF_DYNAMIC_BIND) {
+    /* Add influences in order of the cage vertices, the same as solving them one by one. */
+    for (a = 0; a < mdb->cage_verts_num; a++) {
+      for (const MeshDeformBindWeight &weight : cage_vert_weights[a]) {
+        inf = static_cast<MDefBindInfluence *>(BLI_memarena_alloc(mdb->memarena, sizeof(*inf)));
+        inf->vertex = a;
+        inf->weight = weight.weight;
+        inf->next = mdb->dyngrid[weight.index];
+        mdb->dyngrid[weight.index] = inf;
+      }
+    }
+
     mmd->influences_num = 0;
     for (a = 0; a < mdb->size3; a++) {
       for (inf = mdb->dyngrid[a]; inf; inf = inf->next) {
@@ -1741,17 +1911,17 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
     MEM_freeN(mdb->dyngrid);
   }
   else {
-    mmd->bindweights = mdb->weights;
+    meshdeform_static_bind_influences(mmd, mdb, cage_vert_weights);
     MEM_freeN(mdb->inside);
   }
 
   MEM_freeN(mdb->tag);
-  MEM_freeN(mdb->phi);
-  MEM_freeN(mdb->totalphi);
   MEM_freeN(mdb->boundisect);
   MEM_freeN(mdb->semibound);
   BLI_memarena_free(mdb->memarena);
   free_bvhtree_from_mesh(&mdb->bvhdata);
+
+  return solved;
 }
 
 void ED_mesh_deform_bind_callback(Object *object,
@@ -1792,7 +1962,13 @@ void ED_mesh_deform_bind_callback(Object *object,
   }
 
   /* solve */
-  harmonic_coordinates_bind(mmd_orig, &mdb);
+  if (!harmonic_coordinates_bind(mmd_orig, &mdb)) {
+    MEM_freeN(mdb.cagecos);
+    MEM_freeN(mdb.vertexcos);
+    end_progress_bar();
+    waitcursor(0);
+    return;
+  }
 
   /* assign bind variables */
   mmd_orig->bindcagecos = (float *)mdb.cagecos;
@@ -1808,9 +1984,6 @@ void ED_mesh_deform_bind_callback(Object *object,
   /* free */
   MEM_freeN(mdb.vertexcos);
 
-  /* compact weights */
-  BKE_modifier_mdef_compact_influences((ModifierData *)mmd_orig);
-
   end_progress_bar();
   waitcursor(0);
 }
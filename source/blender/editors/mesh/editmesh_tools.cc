@@ -7198,6 +7198,54 @@ void MESH_OT_sort_elements(wmOperatorType *ot)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Defragment Operator
+ * \{ */
+
+static int edbm_defragment_exec(bContext *C, wmOperator *op)
+{
+  const Scene *scene = CTX_data_scene(C);
+  ViewLayer *view_layer = CTX_data_view_layer(C);
+  const Vector<Object *> objects = BKE_view_layer_array_from_objects_in_edit_mode_unique_data(
+      scene, view_layer, CTX_wm_view3d(C));
+
+  for (Object *ob : objects) {
+    BMEditMesh *em = BKE_editmesh_from_object(ob);
+    if (!BM_mesh_defragment(em->bm)) {
+      BKE_report(op->reports, RPT_WARNING, "Mesh is in use by Python, cannot defragment");
+      continue;
+    }
+
+    EDBMUpdate_Params params{};
+    params.calc_looptris = true;
+    params.calc_normals = false;
+    params.is_destructive = true;
+    EDBM_update(static_cast<Mesh *>(ob->data), &params);
+  }
+  return OPERATOR_FINISHED;
+}
+
+void MESH_OT_defragment(wmOperatorType *ot)
+{
+  /* identifiers */
+  ot->name = "Defragment Mesh";
+  ot->description =
+      "Store the mesh elements close together in memory to speed up editing of meshes with a "
+      "long editing history.\n"
+      "Warning: This changes the order of all vertices, edges and faces, which breaks data that "
+      "depends on it, such as modifier binds and mesh caches";
+  ot->idname = "MESH_OT_defragment";
+
+  /* api callbacks */
+  ot->exec = edbm_defragment_exec;
+  ot->poll = ED_operator_editmesh;
+
+  /* flags */
+  ot->flag = OPTYPE_REGISTER | OPTYPE_UNDO;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Bridge Operator
  * \{ */
@@ -1686,6 +1686,9 @@ void EDBM_update(Mesh *mesh, const EDBMUpdate_Params *params)
     em->bm->spacearr_dirty &= ~BM_SPACEARR_BMO_SET;
   }
 
+  /* Operator changes aren't tracked, the next evaluation has to convert the whole mesh. */
+  BM_mesh_sync_tag_unknown(*em->bm);
+
 #ifndef NDEBUG
   {
     LISTBASE_FOREACH (BMEditSelection *, ese, &em->bm->selected) {
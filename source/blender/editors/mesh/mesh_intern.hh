@@ -247,6 +247,7 @@ void MESH_OT_symmetry_snap(wmOperatorType *ot);
 void MESH_OT_shape_propagate_to_all(wmOperatorType *ot);
 void MESH_OT_blend_from_shape(wmOperatorType *ot);
 void MESH_OT_sort_elements(wmOperatorType *ot);
+void MESH_OT_defragment(wmOperatorType *ot);
 void MESH_OT_uvs_rotate(wmOperatorType *ot);
 void MESH_OT_uvs_reverse(wmOperatorType *ot);
 void MESH_OT_colors_rotate(wmOperatorType *ot);
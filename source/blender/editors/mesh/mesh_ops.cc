@@ -101,6 +101,7 @@ void ED_operatortypes_mesh()
   WM_operatortype_append(MESH_OT_faces_shade_flat);
   WM_operatortype_append(MESH_OT_set_sharpness_by_angle);
   WM_operatortype_append(MESH_OT_sort_elements);
+  WM_operatortype_append(MESH_OT_defragment);
 #ifdef WITH_FREESTYLE
   WM_operatortype_append(MESH_OT_mark_freestyle_face);
 #endif
@@ -1340,7 +1340,7 @@ void constraint_dependency_update(Main *bmain, Object *ob)
   if (ob->pose) {
     object_pose_tag_update(bmain, ob);
   }
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_for_id(bmain, &ob->id);
 }
 
 void constraint_tag_update(Main *bmain, Object *ob, bConstraint *con)
@@ -1373,7 +1373,7 @@ void constraint_dependency_tag_update(Main *bmain, Object *ob, bConstraint *con)
   if (ob->pose) {
     object_pose_tag_update(bmain, ob);
   }
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_for_id(bmain, &ob->id);
 }
 
 bool constraint_move_to_index(Object *ob, bConstraint *con, const int index)
@@ -1448,7 +1448,7 @@ static int constraint_delete_exec(bContext *C, wmOperator *op)
     constraint_update(bmain, ob);
 
     /* relations */
-    DEG_relations_tag_update(bmain);
+    DEG_relations_tag_update_for_id(bmain, &ob->id);
 
     /* notifiers */
     WM_event_add_notifier(C, NC_OBJECT | ND_CONSTRAINT | NA_REMOVED, ob);
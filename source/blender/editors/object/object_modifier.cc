@@ -254,7 +254,7 @@ ModifierData *modifier_add(
   BKE_object_modifier_set_active(ob, new_md);
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_for_id(bmain, &ob->id);
 
   return new_md;
 }
@@ -409,7 +409,7 @@ bool modifier_remove(ReportList *reports, Main *bmain, Scene *scene, Object *ob,
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_for_id(bmain, &ob->id);
 
   return true;
 }
@@ -432,7 +432,7 @@ void modifiers_clear(Main *bmain, Scene *scene, Object *ob)
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_for_id(bmain, &ob->id);
 }
 
 static bool object_modifier_check_move_before(ReportList *reports,
@@ -586,7 +586,7 @@ void modifier_link(bContext *C, Object *ob_dst, Object *ob_src)
   DEG_id_tag_update(&ob_dst->id, ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION);
 
   Main *bmain = CTX_data_main(C);
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_for_id(bmain, &ob_dst->id);
 }
 
 bool modifier_copy_to_object(Main *bmain,
@@ -630,7 +630,7 @@ bool modifier_copy_to_object(Main *bmain,
   }
 
   DEG_id_tag_update(&ob_dst->id, ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION);
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_for_id(bmain, &ob_dst->id);
   return true;
 }
 
@@ -3380,6 +3380,7 @@ static int meshdeform_bind_exec(bContext *C, wmOperator *op)
     MeshDeformModifierData *mmd_eval = (MeshDeformModifierData *)BKE_modifier_get_evaluated(
         depsgraph, ob, &mmd->modifier);
     mmd_eval->bindfunc = ED_mesh_deform_bind_callback;
+    G.is_break = false;
     object_force_modifier_bind_simple_options(depsgraph, ob, &mmd->modifier);
     mmd_eval->bindfunc = nullptr;
   }
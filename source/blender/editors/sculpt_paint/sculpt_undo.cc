@@ -942,6 +942,10 @@ static void restore_list(bContext *C, Depsgraph *depsgraph, StepData &step_data)
           }
         });
         multires_mark_as_modified(depsgraph, &object, MULTIRES_COORDS_MODIFIED);
+        if (tag_update) {
+          Mesh &mesh = *static_cast<Mesh *>(object.data);
+          mesh.tag_positions_changed();
+        }
       }
       else {
         if (!restore_active_shape_key(*C, *depsgraph, step_data, object)) {
@@ -956,11 +960,15 @@ static void restore_list(bContext *C, Depsgraph *depsgraph, StepData &step_data)
             BKE_pbvh_node_mark_positions_update(&node);
           }
         });
+        if (tag_update) {
+          /* Undo steps usually restore a small part of the mesh, only update the normals there. */
+          Mesh &mesh = *static_cast<Mesh *>(object.data);
+          IndexMaskMemory memory;
+          mesh.tag_positions_changed(IndexMask::from_bools(modified_verts, memory));
+        }
       }
 
       if (tag_update) {
-        Mesh &mesh = *static_cast<Mesh *>(object.data);
-        mesh.tag_positions_changed();
         BKE_sculptsession_free_deformMats(&ss);
       }
       bke::pbvh::update_bounds(*ss.pbvh);
@@ -1761,6 +1769,15 @@ void push_end_ex(Object &ob, const bool use_nested_undo)
       },
       std::plus<size_t>());
 
+  if (step_data->bm_entry) {
+    /* Dynamic topology stores its changes in the BMesh log rather than in the undo nodes. */
+    const SculptSession *ss = ob.sculpt;
+    if (ss && ss->bm && ss->bm_log && BM_log_current_entry(ss->bm_log) == step_data->bm_entry) {
+      BM_log_entry_compact(ss->bm, ss->bm_log);
+    }
+    step_data->undo_size += BM_log_entry_size_in_bytes(step_data->bm_entry);
+  }
+
   /* We could remove this and enforce all callers run in an operator using 'OPTYPE_UNDO'. */
   wmWindowManager *wm = static_cast<wmWindowManager *>(G_MAIN->wm.first);
   if (wm->op_undo_depth == 0 || use_nested_undo) {
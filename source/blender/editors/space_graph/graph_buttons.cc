@@ -360,6 +360,9 @@ static void graph_panel_key_properties(const bContext *C, Panel *panel)
   uiLayoutSetPropSep(layout, true);
   uiLayoutSetPropDecorate(layout, false);
 
+  /* The buttons edit the keyframe in place, so it can not be shared with evaluated copies. */
+  BKE_fcurve_bezt_ensure_mutable(fcu);
+
   /* only show this info if there are keyframes to edit */
   if (get_active_fcurve_keyframe_edit(fcu, &bezt, &prevbezt)) {
     PointerRNA fcu_prop_ptr;
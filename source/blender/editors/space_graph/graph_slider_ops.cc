@@ -30,6 +30,7 @@
 #include "BLT_translation.hh"
 
 #include "BKE_context.hh"
+#include "BKE_fcurve.hh"
 
 #include "UI_interface.hh"
 
@@ -218,6 +219,7 @@ static void reset_bezts(tGraphSliderOp *gso)
 
     const int arr_size = sizeof(BezTriple) * data->tot_vert;
 
+    BKE_fcurve_bezt_ensure_mutable(fcu);
     MEM_freeN(fcu->bezt);
 
     fcu->bezt = static_cast<BezTriple *>(MEM_mallocN(arr_size, __func__));
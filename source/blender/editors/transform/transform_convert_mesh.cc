@@ -97,6 +97,11 @@ struct TransCustomDataMesh {
   TransCustomDataLayer *cd_layer_correct;
   TransCustomData_PartialUpdate partial_update[PARTIAL_TYPE_MAX];
   PartialTypeState partial_update_state_prev;
+
+  /** Range of transformed vertex indices, declared with #BM_mesh_sync_tag_changes. */
+  blender::IndexRange sync_vert_range;
+  bool sync_vert_range_calc;
+  int sync_count;
 };
 
 static TransCustomDataMesh *mesh_customdata_ensure(TransDataContainer *tc)
@@ -110,6 +115,7 @@ static TransCustomDataMesh *mesh_customdata_ensure(TransDataContainer *tc)
     tcmd = static_cast<TransCustomDataMesh *>(tc->custom.type.data);
     tcmd->partial_update_state_prev.for_looptris = PARTIAL_NONE;
     tcmd->partial_update_state_prev.for_normals = PARTIAL_NONE;
+    tcmd->sync_count = -1;
   }
   return tcmd;
 }
@@ -2070,6 +2076,51 @@ static void mesh_transdata_mirror_apply(TransDataContainer *tc)
   }
 }
 
+/**
+ * Let the evaluated mesh be updated in place, transforming only moves vertices
+ * (and corrects face corner data when enabled).
+ */
+static void mesh_sync_tag_changes(TransDataContainer *tc)
+{
+  BMesh *bm = BKE_editmesh_from_object(tc->obedit)->bm;
+  TransCustomDataMesh *tcmd = mesh_customdata_ensure(tc);
+
+  if (bm->elem_index_dirty & BM_VERT) {
+    return;
+  }
+
+  if (!tcmd->sync_vert_range_calc) {
+    int vert_min = INT_MAX;
+    int vert_max = -1;
+    const TransData *td = tc->data;
+    for (int i = 0; i < tc->data_len; i++, td++) {
+      const int vert_i = BM_elem_index_get(static_cast<const BMVert *>(td->extra));
+      vert_min = std::min(vert_min, vert_i);
+      vert_max = std::max(vert_max, vert_i);
+    }
+    const TransDataMirror *td_mirror = tc->data_mirror;
+    for (int i = 0; i < tc->data_mirror_len; i++, td_mirror++) {
+      const int vert_i = BM_elem_index_get(static_cast<const BMVert *>(td_mirror->extra));
+      vert_min = std::min(vert_min, vert_i);
+      vert_max = std::max(vert_max, vert_i);
+    }
+    tcmd->sync_vert_range = (vert_max == -1) ?
+                                blender::IndexRange() :
+                                blender::IndexRange::from_begin_end_inclusive(vert_min, vert_max);
+    tcmd->sync_vert_range_calc = true;
+  }
+
+  char sync_flag = BM_SYNC_VERT_POSITIONS;
+  if (tcmd->cd_layer_correct != nullptr) {
+    sync_flag |= BM_SYNC_CORNER_DATA;
+  }
+  BM_mesh_sync_tag_changes(*bm,
+                           sync_flag,
+                           int(tcmd->sync_vert_range.start()),
+                           int(tcmd->sync_vert_range.one_after_last()),
+                           &tcmd->sync_count);
+}
+
 static void recalcData_mesh(TransInfo *t)
 {
   bool is_canceling = t->state == TRANS_CANCEL;
@@ -2097,6 +2148,8 @@ static void recalcData_mesh(TransInfo *t)
   mesh_partial_types_calc(t, &partial_state);
 
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+    mesh_sync_tag_changes(tc);
+
     DEG_id_tag_update(static_cast<ID *>(tc->obedit->data), ID_RECALC_GEOMETRY);
 
     mesh_partial_update(t, tc, &partial_state);
@@ -6,8 +6,11 @@
  * \ingroup editors
  */
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "MOD_lineart.h"
 
@@ -69,6 +72,19 @@ static LineartEdge *lineart_line_get_connected(LineartBoundingArea *ba,
   return nullptr;
 }
 
+/**
+ * Passes that only modify each chain on its own run in parallel over this array. They must not
+ * allocate from the chain memory pool, which isn't thread safe.
+ */
+static blender::Vector<LineartEdgeChain *> lineart_chains_as_vector(ListBase *chains)
+{
+  blender::Vector<LineartEdgeChain *> result;
+  LISTBASE_FOREACH (LineartEdgeChain *, ec, chains) {
+    result.append(ec);
+  }
+  return result;
+}
+
 static LineartEdgeChain *lineart_chain_create(LineartData *ld)
 {
   LineartEdgeChain *ec;
@@ -1056,11 +1072,18 @@ void MOD_lineart_chain_discard_unused(LineartData *ld,
                                       const float threshold,
                                       uint8_t max_occlusion)
 {
-  LineartEdgeChain *ec, *next_ec;
-  for (ec = static_cast<LineartEdgeChain *>(ld->chains.first); ec; ec = next_ec) {
-    next_ec = ec->next;
-    if (ec->level > max_occlusion || MOD_lineart_chain_compute_length(ec) < threshold) {
-      BLI_remlink(&ld->chains, ec);
+  using namespace blender;
+  const Vector<LineartEdgeChain *> chains = lineart_chains_as_vector(&ld->chains);
+  Array<bool> discard(chains.size());
+  threading::parallel_for(chains.index_range(), 256, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      LineartEdgeChain *ec = chains[i];
+      discard[i] = ec->level > max_occlusion || MOD_lineart_chain_compute_length(ec) < threshold;
+    }
+  });
+  for (const int64_t i : chains.index_range()) {
+    if (discard[i]) {
+      BLI_remlink(&ld->chains, chains[i]);
     }
   }
 }
@@ -1096,97 +1119,106 @@ LineartElementLinkNode *lineart_find_matching_eln_obj(ListBase *elns, Object *ob
 
 void MOD_lineart_finalize_chains(LineartData *ld)
 {
-  LISTBASE_FOREACH (LineartEdgeChain *, ec, &ld->chains) {
-    if (ELEM(ec->type,
-             MOD_LINEART_EDGE_FLAG_INTERSECTION,
-             MOD_LINEART_EDGE_FLAG_PROJECTED_SHADOW,
-             MOD_LINEART_EDGE_FLAG_LIGHT_CONTOUR))
-    {
-      continue;
-    }
-    LineartElementLinkNode *eln = lineart_find_matching_eln_obj(&ld->geom.vertex_buffer_pointers,
-                                                                ec->object_ref);
-    BLI_assert(eln != nullptr);
-    if (LIKELY(eln)) {
-      LISTBASE_FOREACH (LineartEdgeChainItem *, eci, &ec->chain) {
-        if (eci->index > eln->global_index_offset) {
-          eci->index -= eln->global_index_offset;
+  using namespace blender;
+  const Vector<LineartEdgeChain *> chains = lineart_chains_as_vector(&ld->chains);
+  threading::parallel_for(chains.index_range(), 256, [&](const IndexRange range) {
+    for (LineartEdgeChain *ec : chains.as_span().slice(range)) {
+      if (ELEM(ec->type,
+               MOD_LINEART_EDGE_FLAG_INTERSECTION,
+               MOD_LINEART_EDGE_FLAG_PROJECTED_SHADOW,
+               MOD_LINEART_EDGE_FLAG_LIGHT_CONTOUR))
+      {
+        continue;
+      }
+      LineartElementLinkNode *eln = lineart_find_matching_eln_obj(
+          &ld->geom.vertex_buffer_pointers, ec->object_ref);
+      BLI_assert(eln != nullptr);
+      if (LIKELY(eln)) {
+        LISTBASE_FOREACH (LineartEdgeChainItem *, eci, &ec->chain) {
+          if (eci->index > eln->global_index_offset) {
+            eci->index -= eln->global_index_offset;
+          }
         }
       }
     }
-  }
+  });
 }
 
 void MOD_lineart_smooth_chains(LineartData *ld, float tolerance)
 {
-  LISTBASE_FOREACH (LineartEdgeChain *, ec, &ld->chains) {
-    /* Go through the chain two times, once from each direction. */
-    for (int times = 0; times < 2; times++) {
-      for (LineartEdgeChainItem *eci = static_cast<LineartEdgeChainItem *>(ec->chain.first),
-                                *next_eci = eci->next;
-           eci;
-           eci = next_eci)
-      {
-        LineartEdgeChainItem *eci2, *eci3, *eci4;
-
-        if (!(eci2 = eci->next) || !(eci3 = eci2->next)) {
-          /* Not enough points to simplify. */
-          next_eci = eci->next;
-          continue;
-        }
-        /* No need to care for different line types/occlusion and so on, because at this stage they
-         * are all the same within a chain.
-         *
-         * We need to simplify a chain from this:
-         * 1-----------2
-         *        3-----------4
-         * to this:
-         * 1-----------2--_
-         *                 `--4 */
-
-        /* If p3 is within the p1-p2 segment of a width of "tolerance", in other words, p3 is
-         * approximately on the segment of p1-p2. */
-        if (dist_to_line_segment_v2(eci3->pos, eci->pos, eci2->pos) < tolerance) {
-          float vec2[2], vec3[2], v2n[2], ratio, len2;
-          sub_v2_v2v2(vec2, eci2->pos, eci->pos);
-          sub_v2_v2v2(vec3, eci3->pos, eci->pos);
-          normalize_v2_v2(v2n, vec2);
-          ratio = dot_v2v2(v2n, vec3);
-          len2 = len_v2(vec2);
-          /* Because this smoothing applies on geometries of different scales in the same scene,
-           * some small scale features (e.g. the "tails" on the inner ring of a torus geometry)
-           * could be completely erased if the tolerance value is set for accommodating the entire
-           * scene. Those situations typically result in (ratio << 0), looks like this:
-           *                         1---2
-           * 3-------------------------------4
-           * (this sort of long zigzag obviously are "features" that can't be erased)
-           * setting a ratio of -10 turned out to be a reasonable threshold in tests. */
-          if (ratio < len2 && ratio > -len2 * 10) {
-            /* We only remove p3 if p4 is on the extension of p1->p2. */
-            if ((eci4 = eci3->next) &&
-                (dist_to_line_v2(eci4->pos, eci->pos, eci2->pos) < tolerance))
-            {
-              BLI_remlink(&ec->chain, eci3);
-              next_eci = eci;
-              continue;
-            }
-            if (!eci4) {
-              /* See if the last segment's direction is reversed, if so remove that.
-               * Basically we don't need to preserve p3 if the entire chain looked like this:
-               * ...----1----3===2 */
-              if (len_v2(vec2) > len_v2(vec3)) {
+  using namespace blender;
+  const Vector<LineartEdgeChain *> chains = lineart_chains_as_vector(&ld->chains);
+  threading::parallel_for(chains.index_range(), 64, [&](const IndexRange range) {
+    for (LineartEdgeChain *ec : chains.as_span().slice(range)) {
+      /* Go through the chain two times, once from each direction. */
+      for (int times = 0; times < 2; times++) {
+        for (LineartEdgeChainItem *eci = static_cast<LineartEdgeChainItem *>(ec->chain.first),
+                                  *next_eci = eci->next;
+             eci;
+             eci = next_eci)
+        {
+          LineartEdgeChainItem *eci2, *eci3, *eci4;
+
+          if (!(eci2 = eci->next) || !(eci3 = eci2->next)) {
+            /* Not enough points to simplify. */
+            next_eci = eci->next;
+            continue;
+          }
+          /* No need to care for different line types/occlusion and so on, because at this stage
+           * they are all the same within a chain.
+           *
+           * We need to simplify a chain from this:
+           * 1-----------2
+           *        3-----------4
+           * to this:
+           * 1-----------2--_
+           *                 `--4 */
+
+          /* If p3 is within the p1-p2 segment of a width of "tolerance", in other words, p3 is
+           * approximately on the segment of p1-p2. */
+          if (dist_to_line_segment_v2(eci3->pos, eci->pos, eci2->pos) < tolerance) {
+            float vec2[2], vec3[2], v2n[2], ratio, len2;
+            sub_v2_v2v2(vec2, eci2->pos, eci->pos);
+            sub_v2_v2v2(vec3, eci3->pos, eci->pos);
+            normalize_v2_v2(v2n, vec2);
+            ratio = dot_v2v2(v2n, vec3);
+            len2 = len_v2(vec2);
+            /* Because this smoothing applies on geometries of different scales in the same
+             * scene, some small scale features (e.g. the "tails" on the inner ring of a torus
+             * geometry) could be completely erased if the tolerance value is set for accommodating
+             * the entire scene. Those situations typically result in (ratio << 0), looks like
+             * this:
+             *                         1---2
+             * 3-------------------------------4
+             * (this sort of long zigzag obviously are "features" that can't be erased)
+             * setting a ratio of -10 turned out to be a reasonable threshold in tests. */
+            if (ratio < len2 && ratio > -len2 * 10) {
+              /* We only remove p3 if p4 is on the extension of p1->p2. */
+              if ((eci4 = eci3->next) &&
+                  (dist_to_line_v2(eci4->pos, eci->pos, eci2->pos) < tolerance))
+              {
                 BLI_remlink(&ec->chain, eci3);
+                next_eci = eci;
+                continue;
+              }
+              if (!eci4) {
+                /* See if the last segment's direction is reversed, if so remove that.
+                 * Basically we don't need to preserve p3 if the entire chain looked like this:
+                 * ...----1----3===2 */
+                if (len_v2(vec2) > len_v2(vec3)) {
+                  BLI_remlink(&ec->chain, eci3);
+                }
+                next_eci = nullptr;
+                continue;
               }
-              next_eci = nullptr;
-              continue;
             }
           }
+          next_eci = eci->next;
         }
-        next_eci = eci->next;
+        BLI_listbase_reverse(&ec->chain);
       }
-      BLI_listbase_reverse(&ec->chain);
     }
-  }
+  });
 }
 
 static LineartEdgeChainItem *lineart_chain_create_crossing_point(LineartData *ld,
@@ -1359,10 +1391,9 @@ void MOD_lineart_chain_split_angle(LineartData *ld, float angle_threshold_rad)
 
 void MOD_lineart_chain_offset_towards_camera(LineartData *ld, float dist, bool use_custom_camera)
 {
-  float dir[3];
+  using namespace blender;
   float cam[3];
   float view[3];
-  float view_clamp[3];
 
   if (use_custom_camera) {
     copy_v3fl_v3db(cam, ld->conf.camera_pos);
@@ -1370,45 +1401,52 @@ void MOD_lineart_chain_offset_towards_camera(LineartData *ld, float dist, bool u
   else {
     copy_v3fl_v3db(cam, ld->conf.active_camera_pos);
   }
-
-  if (ld->conf.cam_is_persp) {
-    LISTBASE_FOREACH (LineartEdgeChain *, ec, &ld->chains) {
-      LISTBASE_FOREACH (LineartEdgeChainItem *, eci, &ec->chain) {
-        sub_v3_v3v3(dir, cam, eci->gpos);
-        float orig_len = len_v3(dir);
-        normalize_v3(dir);
-        mul_v3_fl(dir, std::min<float>(dist, orig_len - ld->conf.near_clip));
-        add_v3_v3(eci->gpos, dir);
+  copy_v3fl_v3db(view, ld->conf.view_vector);
+
+  const Vector<LineartEdgeChain *> chains = lineart_chains_as_vector(&ld->chains);
+  threading::parallel_for(chains.index_range(), 256, [&](const IndexRange range) {
+    float dir[3];
+    float view_clamp[3];
+    for (LineartEdgeChain *ec : chains.as_span().slice(range)) {
+      if (ld->conf.cam_is_persp) {
+        LISTBASE_FOREACH (LineartEdgeChainItem *, eci, &ec->chain) {
+          sub_v3_v3v3(dir, cam, eci->gpos);
+          float orig_len = len_v3(dir);
+          normalize_v3(dir);
+          mul_v3_fl(dir, std::min<float>(dist, orig_len - ld->conf.near_clip));
+          add_v3_v3(eci->gpos, dir);
+        }
       }
-    }
-  }
-  else {
-    copy_v3fl_v3db(view, ld->conf.view_vector);
-    LISTBASE_FOREACH (LineartEdgeChain *, ec, &ld->chains) {
-      LISTBASE_FOREACH (LineartEdgeChainItem *, eci, &ec->chain) {
-        sub_v3_v3v3(dir, cam, eci->gpos);
-        float len_lim = dot_v3v3(view, dir) - ld->conf.near_clip;
-        normalize_v3_v3(view_clamp, view);
-        mul_v3_fl(view_clamp, std::min(dist, len_lim));
-        add_v3_v3(eci->gpos, view_clamp);
+      else {
+        LISTBASE_FOREACH (LineartEdgeChainItem *, eci, &ec->chain) {
+          sub_v3_v3v3(dir, cam, eci->gpos);
+          float len_lim = dot_v3v3(view, dir) - ld->conf.near_clip;
+          normalize_v3_v3(view_clamp, view);
+          mul_v3_fl(view_clamp, std::min(dist, len_lim));
+          add_v3_v3(eci->gpos, view_clamp);
+        }
       }
     }
-  }
+  });
 }
 
 void MOD_lineart_chain_find_silhouette_backdrop_objects(LineartData *ld)
 {
-  LISTBASE_FOREACH (LineartEdgeChain *, ec, &ld->chains) {
-    if (ec->type == MOD_LINEART_EDGE_FLAG_CONTOUR &&
-        ec->shadow_mask_bits & LRT_SHADOW_SILHOUETTE_ERASED_GROUP)
-    {
-      uint32_t target = ec->shadow_mask_bits & LRT_OBINDEX_HIGHER;
-      LineartElementLinkNode *eln = lineart_find_matching_eln(&ld->geom.line_buffer_pointers,
-                                                              target);
-      if (!eln) {
-        continue;
+  using namespace blender;
+  const Vector<LineartEdgeChain *> chains = lineart_chains_as_vector(&ld->chains);
+  threading::parallel_for(chains.index_range(), 256, [&](const IndexRange range) {
+    for (LineartEdgeChain *ec : chains.as_span().slice(range)) {
+      if (ec->type == MOD_LINEART_EDGE_FLAG_CONTOUR &&
+          ec->shadow_mask_bits & LRT_SHADOW_SILHOUETTE_ERASED_GROUP)
+      {
+        uint32_t target = ec->shadow_mask_bits & LRT_OBINDEX_HIGHER;
+        LineartElementLinkNode *eln = lineart_find_matching_eln(&ld->geom.line_buffer_pointers,
+                                                                target);
+        if (!eln) {
+          continue;
+        }
+        ec->silhouette_backdrop = static_cast<Object *>(eln->object_ref);
       }
-      ec->silhouette_backdrop = static_cast<Object *>(eln->object_ref);
     }
-  }
+  });
 }
@@ -11,6 +11,7 @@
 #include "MOD_gpencil_legacy_lineart.h"
 #include "MOD_lineart.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_base.hh"
 #include "BLI_math_geom.h"
@@ -21,6 +22,7 @@
 #include "BLI_sort.hh"
 #include "BLI_string.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
@@ -481,6 +483,11 @@ static void lineart_occlusion_worker(TaskPool *__restrict /*pool*/, LineartRende
 
 void lineart_main_occlusion_begin(LineartData *ld)
 {
+  double t_start;
+  if (G.debug_value == 4000) {
+    t_start = BLI_time_now_seconds();
+  }
+
   int thread_count = ld->thread_count;
   LineartRenderTaskInfo *rti = static_cast<LineartRenderTaskInfo *>(
       MEM_callocN(sizeof(LineartRenderTaskInfo) * thread_count, __func__));
@@ -497,6 +504,11 @@ void lineart_main_occlusion_begin(LineartData *ld)
   BLI_task_pool_free(tp);
 
   MEM_freeN(rti);
+
+  if (G.debug_value == 4000) {
+    double t_elapsed = BLI_time_now_seconds() - t_start;
+    printf("Line art occlusion time: %f\n", t_elapsed);
+  }
 }
 
 /**
@@ -4641,21 +4653,82 @@ static void lineart_add_triangles_worker(TaskPool *__restrict /*pool*/, LineartI
   }
 }
 
-static void lineart_create_edges_from_isec_data(LineartIsecData *d)
+static void lineart_create_edge_from_isec(LineartData *ld,
+                                         const LineartIsecSingle *is,
+                                         LineartVert *v1,
+                                         LineartVert *v2,
+                                         LineartEdge *e,
+                                         LineartEdgeSegment *es)
 {
-  LineartData *ld = d->ld;
   double ZMax = ld->conf.far_clip;
   double ZMin = ld->conf.near_clip;
+
+  copy_v3_v3_db(v1->gloc, is->v1);
+  copy_v3_v3_db(v2->gloc, is->v2);
+  /* The intersection line has been generated only in geometry space, so we need to transform
+   * them as well. */
+  mul_v4_m4v3_db(v1->fbcoord, ld->conf.view_projection, v1->gloc);
+  mul_v4_m4v3_db(v2->fbcoord, ld->conf.view_projection, v2->gloc);
+  mul_v3db_db(v1->fbcoord, (1 / v1->fbcoord[3]));
+  mul_v3db_db(v2->fbcoord, (1 / v2->fbcoord[3]));
+
+  v1->fbcoord[0] -= ld->conf.shift_x * 2;
+  v1->fbcoord[1] -= ld->conf.shift_y * 2;
+  v2->fbcoord[0] -= ld->conf.shift_x * 2;
+  v2->fbcoord[1] -= ld->conf.shift_y * 2;
+
+  /* This z transformation is not the same as the rest of the part, because the data don't go
+   * through normal perspective division calls in the pipeline, but this way the 3D result and
+   * occlusion on the generated line is correct, and we don't really use 2D for viewport stroke
+   * generation anyway. */
+  v1->fbcoord[2] = ZMin * ZMax / (ZMax - fabs(v1->fbcoord[2]) * (ZMax - ZMin));
+  v2->fbcoord[2] = ZMin * ZMax / (ZMax - fabs(v2->fbcoord[2]) * (ZMax - ZMin));
+  e->v1 = v1;
+  e->v2 = v2;
+  e->t1 = is->tri1;
+  e->t2 = is->tri2;
+  /* This is so we can also match intersection edges from shadow to later viewing stage. */
+  e->edge_identifier = (uint64_t(e->t1->target_reference) << 32) | e->t2->target_reference;
+  e->flags = MOD_LINEART_EDGE_FLAG_INTERSECTION;
+  e->intersection_mask = (is->tri1->intersection_mask | is->tri2->intersection_mask);
+  BLI_addtail(&e->segments, es);
+
+  int obi1 = (e->t1->target_reference & LRT_OBINDEX_HIGHER);
+  int obi2 = (e->t2->target_reference & LRT_OBINDEX_HIGHER);
+  LineartElementLinkNode *eln1 = lineart_find_matching_eln(&ld->geom.line_buffer_pointers, obi1);
+  LineartElementLinkNode *eln2 = obi1 == obi2 ? eln1 :
+                                                lineart_find_matching_eln(
+                                                    &ld->geom.line_buffer_pointers, obi2);
+  Object *ob1 = eln1 ? static_cast<Object *>(eln1->object_ref) : nullptr;
+  Object *ob2 = eln2 ? static_cast<Object *>(eln2->object_ref) : nullptr;
+  if (e->t1->intersection_priority > e->t2->intersection_priority) {
+    e->object_ref = ob1;
+  }
+  else if (e->t1->intersection_priority < e->t2->intersection_priority) {
+    e->object_ref = ob2;
+  }
+  else { /* equal priority */
+    if (ob1 == ob2) {
+      /* object_ref should be ambiguous if intersection lines comes from different objects. */
+      e->object_ref = ob1;
+    }
+  }
+}
+
+static void lineart_create_edges_from_isec_data(LineartIsecData *d)
+{
+  using namespace blender;
+  LineartData *ld = d->ld;
   int total_lines = 0;
 
+  /* Where the results of every thread start in the arrays allocated below. */
+  Array<int> thread_offsets(d->thread_count);
   for (int i = 0; i < d->thread_count; i++) {
     LineartIsecThread *th = &d->threads[i];
     if (G.debug_value == 4000) {
       printf("Thread %d isec generated %d lines.\n", i, th->current);
     }
-    if (!th->current) {
-      continue;
-    }
+    thread_offsets[i] = total_lines;
     total_lines += th->current;
   }
 
@@ -4679,74 +4752,23 @@ static void lineart_create_edges_from_isec_data(LineartIsecData *d)
   eln->flags |= LRT_ELEMENT_INTERSECTION_DATA;
   BLI_addhead(&ld->geom.line_buffer_pointers, eln);
 
-  for (int i = 0; i < d->thread_count; i++) {
-    LineartIsecThread *th = &d->threads[i];
-    if (!th->current) {
-      continue;
-    }
-
-    for (int j = 0; j < th->current; j++) {
-      LineartIsecSingle *is = &th->array[j];
-      LineartVert *v1 = v;
-      LineartVert *v2 = v + 1;
-      copy_v3_v3_db(v1->gloc, is->v1);
-      copy_v3_v3_db(v2->gloc, is->v2);
-      /* The intersection line has been generated only in geometry space, so we need to transform
-       * them as well. */
-      mul_v4_m4v3_db(v1->fbcoord, ld->conf.view_projection, v1->gloc);
-      mul_v4_m4v3_db(v2->fbcoord, ld->conf.view_projection, v2->gloc);
-      mul_v3db_db(v1->fbcoord, (1 / v1->fbcoord[3]));
-      mul_v3db_db(v2->fbcoord, (1 / v2->fbcoord[3]));
-
-      v1->fbcoord[0] -= ld->conf.shift_x * 2;
-      v1->fbcoord[1] -= ld->conf.shift_y * 2;
-      v2->fbcoord[0] -= ld->conf.shift_x * 2;
-      v2->fbcoord[1] -= ld->conf.shift_y * 2;
-
-      /* This z transformation is not the same as the rest of the part, because the data don't go
-       * through normal perspective division calls in the pipeline, but this way the 3D result and
-       * occlusion on the generated line is correct, and we don't really use 2D for viewport stroke
-       * generation anyway. */
-      v1->fbcoord[2] = ZMin * ZMax / (ZMax - fabs(v1->fbcoord[2]) * (ZMax - ZMin));
-      v2->fbcoord[2] = ZMin * ZMax / (ZMax - fabs(v2->fbcoord[2]) * (ZMax - ZMin));
-      e->v1 = v1;
-      e->v2 = v2;
-      e->t1 = is->tri1;
-      e->t2 = is->tri2;
-      /* This is so we can also match intersection edges from shadow to later viewing stage. */
-      e->edge_identifier = (uint64_t(e->t1->target_reference) << 32) | e->t2->target_reference;
-      e->flags = MOD_LINEART_EDGE_FLAG_INTERSECTION;
-      e->intersection_mask = (is->tri1->intersection_mask | is->tri2->intersection_mask);
-      BLI_addtail(&e->segments, es);
-
-      int obi1 = (e->t1->target_reference & LRT_OBINDEX_HIGHER);
-      int obi2 = (e->t2->target_reference & LRT_OBINDEX_HIGHER);
-      LineartElementLinkNode *eln1 = lineart_find_matching_eln(&ld->geom.line_buffer_pointers,
-                                                               obi1);
-      LineartElementLinkNode *eln2 = obi1 == obi2 ? eln1 :
-                                                    lineart_find_matching_eln(
-                                                        &ld->geom.line_buffer_pointers, obi2);
-      Object *ob1 = eln1 ? static_cast<Object *>(eln1->object_ref) : nullptr;
-      Object *ob2 = eln2 ? static_cast<Object *>(eln2->object_ref) : nullptr;
-      if (e->t1->intersection_priority > e->t2->intersection_priority) {
-        e->object_ref = ob1;
-      }
-      else if (e->t1->intersection_priority < e->t2->intersection_priority) {
-        e->object_ref = ob2;
-      }
-      else { /* equal priority */
-        if (ob1 == ob2) {
-          /* object_ref should be ambiguous if intersection lines comes from different objects. */
-          e->object_ref = ob1;
+  /* Every result is written to its own slot, the edges are only added to the pending array
+   * afterwards so that they keep the order of the threads. */
+  threading::parallel_for(IndexRange(d->thread_count), 1, [&](const IndexRange thread_range) {
+    for (const int i : thread_range) {
+      const LineartIsecThread *th = &d->threads[i];
+      threading::parallel_for(IndexRange(th->current), 1024, [&](const IndexRange range) {
+        for (const int j : range) {
+          const int index = thread_offsets[i] + j;
+          lineart_create_edge_from_isec(
+              ld, &th->array[j], &v[index * 2], &v[index * 2 + 1], &e[index], &es[index]);
         }
-      }
-
-      lineart_add_edge_to_array(&ld->pending_edges, e);
-
-      v += 2;
-      e++;
-      es++;
+      });
     }
+  });
+
+  for (int i = 0; i < total_lines; i++) {
+    lineart_add_edge_to_array(&ld->pending_edges, &e[i]);
   }
 }
 
@@ -5168,7 +5190,13 @@ bool MOD_lineart_compute_feature_lines_v3(Depsgraph *depsgraph,
 
     lineart_main_remove_unused_lines_from_tiles(ld);
 
-    /* Chaining is all single threaded. See `lineart_chain.cc`.
+    double t_chain_start;
+    if (G.debug_value == 4000) {
+      t_chain_start = BLI_time_now_seconds();
+    }
+
+    /* Building and connecting chains is single threaded, passes that work on every chain
+     * independently are threaded. See `lineart_chain.cc`.
      * In this particular call, only lines that are geometrically connected (share the _exact_
      * same end point) will be chained together. */
     MOD_lineart_chain_feature_lines(ld);
@@ -5205,6 +5233,11 @@ bool MOD_lineart_compute_feature_lines_v3(Depsgraph *depsgraph,
       MOD_lineart_chain_find_silhouette_backdrop_objects(ld);
     }
 
+    if (G.debug_value == 4000) {
+      double t_elapsed = BLI_time_now_seconds() - t_chain_start;
+      printf("Line art chaining time: %f\n", t_elapsed);
+    }
+
     /* Finally transfer the result list into cache. */
     memcpy(&lc->chains, &ld->chains, sizeof(ListBase));
 
@@ -883,6 +883,82 @@ static bool lineart_shadow_cast_onto_triangle(LineartData *ld,
   return true;
 }
 
+static void lineart_shadow_cast_single_edge(LineartData *ld,
+                                            LineartShadowEdge *sedge,
+                                            int thread_id)
+{
+  LineartTriangleThread *tri;
+  double at_1, at_2;
+  double fb_co_1[4], fb_co_2[4];
+  double global_1[3], global_2[3];
+  bool facing_light;
+
+  LRT_EDGE_BA_MARCHING_BEGIN(sedge->fbc1, sedge->fbc2)
+  {
+    for (int i = 0; i < nba->triangle_count; i++) {
+      tri = (LineartTriangleThread *)nba->linked_triangles[i];
+      if (tri->testing_e[thread_id] == (LineartEdge *)sedge || tri->base.mat_occlusion == 0 ||
+          lineart_edge_from_triangle(
+              (LineartTriangle *)tri, sedge->e_ref, ld->conf.allow_overlapping_edges))
+      {
+        continue;
+      }
+      tri->testing_e[thread_id] = (LineartEdge *)sedge;
+
+      if (lineart_shadow_cast_onto_triangle(ld,
+                                            (LineartTriangle *)tri,
+                                            sedge,
+                                            &at_1,
+                                            &at_2,
+                                            fb_co_1,
+                                            fb_co_2,
+                                            global_1,
+                                            global_2,
+                                            &facing_light))
+      {
+        lineart_shadow_edge_cut(ld,
+                                sedge,
+                                at_1,
+                                at_2,
+                                global_1,
+                                global_2,
+                                fb_co_1,
+                                fb_co_2,
+                                facing_light,
+                                tri->base.target_reference);
+      }
+    }
+    LRT_EDGE_BA_MARCHING_NEXT(sedge->fbc1, sedge->fbc2);
+  }
+  LRT_EDGE_BA_MARCHING_END;
+}
+
+static bool lineart_shadow_cast_make_task(LineartData *ld, int *r_start, int *r_end)
+{
+  BLI_spin_lock(&ld->lock_task);
+  const int starting_index = ld->scheduled_count;
+  ld->scheduled_count += LRT_THREAD_EDGE_COUNT;
+  BLI_spin_unlock(&ld->lock_task);
+
+  if (starting_index >= ld->shadow_edges_count) {
+    return false;
+  }
+  *r_start = starting_index;
+  *r_end = std::min(starting_index + LRT_THREAD_EDGE_COUNT, ld->shadow_edges_count);
+  return true;
+}
+
+static void lineart_shadow_cast_worker(TaskPool *__restrict /*pool*/, LineartRenderTaskInfo *rti)
+{
+  LineartData *ld = rti->ld;
+  int start, end;
+  while (lineart_shadow_cast_make_task(ld, &start, &end)) {
+    for (int edge_i = start; edge_i < end; edge_i++) {
+      lineart_shadow_cast_single_edge(ld, &ld->shadow_edges[edge_i], rti->thread_id);
+    }
+  }
+}
+
 /* The one step all to cast all visible edges in light camera back to other geometries behind them,
  * the result of this step can then be generated as actual LineartEdge's for occlusion test in view
  * camera. */
@@ -891,55 +967,23 @@ static void lineart_shadow_cast(LineartData *ld, bool transform_edge_cuts, bool
 
   lineart_shadow_create_shadow_edge_array(ld, transform_edge_cuts, do_light_contour);
 
-  /* Keep it single threaded for now because the loop will write "done" pointers to triangles. */
-  for (int edge_i = 0; edge_i < ld->shadow_edges_count; edge_i++) {
-    LineartShadowEdge *sedge = &ld->shadow_edges[edge_i];
+  /* Like occlusion, every thread marks the triangles it has tested in its own slot of
+   * #LineartTriangleThread::testing_e, and cuts are only added to the edge being cast. */
+  const int thread_count = ld->thread_count;
+  LineartRenderTaskInfo *rti = static_cast<LineartRenderTaskInfo *>(
+      MEM_callocN(sizeof(LineartRenderTaskInfo) * thread_count, __func__));
+  ld->scheduled_count = 0;
 
-    LineartTriangleThread *tri;
-    double at_1, at_2;
-    double fb_co_1[4], fb_co_2[4];
-    double global_1[3], global_2[3];
-    bool facing_light;
-
-    LRT_EDGE_BA_MARCHING_BEGIN(sedge->fbc1, sedge->fbc2)
-    {
-      for (int i = 0; i < nba->triangle_count; i++) {
-        tri = (LineartTriangleThread *)nba->linked_triangles[i];
-        if (tri->testing_e[0] == (LineartEdge *)sedge || tri->base.mat_occlusion == 0 ||
-            lineart_edge_from_triangle(
-                (LineartTriangle *)tri, sedge->e_ref, ld->conf.allow_overlapping_edges))
-        {
-          continue;
-        }
-        tri->testing_e[0] = (LineartEdge *)sedge;
-
-        if (lineart_shadow_cast_onto_triangle(ld,
-                                              (LineartTriangle *)tri,
-                                              sedge,
-                                              &at_1,
-                                              &at_2,
-                                              fb_co_1,
-                                              fb_co_2,
-                                              global_1,
-                                              global_2,
-                                              &facing_light))
-        {
-          lineart_shadow_edge_cut(ld,
-                                  sedge,
-                                  at_1,
-                                  at_2,
-                                  global_1,
-                                  global_2,
-                                  fb_co_1,
-                                  fb_co_2,
-                                  facing_light,
-                                  tri->base.target_reference);
-        }
-      }
-      LRT_EDGE_BA_MARCHING_NEXT(sedge->fbc1, sedge->fbc2);
-    }
-    LRT_EDGE_BA_MARCHING_END;
+  TaskPool *tp = BLI_task_pool_create(nullptr, TASK_PRIORITY_HIGH);
+  for (int i = 0; i < thread_count; i++) {
+    rti[i].thread_id = i;
+    rti[i].ld = ld;
+    BLI_task_pool_push(tp, (TaskRunFunction)lineart_shadow_cast_worker, &rti[i], false, nullptr);
   }
+  BLI_task_pool_work_and_wait(tp);
+  BLI_task_pool_free(tp);
+
+  MEM_freeN(rti);
 }
 
 /* For each [segment] on a shadow shadow_edge, 1 LineartEdge will be generated with a cast shadow
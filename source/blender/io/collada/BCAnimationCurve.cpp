@@ -309,6 +309,7 @@ void BCAnimationCurve::clean_handles()
   const KeyframeSettings settings = get_keyframe_settings(true);
 
   /* Keep old bezt data for copy). */
+  BKE_fcurve_bezt_ensure_mutable(fcurve);
   BezTriple *old_bezts = fcurve->bezt;
   int totvert = fcurve->totvert;
   fcurve->bezt = nullptr;
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "BLI_implicit_sharing.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_ID.h"
@@ -605,6 +606,11 @@ typedef struct FCurve {
   BezTriple *bezt;
   /** 'baked/imported' motion samples (array). */
   FPoint *fpt;
+  /**
+   * Run-time data that allows sharing #bezt with evaluated copies of the F-Curve. When set, #bezt
+   * is owned by it: use #BKE_fcurve_bezt_ensure_mutable() before modifying or freeing the array.
+   */
+  const ImplicitSharingInfoHandle *bezt_sharing_info;
   /** Total number of points which define the curve (i.e. size of arrays in FPoints). */
   unsigned int totvert;
 
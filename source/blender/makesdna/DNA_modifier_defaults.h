@@ -257,6 +257,7 @@
     .flag = 0, \
     .mode = 0, \
     .face_count = 0, \
+    .face_target = 1000, \
   }
 
 #define _DNA_DEFAULT_DisplaceModifierData \
@@ -321,7 +322,6 @@
     .verts_num = 0, \
     .repeat = 1, \
     .vertexco = NULL, \
-    .cache_system = NULL, \
     .flag = 0, \
   }
 
@@ -394,6 +394,7 @@ typedef struct ArrayModifierData {
   /**
    * General flags:
    * #MOD_ARR_MERGE -> merge vertices in adjacent duplicates.
+   * #MOD_ARR_INSTANCES -> output duplicates as instances when possible.
    */
   int flags;
   /** The number of duplicates to generate for #MOD_ARR_FIXEDCOUNT. */
@@ -419,6 +420,7 @@ enum {
 enum {
   MOD_ARR_MERGE = (1 << 0),
   MOD_ARR_MERGEFINAL = (1 << 1),
+  MOD_ARR_INSTANCES = (1 << 2),
 };
 
 typedef struct MirrorModifierData {
@@ -708,6 +710,9 @@ typedef struct DecimateModifierData {
 
   /** runtime only. */
   int face_count;
+  /** Number of triangles to reduce to (mode == MOD_DECIM_MODE_COLLAPSE). */
+  int face_target;
+  char _pad[4];
 } DecimateModifierData;
 
 enum {
@@ -717,6 +722,8 @@ enum {
   /** for dissolve only. collapse all verts between 2 faces */
   MOD_DECIM_FLAG_ALL_BOUNDARY_VERTS = (1 << 2),
   MOD_DECIM_FLAG_SYMMETRY = (1 << 3),
+  /** For collapse only. use #DecimateModifierData.face_target instead of the ratio. */
+  MOD_DECIM_FLAG_USE_FACE_TARGET = (1 << 4),
 };
 
 enum {
@@ -2102,8 +2109,7 @@ typedef struct LaplacianDeformModifierData {
   char anchor_grp_name[64];
   int verts_num, repeat;
   float *vertexco;
-  /** Runtime only. */
-  void *cache_system;
+  void *_pad1;
   short flag;
   char _pad[6];
 
@@ -2307,7 +2313,8 @@ typedef struct SurfaceDeformModifierData {
   struct Object *target;
   /** Vertex bind data. */
   SDefVert *verts;
-  void *_pad1;
+  /** Runtime only, `verts` flattened for evaluation (`SDefEvalData`). */
+  void *eval_data;
   float falloff;
   /* Number of vertices on the deformed mesh upon the bind process. */
   unsigned int mesh_verts_num;
@@ -153,4 +153,8 @@ enum {
   PTCACHE_COMPRESS_NO = 0,
   PTCACHE_COMPRESS_LZO = 1,
   PTCACHE_COMPRESS_LZMA = 2,
+  /** Fast Zstd compression of the raw data arrays. */
+  PTCACHE_COMPRESS_ZSTD_FAST = 3,
+  /** Zstd compression of data arrays with the bytes of every 4-byte word grouped together. */
+  PTCACHE_COMPRESS_ZSTD_FILTERED = 4,
 };
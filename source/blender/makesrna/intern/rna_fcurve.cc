@@ -676,6 +676,33 @@ static bool rna_FCurve_is_empty_get(PointerRNA *ptr)
   return BKE_fcurve_is_empty(fcu);
 }
 
+/* Keyframes can be modified through the collection items, so they must not be shared. */
+static void rna_FCurve_keyframe_points_begin(CollectionPropertyIterator *iter, PointerRNA *ptr)
+{
+  FCurve *fcu = (FCurve *)ptr->data;
+  BKE_fcurve_bezt_ensure_mutable(fcu);
+  rna_iterator_array_begin(iter, fcu->bezt, sizeof(BezTriple), fcu->totvert, false, nullptr);
+}
+
+static int rna_FCurve_keyframe_points_length(PointerRNA *ptr)
+{
+  const FCurve *fcu = (FCurve *)ptr->data;
+  return fcu->totvert;
+}
+
+static bool rna_FCurve_keyframe_points_lookup_int(PointerRNA *ptr, int index, PointerRNA *r_ptr)
+{
+  FCurve *fcu = (FCurve *)ptr->data;
+  if (fcu->bezt == nullptr || index < 0 || index >= fcu->totvert) {
+    return false;
+  }
+  BKE_fcurve_bezt_ensure_mutable(fcu);
+  r_ptr->owner_id = ptr->owner_id;
+  r_ptr->type = &RNA_Keyframe;
+  r_ptr->data = &fcu->bezt[index];
+  return true;
+}
+
 static void rna_tag_animation_update(Main *bmain, ID *id)
 {
   const int tags = ID_RECALC_ANIMATION;
@@ -2609,6 +2636,15 @@ static void rna_def_fcurve(BlenderRNA *brna)
 
   prop = RNA_def_property(srna, "keyframe_points", PROP_COLLECTION, PROP_NONE);
   RNA_def_property_collection_sdna(prop, nullptr, "bezt", "totvert");
+  RNA_def_property_collection_funcs(prop,
+                                    "rna_FCurve_keyframe_points_begin",
+                                    "rna_iterator_array_next",
+                                    "rna_iterator_array_end",
+                                    "rna_iterator_array_get",
+                                    "rna_FCurve_keyframe_points_length",
+                                    "rna_FCurve_keyframe_points_lookup_int",
+                                    nullptr,
+                                    nullptr);
   RNA_def_property_struct_type(prop, "Keyframe");
   RNA_def_property_ui_text(prop, "Keyframes", "User-editable keyframes");
   rna_def_fcurve_keyframe_points(brna, prop);
@@ -929,7 +929,7 @@ static void rna_Modifier_update(Main * /*bmain*/, Scene * /*scene*/, PointerRNA
 static void rna_Modifier_dependency_update(Main *bmain, Scene *scene, PointerRNA *ptr)
 {
   rna_Modifier_update(bmain, scene, ptr);
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_for_id(bmain, ptr->owner_id);
 }
 
 static void rna_Modifier_is_active_set(PointerRNA *ptr, bool value)
@@ -2953,6 +2953,20 @@ static void rna_def_modifier_decimate(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Ratio", "Ratio of triangles to reduce to (collapse only)");
   RNA_def_property_update(prop, 0, "rna_Modifier_update");
 
+  prop = RNA_def_property(srna, "use_face_target", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", MOD_DECIM_FLAG_USE_FACE_TARGET);
+  RNA_def_property_ui_text(prop,
+                           "Use Target Count",
+                           "Reduce to a number of triangles instead of a ratio (collapse only)");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
+  prop = RNA_def_property(srna, "face_target", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_range(prop, 1, INT_MAX);
+  RNA_def_property_ui_range(prop, 1, 1000000, 100, -1);
+  RNA_def_property_ui_text(
+      prop, "Target Count", "Number of triangles to reduce to (collapse only)");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
   /* (mode == MOD_DECIM_MODE_UNSUBDIV) */
   prop = RNA_def_property(srna, "iterations", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_int_sdna(prop, nullptr, "iter");
@@ -3618,6 +3632,14 @@ static void rna_def_modifier_array(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Merge Vertices", "Merge vertices in adjacent duplicates");
   RNA_def_property_update(prop, 0, "rna_Modifier_update");
 
+  prop = RNA_def_property(srna, "use_instances", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flags", MOD_ARR_INSTANCES);
+  RNA_def_property_ui_text(prop,
+                           "Instance Copies",
+                           "Output the copies as instances instead of one mesh, when they are not "
+                           "merged, capped or offset in UV space and no modifier follows");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
   prop = RNA_def_property(srna, "use_merge_vertices_cap", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, nullptr, "flags", MOD_ARR_MERGEFINAL);
   RNA_def_property_ui_text(
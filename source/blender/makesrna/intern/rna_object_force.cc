@@ -962,6 +962,13 @@ static void rna_def_pointcache_common(StructRNA *srna)
       {PTCACHE_COMPRESS_NO, "NO", 0, "None", "No compression"},
       {PTCACHE_COMPRESS_LZO, "LIGHT", 0, "Lite", "Fast but not so effective compression"},
       {PTCACHE_COMPRESS_LZMA, "HEAVY", 0, "Heavy", "Effective but slow compression"},
+      {PTCACHE_COMPRESS_ZSTD_FAST, "ZSTD_FAST", 0, "Fast", "Fast Zstd compression"},
+      {PTCACHE_COMPRESS_ZSTD_FILTERED,
+       "ZSTD_FILTERED",
+       0,
+       "Filtered",
+       "Zstd compression of the cached data reordered for a better compression ratio, "
+       "usually smaller than Heavy and much faster to read and write"},
       {0, nullptr, 0, nullptr, nullptr},
   };
 
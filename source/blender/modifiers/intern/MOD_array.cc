@@ -13,6 +13,7 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_math_matrix.h"
+#include "BLI_math_matrix.hh"
 #include "BLI_math_vector.h"
 #include "BLI_span.hh"
 
@@ -27,11 +28,14 @@
 #include "BKE_attribute.hh"
 #include "BKE_curve.hh"
 #include "BKE_customdata.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_instances.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_lib_query.hh"
 #include "BKE_mesh.hh"
 #include "BKE_mesh_wrapper.hh"
 #include "BKE_modifier.hh"
+#include "BKE_object.hh"
 #include "BKE_object_deform.h"
 #include "BKE_object_types.hh"
 
@@ -44,6 +48,7 @@
 #include "MOD_ui_common.hh"
 
 #include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_query.hh"
 
 #include "GEO_mesh_merge_by_distance.hh"
 
@@ -372,6 +377,114 @@ static void mesh_merge_transform(Mesh *result,
   }
 }
 
+/**
+ * Build up the offset between two consecutive copies, accumulating all settings options, and
+ * compute the number of copies. The number of copies is limited by the amount of vertices a
+ * realized result would have, with \a chunk_verts_num vertices per copy.
+ */
+static void array_offset_and_count_get(ArrayModifierData *amd,
+                                       const ModifierEvalContext *ctx,
+                                       const Mesh *mesh,
+                                       const size_t chunk_verts_num,
+                                       const size_t caps_verts_num,
+                                       float r_offset[4][4],
+                                       int *r_count)
+{
+  using namespace blender;
+  const bool use_offset_ob = ((amd->offset_type & MOD_ARR_OFF_OBJ) && amd->offset_ob != nullptr);
+  float length = amd->length;
+  int count = amd->count;
+
+  unit_m4(r_offset);
+
+  if (amd->offset_type & MOD_ARR_OFF_CONST) {
+    add_v3_v3(r_offset[3], amd->offset);
+  }
+
+  if (amd->offset_type & MOD_ARR_OFF_RELATIVE) {
+    const Bounds<float3> bounds = *mesh->bounds_min_max();
+    for (int j = 3; j--;) {
+      r_offset[3][j] += amd->scale[j] * (bounds.max[j] - bounds.min[j]);
+    }
+  }
+
+  if (use_offset_ob) {
+    float obinv[4][4];
+    float result_mat[4][4];
+
+    if (ctx->object) {
+      invert_m4_m4(obinv, ctx->object->object_to_world().ptr());
+    }
+    else {
+      unit_m4(obinv);
+    }
+
+    mul_m4_series(result_mat, r_offset, obinv, amd->offset_ob->object_to_world().ptr());
+    copy_m4_m4(r_offset, result_mat);
+  }
+
+  if (amd->fit_type == MOD_ARR_FITCURVE && amd->curve_ob != nullptr) {
+    Object *curve_ob = amd->curve_ob;
+    CurveCache *curve_cache = curve_ob->runtime->curve_cache;
+    if (curve_cache != nullptr && curve_cache->anim_path_accum_length != nullptr) {
+      float scale_fac = mat4_to_scale(curve_ob->object_to_world().ptr());
+      length = scale_fac * BKE_anim_path_get_length(curve_cache);
+    }
+  }
+
+  /* About 67 million vertices max seems a decent limit for now. */
+  const size_t max_verts_num = 1 << 26;
+
+  /* calculate the maximum number of copies which will fit within the
+   * prescribed length */
+  if (ELEM(amd->fit_type, MOD_ARR_FITLENGTH, MOD_ARR_FITCURVE)) {
+    const float float_epsilon = 1e-6f;
+    bool offset_is_too_small = false;
+    float dist = len_v3(r_offset[3]);
+
+    if (dist > float_epsilon) {
+      /* this gives length = first copy start to last copy end
+       * add a tiny offset for floating point rounding errors */
+      count = (length + float_epsilon) / dist + 1;
+
+      /* Ensure we keep things to a reasonable level, in terms of rough total amount of generated
+       * vertices.
+       */
+      if ((size_t(count) * chunk_verts_num + caps_verts_num) > max_verts_num) {
+        count = 1;
+        offset_is_too_small = true;
+      }
+    }
+    else {
+      /* if the offset has no translation, just make one copy */
+      count = 1;
+      offset_is_too_small = true;
+    }
+
+    if (offset_is_too_small) {
+      BKE_modifier_set_error(
+          ctx->object,
+          &amd->modifier,
+          "The offset is too small, we cannot generate the amount of geometry it would require");
+    }
+  }
+  /* Ensure we keep things to a reasonable level, in terms of rough total amount of generated
+   * vertices.
+   */
+  else if ((size_t(count) * chunk_verts_num + caps_verts_num) > max_verts_num) {
+    count = 1;
+    BKE_modifier_set_error(ctx->object,
+                           &amd->modifier,
+                           "The amount of copies is too high, we cannot generate the amount of "
+                           "geometry it would require");
+  }
+
+  if (count < 1) {
+    count = 1;
+  }
+  *r_count = count;
+}
+
 static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
                                    const ModifierEvalContext *ctx,
                                    Mesh *mesh)
@@ -391,8 +504,7 @@ static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
   }
 
   int2 *edge;
-  int i, j, c, count;
-  float length = amd->length;
+  int i, c, count;
   /* offset matrix */
   float offset[4][4];
   float scale[3];
@@ -404,7 +516,6 @@ static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
 
   const bool use_merge = (amd->flags & MOD_ARR_MERGE) != 0;
   const bool use_recalc_normals = BKE_mesh_vert_normals_are_dirty(mesh) || use_merge;
-  const bool use_offset_ob = ((amd->offset_type & MOD_ARR_OFF_OBJ) && amd->offset_ob != nullptr);
 
   int start_cap_nverts = 0, start_cap_nedges = 0, start_cap_nfaces = 0, start_cap_nloops = 0;
   int end_cap_nverts = 0, end_cap_nedges = 0, end_cap_nfaces = 0, end_cap_nloops = 0;
@@ -424,8 +535,6 @@ static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
   chunk_nloops = mesh->corners_num;
   chunk_nfaces = mesh->faces_num;
 
-  count = amd->count;
-
   Object *start_cap_ob = amd->start_cap;
   if (start_cap_ob && start_cap_ob != ctx->object) {
     if (start_cap_ob->type == OB_MESH && ctx->object->type == OB_MESH) {
@@ -459,104 +568,18 @@ static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
     }
   }
 
-  /* Build up offset array, accumulating all settings options. */
-
-  unit_m4(offset);
-
-  if (amd->offset_type & MOD_ARR_OFF_CONST) {
-    add_v3_v3(offset[3], amd->offset);
-  }
-
-  if (amd->offset_type & MOD_ARR_OFF_RELATIVE) {
-    const Bounds<float3> bounds = *mesh->bounds_min_max();
-    for (j = 3; j--;) {
-      offset[3][j] += amd->scale[j] * (bounds.max[j] - bounds.min[j]);
-    }
-  }
-
-  if (use_offset_ob) {
-    float obinv[4][4];
-    float result_mat[4][4];
-
-    if (ctx->object) {
-      invert_m4_m4(obinv, ctx->object->object_to_world().ptr());
-    }
-    else {
-      unit_m4(obinv);
-    }
-
-    mul_m4_series(result_mat, offset, obinv, amd->offset_ob->object_to_world().ptr());
-    copy_m4_m4(offset, result_mat);
-  }
+  array_offset_and_count_get(amd,
+                             ctx,
+                             mesh,
+                             size_t(chunk_nverts),
+                             size_t(start_cap_nverts) + size_t(end_cap_nverts),
+                             offset,
+                             &count);
 
   /* Check if there is some scaling. If scaling, then we will not translate mapping */
   mat4_to_size(scale, offset);
   offset_has_scale = !is_one_v3(scale);
 
-  if (amd->fit_type == MOD_ARR_FITCURVE && amd->curve_ob != nullptr) {
-    Object *curve_ob = amd->curve_ob;
-    CurveCache *curve_cache = curve_ob->runtime->curve_cache;
-    if (curve_cache != nullptr && curve_cache->anim_path_accum_length != nullptr) {
-      float scale_fac = mat4_to_scale(curve_ob->object_to_world().ptr());
-      length = scale_fac * BKE_anim_path_get_length(curve_cache);
-    }
-  }
-
-  /* About 67 million vertices max seems a decent limit for now. */
-  const size_t max_verts_num = 1 << 26;
-
-  /* calculate the maximum number of copies which will fit within the
-   * prescribed length */
-  if (ELEM(amd->fit_type, MOD_ARR_FITLENGTH, MOD_ARR_FITCURVE)) {
-    const float float_epsilon = 1e-6f;
-    bool offset_is_too_small = false;
-    float dist = len_v3(offset[3]);
-
-    if (dist > float_epsilon) {
-      /* this gives length = first copy start to last copy end
-       * add a tiny offset for floating point rounding errors */
-      count = (length + float_epsilon) / dist + 1;
-
-      /* Ensure we keep things to a reasonable level, in terms of rough total amount of generated
-       * vertices.
-       */
-      if ((size_t(count) * size_t(chunk_nverts) + size_t(start_cap_nverts) +
-           size_t(end_cap_nverts)) > max_verts_num)
-      {
-        count = 1;
-        offset_is_too_small = true;
-      }
-    }
-    else {
-      /* if the offset has no translation, just make one copy */
-      count = 1;
-      offset_is_too_small = true;
-    }
-
-    if (offset_is_too_small) {
-      BKE_modifier_set_error(
-          ctx->object,
-          &amd->modifier,
-          "The offset is too small, we cannot generate the amount of geometry it would require");
-    }
-  }
-  /* Ensure we keep things to a reasonable level, in terms of rough total amount of generated
-   * vertices.
-   */
-  else if ((size_t(count) * size_t(chunk_nverts) + size_t(start_cap_nverts) +
-            size_t(end_cap_nverts)) > max_verts_num)
-  {
-    count = 1;
-    BKE_modifier_set_error(ctx->object,
-                           &amd->modifier,
-                           "The amount of copies is too high, we cannot generate the amount of "
-                           "geometry it would require");
-  }
-
-  if (count < 1) {
-    count = 1;
-  }
-
   /* The number of verts, edges, loops, faces, before eventually merging doubles */
   result_nverts = chunk_nverts * count + start_cap_nverts + end_cap_nverts;
   result_nedges = chunk_nedges * count + start_cap_nedges + end_cap_nedges;
@@ -865,6 +888,93 @@ static Mesh *modify_mesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh
   return arrayModifier_doArray(amd, ctx, mesh);
 }
 
+/**
+ * Copies can be output as instances when the result is the same as for a realized mesh, i.e. when
+ * they are not merged, capped or offset in UV space. The instances only exist next to the final
+ * mesh, so following modifiers would only affect the first copy. Applying the modifier needs a
+ * single mesh as well.
+ */
+static bool array_use_instances(ArrayModifierData *amd,
+                                const ModifierEvalContext *ctx,
+                                const bke::GeometrySet &geometry_set)
+{
+  if ((amd->flags & MOD_ARR_INSTANCES) == 0 || (amd->flags & MOD_ARR_MERGE) != 0) {
+    return false;
+  }
+  if (ctx->flag & MOD_APPLY_TO_BASE_MESH) {
+    return false;
+  }
+  if ((amd->start_cap && amd->start_cap != ctx->object) ||
+      (amd->end_cap && amd->end_cap != ctx->object))
+  {
+    return false;
+  }
+  if (amd->uv_offset[0] != 0.0f || amd->uv_offset[1] != 0.0f) {
+    return false;
+  }
+  if (geometry_set.has_instances()) {
+    return false;
+  }
+  const Scene *scene = DEG_get_evaluated_scene(ctx->depsgraph);
+  int required_mode = eModifierMode_Render;
+  if (!(ctx->flag & MOD_APPLY_RENDER)) {
+    /* Match the mode used by edit-mesh evaluation, see #editbmesh_calc_modifiers. */
+    required_mode = BKE_object_is_in_editmode(ctx->object) ?
+                        eModifierMode_Realtime | eModifierMode_Editmode :
+                        eModifierMode_Realtime;
+  }
+  for (ModifierData *md = amd->modifier.next; md; md = md->next) {
+    if (BKE_modifier_is_enabled(scene, md, required_mode)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void modify_geometry_set(ModifierData *md,
+                                const ModifierEvalContext *ctx,
+                                bke::GeometrySet *geometry_set)
+{
+  ArrayModifierData *amd = (ArrayModifierData *)md;
+  Mesh *mesh = geometry_set->get_mesh_for_write();
+  if (mesh == nullptr) {
+    return;
+  }
+
+  if (!array_use_instances(amd, ctx, *geometry_set) || mesh->verts_num == 0) {
+    Mesh *result = arrayModifier_doArray(amd, ctx, mesh);
+    if (result != mesh) {
+      geometry_set->replace_mesh(result);
+    }
+    return;
+  }
+
+  float offset[4][4];
+  int count;
+  /* Instances are not realized, so only limit the number of copies. */
+  array_offset_and_count_get(amd, ctx, mesh, 1, 0, offset, &count);
+  if (count == 1) {
+    return;
+  }
+
+  /* The first copy stays the evaluated mesh, so edit-mode mapping keeps working. The others
+   * share its data through implicit sharing rather than copying it. */
+  std::unique_ptr<bke::Instances> instances = std::make_unique<bke::Instances>();
+  const int handle = instances->add_reference(
+      bke::InstanceReference(bke::GeometrySet::from_mesh(BKE_mesh_copy_for_eval(*mesh))));
+  instances->resize(count - 1);
+  instances->reference_handles_for_write().fill(handle);
+
+  MutableSpan<float4x4> transforms = instances->transforms_for_write();
+  float4x4 current_offset = float4x4::identity();
+  for (const int i : transforms.index_range()) {
+    current_offset = current_offset * float4x4(offset);
+    transforms[i] = current_offset;
+  }
+
+  geometry_set->replace_instances(instances.release());
+}
+
 static bool is_disabled(const Scene * /*scene*/, ModifierData *md, bool /*use_render_params*/)
 {
   ArrayModifierData *amd = (ArrayModifierData *)md;
@@ -910,6 +1020,8 @@ static void panel_draw(const bContext * /*C*/, Panel *panel)
     uiItemR(layout, ptr, "curve", UI_ITEM_NONE, nullptr, ICON_NONE);
   }
 
+  uiItemR(layout, ptr, "use_instances", UI_ITEM_NONE, nullptr, ICON_NONE);
+
   modifier_panel_end(layout, ptr);
 }
 
@@ -1083,7 +1195,7 @@ ModifierTypeInfo modifierType_Array = {
     /*deform_verts_EM*/ nullptr,
     /*deform_matrices_EM*/ nullptr,
     /*modify_mesh*/ modify_mesh,
-    /*modify_geometry_set*/ nullptr,
+    /*modify_geometry_set*/ modify_geometry_set,
 
     /*init_data*/ init_data,
     /*required_data_mask*/ nullptr,
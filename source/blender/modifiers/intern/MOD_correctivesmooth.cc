@@ -8,9 +8,11 @@
  * Method of smoothing deformation, also known as 'delta-mush'.
  */
 
+#include "BLI_array.hh"
 #include "BLI_math_base.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.hh"
@@ -25,6 +27,7 @@
 
 #include "BKE_deform.hh"
 #include "BKE_editmesh.hh"
+#include "BKE_mesh_mapping.hh"
 
 #include "UI_interface.hh"
 #include "UI_resources.hh"
@@ -49,6 +52,27 @@
 
 #include "BLI_strict_flags.h" /* Keep last. */
 
+/**
+ * Data that only depends on the topology of the mesh, stored in #ModifierData.runtime so that it
+ * survives evaluations (and copies of the modifier) until the topology changes.
+ */
+struct CorrectiveSmoothRuntime {
+  /** Topology the data below was computed for. */
+  blender::MeshTopologyKey topology_key;
+
+  blender::Array<int> vert_to_edge_offsets;
+  blender::Array<int> vert_to_edge_indices;
+  blender::GroupedSpan<int> vert_to_edge;
+
+  /** Face corners of every vertex, in ascending order. */
+  blender::Array<int> vert_to_corner_offsets;
+  blender::Array<int> vert_to_corner_indices;
+  blender::GroupedSpan<int> vert_to_corner;
+
+  /** Vertices of edges used by a single face, see #MOD_CORRECTIVESMOOTH_PIN_BOUNDARY. */
+  blender::Array<bool> boundary_verts;
+};
+
 static void init_data(ModifierData *md)
 {
   CorrectiveSmoothModifierData *csmd = (CorrectiveSmoothModifierData *)md;
@@ -83,10 +107,17 @@ static void freeBind(CorrectiveSmoothModifierData *csmd)
   csmd->bind_coords_num = 0;
 }
 
+static void free_runtime_data(void *runtime_data)
+{
+  MEM_delete(static_cast<CorrectiveSmoothRuntime *>(runtime_data));
+}
+
 static void free_data(ModifierData *md)
 {
   CorrectiveSmoothModifierData *csmd = (CorrectiveSmoothModifierData *)md;
   freeBind(csmd);
+  free_runtime_data(md->runtime);
+  md->runtime = nullptr;
 }
 
 static void required_data_mask(ModifierData *md, CustomData_MeshMasks *r_cddata_masks)
@@ -99,37 +130,43 @@ static void required_data_mask(ModifierData *md, CustomData_MeshMasks *r_cddata_
   }
 }
 
-/* check individual weights for changes and cache values */
-static void mesh_get_weights(const MDeformVert *dvert,
-                             const int defgrp_index,
-                             const uint verts_num,
-                             const bool use_invert_vgroup,
-                             float *smooth_weights)
-{
-  uint i;
-
-  for (i = 0; i < verts_num; i++, dvert++) {
-    const float w = BKE_defvert_find_weight(dvert, defgrp_index);
-
-    if (use_invert_vgroup == false) {
-      smooth_weights[i] = w;
-    }
-    else {
-      smooth_weights[i] = 1.0f - w;
-    }
-  }
-}
-
-static void mesh_get_boundaries(Mesh *mesh, float *smooth_weights)
+/**
+ * Get the topology data of the mesh, computing it when the topology changed since the previous
+ * evaluation.
+ */
+static const CorrectiveSmoothRuntime &runtime_ensure(CorrectiveSmoothModifierData *csmd,
+                                                     const Mesh *mesh,
+                                                     bool *r_topology_changed)
 {
-  const blender::Span<blender::int2> edges = mesh->edges();
-  const blender::OffsetIndices faces = mesh->faces();
-  const blender::Span<int> corner_edges = mesh->corner_edges();
+  using namespace blender;
+  CorrectiveSmoothRuntime *runtime = static_cast<CorrectiveSmoothRuntime *>(
+      csmd->modifier.runtime);
+  if (runtime && runtime->topology_key.matches(*mesh)) {
+    *r_topology_changed = false;
+    return *runtime;
+  }
+  *r_topology_changed = true;
+
+  free_runtime_data(runtime);
+  runtime = MEM_new<CorrectiveSmoothRuntime>(__func__);
+  csmd->modifier.runtime = runtime;
+  runtime->topology_key.update(*mesh);
+
+  const Span<int2> edges = mesh->edges();
+  const OffsetIndices faces = mesh->faces();
+  const Span<int> corner_edges = mesh->corner_edges();
+
+  runtime->vert_to_edge = bke::mesh::build_vert_to_edge_map(edges,
+                                                            mesh->verts_num,
+                                                            runtime->vert_to_edge_offsets,
+                                                            runtime->vert_to_edge_indices);
+  runtime->vert_to_corner = bke::mesh::build_vert_to_corner_map(mesh->corner_verts(),
+                                                                mesh->verts_num,
+                                                                runtime->vert_to_corner_offsets,
+                                                                runtime->vert_to_corner_indices);
 
   /* Flag boundary edges so only boundaries are set to 1. */
-  uint8_t *boundaries = static_cast<uint8_t *>(
-      MEM_calloc_arrayN(size_t(edges.size()), sizeof(*boundaries), __func__));
-
+  Array<uint8_t> boundaries(edges.size(), 0);
   for (const int64_t i : faces.index_range()) {
     for (const int edge : corner_edges.slice(faces[i])) {
       uint8_t *e_value = &boundaries[edge];
@@ -137,14 +174,37 @@ static void mesh_get_boundaries(Mesh *mesh, float *smooth_weights)
     }
   }
 
+  runtime->boundary_verts.reinitialize(mesh->verts_num);
+  runtime->boundary_verts.fill(false);
   for (const int64_t i : edges.index_range()) {
     if (boundaries[i] == 1) {
-      smooth_weights[edges[i][0]] = 0.0f;
-      smooth_weights[edges[i][1]] = 0.0f;
+      runtime->boundary_verts[edges[i][0]] = true;
+      runtime->boundary_verts[edges[i][1]] = true;
     }
   }
 
-  MEM_freeN(boundaries);
+  return *runtime;
+}
+
+/* check individual weights for changes and cache values */
+static void mesh_get_weights(const MDeformVert *dvert,
+                             const int defgrp_index,
+                             const bool use_invert_vgroup,
+                             blender::MutableSpan<float> smooth_weights)
+{
+  blender::threading::parallel_for(
+      smooth_weights.index_range(), 4096, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          const float w = BKE_defvert_find_weight(&dvert[i], defgrp_index);
+
+          if (use_invert_vgroup == false) {
+            smooth_weights[i] = w;
+          }
+          else {
+            smooth_weights[i] = 1.0f - w;
+          }
+        }
+      });
 }
 
 /* -------------------------------------------------------------------- */
@@ -154,76 +214,69 @@ static void mesh_get_boundaries(Mesh *mesh, float *smooth_weights)
  */
 static void smooth_iter__simple(CorrectiveSmoothModifierData *csmd,
                                 Mesh *mesh,
+                                const CorrectiveSmoothRuntime &runtime,
                                 blender::MutableSpan<blender::float3> vertexCos,
                                 const float *smooth_weights,
                                 uint iterations)
 {
+  using namespace blender;
   const float lambda = csmd->lambda;
-  int i;
 
-  const int edges_num = mesh->edges_num;
-  const blender::Span<blender::int2> edges = mesh->edges();
+  const Span<int2> edges = mesh->edges();
+  const GroupedSpan<int> vert_to_edge = runtime.vert_to_edge;
 
   struct SmoothingData_Simple {
     float delta[3];
   };
-  SmoothingData_Simple *smooth_data = MEM_cnew_array<SmoothingData_Simple>(
-      size_t(vertexCos.size()), __func__);
-
-  float *vertex_edge_count_div = static_cast<float *>(
-      MEM_calloc_arrayN(size_t(vertexCos.size()), sizeof(float), __func__));
-
-  /* calculate as floats to avoid int->float conversion in #smooth_iter */
-  for (i = 0; i < edges_num; i++) {
-    vertex_edge_count_div[edges[i][0]] += 1.0f;
-    vertex_edge_count_div[edges[i][1]] += 1.0f;
-  }
+  Array<SmoothingData_Simple> smooth_data(vertexCos.size());
 
   /* a little confusing, but we can include 'lambda' and smoothing weight
    * here to avoid multiplying for every iteration */
-  if (smooth_weights == nullptr) {
-    for (i = 0; i < vertexCos.size(); i++) {
-      vertex_edge_count_div[i] = lambda * (vertex_edge_count_div[i] ?
-                                               (1.0f / vertex_edge_count_div[i]) :
-                                               1.0f);
-    }
-  }
-  else {
-    for (i = 0; i < vertexCos.size(); i++) {
-      vertex_edge_count_div[i] = smooth_weights[i] * lambda *
-                                 (vertex_edge_count_div[i] ? (1.0f / vertex_edge_count_div[i]) :
-                                                             1.0f);
+  Array<float> vertex_edge_count_div(vertexCos.size());
+  threading::parallel_for(vertexCos.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      /* calculate as floats to avoid int->float conversion in #smooth_iter */
+      const float vertex_edge_count = float(vert_to_edge[i].size());
+      if (smooth_weights == nullptr) {
+        vertex_edge_count_div[i] = lambda *
+                                   (vertex_edge_count ? (1.0f / vertex_edge_count) : 1.0f);
+      }
+      else {
+        vertex_edge_count_div[i] = smooth_weights[i] * lambda *
+                                   (vertex_edge_count ? (1.0f / vertex_edge_count) : 1.0f);
+      }
     }
-  }
+  });
 
   /* -------------------------------------------------------------------- */
   /* Main Smoothing Loop */
 
+  /* Every vertex gathers the edge directions in the order of the edges, then all vertices move at
+   * once, matching a loop over the edges that accumulates into both vertices. */
   while (iterations--) {
-    for (i = 0; i < edges_num; i++) {
-      SmoothingData_Simple *sd_v1;
-      SmoothingData_Simple *sd_v2;
-      float edge_dir[3];
-
-      sub_v3_v3v3(edge_dir, vertexCos[edges[i][1]], vertexCos[edges[i][0]]);
-
-      sd_v1 = &smooth_data[edges[i][0]];
-      sd_v2 = &smooth_data[edges[i][1]];
-
-      add_v3_v3(sd_v1->delta, edge_dir);
-      sub_v3_v3(sd_v2->delta, edge_dir);
-    }
+    threading::parallel_for(vertexCos.index_range(), 1024, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        SmoothingData_Simple *sd = &smooth_data[i];
+        zero_v3(sd->delta);
+        for (const int edge : vert_to_edge[i]) {
+          float edge_dir[3];
+          sub_v3_v3v3(edge_dir, vertexCos[edges[edge][1]], vertexCos[edges[edge][0]]);
+          if (edges[edge][0] == i) {
+            add_v3_v3(sd->delta, edge_dir);
+          }
+          else {
+            sub_v3_v3(sd->delta, edge_dir);
+          }
+        }
+      }
+    });
 
-    for (i = 0; i < vertexCos.size(); i++) {
-      SmoothingData_Simple *sd = &smooth_data[i];
-      madd_v3_v3fl(vertexCos[i], sd->delta, vertex_edge_count_div[i]);
-      /* zero for the next iteration (saves memset on entire array) */
-      memset(sd, 0, sizeof(*sd));
-    }
+    threading::parallel_for(vertexCos.index_range(), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        madd_v3_v3fl(vertexCos[i], smooth_data[i].delta, vertex_edge_count_div[i]);
+      }
+    });
   }
-
-  MEM_freeN(vertex_edge_count_div);
-  MEM_freeN(smooth_data);
 }
 
 /* -------------------------------------------------------------------- */
@@ -231,151 +284,133 @@ static void smooth_iter__simple(CorrectiveSmoothModifierData *csmd,
  */
 static void smooth_iter__length_weight(CorrectiveSmoothModifierData *csmd,
                                        Mesh *mesh,
+                                       const CorrectiveSmoothRuntime &runtime,
                                        blender::MutableSpan<blender::float3> vertexCos,
                                        const float *smooth_weights,
                                        uint iterations)
 {
+  using namespace blender;
   const float eps = FLT_EPSILON * 10.0f;
-  const uint edges_num = uint(mesh->edges_num);
   /* NOTE: the way this smoothing method works, its approx half as strong as the simple-smooth,
    * and 2.0 rarely spikes, double the value for consistent behavior. */
   const float lambda = csmd->lambda * 2.0f;
-  const blender::Span<blender::int2> edges = mesh->edges();
-  uint i;
+  const Span<int2> edges = mesh->edges();
+  const GroupedSpan<int> vert_to_edge = runtime.vert_to_edge;
 
   struct SmoothingData_Weighted {
     float delta[3];
     float edge_length_sum;
   };
-  SmoothingData_Weighted *smooth_data = MEM_cnew_array<SmoothingData_Weighted>(
-      size_t(vertexCos.size()), __func__);
-
-  /* calculate as floats to avoid int->float conversion in #smooth_iter */
-  float *vertex_edge_count = static_cast<float *>(
-      MEM_calloc_arrayN(size_t(vertexCos.size()), sizeof(float), __func__));
-  for (i = 0; i < edges_num; i++) {
-    vertex_edge_count[edges[i][0]] += 1.0f;
-    vertex_edge_count[edges[i][1]] += 1.0f;
-  }
+  Array<SmoothingData_Weighted> smooth_data(vertexCos.size());
 
   /* -------------------------------------------------------------------- */
   /* Main Smoothing Loop */
 
   while (iterations--) {
-    for (i = 0; i < edges_num; i++) {
-      SmoothingData_Weighted *sd_v1;
-      SmoothingData_Weighted *sd_v2;
-      float edge_dir[3];
-      float edge_dist;
-
-      sub_v3_v3v3(edge_dir, vertexCos[edges[i][1]], vertexCos[edges[i][0]]);
-      edge_dist = len_v3(edge_dir);
-
-      /* weight by distance */
-      mul_v3_fl(edge_dir, edge_dist);
-
-      sd_v1 = &smooth_data[edges[i][0]];
-      sd_v2 = &smooth_data[edges[i][1]];
-
-      add_v3_v3(sd_v1->delta, edge_dir);
-      sub_v3_v3(sd_v2->delta, edge_dir);
-
-      sd_v1->edge_length_sum += edge_dist;
-      sd_v2->edge_length_sum += edge_dist;
-    }
-
-    if (smooth_weights == nullptr) {
-      /* fast-path */
-      for (i = 0; i < vertexCos.size(); i++) {
+    threading::parallel_for(vertexCos.index_range(), 1024, [&](const IndexRange range) {
+      for (const int64_t i : range) {
         SmoothingData_Weighted *sd = &smooth_data[i];
-        /* Divide by sum of all neighbor distances (weighted) and amount of neighbors,
-         * (mean average). */
-        const float div = sd->edge_length_sum * vertex_edge_count[i];
-        if (div > eps) {
-#if 0
-          /* first calculate the new location */
-          mul_v3_fl(sd->delta, 1.0f / div);
-          /* then interpolate */
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda);
-#else
-          /* do this in one step */
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda / div);
-#endif
+        zero_v3(sd->delta);
+        sd->edge_length_sum = 0.0f;
+        for (const int edge : vert_to_edge[i]) {
+          float edge_dir[3];
+          float edge_dist;
+
+          sub_v3_v3v3(edge_dir, vertexCos[edges[edge][1]], vertexCos[edges[edge][0]]);
+          edge_dist = len_v3(edge_dir);
+
+          /* weight by distance */
+          mul_v3_fl(edge_dir, edge_dist);
+
+          if (edges[edge][0] == i) {
+            add_v3_v3(sd->delta, edge_dir);
+          }
+          else {
+            sub_v3_v3(sd->delta, edge_dir);
+          }
+          sd->edge_length_sum += edge_dist;
         }
-        /* zero for the next iteration (saves memset on entire array) */
-        memset(sd, 0, sizeof(*sd));
       }
-    }
-    else {
-      for (i = 0; i < vertexCos.size(); i++) {
-        SmoothingData_Weighted *sd = &smooth_data[i];
-        const float div = sd->edge_length_sum * vertex_edge_count[i];
+    });
+
+    threading::parallel_for(vertexCos.index_range(), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        const SmoothingData_Weighted *sd = &smooth_data[i];
+        /* Divide by sum of all neighbor distances (weighted) and amount of neighbors,
+         * (mean average). */
+        const float div = sd->edge_length_sum * float(vert_to_edge[i].size());
         if (div > eps) {
-          const float lambda_w = lambda * smooth_weights[i];
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda_w / div);
+          if (smooth_weights == nullptr) {
+            /* fast-path */
+            madd_v3_v3fl(vertexCos[i], sd->delta, lambda / div);
+          }
+          else {
+            const float lambda_w = lambda * smooth_weights[i];
+            madd_v3_v3fl(vertexCos[i], sd->delta, lambda_w / div);
+          }
         }
-
-        memset(sd, 0, sizeof(*sd));
       }
-    }
+    });
   }
-
-  MEM_freeN(vertex_edge_count);
-  MEM_freeN(smooth_data);
 }
 
 static void smooth_iter(CorrectiveSmoothModifierData *csmd,
                         Mesh *mesh,
+                        const CorrectiveSmoothRuntime &runtime,
                         blender::MutableSpan<blender::float3> vertexCos,
                         const float *smooth_weights,
                         uint iterations)
 {
   switch (csmd->smooth_type) {
     case MOD_CORRECTIVESMOOTH_SMOOTH_LENGTH_WEIGHT:
-      smooth_iter__length_weight(csmd, mesh, vertexCos, smooth_weights, iterations);
+      smooth_iter__length_weight(csmd, mesh, runtime, vertexCos, smooth_weights, iterations);
       break;
 
     /* case MOD_CORRECTIVESMOOTH_SMOOTH_SIMPLE: */
     default:
-      smooth_iter__simple(csmd, mesh, vertexCos, smooth_weights, iterations);
+      smooth_iter__simple(csmd, mesh, runtime, vertexCos, smooth_weights, iterations);
       break;
   }
 }
 
 static void smooth_verts(CorrectiveSmoothModifierData *csmd,
                          Mesh *mesh,
+                         const CorrectiveSmoothRuntime &runtime,
                          const MDeformVert *dvert,
                          const int defgrp_index,
                          blender::MutableSpan<blender::float3> vertexCos)
 {
-  float *smooth_weights = nullptr;
+  blender::Array<float> smooth_weights;
 
   if (dvert || (csmd->flag & MOD_CORRECTIVESMOOTH_PIN_BOUNDARY)) {
 
-    smooth_weights = static_cast<float *>(
-        MEM_malloc_arrayN(size_t(vertexCos.size()), sizeof(float), __func__));
+    smooth_weights.reinitialize(vertexCos.size());
 
     if (dvert) {
       mesh_get_weights(dvert,
                        defgrp_index,
-                       uint(vertexCos.size()),
                        (csmd->flag & MOD_CORRECTIVESMOOTH_INVERT_VGROUP) != 0,
                        smooth_weights);
     }
     else {
-      copy_vn_fl(smooth_weights, int(vertexCos.size()), 1.0f);
+      smooth_weights.fill(1.0f);
     }
 
     if (csmd->flag & MOD_CORRECTIVESMOOTH_PIN_BOUNDARY) {
-      mesh_get_boundaries(mesh, smooth_weights);
+      for (const int64_t i : smooth_weights.index_range()) {
+        if (runtime.boundary_verts[i]) {
+          smooth_weights[i] = 0.0f;
+        }
+      }
     }
   }
 
-  smooth_iter(csmd, mesh, vertexCos, smooth_weights, uint(csmd->repeat));
-
-  if (smooth_weights) {
-    MEM_freeN(smooth_weights);
-  }
+  smooth_iter(csmd,
+              mesh,
+              runtime,
+              vertexCos,
+              smooth_weights.is_empty() ? nullptr : smooth_weights.data(),
+              uint(csmd->repeat));
 }
 
 /**
@@ -419,65 +454,79 @@ static bool calc_tangent_loop(const float v_dir_prev[3],
  * (may be nullptr).
  */
 static void calc_tangent_spaces(const Mesh *mesh,
+                                const CorrectiveSmoothRuntime &runtime,
                                 blender::Span<blender::float3> vertexCos,
                                 float (*r_tangent_spaces)[3][3],
                                 float *r_tangent_weights,
                                 float *r_tangent_weights_per_vertex)
 {
-  const uint mvert_num = uint(mesh->verts_num);
-  const blender::OffsetIndices faces = mesh->faces();
-  blender::Span<int> corner_verts = mesh->corner_verts();
+  using namespace blender;
+  const OffsetIndices faces = mesh->faces();
+  Span<int> corner_verts = mesh->corner_verts();
+
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const IndexRange face = faces[i];
+      int next_corner = int(face.start());
+      int term_corner = next_corner + int(face.size());
+      int prev_corner = term_corner - 2;
+      int curr_corner = term_corner - 1;
+
+      /* loop directions */
+      float v_dir_prev[3], v_dir_next[3];
+
+      /* needed entering the loop */
+      sub_v3_v3v3(v_dir_prev,
+                  vertexCos[corner_verts[prev_corner]],
+                  vertexCos[corner_verts[curr_corner]]);
+      normalize_v3(v_dir_prev);
 
-  if (r_tangent_weights_per_vertex != nullptr) {
-    copy_vn_fl(r_tangent_weights_per_vertex, int(mvert_num), 0.0f);
-  }
+      for (; next_corner != term_corner;
+           prev_corner = curr_corner, curr_corner = next_corner, next_corner++)
+      {
+        float(*ts)[3] = r_tangent_spaces[curr_corner];
 
-  for (const int64_t i : faces.index_range()) {
-    const blender::IndexRange face = faces[i];
-    int next_corner = int(face.start());
-    int term_corner = next_corner + int(face.size());
-    int prev_corner = term_corner - 2;
-    int curr_corner = term_corner - 1;
-
-    /* loop directions */
-    float v_dir_prev[3], v_dir_next[3];
-
-    /* needed entering the loop */
-    sub_v3_v3v3(
-        v_dir_prev, vertexCos[corner_verts[prev_corner]], vertexCos[corner_verts[curr_corner]]);
-    normalize_v3(v_dir_prev);
-
-    for (; next_corner != term_corner;
-         prev_corner = curr_corner, curr_corner = next_corner, next_corner++)
-    {
-      float(*ts)[3] = r_tangent_spaces[curr_corner];
-
-      /* re-use the previous value */
+        /* re-use the previous value */
 #if 0
-      sub_v3_v3v3(
-          v_dir_prev, vertexCos[corner_verts[prev_corner]], vertexCos[corner_verts[curr_corner]]);
-      normalize_v3(v_dir_prev);
+        sub_v3_v3v3(v_dir_prev,
+                    vertexCos[corner_verts[prev_corner]],
+                    vertexCos[corner_verts[curr_corner]]);
+        normalize_v3(v_dir_prev);
 #endif
-      sub_v3_v3v3(
-          v_dir_next, vertexCos[corner_verts[curr_corner]], vertexCos[corner_verts[next_corner]]);
-      normalize_v3(v_dir_next);
-
-      if (calc_tangent_loop(v_dir_prev, v_dir_next, ts)) {
-        if (r_tangent_weights != nullptr) {
-          const float weight = fabsf(
-              blender::math::safe_acos_approx(dot_v3v3(v_dir_next, v_dir_prev)));
-          r_tangent_weights[curr_corner] = weight;
-          r_tangent_weights_per_vertex[corner_verts[curr_corner]] += weight;
+        sub_v3_v3v3(v_dir_next,
+                    vertexCos[corner_verts[curr_corner]],
+                    vertexCos[corner_verts[next_corner]]);
+        normalize_v3(v_dir_next);
+
+        if (calc_tangent_loop(v_dir_prev, v_dir_next, ts)) {
+          if (r_tangent_weights != nullptr) {
+            const float weight = fabsf(math::safe_acos_approx(dot_v3v3(v_dir_next, v_dir_prev)));
+            r_tangent_weights[curr_corner] = weight;
+          }
         }
-      }
-      else {
-        if (r_tangent_weights != nullptr) {
-          r_tangent_weights[curr_corner] = 0;
+        else {
+          if (r_tangent_weights != nullptr) {
+            r_tangent_weights[curr_corner] = 0;
+          }
         }
-      }
 
-      copy_v3_v3(v_dir_prev, v_dir_next);
+        copy_v3_v3(v_dir_prev, v_dir_next);
+      }
     }
+  });
+
+  if (r_tangent_weights_per_vertex != nullptr) {
+    /* Sum in ascending corner order, like a loop over all faces would. */
+    const GroupedSpan<int> vert_to_corner = runtime.vert_to_corner;
+    threading::parallel_for(vert_to_corner.index_range(), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        float weight = 0.0f;
+        for (const int corner : vert_to_corner[i]) {
+          weight += r_tangent_weights[corner];
+        }
+        r_tangent_weights_per_vertex[i] = weight;
+      }
+    });
   }
 }
 
@@ -504,6 +553,7 @@ static bool cache_settings_equal(CorrectiveSmoothModifierData *csmd)
  */
 static void calc_deltas(CorrectiveSmoothModifierData *csmd,
                         Mesh *mesh,
+                        const CorrectiveSmoothRuntime &runtime,
                         const MDeformVert *dvert,
                         const int defgrp_index,
                         const blender::Span<blender::float3> rest_coords)
@@ -512,8 +562,6 @@ static void calc_deltas(CorrectiveSmoothModifierData *csmd,
 
   blender::Array<blender::float3> smooth_vertex_coords(rest_coords);
 
-  uint l_index;
-
   float(*tangent_spaces)[3][3] = static_cast<float(*)[3][3]>(
       MEM_malloc_arrayN(size_t(corner_verts.size()), sizeof(float[3][3]), __func__));
 
@@ -528,23 +576,25 @@ static void calc_deltas(CorrectiveSmoothModifierData *csmd,
         MEM_malloc_arrayN(size_t(corner_verts.size()), sizeof(float[3]), __func__));
   }
 
-  smooth_verts(csmd, mesh, dvert, defgrp_index, smooth_vertex_coords);
+  smooth_verts(csmd, mesh, runtime, dvert, defgrp_index, smooth_vertex_coords);
 
-  calc_tangent_spaces(mesh, smooth_vertex_coords, tangent_spaces, nullptr, nullptr);
+  calc_tangent_spaces(mesh, runtime, smooth_vertex_coords, tangent_spaces, nullptr, nullptr);
 
-  copy_vn_fl(&csmd->delta_cache.deltas[0][0], int(corner_verts.size()) * 3, 0.0f);
+  float(*deltas)[3] = csmd->delta_cache.deltas;
+  blender::threading::parallel_for(
+      corner_verts.index_range(), 4096, [&](const blender::IndexRange range) {
+        for (const int64_t l_index : range) {
+          const int v_index = corner_verts[l_index];
+          float delta[3];
+          sub_v3_v3v3(delta, rest_coords[v_index], smooth_vertex_coords[v_index]);
 
-  for (l_index = 0; l_index < corner_verts.size(); l_index++) {
-    const int v_index = corner_verts[l_index];
-    float delta[3];
-    sub_v3_v3v3(delta, rest_coords[v_index], smooth_vertex_coords[v_index]);
-
-    float imat[3][3];
-    if (UNLIKELY(!invert_m3_m3(imat, tangent_spaces[l_index]))) {
-      transpose_m3_m3(imat, tangent_spaces[l_index]);
-    }
-    mul_v3_m3v3(csmd->delta_cache.deltas[l_index], imat, delta);
-  }
+          float imat[3][3];
+          if (UNLIKELY(!invert_m3_m3(imat, tangent_spaces[l_index]))) {
+            transpose_m3_m3(imat, tangent_spaces[l_index]);
+          }
+          mul_v3_m3v3(deltas[l_index], imat, delta);
+        }
+      });
 
   MEM_SAFE_FREE(tangent_spaces);
 }
@@ -558,9 +608,12 @@ static void correctivesmooth_modifier_do(ModifierData *md,
 {
   CorrectiveSmoothModifierData *csmd = (CorrectiveSmoothModifierData *)md;
 
+  bool topology_changed;
+  const CorrectiveSmoothRuntime &runtime = runtime_ensure(csmd, mesh, &topology_changed);
+
   const bool force_delta_cache_update =
       /* XXX, take care! if mesh data itself changes we need to forcefully recalculate deltas */
-      !cache_settings_equal(csmd) ||
+      !cache_settings_equal(csmd) || topology_changed ||
       ((csmd->rest_source == MOD_CORRECTIVESMOOTH_RESTSOURCE_ORCO) &&
        (((ID *)ob->data)->recalc & ID_RECALC_ALL));
 
@@ -596,7 +649,7 @@ static void correctivesmooth_modifier_do(ModifierData *md,
   }
 
   if (UNLIKELY(use_only_smooth)) {
-    smooth_verts(csmd, mesh, dvert, defgrp_index, vertexCos);
+    smooth_verts(csmd, mesh, runtime, dvert, defgrp_index, vertexCos);
     return;
   }
 
@@ -668,7 +721,7 @@ static void correctivesmooth_modifier_do(ModifierData *md,
     TIMEIT_START(corrective_smooth_deltas);
 #endif
 
-    calc_deltas(csmd, mesh, dvert, defgrp_index, rest_coords);
+    calc_deltas(csmd, mesh, runtime, dvert, defgrp_index, rest_coords);
 
 #ifdef DEBUG_TIME
     TIMEIT_END(corrective_smooth_deltas);
@@ -685,7 +738,7 @@ static void correctivesmooth_modifier_do(ModifierData *md,
 #endif
 
   /* do the actual delta mush */
-  smooth_verts(csmd, mesh, dvert, defgrp_index, vertexCos);
+  smooth_verts(csmd, mesh, runtime, dvert, defgrp_index, vertexCos);
 
   {
 
@@ -699,21 +752,28 @@ static void correctivesmooth_modifier_do(ModifierData *md,
         MEM_malloc_arrayN(size_t(vertexCos.size()), sizeof(float), __func__));
 
     calc_tangent_spaces(
-        mesh, vertexCos, tangent_spaces, tangent_weights, tangent_weights_per_vertex);
-
-    for (const int64_t l_index : corner_verts.index_range()) {
-      const int v_index = corner_verts[l_index];
-      const float weight = tangent_weights[l_index] / tangent_weights_per_vertex[v_index];
-      if (UNLIKELY(!(weight > 0.0f))) {
-        /* Catches zero & divide by zero. */
-        continue;
-      }
-
-      float delta[3];
-      mul_v3_m3v3(delta, tangent_spaces[l_index], csmd->delta_cache.deltas[l_index]);
-      mul_v3_fl(delta, weight);
-      madd_v3_v3fl(vertexCos[v_index], delta, scale);
-    }
+        mesh, runtime, vertexCos, tangent_spaces, tangent_weights, tangent_weights_per_vertex);
+
+    /* Every vertex gathers the deltas of its corners in ascending order. */
+    const float(*deltas)[3] = csmd->delta_cache.deltas;
+    const blender::GroupedSpan<int> vert_to_corner = runtime.vert_to_corner;
+    blender::threading::parallel_for(
+        vertexCos.index_range(), 1024, [&](const blender::IndexRange range) {
+          for (const int64_t v_index : range) {
+            for (const int l_index : vert_to_corner[v_index]) {
+              const float weight = tangent_weights[l_index] / tangent_weights_per_vertex[v_index];
+              if (UNLIKELY(!(weight > 0.0f))) {
+                /* Catches zero & divide by zero. */
+                continue;
+              }
+
+              float delta[3];
+              mul_v3_m3v3(delta, tangent_spaces[l_index], deltas[l_index]);
+              mul_v3_fl(delta, weight);
+              madd_v3_v3fl(vertexCos[v_index], delta, scale);
+            }
+          }
+        });
 
     MEM_freeN(tangent_spaces);
     MEM_freeN(tangent_weights);
@@ -839,7 +899,7 @@ ModifierTypeInfo modifierType_CorrectiveSmooth = {
     /*depends_on_normals*/ nullptr,
     /*foreach_ID_link*/ nullptr,
     /*foreach_tex_link*/ nullptr,
-    /*free_runtime_data*/ nullptr,
+    /*free_runtime_data*/ free_runtime_data,
     /*panel_register*/ panel_register,
     /*blend_write*/ blend_write,
     /*blend_read*/ blend_read,
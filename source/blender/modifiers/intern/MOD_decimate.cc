@@ -92,6 +92,7 @@ static Mesh *modify_mesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh
   bool calc_vert_normal;
   bool calc_face_normal;
   float *vweights = nullptr;
+  float collapse_factor = dmd->percent;
 
 #ifdef USE_TIMEIT
   TIMEIT_START(decim);
@@ -102,7 +103,13 @@ static Mesh *modify_mesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh
 
   switch (dmd->mode) {
     case MOD_DECIM_MODE_COLLAPSE:
-      if (dmd->percent == 1.0f) {
+      if (dmd->flag & MOD_DECIM_FLAG_USE_FACE_TARGET) {
+        /* The collapse works on the triangulated mesh, so the ratio is relative to that. */
+        const int tris_num = mesh->corners_num - 2 * mesh->faces_num;
+        collapse_factor = tris_num ? std::min(float(dmd->face_target) / float(tris_num), 1.0f) :
+                                     1.0f;
+      }
+      if (collapse_factor == 1.0f) {
         return mesh;
       }
       calc_face_normal = true;
@@ -174,7 +181,7 @@ static Mesh *modify_mesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh
       const int symmetry_axis = (dmd->flag & MOD_DECIM_FLAG_SYMMETRY) ? dmd->symmetry_axis : -1;
       const float symmetry_eps = 0.00002f;
       BM_mesh_decimate_collapse(bm,
-                                dmd->percent,
+                                collapse_factor,
                                 vweights,
                                 dmd->defgrp_factor,
                                 do_triangulate,
@@ -233,7 +240,18 @@ static void panel_draw(const bContext * /*C*/, Panel *panel)
   uiLayoutSetPropSep(layout, true);
 
   if (decimate_type == MOD_DECIM_MODE_COLLAPSE) {
-    uiItemR(layout, ptr, "ratio", UI_ITEM_R_SLIDER, nullptr, ICON_NONE);
+    row = uiLayoutRowWithHeading(layout, true, IFACE_("Target Count"));
+    uiLayoutSetPropDecorate(row, false);
+    uiItemR(row, ptr, "use_face_target", UI_ITEM_NONE, "", ICON_NONE);
+    sub = uiLayoutRow(row, true);
+    const bool use_face_target = RNA_boolean_get(ptr, "use_face_target");
+    uiLayoutSetActive(sub, use_face_target);
+    uiItemR(sub, ptr, "face_target", UI_ITEM_NONE, "", ICON_NONE);
+    uiItemDecoratorR(row, ptr, "face_target", 0);
+
+    sub = uiLayoutRow(layout, true);
+    uiLayoutSetActive(sub, !use_face_target);
+    uiItemR(sub, ptr, "ratio", UI_ITEM_R_SLIDER, nullptr, ICON_NONE);
 
     row = uiLayoutRowWithHeading(layout, true, IFACE_("Symmetry"));
     uiLayoutSetPropDecorate(row, false);
@@ -8,7 +8,9 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_array.hh"
 #include "BLI_bitmap.h"
+#include "BLI_index_mask.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
 
@@ -120,6 +122,8 @@ static void update_depsgraph(ModifierData *md, const ModifierUpdateDepsgraphCont
 
 struct HookData_cb {
   blender::MutableSpan<blender::float3> positions;
+  /** Optional, set to true for every moved vertex. */
+  blender::MutableSpan<bool> moved_verts;
 
   /**
    * When anything other than -1, use deform groups.
@@ -258,6 +262,9 @@ static void hook_co_apply(HookData_cb *hd, int j, const MDeformVert *dv)
       float co_tmp[3];
       mul_v3_m4v3(co_tmp, hd->mat, co);
       interp_v3_v3v3(co, co, co_tmp, fac);
+      if (!hd->moved_verts.is_empty()) {
+        hd->moved_verts[j] = true;
+      }
     }
   }
 }
@@ -267,7 +274,8 @@ static void deformVerts_do(HookModifierData *hmd,
                            Object *ob,
                            Mesh *mesh,
                            const BMEditMesh *em,
-                           blender::MutableSpan<blender::float3> positions)
+                           blender::MutableSpan<blender::float3> positions,
+                           blender::MutableSpan<bool> moved_verts = {})
 {
   Object *ob_target = hmd->object;
   bPoseChannel *pchan = BKE_pose_channel_find_name(ob_target->pose, hmd->subtarget);
@@ -288,6 +296,7 @@ static void deformVerts_do(HookModifierData *hmd,
 
   /* Generic data needed for applying per-vertex calculations (initialize all members) */
   hd.positions = positions;
+  hd.moved_verts = moved_verts;
 
   MOD_get_vgroup(ob, mesh, hmd->name, &dvert, &hd.defgrp_index);
   int cd_dvert_offset = -1;
@@ -424,8 +433,18 @@ static void deform_verts(ModifierData *md,
                          Mesh *mesh,
                          blender::MutableSpan<blender::float3> positions)
 {
+  using namespace blender;
   HookModifierData *hmd = (HookModifierData *)md;
-  deformVerts_do(hmd, ctx, ctx->object, mesh, nullptr, positions);
+  if (mesh == nullptr || positions.data() != mesh->vert_positions().data()) {
+    deformVerts_do(hmd, ctx, ctx->object, mesh, nullptr, positions);
+    return;
+  }
+
+  /* Hooks usually move a small part of the mesh, only update the normals around it. */
+  Array<bool> moved_verts(positions.size(), false);
+  deformVerts_do(hmd, ctx, ctx->object, mesh, nullptr, positions, moved_verts);
+  IndexMaskMemory memory;
+  mesh->tag_positions_changed(IndexMask::from_bools(moved_verts, memory));
 }
 
 static void deform_verts_EM(ModifierData *md,
@@ -545,7 +564,7 @@ ModifierTypeInfo modifierType_Hook = {
     /*srna*/ &RNA_HookModifier,
     /*type*/ ModifierTypeType::OnlyDeform,
     /*flags*/ eModifierTypeFlag_AcceptsCVs | eModifierTypeFlag_AcceptsVertexCosOnly |
-        eModifierTypeFlag_SupportsEditmode,
+        eModifierTypeFlag_SupportsEditmode | eModifierTypeFlag_TagsChangedPositions,
     /*icon*/ ICON_HOOK,
     /*copy_data*/ copy_data,
 
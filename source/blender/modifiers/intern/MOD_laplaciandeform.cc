@@ -11,6 +11,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines_stack.h"
 
 #include "MEM_guardedalloc.h"
@@ -57,6 +58,13 @@ struct LaplacianSystem {
   int tris_num;
   int anchors_num;
   int repeat;
+  /** Topology of the mesh the system was built for. */
+  blender::MeshTopologyKey topology_key;
+  /**
+   * Bind coordinates which were checked to match #co, to avoid comparing them again on every
+   * evaluation. They are only reallocated when the modifier is copied or bound again.
+   */
+  const float *vertexco_checked;
   /** Vertex Group name */
   char anchor_grp_name[64];
   /** Original vertex coordinates. */
@@ -89,7 +97,7 @@ struct LaplacianSystem {
 
 static LaplacianSystem *newLaplacianSystem()
 {
-  LaplacianSystem *sys = MEM_cnew<LaplacianSystem>(__func__);
+  LaplacianSystem *sys = MEM_new<LaplacianSystem>(__func__);
 
   sys->is_matrix_computed = false;
   sys->has_solution = false;
@@ -145,7 +153,7 @@ static void deleteLaplacianSystem(LaplacianSystem *sys)
   if (sys->context) {
     EIG_linear_solver_delete(sys->context);
   }
-  MEM_SAFE_FREE(sys);
+  MEM_delete(sys);
 }
 
 static void createFaceRingMap(const int mvert_tot,
@@ -332,70 +340,87 @@ static void computeImplictRotations(LaplacianSystem *sys)
 
 static void rotateDifferentialCoordinates(LaplacianSystem *sys)
 {
-  float alpha, beta, gamma;
-  float pj[3], ni[3], di[3];
-  float uij[3], dun[3], e2[3], pi[3], fni[3], vn[3][3];
-  int i, j, fidn_num, k, fi;
-  int *fidn;
-
-  for (i = 0; i < sys->verts_num; i++) {
-    copy_v3_v3(pi, sys->co[i]);
-    copy_v3_v3(ni, sys->no[i]);
-    k = sys->unit_verts[i];
-    copy_v3_v3(pj, sys->co[k]);
-    sub_v3_v3v3(uij, pj, pi);
-    mul_v3_v3fl(dun, ni, dot_v3v3(uij, ni));
-    sub_v3_v3(uij, dun);
-    normalize_v3(uij);
-    cross_v3_v3v3(e2, ni, uij);
-    copy_v3_v3(di, sys->delta[i]);
-    alpha = dot_v3v3(ni, di);
-    beta = dot_v3v3(uij, di);
-    gamma = dot_v3v3(e2, di);
-
-    pi[0] = EIG_linear_solver_variable_get(sys->context, 0, i);
-    pi[1] = EIG_linear_solver_variable_get(sys->context, 1, i);
-    pi[2] = EIG_linear_solver_variable_get(sys->context, 2, i);
-    zero_v3(ni);
-    fidn_num = sys->ringf_map[i].count;
-    for (fi = 0; fi < fidn_num; fi++) {
-      const uint *vin;
-      fidn = sys->ringf_map[i].indices;
-      vin = sys->tris[fidn[fi]];
-      for (j = 0; j < 3; j++) {
-        vn[j][0] = EIG_linear_solver_variable_get(sys->context, 0, vin[j]);
-        vn[j][1] = EIG_linear_solver_variable_get(sys->context, 1, vin[j]);
-        vn[j][2] = EIG_linear_solver_variable_get(sys->context, 2, vin[j]);
-        if (vin[j] == sys->unit_verts[i]) {
-          copy_v3_v3(pj, vn[j]);
+  /* Every vertex only reads the current solution and writes its own right hand side. */
+  blender::threading::parallel_for(
+      blender::IndexRange(sys->verts_num), 1024, [&](const blender::IndexRange range) {
+        float alpha, beta, gamma;
+        float pj[3], ni[3], di[3];
+        float uij[3], dun[3], e2[3], pi[3], fni[3], vn[3][3];
+        int j, fidn_num, k, fi;
+        int *fidn;
+
+        for (const int i : range) {
+          copy_v3_v3(pi, sys->co[i]);
+          copy_v3_v3(ni, sys->no[i]);
+          k = sys->unit_verts[i];
+          copy_v3_v3(pj, sys->co[k]);
+          sub_v3_v3v3(uij, pj, pi);
+          mul_v3_v3fl(dun, ni, dot_v3v3(uij, ni));
+          sub_v3_v3(uij, dun);
+          normalize_v3(uij);
+          cross_v3_v3v3(e2, ni, uij);
+          copy_v3_v3(di, sys->delta[i]);
+          alpha = dot_v3v3(ni, di);
+          beta = dot_v3v3(uij, di);
+          gamma = dot_v3v3(e2, di);
+
+          pi[0] = EIG_linear_solver_variable_get(sys->context, 0, i);
+          pi[1] = EIG_linear_solver_variable_get(sys->context, 1, i);
+          pi[2] = EIG_linear_solver_variable_get(sys->context, 2, i);
+          zero_v3(ni);
+          fidn_num = sys->ringf_map[i].count;
+          for (fi = 0; fi < fidn_num; fi++) {
+            const uint *vin;
+            fidn = sys->ringf_map[i].indices;
+            vin = sys->tris[fidn[fi]];
+            for (j = 0; j < 3; j++) {
+              vn[j][0] = EIG_linear_solver_variable_get(sys->context, 0, vin[j]);
+              vn[j][1] = EIG_linear_solver_variable_get(sys->context, 1, vin[j]);
+              vn[j][2] = EIG_linear_solver_variable_get(sys->context, 2, vin[j]);
+              if (vin[j] == sys->unit_verts[i]) {
+                copy_v3_v3(pj, vn[j]);
+              }
+            }
+
+            normal_tri_v3(fni, UNPACK3(vn));
+            add_v3_v3(ni, fni);
+          }
+
+          normalize_v3(ni);
+          sub_v3_v3v3(uij, pj, pi);
+          mul_v3_v3fl(dun, ni, dot_v3v3(uij, ni));
+          sub_v3_v3(uij, dun);
+          normalize_v3(uij);
+          cross_v3_v3v3(e2, ni, uij);
+          fni[0] = alpha * ni[0] + beta * uij[0] + gamma * e2[0];
+          fni[1] = alpha * ni[1] + beta * uij[1] + gamma * e2[1];
+          fni[2] = alpha * ni[2] + beta * uij[2] + gamma * e2[2];
+
+          if (len_squared_v3(fni) > FLT_EPSILON) {
+            EIG_linear_solver_right_hand_side_add(sys->context, 0, i, fni[0]);
+            EIG_linear_solver_right_hand_side_add(sys->context, 1, i, fni[1]);
+            EIG_linear_solver_right_hand_side_add(sys->context, 2, i, fni[2]);
+          }
+          else {
+            EIG_linear_solver_right_hand_side_add(sys->context, 0, i, sys->delta[i][0]);
+            EIG_linear_solver_right_hand_side_add(sys->context, 1, i, sys->delta[i][1]);
+            EIG_linear_solver_right_hand_side_add(sys->context, 2, i, sys->delta[i][2]);
+          }
         }
-      }
-
-      normal_tri_v3(fni, UNPACK3(vn));
-      add_v3_v3(ni, fni);
-    }
+      });
+}
 
-    normalize_v3(ni);
-    sub_v3_v3v3(uij, pj, pi);
-    mul_v3_v3fl(dun, ni, dot_v3v3(uij, ni));
-    sub_v3_v3(uij, dun);
-    normalize_v3(uij);
-    cross_v3_v3v3(e2, ni, uij);
-    fni[0] = alpha * ni[0] + beta * uij[0] + gamma * e2[0];
-    fni[1] = alpha * ni[1] + beta * uij[1] + gamma * e2[1];
-    fni[2] = alpha * ni[2] + beta * uij[2] + gamma * e2[2];
-
-    if (len_squared_v3(fni) > FLT_EPSILON) {
-      EIG_linear_solver_right_hand_side_add(sys->context, 0, i, fni[0]);
-      EIG_linear_solver_right_hand_side_add(sys->context, 1, i, fni[1]);
-      EIG_linear_solver_right_hand_side_add(sys->context, 2, i, fni[2]);
-    }
-    else {
-      EIG_linear_solver_right_hand_side_add(sys->context, 0, i, sys->delta[i][0]);
-      EIG_linear_solver_right_hand_side_add(sys->context, 1, i, sys->delta[i][1]);
-      EIG_linear_solver_right_hand_side_add(sys->context, 2, i, sys->delta[i][2]);
-    }
-  }
+/** Copy the solution to the deformed coordinates. */
+static void laplacianDeformSolutionGet(const LaplacianSystem *sys, float (*vertexCos)[3])
+{
+  blender::threading::parallel_for(
+      blender::IndexRange(sys->verts_num), 4096, [&](const blender::IndexRange range) {
+        for (const int vid : range) {
+          vertexCos[vid][0] = EIG_linear_solver_variable_get(sys->context, 0, vid);
+          vertexCos[vid][1] = EIG_linear_solver_variable_get(sys->context, 1, vid);
+          vertexCos[vid][2] = EIG_linear_solver_variable_get(sys->context, 2, vid);
+        }
+      });
 }
 
 static void laplacianDeformPreview(LaplacianSystem *sys, float (*vertexCos)[3])
@@ -453,11 +478,7 @@ static void laplacianDeformPreview(LaplacianSystem *sys, float (*vertexCos)[3])
         }
       }
       if (sys->has_solution) {
-        for (vid = 0; vid < sys->verts_num; vid++) {
-          vertexCos[vid][0] = EIG_linear_solver_variable_get(sys->context, 0, vid);
-          vertexCos[vid][1] = EIG_linear_solver_variable_get(sys->context, 1, vid);
-          vertexCos[vid][2] = EIG_linear_solver_variable_get(sys->context, 2, vid);
-        }
+        laplacianDeformSolutionGet(sys, vertexCos);
       }
       else {
         sys->has_solution = false;
@@ -499,11 +520,7 @@ static void laplacianDeformPreview(LaplacianSystem *sys, float (*vertexCos)[3])
         }
       }
       if (sys->has_solution) {
-        for (vid = 0; vid < sys->verts_num; vid++) {
-          vertexCos[vid][0] = EIG_linear_solver_variable_get(sys->context, 0, vid);
-          vertexCos[vid][1] = EIG_linear_solver_variable_get(sys->context, 1, vid);
-          vertexCos[vid][2] = EIG_linear_solver_variable_get(sys->context, 2, vid);
-        }
+        laplacianDeformSolutionGet(sys, vertexCos);
       }
       else {
         sys->has_solution = false;
@@ -562,18 +579,20 @@ static void initSystem(
     const blender::Span<blender::int3> corner_tris = mesh->corner_tris();
 
     anchors_num = STACK_SIZE(index_anchors);
-    lmd->cache_system = initLaplacianSystem(verts_num,
-                                            edges.size(),
-                                            corner_tris.size(),
-                                            anchors_num,
-                                            lmd->anchor_grp_name,
-                                            lmd->repeat);
-    sys = (LaplacianSystem *)lmd->cache_system;
+    lmd->modifier.runtime = initLaplacianSystem(verts_num,
+                                                edges.size(),
+                                                corner_tris.size(),
+                                                anchors_num,
+                                                lmd->anchor_grp_name,
+                                                lmd->repeat);
+    sys = (LaplacianSystem *)lmd->modifier.runtime;
+    sys->topology_key.update(*mesh);
     memcpy(sys->index_anchors, index_anchors, sizeof(int) * anchors_num);
     memcpy(sys->co, vertexCos, sizeof(float[3]) * verts_num);
     MEM_freeN(index_anchors);
     lmd->vertexco = static_cast<float *>(MEM_malloc_arrayN(verts_num, sizeof(float[3]), __func__));
     memcpy(lmd->vertexco, vertexCos, sizeof(float[3]) * verts_num);
+    sys->vertexco_checked = lmd->vertexco;
     lmd->verts_num = verts_num;
 
     createFaceRingMap(
@@ -599,7 +618,7 @@ static int isSystemDifferent(LaplacianDeformModifierData *lmd,
   float wpaint;
   const MDeformVert *dvert = nullptr;
   const MDeformVert *dv = nullptr;
-  LaplacianSystem *sys = (LaplacianSystem *)lmd->cache_system;
+  LaplacianSystem *sys = (LaplacianSystem *)lmd->modifier.runtime;
   const bool invert_vgroup = (lmd->flag & MOD_LAPLACIANDEFORM_INVERT_VGROUP) != 0;
 
   if (sys->verts_num != verts_num) {
@@ -615,18 +634,35 @@ static int isSystemDifferent(LaplacianDeformModifierData *lmd,
   if (!dvert) {
     return LAPDEFORM_SYSTEM_CHANGE_NOT_VALID_GROUP;
   }
+  /* The factorization depends on exactly which vertices are anchors, not only on their count. */
   dv = dvert;
   for (i = 0; i < verts_num; i++) {
     wpaint = invert_vgroup ? 1.0f - BKE_defvert_find_weight(dv, defgrp_index) :
                              BKE_defvert_find_weight(dv, defgrp_index);
     dv++;
     if (wpaint > 0.0f) {
+      if (anchors_num == sys->anchors_num || sys->index_anchors[anchors_num] != i) {
+        return LAPDEFORM_SYSTEM_ONLY_CHANGE_ANCHORS;
+      }
       anchors_num++;
     }
   }
   if (sys->anchors_num != anchors_num) {
     return LAPDEFORM_SYSTEM_ONLY_CHANGE_ANCHORS;
   }
+  /* The system is kept across copies of the modifier, check it still matches the bind. */
+  if (lmd->verts_num != verts_num) {
+    return LAPDEFORM_SYSTEM_CHANGE_VERTEXES;
+  }
+  if (!sys->topology_key.matches(*mesh)) {
+    return LAPDEFORM_SYSTEM_ONLY_CHANGE_MESH;
+  }
+  if (sys->vertexco_checked != lmd->vertexco) {
+    if (memcmp(sys->co, lmd->vertexco, sizeof(float[3]) * verts_num) != 0) {
+      return LAPDEFORM_SYSTEM_ONLY_CHANGE_MESH;
+    }
+    sys->vertexco_checked = lmd->vertexco;
+  }
 
   return LAPDEFORM_SYSTEM_NOT_CHANGE;
 }
@@ -639,29 +675,39 @@ static void LaplacianDeformModifier_do(
   LaplacianSystem *sys = nullptr;
   filevertexCos = nullptr;
   if (!(lmd->flag & MOD_LAPLACIANDEFORM_BIND)) {
-    if (lmd->cache_system) {
-      sys = static_cast<LaplacianSystem *>(lmd->cache_system);
+    if (lmd->modifier.runtime) {
+      sys = static_cast<LaplacianSystem *>(lmd->modifier.runtime);
       deleteLaplacianSystem(sys);
-      lmd->cache_system = nullptr;
+      lmd->modifier.runtime = nullptr;
     }
     lmd->verts_num = 0;
     MEM_SAFE_FREE(lmd->vertexco);
     return;
   }
-  if (lmd->cache_system) {
+  if (lmd->modifier.runtime && lmd->vertexco == nullptr) {
+    /* The system outlived the bind it was built for. */
+    deleteLaplacianSystem(static_cast<LaplacianSystem *>(lmd->modifier.runtime));
+    lmd->modifier.runtime = nullptr;
+  }
+  if (lmd->modifier.runtime) {
     sysdif = isSystemDifferent(lmd, ob, mesh, verts_num);
-    sys = static_cast<LaplacianSystem *>(lmd->cache_system);
+    sys = static_cast<LaplacianSystem *>(lmd->modifier.runtime);
     if (sysdif) {
-      if (ELEM(sysdif, LAPDEFORM_SYSTEM_ONLY_CHANGE_ANCHORS, LAPDEFORM_SYSTEM_ONLY_CHANGE_GROUP)) {
+      if (ELEM(sysdif,
+               LAPDEFORM_SYSTEM_ONLY_CHANGE_ANCHORS,
+               LAPDEFORM_SYSTEM_ONLY_CHANGE_GROUP,
+               LAPDEFORM_SYSTEM_ONLY_CHANGE_MESH))
+      {
         filevertexCos = static_cast<float(*)[3]>(
             MEM_malloc_arrayN(verts_num, sizeof(float[3]), __func__));
         memcpy(filevertexCos, lmd->vertexco, sizeof(float[3]) * verts_num);
         MEM_SAFE_FREE(lmd->vertexco);
         lmd->verts_num = 0;
         deleteLaplacianSystem(sys);
-        lmd->cache_system = nullptr;
+        lmd->modifier.runtime = nullptr;
         initSystem(lmd, ob, mesh, filevertexCos, verts_num);
-        sys = static_cast<LaplacianSystem *>(lmd->cache_system); /* may have been reallocated */
+        /* May have been reallocated. */
+        sys = static_cast<LaplacianSystem *>(lmd->modifier.runtime);
         MEM_SAFE_FREE(filevertexCos);
         if (sys) {
           laplacianDeformPreview(sys, vertexCos);
@@ -704,13 +750,13 @@ static void LaplacianDeformModifier_do(
       MEM_SAFE_FREE(lmd->vertexco);
       lmd->verts_num = 0;
       initSystem(lmd, ob, mesh, filevertexCos, verts_num);
-      sys = static_cast<LaplacianSystem *>(lmd->cache_system);
+      sys = static_cast<LaplacianSystem *>(lmd->modifier.runtime);
       MEM_SAFE_FREE(filevertexCos);
       laplacianDeformPreview(sys, vertexCos);
     }
     else {
       initSystem(lmd, ob, mesh, vertexCos, verts_num);
-      sys = static_cast<LaplacianSystem *>(lmd->cache_system);
+      sys = static_cast<LaplacianSystem *>(lmd->modifier.runtime);
       laplacianDeformPreview(sys, vertexCos);
     }
   }
@@ -736,7 +782,6 @@ static void copy_data(const ModifierData *md, ModifierData *target, const int fl
   BKE_modifier_copydata_generic(md, target, flag);
 
   tlmd->vertexco = static_cast<float *>(MEM_dupallocN(lmd->vertexco));
-  tlmd->cache_system = nullptr;
 }
 
 static bool is_disabled(const Scene * /*scene*/, ModifierData *md, bool /*use_render_params*/)
@@ -769,13 +814,19 @@ static void deform_verts(ModifierData *md,
                              positions.size());
 }
 
-static void free_data(ModifierData *md)
+static void free_runtime_data(void *runtime_data)
 {
-  LaplacianDeformModifierData *lmd = (LaplacianDeformModifierData *)md;
-  LaplacianSystem *sys = (LaplacianSystem *)lmd->cache_system;
+  LaplacianSystem *sys = (LaplacianSystem *)runtime_data;
   if (sys) {
     deleteLaplacianSystem(sys);
   }
+}
+
+static void free_data(ModifierData *md)
+{
+  LaplacianDeformModifierData *lmd = (LaplacianDeformModifierData *)md;
+  free_runtime_data(lmd->modifier.runtime);
+  lmd->modifier.runtime = nullptr;
   MEM_SAFE_FREE(lmd->vertexco);
   lmd->verts_num = 0;
 }
@@ -842,7 +893,6 @@ static void blend_read(BlendDataReader *reader, ModifierData *md)
   LaplacianDeformModifierData *lmd = (LaplacianDeformModifierData *)md;
 
   BLO_read_float3_array(reader, lmd->verts_num, &lmd->vertexco);
-  lmd->cache_system = nullptr;
 }
 
 ModifierTypeInfo modifierType_LaplacianDeform = {
@@ -872,7 +922,7 @@ ModifierTypeInfo modifierType_LaplacianDeform = {
     /*depends_on_normals*/ nullptr,
     /*foreach_ID_link*/ nullptr,
     /*foreach_tex_link*/ nullptr,
-    /*free_runtime_data*/ nullptr,
+    /*free_runtime_data*/ free_runtime_data,
     /*panel_register*/ panel_register,
     /*blend_write*/ blend_write,
     /*blend_read*/ blend_read,
@@ -194,7 +194,7 @@ ModifierTypeInfo modifierType_MeshToVolume = {
     /*struct_size*/ sizeof(MeshToVolumeModifierData),
     /*srna*/ &RNA_MeshToVolumeModifier,
     /*type*/ ModifierTypeType::Constructive,
-    /*flags*/ static_cast<ModifierTypeFlag>(0),
+    /*flags*/ eModifierTypeFlag_AcceptsGeometrySet,
     /*icon*/ ICON_VOLUME_DATA, /* TODO: Use correct icon. */
 
     /*copy_data*/ BKE_modifier_copydata_generic,
@@ -6,13 +6,51 @@
  * \ingroup modifiers
  */
 
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+
+#include "BLI_endian_switch.h"
+#include "BLI_fileops.h"
 #include "BLI_math_base.h"
+#include "BLI_mmap.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
+#ifdef WIN32
+#  include "BLI_winstuff.h"
+#else
+#  include <unistd.h>
+#endif
+
+#include "BLT_translation.hh"
+
 #include "DNA_modifier_types.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "MOD_meshcache_util.hh"
 
+/**
+ * Number of frames read ahead along the playback direction. Enough to hide the latency of
+ * network file systems without keeping too much of large caches in memory.
+ */
+#define MESHCACHE_PREFETCH_FRAMES 4
+
+/** Cache file kept mapped in memory between evaluations, stored as #ModifierData.runtime. */
+struct MeshCacheFile {
+  /** Absolute path, size and modification time of the mapped file, to detect changes. */
+  std::string filepath;
+  int64_t size = 0;
+  int64_t mtime = 0;
+
+  BLI_mmap_file *mmap_file = nullptr;
+
+  /** First frame read by the previous evaluation, to find the playback direction. */
+  int index_prev = -1;
+};
+
 void MOD_meshcache_calc_range(const float frame,
                               const char interp,
                               const int frame_tot,
@@ -49,3 +87,201 @@ void MOD_meshcache_calc_range(const float frame,
     }
   }
 }
+
+static void meshcache_file_close(MeshCacheFile *file)
+{
+  if (file->mmap_file) {
+    BLI_mmap_free(file->mmap_file);
+    file->mmap_file = nullptr;
+  }
+}
+
+MeshCacheFile *MOD_meshcache_file_ensure(void **runtime,
+                                         const char *filepath,
+                                         const char **err_str)
+{
+  MeshCacheFile *file = static_cast<MeshCacheFile *>(*runtime);
+  if (file == nullptr) {
+    file = MEM_new<MeshCacheFile>(__func__);
+    *runtime = file;
+  }
+
+  BLI_stat_t st;
+  errno = 0;
+  if (BLI_stat(filepath, &st) != 0) {
+    meshcache_file_close(file);
+    *err_str = errno ? strerror(errno) : RPT_("Unknown error opening file");
+    return nullptr;
+  }
+
+  const bool is_same_file = file->filepath == filepath && file->size == int64_t(st.st_size) &&
+                            file->mtime == int64_t(st.st_mtime);
+  if (file->mmap_file && is_same_file) {
+    return file;
+  }
+  meshcache_file_close(file);
+  if (!is_same_file) {
+    file->index_prev = -1;
+  }
+
+  errno = 0;
+  const int fd = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (fd == -1) {
+    *err_str = errno ? strerror(errno) : RPT_("Unknown error opening file");
+    return nullptr;
+  }
+  file->mmap_file = BLI_mmap_open(fd);
+  /* The mapping stays valid after closing the file. */
+  close(fd);
+
+  if (file->mmap_file == nullptr) {
+    *err_str = (st.st_size == 0) ? RPT_("Missing header") : RPT_("Failed to map file");
+    return nullptr;
+  }
+
+  file->filepath = filepath;
+  file->size = int64_t(st.st_size);
+  file->mtime = int64_t(st.st_mtime);
+  return file;
+}
+
+void MOD_meshcache_file_end_read(MeshCacheFile *file, const bool ok)
+{
+#ifdef WIN32
+  /* Prefetched pages stay in the system file cache after unmapping. */
+  UNUSED_VARS(ok);
+  meshcache_file_close(file);
+#else
+  /* After an IO error (e.g. the file was truncated while being re-exported) the mapped pages
+   * are replaced by zeroes and the error is kept, only a new mapping reads the file again. */
+  if (!ok) {
+    meshcache_file_close(file);
+  }
+#endif
+}
+
+void MOD_meshcache_file_free(void *runtime)
+{
+  MeshCacheFile *file = static_cast<MeshCacheFile *>(runtime);
+  if (file == nullptr) {
+    return;
+  }
+  meshcache_file_close(file);
+  MEM_delete(file);
+}
+
+bool MOD_meshcache_file_read(MeshCacheFile *file,
+                             void *dest,
+                             const size_t offset,
+                             const size_t length,
+                             const char **err_str)
+{
+  if (!BLI_mmap_read(file->mmap_file, dest, offset, length)) {
+    *err_str = (offset == 0) ? RPT_("Missing header") : RPT_("Header read failed");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Blend two frames of coordinates as they are stored in the file, `frame_b` is only read when
+ * `factor` is below one.
+ */
+static void meshcache_blend_frames(const float *frame_a,
+                                   const float *frame_b,
+                                   const float factor,
+                                   const bool swap_endian,
+                                   float *dst,
+                                   const int64_t size)
+{
+  using namespace blender;
+  const float ifactor = 1.0f - factor;
+  threading::parallel_for(IndexRange(size), 16384, [&](const IndexRange range) {
+    if (!swap_endian) {
+      if (factor >= 1.0f) {
+        memcpy(dst + range.start(), frame_a + range.start(), sizeof(float) * range.size());
+      }
+      else {
+        for (const int64_t i : range) {
+          dst[i] = (frame_a[i] * ifactor) + (frame_b[i] * factor);
+        }
+      }
+      return;
+    }
+
+    if (factor >= 1.0f) {
+      for (const int64_t i : range) {
+        float a = frame_a[i];
+        BLI_endian_switch_float(&a);
+        dst[i] = a;
+      }
+    }
+    else {
+      for (const int64_t i : range) {
+        float a = frame_a[i];
+        float b = frame_b[i];
+        BLI_endian_switch_float(&a);
+        BLI_endian_switch_float(&b);
+        dst[i] = (a * ifactor) + (b * factor);
+      }
+    }
+  });
+}
+
+bool MOD_meshcache_read_frames(MeshCacheFile *file,
+                               const size_t frames_offset,
+                               const int verts_tot,
+                               const int frame_tot,
+                               const int index_range[2],
+                               const float factor,
+                               const bool swap_endian,
+                               float (*vertexCos)[3],
+                               const char **err_str)
+{
+  BLI_mmap_file *mmap_file = file->mmap_file;
+  const size_t frame_size = sizeof(float[3]) * size_t(verts_tot);
+  const bool use_blend = (index_range[0] != index_range[1]) && (factor < 1.0f);
+  const int index_first = index_range[0];
+  const int index_last = use_blend ? index_range[1] : index_range[0];
+
+  if (frames_offset + frame_size * size_t(index_last + 1) > BLI_mmap_get_length(mmap_file)) {
+    *err_str = RPT_("Failed to seek frame");
+    return false;
+  }
+
+  /* Start reading all needed frames at once, rather than faulting in their pages one by one. */
+  BLI_mmap_prefetch(mmap_file,
+                    frames_offset + frame_size * size_t(index_first),
+                    frame_size * size_t(index_last - index_first + 1));
+
+  const char *frames = static_cast<const char *>(BLI_mmap_get_pointer(mmap_file)) +
+                       frames_offset;
+  meshcache_blend_frames(reinterpret_cast<const float *>(frames + frame_size * index_first),
+                         reinterpret_cast<const float *>(frames + frame_size * index_last),
+                         use_blend ? factor : 1.0f,
+                         swap_endian,
+                         *vertexCos,
+                         int64_t(verts_tot) * 3);
+
+  if (BLI_mmap_any_io_error(mmap_file)) {
+    *err_str = RPT_("Vertex coordinate read failed");
+    return false;
+  }
+
+  /* Read ahead along the playback direction, assuming forward playback when starting. */
+  if (index_first < file->index_prev) {
+    const int prefetch_first = max_ii(index_first - MESHCACHE_PREFETCH_FRAMES, 0);
+    BLI_mmap_prefetch(mmap_file,
+                      frames_offset + frame_size * size_t(prefetch_first),
+                      frame_size * size_t(index_first - prefetch_first));
+  }
+  else if (index_first > file->index_prev) {
+    const int prefetch_last = min_ii(index_last + MESHCACHE_PREFETCH_FRAMES, frame_tot - 1);
+    BLI_mmap_prefetch(mmap_file,
+                      frames_offset + frame_size * size_t(index_last + 1),
+                      frame_size * size_t(max_ii(prefetch_last - index_last, 0)));
+  }
+  file->index_prev = index_first;
+
+  return true;
+}
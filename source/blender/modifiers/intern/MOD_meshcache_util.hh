@@ -8,17 +8,17 @@
 
 #pragma once
 
+struct MeshCacheFile;
+
 /* `MOD_meshcache_mdd.cc` */
 
-bool MOD_meshcache_read_mdd_index(
-    FILE *fp, float (*vertexCos)[3], int verts_tot, int index, float factor, const char **err_str);
-bool MOD_meshcache_read_mdd_frame(FILE *fp,
+bool MOD_meshcache_read_mdd_frame(MeshCacheFile *file,
                                   float (*vertexCos)[3],
                                   int verts_tot,
                                   char interp,
                                   float frame,
                                   const char **err_str);
-bool MOD_meshcache_read_mdd_times(const char *filepath,
+bool MOD_meshcache_read_mdd_times(MeshCacheFile *file,
                                   float (*vertexCos)[3],
                                   int verts_tot,
                                   char interp,
@@ -29,15 +29,13 @@ bool MOD_meshcache_read_mdd_times(const char *filepath,
 
 /* `MOD_meshcache_pc2.cc` */
 
-bool MOD_meshcache_read_pc2_index(
-    FILE *fp, float (*vertexCos)[3], int verts_tot, int index, float factor, const char **err_str);
-bool MOD_meshcache_read_pc2_frame(FILE *fp,
+bool MOD_meshcache_read_pc2_frame(MeshCacheFile *file,
                                   float (*vertexCos)[3],
                                   int verts_tot,
                                   char interp,
                                   float frame,
                                   const char **err_str);
-bool MOD_meshcache_read_pc2_times(const char *filepath,
+bool MOD_meshcache_read_pc2_times(MeshCacheFile *file,
                                   float (*vertexCos)[3],
                                   int verts_tot,
                                   char interp,
@@ -51,4 +49,41 @@ bool MOD_meshcache_read_pc2_times(const char *filepath,
 void MOD_meshcache_calc_range(
     float frame, char interp, int frame_tot, int r_index_range[2], float *r_factor);
 
+/**
+ * Get the memory mapped cache file stored in `*runtime`, (re)opening it when there is none yet
+ * or when the file changed on disk since it was mapped.
+ */
+MeshCacheFile *MOD_meshcache_file_ensure(void **runtime,
+                                         const char *filepath,
+                                         const char **err_str);
+/**
+ * Called after reading from the file in an evaluation. Unmaps the file after errors, so that the
+ * next evaluation maps it again rather than failing on the old mapping, and on Windows, where a
+ * mapped file can't be written and so would block re-exporting the cache.
+ */
+void MOD_meshcache_file_end_read(MeshCacheFile *file, bool ok);
+void MOD_meshcache_file_free(void *runtime);
+
+/** Read `length` bytes at `offset`, used for the file headers. */
+bool MOD_meshcache_file_read(
+    MeshCacheFile *file, void *dest, size_t offset, size_t length, const char **err_str);
+
+/**
+ * Read the frames in `index_range` directly from the mapped file, blending them by `factor`.
+ * Frames are stored one after the other starting at `frames_offset`, with the coordinates in
+ * byte order that is swapped when `swap_endian` is set.
+ *
+ * Frames following along the playback direction are prefetched, so reading them on the next
+ * evaluation does not have to wait for the file system.
+ */
+bool MOD_meshcache_read_frames(MeshCacheFile *file,
+                               size_t frames_offset,
+                               int verts_tot,
+                               int frame_tot,
+                               const int index_range[2],
+                               float factor,
+                               bool swap_endian,
+                               float (*vertexCos)[3],
+                               const char **err_str);
+
 #define FRAME_SNAP_EPS 0.0001f
@@ -292,15 +292,29 @@ static void meshdeform_vert_task(void *__restrict userdata,
   }
   else {
     totweight = 0.0f;
-    zero_v3(co);
     int start = offsets[iter];
     int end = offsets[iter + 1];
 
+#if BLI_HAVE_SSE2
+    __m128 co_r = _mm_setzero_ps();
+    for (int a = start; a < end; a++) {
+      weight = influences[a].weight;
+      /* This will load one extra element, this is ok because
+       * we ignore that part of register anyway.
+       */
+      __m128 cageco_r = _mm_loadu_ps(dco[influences[a].vertex]);
+      co_r = _mm_add_ps(co_r, _mm_mul_ps(cageco_r, _mm_set1_ps(weight)));
+      totweight += weight;
+    }
+    copy_v3_v3(co, (float *)&co_r);
+#else
+    zero_v3(co);
     for (int a = start; a < end; a++) {
       weight = influences[a].weight;
       madd_v3_v3fl(co, dco[influences[a].vertex], weight);
       totweight += weight;
     }
+#endif
   }
 
   if (totweight > 0.0f) {
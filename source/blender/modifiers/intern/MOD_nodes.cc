@@ -2518,7 +2518,8 @@ ModifierTypeInfo modifierType_Nodes = {
     static_cast<ModifierTypeFlag>(
         eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_AcceptsCVs |
         eModifierTypeFlag_SupportsEditmode | eModifierTypeFlag_EnableInEditmode |
-        eModifierTypeFlag_SupportsMapping | eModifierTypeFlag_AcceptsGreasePencil),
+        eModifierTypeFlag_SupportsMapping | eModifierTypeFlag_AcceptsGreasePencil |
+        eModifierTypeFlag_AcceptsGeometrySet),
     /*icon*/ ICON_GEOMETRY_NODES,
 
     /*copy_data*/ blender::copy_data,
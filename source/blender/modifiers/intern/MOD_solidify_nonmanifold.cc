@@ -6,8 +6,12 @@
  * \ingroup modifiers
  */
 
+#include "BLI_array.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
+#include "BLI_offset_indices.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_mesh_types.h"
@@ -913,482 +917,520 @@ Mesh *MOD_solidify_nonmanifold_modifyMesh(ModifierData *md,
     MEM_freeN(edge_adj_faces);
   }
 
-  /* Create sorted edge groups for every vert. */
+  /* Create sorted edge groups for every vert. The groups of a vert only depend on its own
+   * adjacent edges, so all verts are handled in parallel. Only the indices of the new verts
+   * depend on the preceding verts, they are offset once the sizes of all verts are known. */
   {
-    OldVertEdgeRef **adj_edges_ptr = vert_adj_edges;
-    for (uint i = 0; i < verts_num; i++, adj_edges_ptr++) {
-      if (*adj_edges_ptr != nullptr && (*adj_edges_ptr)->edges_len >= 2) {
-        EdgeGroup *edge_groups;
-
-        int eg_index = -1;
-        bool contains_long_groups = false;
-        uint topo_groups = 0;
-
-        /* Initial sorted creation. */
-        {
-          const uint *adj_edges = (*adj_edges_ptr)->edges;
-          const uint tot_adj_edges = (*adj_edges_ptr)->edges_len;
-
-          uint unassigned_edges_len = 0;
-          for (uint j = 0; j < tot_adj_edges; j++) {
-            NewEdgeRef **new_edges = orig_edge_data_arr[adj_edges[j]];
-            /* TODO: check where the null pointer come from,
-             * because there should not be any... */
-            if (new_edges) {
-              /* count the number of new edges around the original vert */
-              while (*new_edges) {
-                unassigned_edges_len++;
-                new_edges++;
+    struct VertGroupsSize {
+      uint verts_num = 0;
+      uint edges_num = 0;
+      uint faces_num = 0;
+      uint loops_num = 0;
+      bool has_singularities = false;
+    };
+    Array<VertGroupsSize> vert_sizes(verts_num);
+    threading::parallel_for(IndexRange(verts_num), 256, [&](const IndexRange range) {
+      for (const int64_t vert : range) {
+        const uint i = uint(vert);
+        OldVertEdgeRef *const *adj_edges_ptr = &vert_adj_edges[i];
+        if (*adj_edges_ptr != nullptr && (*adj_edges_ptr)->edges_len >= 2) {
+          VertGroupsSize &vert_size = vert_sizes[i];
+          EdgeGroup *edge_groups;
+
+          int eg_index = -1;
+          bool contains_long_groups = false;
+          uint topo_groups = 0;
+
+          /* Initial sorted creation. */
+          {
+            const uint *adj_edges = (*adj_edges_ptr)->edges;
+            const uint tot_adj_edges = (*adj_edges_ptr)->edges_len;
+
+            uint unassigned_edges_len = 0;
+            for (uint j = 0; j < tot_adj_edges; j++) {
+              NewEdgeRef **new_edges = orig_edge_data_arr[adj_edges[j]];
+              /* TODO: check where the null pointer come from,
+               * because there should not be any... */
+              if (new_edges) {
+                /* count the number of new edges around the original vert */
+                while (*new_edges) {
+                  unassigned_edges_len++;
+                  new_edges++;
+                }
               }
             }
-          }
-          NewEdgeRef **unassigned_edges = static_cast<NewEdgeRef **>(
-              MEM_malloc_arrayN(unassigned_edges_len, sizeof(*unassigned_edges), __func__));
-          for (uint j = 0, k = 0; j < tot_adj_edges; j++) {
-            NewEdgeRef **new_edges = orig_edge_data_arr[adj_edges[j]];
-            if (new_edges) {
-              while (*new_edges) {
-                unassigned_edges[k++] = *new_edges;
-                new_edges++;
+            NewEdgeRef **unassigned_edges = static_cast<NewEdgeRef **>(
+                MEM_malloc_arrayN(unassigned_edges_len, sizeof(*unassigned_edges), __func__));
+            for (uint j = 0, k = 0; j < tot_adj_edges; j++) {
+              NewEdgeRef **new_edges = orig_edge_data_arr[adj_edges[j]];
+              if (new_edges) {
+                while (*new_edges) {
+                  unassigned_edges[k++] = *new_edges;
+                  new_edges++;
+                }
               }
             }
-          }
 
-          /* An edge group will always contain min 2 edges
-           * so max edge group count can be calculated. */
-          uint edge_groups_len = unassigned_edges_len / 2;
-          edge_groups = static_cast<EdgeGroup *>(
-              MEM_calloc_arrayN(edge_groups_len + 1, sizeof(*edge_groups), __func__));
-
-          uint assigned_edges_len = 0;
-          NewEdgeRef *found_edge = nullptr;
-          uint found_edge_index = 0;
-          bool insert_at_start = false;
-          uint eg_capacity = 5;
-          NewFaceRef *eg_track_faces[2] = {nullptr, nullptr};
-          NewFaceRef *last_open_edge_track = nullptr;
-
-          while (assigned_edges_len < unassigned_edges_len) {
-            found_edge = nullptr;
-            insert_at_start = false;
-            if (eg_index >= 0 && edge_groups[eg_index].edges_len == 0) {
-              /* Called every time a new group was started in the last iteration. */
-              /* Find an unused edge to start the next group
-               * and setup variables to start creating it. */
-              uint j = 0;
-              NewEdgeRef *edge = nullptr;
-              while (!edge && j < unassigned_edges_len) {
-                edge = unassigned_edges[j++];
-                if (edge && last_open_edge_track &&
-                    (edge->faces[0] != last_open_edge_track || edge->faces[1] != nullptr))
-                {
-                  edge = nullptr;
-                }
-              }
-              if (!edge && last_open_edge_track) {
-                topo_groups++;
-                last_open_edge_track = nullptr;
-                edge_groups[eg_index].topo_group++;
-                j = 0;
+            /* An edge group will always contain min 2 edges
+             * so max edge group count can be calculated. */
+            uint edge_groups_len = unassigned_edges_len / 2;
+            edge_groups = static_cast<EdgeGroup *>(
+                MEM_calloc_arrayN(edge_groups_len + 1, sizeof(*edge_groups), __func__));
+
+            uint assigned_edges_len = 0;
+            NewEdgeRef *found_edge = nullptr;
+            uint found_edge_index = 0;
+            bool insert_at_start = false;
+            uint eg_capacity = 5;
+            NewFaceRef *eg_track_faces[2] = {nullptr, nullptr};
+            NewFaceRef *last_open_edge_track = nullptr;
+
+            while (assigned_edges_len < unassigned_edges_len) {
+              found_edge = nullptr;
+              insert_at_start = false;
+              if (eg_index >= 0 && edge_groups[eg_index].edges_len == 0) {
+                /* Called every time a new group was started in the last iteration. */
+                /* Find an unused edge to start the next group
+                 * and setup variables to start creating it. */
+                uint j = 0;
+                NewEdgeRef *edge = nullptr;
                 while (!edge && j < unassigned_edges_len) {
                   edge = unassigned_edges[j++];
+                  if (edge && last_open_edge_track &&
+                      (edge->faces[0] != last_open_edge_track || edge->faces[1] != nullptr))
+                  {
+                    edge = nullptr;
+                  }
                 }
-              }
-              else if (!last_open_edge_track && eg_index > 0) {
-                topo_groups++;
-                edge_groups[eg_index].topo_group++;
-              }
-              BLI_assert(edge != nullptr);
-              found_edge_index = j - 1;
-              found_edge = edge;
-              if (!last_open_edge_track && vm[orig_edges[edge->old_edge][0]] == i) {
-                eg_track_faces[0] = edge->faces[0];
-                eg_track_faces[1] = edge->faces[1];
-                if (edge->faces[1] == nullptr) {
-                  last_open_edge_track = edge->faces[0]->reversed ? edge->faces[0] - 1 :
-                                                                    edge->faces[0] + 1;
-                }
-              }
-              else {
-                eg_track_faces[0] = edge->faces[1];
-                eg_track_faces[1] = edge->faces[0];
-              }
-            }
-            else if (eg_index >= 0) {
-              NewEdgeRef **edge_ptr = unassigned_edges;
-              for (found_edge_index = 0; found_edge_index < unassigned_edges_len;
-                   found_edge_index++, edge_ptr++)
-              {
-                if (*edge_ptr) {
-                  NewEdgeRef *edge = *edge_ptr;
-                  if (edge->faces[0] == eg_track_faces[1]) {
-                    insert_at_start = false;
-                    eg_track_faces[1] = edge->faces[1];
-                    found_edge = edge;
-                    if (edge->faces[1] == nullptr) {
-                      edge_groups[eg_index].is_orig_closed = false;
-                      last_open_edge_track = edge->faces[0]->reversed ? edge->faces[0] - 1 :
-                                                                        edge->faces[0] + 1;
-                    }
-                    break;
+                if (!edge && last_open_edge_track) {
+                  topo_groups++;
+                  last_open_edge_track = nullptr;
+                  edge_groups[eg_index].topo_group++;
+                  j = 0;
+                  while (!edge && j < unassigned_edges_len) {
+                    edge = unassigned_edges[j++];
                   }
-                  if (edge->faces[0] == eg_track_faces[0]) {
-                    insert_at_start = true;
-                    eg_track_faces[0] = edge->faces[1];
-                    found_edge = edge;
-                    if (edge->faces[1] == nullptr) {
-                      edge_groups[eg_index].is_orig_closed = false;
-                    }
-                    break;
+                }
+                else if (!last_open_edge_track && eg_index > 0) {
+                  topo_groups++;
+                  edge_groups[eg_index].topo_group++;
+                }
+                BLI_assert(edge != nullptr);
+                found_edge_index = j - 1;
+                found_edge = edge;
+                if (!last_open_edge_track && vm[orig_edges[edge->old_edge][0]] == i) {
+                  eg_track_faces[0] = edge->faces[0];
+                  eg_track_faces[1] = edge->faces[1];
+                  if (edge->faces[1] == nullptr) {
+                    last_open_edge_track = edge->faces[0]->reversed ? edge->faces[0] - 1 :
+                                                                      edge->faces[0] + 1;
                   }
-                  if (edge->faces[1] != nullptr) {
-                    if (edge->faces[1] == eg_track_faces[1]) {
+                }
+                else {
+                  eg_track_faces[0] = edge->faces[1];
+                  eg_track_faces[1] = edge->faces[0];
+                }
+              }
+              else if (eg_index >= 0) {
+                NewEdgeRef **edge_ptr = unassigned_edges;
+                for (found_edge_index = 0; found_edge_index < unassigned_edges_len;
+                     found_edge_index++, edge_ptr++)
+                {
+                  if (*edge_ptr) {
+                    NewEdgeRef *edge = *edge_ptr;
+                    if (edge->faces[0] == eg_track_faces[1]) {
                       insert_at_start = false;
-                      eg_track_faces[1] = edge->faces[0];
+                      eg_track_faces[1] = edge->faces[1];
                       found_edge = edge;
+                      if (edge->faces[1] == nullptr) {
+                        edge_groups[eg_index].is_orig_closed = false;
+                        last_open_edge_track = edge->faces[0]->reversed ? edge->faces[0] - 1 :
+                                                                          edge->faces[0] + 1;
+                      }
                       break;
                     }
-                    if (edge->faces[1] == eg_track_faces[0]) {
+                    if (edge->faces[0] == eg_track_faces[0]) {
                       insert_at_start = true;
-                      eg_track_faces[0] = edge->faces[0];
+                      eg_track_faces[0] = edge->faces[1];
                       found_edge = edge;
+                      if (edge->faces[1] == nullptr) {
+                        edge_groups[eg_index].is_orig_closed = false;
+                      }
                       break;
                     }
+                    if (edge->faces[1] != nullptr) {
+                      if (edge->faces[1] == eg_track_faces[1]) {
+                        insert_at_start = false;
+                        eg_track_faces[1] = edge->faces[0];
+                        found_edge = edge;
+                        break;
+                      }
+                      if (edge->faces[1] == eg_track_faces[0]) {
+                        insert_at_start = true;
+                        eg_track_faces[0] = edge->faces[0];
+                        found_edge = edge;
+                        break;
+                      }
+                    }
                   }
                 }
               }
-            }
-            if (found_edge) {
-              unassigned_edges[found_edge_index] = nullptr;
-              assigned_edges_len++;
-              const uint needed_capacity = edge_groups[eg_index].edges_len + 1;
-              if (needed_capacity > eg_capacity) {
-                eg_capacity = needed_capacity + 1;
-                NewEdgeRef **new_eg = static_cast<NewEdgeRef **>(
-                    MEM_calloc_arrayN(eg_capacity, sizeof(*new_eg), __func__));
-                if (insert_at_start) {
-                  memcpy(new_eg + 1,
-                         edge_groups[eg_index].edges,
-                         edge_groups[eg_index].edges_len * sizeof(*new_eg));
+              if (found_edge) {
+                unassigned_edges[found_edge_index] = nullptr;
+                assigned_edges_len++;
+                const uint needed_capacity = edge_groups[eg_index].edges_len + 1;
+                if (needed_capacity > eg_capacity) {
+                  eg_capacity = needed_capacity + 1;
+                  NewEdgeRef **new_eg = static_cast<NewEdgeRef **>(
+                      MEM_calloc_arrayN(eg_capacity, sizeof(*new_eg), __func__));
+                  if (insert_at_start) {
+                    memcpy(new_eg + 1,
+                           edge_groups[eg_index].edges,
+                           edge_groups[eg_index].edges_len * sizeof(*new_eg));
+                  }
+                  else {
+                    memcpy(new_eg,
+                           edge_groups[eg_index].edges,
+                           edge_groups[eg_index].edges_len * sizeof(*new_eg));
+                  }
+                  MEM_freeN(edge_groups[eg_index].edges);
+                  edge_groups[eg_index].edges = new_eg;
                 }
-                else {
-                  memcpy(new_eg,
-                         edge_groups[eg_index].edges,
-                         edge_groups[eg_index].edges_len * sizeof(*new_eg));
+                else if (insert_at_start) {
+                  memmove(edge_groups[eg_index].edges + 1,
+                          edge_groups[eg_index].edges,
+                          edge_groups[eg_index].edges_len * sizeof(*edge_groups[eg_index].edges));
+                }
+                edge_groups[eg_index]
+                    .edges[insert_at_start ? 0 : edge_groups[eg_index].edges_len] = found_edge;
+                edge_groups[eg_index].edges_len++;
+                if (edge_groups[eg_index].edges[edge_groups[eg_index].edges_len - 1]->faces[1] !=
+                    nullptr)
+                {
+                  last_open_edge_track = nullptr;
+                }
+                if (edge_groups[eg_index].edges_len > 3) {
+                  contains_long_groups = true;
                 }
-                MEM_freeN(edge_groups[eg_index].edges);
-                edge_groups[eg_index].edges = new_eg;
-              }
-              else if (insert_at_start) {
-                memmove(edge_groups[eg_index].edges + 1,
-                        edge_groups[eg_index].edges,
-                        edge_groups[eg_index].edges_len * sizeof(*edge_groups[eg_index].edges));
-              }
-              edge_groups[eg_index].edges[insert_at_start ? 0 : edge_groups[eg_index].edges_len] =
-                  found_edge;
-              edge_groups[eg_index].edges_len++;
-              if (edge_groups[eg_index].edges[edge_groups[eg_index].edges_len - 1]->faces[1] !=
-                  nullptr)
-              {
-                last_open_edge_track = nullptr;
-              }
-              if (edge_groups[eg_index].edges_len > 3) {
-                contains_long_groups = true;
               }
-            }
-            else {
-              /* called on first iteration to clean up the eg_index = -1 and start the first group,
-               * or when the current group is found to be complete (no new found_edge) */
-              eg_index++;
-              BLI_assert(eg_index < edge_groups_len);
-              eg_capacity = 5;
-              NewEdgeRef **edges = static_cast<NewEdgeRef **>(
-                  MEM_calloc_arrayN(eg_capacity, sizeof(*edges), __func__));
-
-              EdgeGroup edge_group{};
-              edge_group.valid = true;
-              edge_group.edges = edges;
-              edge_group.edges_len = 0;
-              edge_group.open_face_edge = MOD_SOLIDIFY_EMPTY_TAG;
-              edge_group.is_orig_closed = true;
-              edge_group.is_even_split = false;
-              edge_group.split = 0;
-              edge_group.is_singularity = false;
-              edge_group.topo_group = topo_groups;
-              zero_v3(edge_group.co);
-              zero_v3(edge_group.no);
-              edge_group.new_vert = MOD_SOLIDIFY_EMPTY_TAG;
-              edge_groups[eg_index] = edge_group;
-
-              eg_track_faces[0] = nullptr;
-              eg_track_faces[1] = nullptr;
-            }
+              else {
+                /* called on first iteration to clean up the eg_index = -1 and start the first
+                 * group, or when the current group is found to be complete (no new found_edge) */
+                eg_index++;
+                BLI_assert(eg_index < edge_groups_len);
+                eg_capacity = 5;
+                NewEdgeRef **edges = static_cast<NewEdgeRef **>(
+                    MEM_calloc_arrayN(eg_capacity, sizeof(*edges), __func__));
+
+                EdgeGroup edge_group{};
+                edge_group.valid = true;
+                edge_group.edges = edges;
+                edge_group.edges_len = 0;
+                edge_group.open_face_edge = MOD_SOLIDIFY_EMPTY_TAG;
+                edge_group.is_orig_closed = true;
+                edge_group.is_even_split = false;
+                edge_group.split = 0;
+                edge_group.is_singularity = false;
+                edge_group.topo_group = topo_groups;
+                zero_v3(edge_group.co);
+                zero_v3(edge_group.no);
+                edge_group.new_vert = MOD_SOLIDIFY_EMPTY_TAG;
+                edge_groups[eg_index] = edge_group;
+
+                eg_track_faces[0] = nullptr;
+                eg_track_faces[1] = nullptr;
+              }
+            }
+            /* #eg_index is the number of groups from here on. */
+            eg_index++;
+            /* #topo_groups is the number of topo groups from here on. */
+            topo_groups++;
+
+            MEM_freeN(unassigned_edges);
+
+            /* TODO: reshape the edge_groups array to its actual size
+             * after writing is finished to save on memory. */
           }
-          /* #eg_index is the number of groups from here on. */
-          eg_index++;
-          /* #topo_groups is the number of topo groups from here on. */
-          topo_groups++;
-
-          MEM_freeN(unassigned_edges);
 
-          /* TODO: reshape the edge_groups array to its actual size
-           * after writing is finished to save on memory. */
-        }
-
-        /* Split of long self intersection groups */
-        {
-          uint splits = 0;
-          if (contains_long_groups) {
-            uint add_index = 0;
-            for (uint j = 0; j < eg_index; j++) {
-              const uint edges_len = edge_groups[j + add_index].edges_len;
-              if (edges_len > 3) {
-                bool has_doubles = false;
-                bool *doubles = static_cast<bool *>(
-                    MEM_calloc_arrayN(edges_len, sizeof(*doubles), __func__));
-                EdgeGroup g = edge_groups[j + add_index];
-                for (uint k = 0; k < edges_len; k++) {
-                  for (uint l = k + 1; l < edges_len; l++) {
-                    if (g.edges[k]->old_edge == g.edges[l]->old_edge) {
-                      doubles[k] = true;
-                      doubles[l] = true;
-                      has_doubles = true;
+          /* Split of long self intersection groups */
+          {
+            uint splits = 0;
+            if (contains_long_groups) {
+              uint add_index = 0;
+              for (uint j = 0; j < eg_index; j++) {
+                const uint edges_len = edge_groups[j + add_index].edges_len;
+                if (edges_len > 3) {
+                  bool has_doubles = false;
+                  bool *doubles = static_cast<bool *>(
+                      MEM_calloc_arrayN(edges_len, sizeof(*doubles), __func__));
+                  EdgeGroup g = edge_groups[j + add_index];
+                  for (uint k = 0; k < edges_len; k++) {
+                    for (uint l = k + 1; l < edges_len; l++) {
+                      if (g.edges[k]->old_edge == g.edges[l]->old_edge) {
+                        doubles[k] = true;
+                        doubles[l] = true;
+                        has_doubles = true;
+                      }
                     }
                   }
-                }
-                if (has_doubles) {
-                  const uint prior_splits = splits;
-                  const uint prior_index = add_index;
-                  int unique_start = -1;
-                  int first_unique_end = -1;
-                  int last_split = -1;
-                  int first_split = -1;
-                  bool first_even_split = false;
-                  uint real_k = 0;
-                  while (real_k < edges_len ||
-                         (g.is_orig_closed &&
-                          (real_k <=
-                               (first_unique_end == -1 ? 0 : first_unique_end) + int(edges_len) ||
-                           first_split != last_split)))
-                  {
-                    const uint k = real_k % edges_len;
-                    if (!doubles[k]) {
-                      if (first_unique_end != -1 && unique_start == -1) {
-                        unique_start = int(real_k);
+                  if (has_doubles) {
+                    const uint prior_splits = splits;
+                    const uint prior_index = add_index;
+                    int unique_start = -1;
+                    int first_unique_end = -1;
+                    int last_split = -1;
+                    int first_split = -1;
+                    bool first_even_split = false;
+                    uint real_k = 0;
+                    while (real_k < edges_len ||
+                           (g.is_orig_closed &&
+                            (real_k <= (first_unique_end == -1 ? 0 : first_unique_end) +
+                                           int(edges_len) ||
+                             first_split != last_split)))
+                    {
+                      const uint k = real_k % edges_len;
+                      if (!doubles[k]) {
+                        if (first_unique_end != -1 && unique_start == -1) {
+                          unique_start = int(real_k);
+                        }
                       }
+                      else if (first_unique_end == -1) {
+                        first_unique_end = int(k);
+                      }
+                      else if (unique_start != -1) {
+                        const uint split = ((uint(unique_start) + real_k + 1) / 2) % edges_len;
+                        const bool is_even_split = ((uint(unique_start) + real_k) & 1);
+                        if (last_split != -1) {
+                          /* Override g on first split (no insert). */
+                          if (prior_splits != splits) {
+                            memmove(edge_groups + j + add_index + 1,
+                                    edge_groups + j + add_index,
+                                    (uint(eg_index) - j) * sizeof(*edge_groups));
+                            add_index++;
+                          }
+                          if (last_split > split) {
+                            const uint edges_len_group = (split + edges_len) - uint(last_split);
+                            NewEdgeRef **edges = static_cast<NewEdgeRef **>(
+                                MEM_malloc_arrayN(edges_len_group, sizeof(*edges), __func__));
+                            memcpy(edges,
+                                   g.edges + last_split,
+                                   (edges_len - uint(last_split)) * sizeof(*edges));
+                            memcpy(edges + (edges_len - uint(last_split)),
+                                   g.edges,
+                                   split * sizeof(*edges));
+
+                            EdgeGroup edge_group{};
+                            edge_group.valid = true;
+                            edge_group.edges = edges;
+                            edge_group.edges_len = edges_len_group;
+                            edge_group.open_face_edge = MOD_SOLIDIFY_EMPTY_TAG;
+                            edge_group.is_orig_closed = g.is_orig_closed;
+                            edge_group.is_even_split = is_even_split;
+                            edge_group.split = add_index - prior_index + 1 +
+                                               uint(!g.is_orig_closed);
+                            edge_group.is_singularity = false;
+                            edge_group.topo_group = g.topo_group;
+                            zero_v3(edge_group.co);
+                            zero_v3(edge_group.no);
+                            edge_group.new_vert = MOD_SOLIDIFY_EMPTY_TAG;
+                            edge_groups[j + add_index] = edge_group;
+                          }
+                          else {
+                            const uint edges_len_group = split - uint(last_split);
+                            NewEdgeRef **edges = static_cast<NewEdgeRef **>(
+                                MEM_malloc_arrayN(edges_len_group, sizeof(*edges), __func__));
+                            memcpy(edges, g.edges + last_split, edges_len_group * sizeof(*edges));
+
+                            EdgeGroup edge_group{};
+                            edge_group.valid = true;
+                            edge_group.edges = edges;
+                            edge_group.edges_len = edges_len_group;
+                            edge_group.open_face_edge = MOD_SOLIDIFY_EMPTY_TAG;
+                            edge_group.is_orig_closed = g.is_orig_closed;
+                            edge_group.is_even_split = is_even_split;
+                            edge_group.split = add_index - prior_index + 1 +
+                                               uint(!g.is_orig_closed);
+                            edge_group.is_singularity = false;
+                            edge_group.topo_group = g.topo_group;
+                            zero_v3(edge_group.co);
+                            zero_v3(edge_group.no);
+                            edge_group.new_vert = MOD_SOLIDIFY_EMPTY_TAG;
+                            edge_groups[j + add_index] = edge_group;
+                          }
+                          splits++;
+                        }
+                        last_split = int(split);
+                        if (first_split == -1) {
+                          first_split = int(split);
+                          first_even_split = is_even_split;
+                        }
+                        unique_start = -1;
+                      }
+                      real_k++;
                     }
-                    else if (first_unique_end == -1) {
-                      first_unique_end = int(k);
-                    }
-                    else if (unique_start != -1) {
-                      const uint split = ((uint(unique_start) + real_k + 1) / 2) % edges_len;
-                      const bool is_even_split = ((uint(unique_start) + real_k) & 1);
-                      if (last_split != -1) {
-                        /* Override g on first split (no insert). */
+                    if (first_split != -1) {
+                      if (!g.is_orig_closed) {
                         if (prior_splits != splits) {
-                          memmove(edge_groups + j + add_index + 1,
-                                  edge_groups + j + add_index,
+                          memmove(edge_groups + (j + prior_index + 1),
+                                  edge_groups + (j + prior_index),
+                                  (uint(eg_index) + add_index - (j + prior_index)) *
+                                      sizeof(*edge_groups));
+                          memmove(edge_groups + (j + add_index + 2),
+                                  edge_groups + (j + add_index + 1),
                                   (uint(eg_index) - j) * sizeof(*edge_groups));
                           add_index++;
                         }
-                        if (last_split > split) {
-                          const uint edges_len_group = (split + edges_len) - uint(last_split);
-                          NewEdgeRef **edges = static_cast<NewEdgeRef **>(
-                              MEM_malloc_arrayN(edges_len_group, sizeof(*edges), __func__));
-                          memcpy(edges,
-                                 g.edges + last_split,
-                                 (edges_len - uint(last_split)) * sizeof(*edges));
-                          memcpy(edges + (edges_len - uint(last_split)),
-                                 g.edges,
-                                 split * sizeof(*edges));
-
-                          EdgeGroup edge_group{};
-                          edge_group.valid = true;
-                          edge_group.edges = edges;
-                          edge_group.edges_len = edges_len_group;
-                          edge_group.open_face_edge = MOD_SOLIDIFY_EMPTY_TAG;
-                          edge_group.is_orig_closed = g.is_orig_closed;
-                          edge_group.is_even_split = is_even_split;
-                          edge_group.split = add_index - prior_index + 1 + uint(!g.is_orig_closed);
-                          edge_group.is_singularity = false;
-                          edge_group.topo_group = g.topo_group;
-                          zero_v3(edge_group.co);
-                          zero_v3(edge_group.no);
-                          edge_group.new_vert = MOD_SOLIDIFY_EMPTY_TAG;
-                          edge_groups[j + add_index] = edge_group;
-                        }
                         else {
-                          const uint edges_len_group = split - uint(last_split);
-                          NewEdgeRef **edges = static_cast<NewEdgeRef **>(
-                              MEM_malloc_arrayN(edges_len_group, sizeof(*edges), __func__));
-                          memcpy(edges, g.edges + last_split, edges_len_group * sizeof(*edges));
-
-                          EdgeGroup edge_group{};
-                          edge_group.valid = true;
-                          edge_group.edges = edges;
-                          edge_group.edges_len = edges_len_group;
-                          edge_group.open_face_edge = MOD_SOLIDIFY_EMPTY_TAG;
-                          edge_group.is_orig_closed = g.is_orig_closed;
-                          edge_group.is_even_split = is_even_split;
-                          edge_group.split = add_index - prior_index + 1 + uint(!g.is_orig_closed);
-                          edge_group.is_singularity = false;
-                          edge_group.topo_group = g.topo_group;
-                          zero_v3(edge_group.co);
-                          zero_v3(edge_group.no);
-                          edge_group.new_vert = MOD_SOLIDIFY_EMPTY_TAG;
-                          edge_groups[j + add_index] = edge_group;
+                          memmove(edge_groups + (j + add_index + 2),
+                                  edge_groups + (j + add_index + 1),
+                                  (uint(eg_index) - j - 1) * sizeof(*edge_groups));
                         }
+                        NewEdgeRef **edges = static_cast<NewEdgeRef **>(
+                            MEM_malloc_arrayN(uint(first_split), sizeof(*edges), __func__));
+                        memcpy(edges, g.edges, uint(first_split) * sizeof(*edges));
+
+                        EdgeGroup edge_group_a{};
+                        edge_group_a.valid = true;
+                        edge_group_a.edges = edges;
+                        edge_group_a.edges_len = uint(first_split);
+                        edge_group_a.open_face_edge = MOD_SOLIDIFY_EMPTY_TAG;
+                        edge_group_a.is_orig_closed = g.is_orig_closed;
+                        edge_group_a.is_even_split = first_even_split;
+                        edge_group_a.split = 1;
+                        edge_group_a.is_singularity = false;
+                        edge_group_a.topo_group = g.topo_group;
+                        zero_v3(edge_group_a.co);
+                        zero_v3(edge_group_a.no);
+                        edge_group_a.new_vert = MOD_SOLIDIFY_EMPTY_TAG;
+                        edge_groups[j + prior_index] = edge_group_a;
+
+                        add_index++;
                         splits++;
+                        edges = static_cast<NewEdgeRef **>(MEM_malloc_arrayN(
+                            edges_len - uint(last_split), sizeof(*edges), __func__));
+                        memcpy(edges,
+                               g.edges + last_split,
+                               (edges_len - uint(last_split)) * sizeof(*edges));
+
+                        EdgeGroup edge_group_b{};
+                        edge_group_b.valid = true;
+                        edge_group_b.edges = edges;
+                        edge_group_b.edges_len = (edges_len - uint(last_split));
+                        edge_group_b.open_face_edge = MOD_SOLIDIFY_EMPTY_TAG;
+                        edge_group_b.is_orig_closed = g.is_orig_closed;
+                        edge_group_b.is_even_split = false;
+                        edge_group_b.split = add_index - prior_index + 1;
+                        edge_group_b.is_singularity = false;
+                        edge_group_b.topo_group = g.topo_group;
+                        zero_v3(edge_group_b.co);
+                        zero_v3(edge_group_b.no);
+                        edge_group_b.new_vert = MOD_SOLIDIFY_EMPTY_TAG;
+                        edge_groups[j + add_index] = edge_group_b;
                       }
-                      last_split = int(split);
-                      if (first_split == -1) {
-                        first_split = int(split);
-                        first_even_split = is_even_split;
-                      }
-                      unique_start = -1;
-                    }
-                    real_k++;
-                  }
-                  if (first_split != -1) {
-                    if (!g.is_orig_closed) {
                       if (prior_splits != splits) {
-                        memmove(edge_groups + (j + prior_index + 1),
-                                edge_groups + (j + prior_index),
-                                (uint(eg_index) + add_index - (j + prior_index)) *
-                                    sizeof(*edge_groups));
-                        memmove(edge_groups + (j + add_index + 2),
-                                edge_groups + (j + add_index + 1),
-                                (uint(eg_index) - j) * sizeof(*edge_groups));
-                        add_index++;
+                        MEM_freeN(g.edges);
                       }
-                      else {
-                        memmove(edge_groups + (j + add_index + 2),
-                                edge_groups + (j + add_index + 1),
-                                (uint(eg_index) - j - 1) * sizeof(*edge_groups));
-                      }
-                      NewEdgeRef **edges = static_cast<NewEdgeRef **>(
-                          MEM_malloc_arrayN(uint(first_split), sizeof(*edges), __func__));
-                      memcpy(edges, g.edges, uint(first_split) * sizeof(*edges));
-
-                      EdgeGroup edge_group_a{};
-                      edge_group_a.valid = true;
-                      edge_group_a.edges = edges;
-                      edge_group_a.edges_len = uint(first_split);
-                      edge_group_a.open_face_edge = MOD_SOLIDIFY_EMPTY_TAG;
-                      edge_group_a.is_orig_closed = g.is_orig_closed;
-                      edge_group_a.is_even_split = first_even_split;
-                      edge_group_a.split = 1;
-                      edge_group_a.is_singularity = false;
-                      edge_group_a.topo_group = g.topo_group;
-                      zero_v3(edge_group_a.co);
-                      zero_v3(edge_group_a.no);
-                      edge_group_a.new_vert = MOD_SOLIDIFY_EMPTY_TAG;
-                      edge_groups[j + prior_index] = edge_group_a;
-
-                      add_index++;
-                      splits++;
-                      edges = static_cast<NewEdgeRef **>(MEM_malloc_arrayN(
-                          edges_len - uint(last_split), sizeof(*edges), __func__));
-                      memcpy(edges,
-                             g.edges + last_split,
-                             (edges_len - uint(last_split)) * sizeof(*edges));
-
-                      EdgeGroup edge_group_b{};
-                      edge_group_b.valid = true;
-                      edge_group_b.edges = edges;
-                      edge_group_b.edges_len = (edges_len - uint(last_split));
-                      edge_group_b.open_face_edge = MOD_SOLIDIFY_EMPTY_TAG;
-                      edge_group_b.is_orig_closed = g.is_orig_closed;
-                      edge_group_b.is_even_split = false;
-                      edge_group_b.split = add_index - prior_index + 1;
-                      edge_group_b.is_singularity = false;
-                      edge_group_b.topo_group = g.topo_group;
-                      zero_v3(edge_group_b.co);
-                      zero_v3(edge_group_b.no);
-                      edge_group_b.new_vert = MOD_SOLIDIFY_EMPTY_TAG;
-                      edge_groups[j + add_index] = edge_group_b;
                     }
-                    if (prior_splits != splits) {
-                      MEM_freeN(g.edges);
+                    if (first_unique_end != -1 && prior_splits == splits) {
+                      vert_size.has_singularities = true;
+                      edge_groups[j + add_index].is_singularity = true;
                     }
                   }
-                  if (first_unique_end != -1 && prior_splits == splits) {
-                    has_singularities = true;
-                    edge_groups[j + add_index].is_singularity = true;
-                  }
+                  MEM_freeN(doubles);
                 }
-                MEM_freeN(doubles);
               }
             }
           }
-        }
 
-        orig_vert_groups_arr[i] = edge_groups;
-        /* Count new edges, loops, faces and add to link_edge_groups. */
-        {
-          uint new_verts = 0;
-          bool contains_open_splits = false;
-          uint open_edges = 0;
-          uint contains_splits = 0;
-          uint last_added = 0;
-          uint first_added = 0;
-          bool first_set = false;
-          for (EdgeGroup *g = edge_groups; g->valid; g++) {
-            NewEdgeRef **e = g->edges;
-            for (uint j = 0; j < g->edges_len; j++, e++) {
-              const uint flip = uint(vm[orig_edges[(*e)->old_edge][1]] == i);
-              BLI_assert(flip || vm[orig_edges[(*e)->old_edge][0]] == i);
-              (*e)->link_edge_groups[flip] = g;
-            }
-            uint added = 0;
-            if (do_shell || (do_rim && !g->is_orig_closed)) {
-              BLI_assert(g->new_vert == MOD_SOLIDIFY_EMPTY_TAG);
-              g->new_vert = new_verts_num++;
-              if (do_rim || (do_shell && g->split)) {
-                new_verts++;
-                contains_splits += (g->split != 0);
-                contains_open_splits |= g->split && !g->is_orig_closed;
-                added = g->split;
-              }
-            }
-            open_edges += uint(added < last_added);
-            if (!first_set) {
-              first_set = true;
-              first_added = added;
-            }
-            last_added = added;
-            if (!(g + 1)->valid || g->topo_group != (g + 1)->topo_group) {
-              if (new_verts > 2) {
-                new_faces_num++;
-                new_edges_num += new_verts;
-                open_edges += uint(first_added < last_added);
-                open_edges -= uint(open_edges && !contains_open_splits);
-                if (do_shell && do_rim) {
-                  new_loops_num += new_verts * 2;
+          orig_vert_groups_arr[i] = edge_groups;
+          /* Count new edges, loops, faces and add to link_edge_groups. */
+          {
+            uint new_verts = 0;
+            bool contains_open_splits = false;
+            uint open_edges = 0;
+            uint contains_splits = 0;
+            uint last_added = 0;
+            uint first_added = 0;
+            bool first_set = false;
+            for (EdgeGroup *g = edge_groups; g->valid; g++) {
+              NewEdgeRef **e = g->edges;
+              for (uint j = 0; j < g->edges_len; j++, e++) {
+                const uint flip = uint(vm[orig_edges[(*e)->old_edge][1]] == i);
+                BLI_assert(flip || vm[orig_edges[(*e)->old_edge][0]] == i);
+                (*e)->link_edge_groups[flip] = g;
+              }
+              uint added = 0;
+              if (do_shell || (do_rim && !g->is_orig_closed)) {
+                BLI_assert(g->new_vert == MOD_SOLIDIFY_EMPTY_TAG);
+                g->new_vert = vert_size.verts_num++;
+                if (do_rim || (do_shell && g->split)) {
+                  new_verts++;
+                  contains_splits += (g->split != 0);
+                  contains_open_splits |= g->split && !g->is_orig_closed;
+                  added = g->split;
                 }
-                else if (do_shell) {
-                  new_loops_num += new_verts * 2 - open_edges;
+              }
+              open_edges += uint(added < last_added);
+              if (!first_set) {
+                first_set = true;
+                first_added = added;
+              }
+              last_added = added;
+              if (!(g + 1)->valid || g->topo_group != (g + 1)->topo_group) {
+                if (new_verts > 2) {
+                  vert_size.faces_num++;
+                  vert_size.edges_num += new_verts;
+                  open_edges += uint(first_added < last_added);
+                  open_edges -= uint(open_edges && !contains_open_splits);
+                  if (do_shell && do_rim) {
+                    vert_size.loops_num += new_verts * 2;
+                  }
+                  else if (do_shell) {
+                    vert_size.loops_num += new_verts * 2 - open_edges;
+                  }
+                  else {  // do_rim
+                    vert_size.loops_num += new_verts * 2 + open_edges - contains_splits;
+                  }
                 }
-                else {  // do_rim
-                  new_loops_num += new_verts * 2 + open_edges - contains_splits;
+                else if (new_verts == 2) {
+                  vert_size.edges_num++;
+                  vert_size.loops_num += 2u - uint(!(do_rim && do_shell) && contains_open_splits);
                 }
+                new_verts = 0;
+                contains_open_splits = false;
+                contains_splits = 0;
+                open_edges = 0;
+                last_added = 0;
+                first_added = 0;
+                first_set = false;
               }
-              else if (new_verts == 2) {
-                new_edges_num++;
-                new_loops_num += 2u - uint(!(do_rim && do_shell) && contains_open_splits);
-              }
-              new_verts = 0;
-              contains_open_splits = false;
-              contains_splits = 0;
-              open_edges = 0;
-              last_added = 0;
-              first_added = 0;
-              first_set = false;
             }
           }
         }
       }
+    });
+
+    Array<uint> vert_new_vert_offsets(verts_num);
+    for (const uint i : IndexRange(verts_num)) {
+      vert_new_vert_offsets[i] = new_verts_num;
+      new_verts_num += vert_sizes[i].verts_num;
+      new_edges_num += vert_sizes[i].edges_num;
+      new_faces_num += vert_sizes[i].faces_num;
+      new_loops_num += vert_sizes[i].loops_num;
+      has_singularities |= vert_sizes[i].has_singularities;
     }
+    threading::parallel_for(IndexRange(verts_num), 1024, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        if (orig_vert_groups_arr[i] == nullptr || vert_new_vert_offsets[i] == 0) {
+          continue;
+        }
+        for (EdgeGroup *g = orig_vert_groups_arr[i]; g->valid; g++) {
+          if (g->new_vert != MOD_SOLIDIFY_EMPTY_TAG) {
+            g->new_vert += vert_new_vert_offsets[i];
+          }
+        }
+      }
+    });
   }
 
   /* Free vert_adj_edges memory. */
@@ -1416,520 +1458,531 @@ Mesh *MOD_solidify_nonmanifold_modifyMesh(ModifierData *md,
       face_weight = static_cast<float *>(
           MEM_malloc_arrayN(faces_num, sizeof(*face_weight), __func__));
 
-      for (const int i : orig_faces.index_range()) {
-        float scalar_vgroup = 1.0f;
-        for (const int vert : orig_corner_verts.slice(orig_faces[i])) {
-          const MDeformVert *dv = &dvert[vert];
-          if (defgrp_invert) {
-            scalar_vgroup = min_ff(1.0f - BKE_defvert_find_weight(dv, defgrp_index),
-                                   scalar_vgroup);
-          }
-          else {
-            scalar_vgroup = min_ff(BKE_defvert_find_weight(dv, defgrp_index), scalar_vgroup);
+      threading::parallel_for(orig_faces.index_range(), 1024, [&](const IndexRange range) {
+        for (const int i : range) {
+          float scalar_vgroup = 1.0f;
+          for (const int vert : orig_corner_verts.slice(orig_faces[i])) {
+            const MDeformVert *dv = &dvert[vert];
+            if (defgrp_invert) {
+              scalar_vgroup = min_ff(1.0f - BKE_defvert_find_weight(dv, defgrp_index),
+                                     scalar_vgroup);
+            }
+            else {
+              scalar_vgroup = min_ff(BKE_defvert_find_weight(dv, defgrp_index), scalar_vgroup);
+            }
           }
+          scalar_vgroup = offset_fac_vg + (scalar_vgroup * offset_fac_vg_inv);
+          face_weight[i] = scalar_vgroup;
         }
-        scalar_vgroup = offset_fac_vg + (scalar_vgroup * offset_fac_vg_inv);
-        face_weight[i] = scalar_vgroup;
-      }
+      });
     }
 
-    gs_ptr = orig_vert_groups_arr;
-    for (uint i = 0; i < verts_num; i++, gs_ptr++) {
-      if (*gs_ptr) {
-        for (EdgeGroup *g = *gs_ptr; g->valid; g++) {
-          if (!g->is_singularity) {
-            float *nor = g->no;
-            /* During vertex position calculation, the algorithm decides if it wants to disable the
-             * boundary fix to maintain correct thickness. If the used algorithm does not produce a
-             * free move direction (move_nor), it can use approximate_free_direction to decide on
-             * a movement direction based on the connected edges. */
-            float move_nor[3] = {0, 0, 0};
-            bool disable_boundary_fix = (smd->nonmanifold_boundary_mode ==
-                                             MOD_SOLIDIFY_NONMANIFOLD_BOUNDARY_MODE_NONE ||
-                                         (g->is_orig_closed || g->split));
-            bool approximate_free_direction = false;
-            /* Constraints Method. */
-            if (smd->nonmanifold_offset_mode == MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_CONSTRAINTS) {
-              NewEdgeRef *first_edge = nullptr;
-              NewEdgeRef **edge_ptr = g->edges;
-              /* Contains normal and offset `[nx, ny, nz, ofs]`. */
-              float(*planes_queue)[4] = static_cast<float(*)[4]>(
-                  MEM_malloc_arrayN(g->edges_len + 1, sizeof(*planes_queue), __func__));
-              uint queue_index = 0;
-
-              float fallback_nor[3];
-              float fallback_ofs = 0.0f;
-
-              const bool cycle = (g->is_orig_closed && !g->split) || g->is_even_split;
-              for (uint k = 0; k < g->edges_len; k++, edge_ptr++) {
-                if (!(k & 1) || (!cycle && k == g->edges_len - 1)) {
-                  NewEdgeRef *edge = *edge_ptr;
-                  for (uint l = 0; l < 2; l++) {
-                    NewFaceRef *face = edge->faces[l];
-                    if (face && (first_edge == nullptr ||
-                                 (first_edge->faces[0] != face && first_edge->faces[1] != face)))
-                    {
-                      float ofs = face->reversed ? ofs_back_clamped : ofs_front_clamped;
-                      /* Use face_weight here to make faces thinner. */
-                      if (do_flat_faces) {
-                        ofs *= face_weight[face->index];
-                      }
+    /* The groups of every vert are independent. */
+    threading::parallel_for(IndexRange(verts_num), 256, [&](const IndexRange range) {
+      for (const int64_t vert : range) {
+        const uint i = uint(vert);
+        EdgeGroup *gs = orig_vert_groups_arr[i];
+        if (gs) {
+          for (EdgeGroup *g = gs; g->valid; g++) {
+            if (!g->is_singularity) {
+              float *nor = g->no;
+              /* During vertex position calculation, the algorithm decides if it wants to disable
+               * the boundary fix to maintain correct thickness. If the used algorithm does not
+               * produce a free move direction (move_nor), it can use approximate_free_direction to
+               * decide on a movement direction based on the connected edges. */
+              float move_nor[3] = {0, 0, 0};
+              bool disable_boundary_fix = (smd->nonmanifold_boundary_mode ==
+                                               MOD_SOLIDIFY_NONMANIFOLD_BOUNDARY_MODE_NONE ||
+                                           (g->is_orig_closed || g->split));
+              bool approximate_free_direction = false;
+              /* Constraints Method. */
+              if (smd->nonmanifold_offset_mode == MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_CONSTRAINTS)
+              {
+                NewEdgeRef *first_edge = nullptr;
+                NewEdgeRef **edge_ptr = g->edges;
+                /* Contains normal and offset `[nx, ny, nz, ofs]`. */
+                float(*planes_queue)[4] = static_cast<float(*)[4]>(
+                    MEM_malloc_arrayN(g->edges_len + 1, sizeof(*planes_queue), __func__));
+                uint queue_index = 0;
+
+                float fallback_nor[3];
+                float fallback_ofs = 0.0f;
+
+                const bool cycle = (g->is_orig_closed && !g->split) || g->is_even_split;
+                for (uint k = 0; k < g->edges_len; k++, edge_ptr++) {
+                  if (!(k & 1) || (!cycle && k == g->edges_len - 1)) {
+                    NewEdgeRef *edge = *edge_ptr;
+                    for (uint l = 0; l < 2; l++) {
+                      NewFaceRef *face = edge->faces[l];
+                      if (face && (first_edge == nullptr ||
+                                   (first_edge->faces[0] != face && first_edge->faces[1] != face)))
+                      {
+                        float ofs = face->reversed ? ofs_back_clamped : ofs_front_clamped;
+                        /* Use face_weight here to make faces thinner. */
+                        if (do_flat_faces) {
+                          ofs *= face_weight[face->index];
+                        }
 
-                      if (!null_faces[face->index]) {
-                        /* And plane to the queue. */
-                        mul_v3_v3fl(planes_queue[queue_index],
-                                    face_nors[face->index],
-                                    face->reversed ? -1 : 1);
-                        planes_queue[queue_index++][3] = ofs;
+                        if (!null_faces[face->index]) {
+                          /* And plane to the queue. */
+                          mul_v3_v3fl(planes_queue[queue_index],
+                                      face_nors[face->index],
+                                      face->reversed ? -1 : 1);
+                          planes_queue[queue_index++][3] = ofs;
+                        }
+                        else {
+                          /* Just use this approximate normal of the null face if there is no other
+                           * normal to use. */
+                          mul_v3_v3fl(
+                              fallback_nor, face_nors[face->index], face->reversed ? -1 : 1);
+                          fallback_ofs = ofs;
+                        }
                       }
-                      else {
-                        /* Just use this approximate normal of the null face if there is no other
-                         * normal to use. */
-                        mul_v3_v3fl(fallback_nor, face_nors[face->index], face->reversed ? -1 : 1);
-                        fallback_ofs = ofs;
+                    }
+                    if ((cycle && k == 0) || (!cycle && k + 3 >= g->edges_len)) {
+                      first_edge = edge;
+                    }
+                  }
+                }
+                if (queue_index > 2) {
+                  /* Find the two most different normals. */
+                  float min_p = 2.0f;
+                  uint min_n0 = 0;
+                  uint min_n1 = 0;
+                  for (uint k = 0; k < queue_index; k++) {
+                    for (uint m = k + 1; m < queue_index; m++) {
+                      float p = dot_v3v3(planes_queue[k], planes_queue[m]);
+                      if (p < min_p) {
+                        min_p = p;
+                        min_n0 = k;
+                        min_n1 = m;
                       }
                     }
                   }
-                  if ((cycle && k == 0) || (!cycle && k + 3 >= g->edges_len)) {
-                    first_edge = edge;
+                  /* Put the two found normals, first in the array queue. */
+                  if (min_n1 != 0) {
+                    swap_v4_v4(planes_queue[min_n0], planes_queue[0]);
+                    swap_v4_v4(planes_queue[min_n1], planes_queue[1]);
                   }
-                }
-              }
-              if (queue_index > 2) {
-                /* Find the two most different normals. */
-                float min_p = 2.0f;
-                uint min_n0 = 0;
-                uint min_n1 = 0;
-                for (uint k = 0; k < queue_index; k++) {
-                  for (uint m = k + 1; m < queue_index; m++) {
-                    float p = dot_v3v3(planes_queue[k], planes_queue[m]);
-                    if (p < min_p) {
-                      min_p = p;
-                      min_n0 = k;
-                      min_n1 = m;
+                  else {
+                    swap_v4_v4(planes_queue[min_n0], planes_queue[1]);
+                  }
+                  /* Find the third most important/different normal. */
+                  min_p = 1.0f;
+                  min_n1 = 2;
+                  float max_p = -1.0f;
+                  for (uint k = 2; k < queue_index; k++) {
+                    max_p = max_ff(dot_v3v3(planes_queue[0], planes_queue[k]),
+                                   dot_v3v3(planes_queue[1], planes_queue[k]));
+                    if (max_p <= min_p) {
+                      min_p = max_p;
+                      min_n1 = k;
                     }
                   }
+                  swap_v4_v4(planes_queue[min_n1], planes_queue[2]);
                 }
-                /* Put the two found normals, first in the array queue. */
-                if (min_n1 != 0) {
-                  swap_v4_v4(planes_queue[min_n0], planes_queue[0]);
-                  swap_v4_v4(planes_queue[min_n1], planes_queue[1]);
-                }
-                else {
-                  swap_v4_v4(planes_queue[min_n0], planes_queue[1]);
-                }
-                /* Find the third most important/different normal. */
-                min_p = 1.0f;
-                min_n1 = 2;
-                float max_p = -1.0f;
-                for (uint k = 2; k < queue_index; k++) {
-                  max_p = max_ff(dot_v3v3(planes_queue[0], planes_queue[k]),
-                                 dot_v3v3(planes_queue[1], planes_queue[k]));
-                  if (max_p <= min_p) {
-                    min_p = max_p;
-                    min_n1 = k;
+                /* Remove/average duplicate normals in planes_queue. */
+                while (queue_index > 2) {
+                  uint best_n0 = 0;
+                  uint best_n1 = 0;
+                  float best_p = -1.0f;
+                  float best_ofs_diff = 0.0f;
+                  for (uint k = 0; k < queue_index; k++) {
+                    for (uint m = k + 1; m < queue_index; m++) {
+                      float p = dot_v3v3(planes_queue[m], planes_queue[k]);
+                      float ofs_diff = fabsf(planes_queue[m][3] - planes_queue[k][3]);
+                      if (p > best_p + FLT_EPSILON || (p >= best_p && ofs_diff < best_ofs_diff)) {
+                        best_p = p;
+                        best_ofs_diff = ofs_diff;
+                        best_n0 = k;
+                        best_n1 = m;
+                      }
+                    }
+                  }
+                  /* Make sure there are no equal planes. This threshold is crucial for the
+                   * methods below to work without numerical issues. */
+                  if (best_p < 0.98f) {
+                    break;
                   }
+                  add_v3_v3(planes_queue[best_n0], planes_queue[best_n1]);
+                  normalize_v3(planes_queue[best_n0]);
+                  planes_queue[best_n0][3] = (planes_queue[best_n0][3] +
+                                              planes_queue[best_n1][3]) *
+                                             0.5f;
+                  queue_index--;
+                  memmove(planes_queue + best_n1,
+                          planes_queue + best_n1 + 1,
+                          (queue_index - best_n1) * sizeof(*planes_queue));
                 }
-                swap_v4_v4(planes_queue[min_n1], planes_queue[2]);
-              }
-              /* Remove/average duplicate normals in planes_queue. */
-              while (queue_index > 2) {
-                uint best_n0 = 0;
-                uint best_n1 = 0;
-                float best_p = -1.0f;
-                float best_ofs_diff = 0.0f;
-                for (uint k = 0; k < queue_index; k++) {
-                  for (uint m = k + 1; m < queue_index; m++) {
-                    float p = dot_v3v3(planes_queue[m], planes_queue[k]);
-                    float ofs_diff = fabsf(planes_queue[m][3] - planes_queue[k][3]);
-                    if (p > best_p + FLT_EPSILON || (p >= best_p && ofs_diff < best_ofs_diff)) {
-                      best_p = p;
-                      best_ofs_diff = ofs_diff;
-                      best_n0 = k;
-                      best_n1 = m;
+                const uint size = queue_index;
+                /* If there is more than 2 planes at this vertex, the boundary fix should be
+                 * disabled to stay at the correct thickness for all the faces. This is not very
+                 * good in practice though, since that will almost always disable the boundary fix.
+                 * Instead introduce a threshold which decides whether the boundary fix can be used
+                 * without major thickness changes. If the following constant is 1.0, it would
+                 * always prioritize correct thickness. At 0.7 the thickness is allowed to change a
+                 * bit if necessary for the fix (~10%). Note this only applies if a boundary fix is
+                 * used. */
+                const float boundary_fix_threshold = 0.7f;
+                if (size > 3) {
+                  /* Use the most general least squares method to find the best position. */
+                  float mat[3][3];
+                  zero_m3(mat);
+                  for (int k = 0; k < 3; k++) {
+                    for (int m = 0; m < size; m++) {
+                      madd_v3_v3fl(mat[k], planes_queue[m], planes_queue[m][k]);
                     }
+                    /* Add a small epsilon to ensure the invert is going to work.
+                     * This addition makes the inverse more stable and the results
+                     * seem to get more precise. */
+                    mat[k][k] += 5e-5f;
                   }
-                }
-                /* Make sure there are no equal planes. This threshold is crucial for the
-                 * methods below to work without numerical issues. */
-                if (best_p < 0.98f) {
-                  break;
-                }
-                add_v3_v3(planes_queue[best_n0], planes_queue[best_n1]);
-                normalize_v3(planes_queue[best_n0]);
-                planes_queue[best_n0][3] = (planes_queue[best_n0][3] + planes_queue[best_n1][3]) *
-                                           0.5f;
-                queue_index--;
-                memmove(planes_queue + best_n1,
-                        planes_queue + best_n1 + 1,
-                        (queue_index - best_n1) * sizeof(*planes_queue));
-              }
-              const uint size = queue_index;
-              /* If there is more than 2 planes at this vertex, the boundary fix should be disabled
-               * to stay at the correct thickness for all the faces. This is not very good in
-               * practice though, since that will almost always disable the boundary fix. Instead
-               * introduce a threshold which decides whether the boundary fix can be used without
-               * major thickness changes. If the following constant is 1.0, it would always
-               * prioritize correct thickness. At 0.7 the thickness is allowed to change a bit if
-               * necessary for the fix (~10%). Note this only applies if a boundary fix is used. */
-              const float boundary_fix_threshold = 0.7f;
-              if (size > 3) {
-                /* Use the most general least squares method to find the best position. */
-                float mat[3][3];
-                zero_m3(mat);
-                for (int k = 0; k < 3; k++) {
-                  for (int m = 0; m < size; m++) {
-                    madd_v3_v3fl(mat[k], planes_queue[m], planes_queue[m][k]);
+                  /* NOTE: this matrix invert fails if there is less than 3 different normals. */
+                  invert_m3(mat);
+                  zero_v3(nor);
+                  for (int k = 0; k < size; k++) {
+                    madd_v3_v3fl(nor, planes_queue[k], planes_queue[k][3]);
                   }
-                  /* Add a small epsilon to ensure the invert is going to work.
-                   * This addition makes the inverse more stable and the results
-                   * seem to get more precise. */
-                  mat[k][k] += 5e-5f;
-                }
-                /* NOTE: this matrix invert fails if there is less than 3 different normals. */
-                invert_m3(mat);
-                zero_v3(nor);
-                for (int k = 0; k < size; k++) {
-                  madd_v3_v3fl(nor, planes_queue[k], planes_queue[k][3]);
-                }
-                mul_v3_m3v3(nor, mat, nor);
-
-                if (!disable_boundary_fix) {
-                  /* Figure out if the approximate boundary fix can get use here. */
-                  float greatest_angle_cos = 1.0f;
-                  for (uint k = 0; k < 2; k++) {
-                    for (uint m = 2; m < size; m++) {
-                      float p = dot_v3v3(planes_queue[m], planes_queue[k]);
-                      if (p < greatest_angle_cos) {
-                        greatest_angle_cos = p;
+                  mul_v3_m3v3(nor, mat, nor);
+
+                  if (!disable_boundary_fix) {
+                    /* Figure out if the approximate boundary fix can get use here. */
+                    float greatest_angle_cos = 1.0f;
+                    for (uint k = 0; k < 2; k++) {
+                      for (uint m = 2; m < size; m++) {
+                        float p = dot_v3v3(planes_queue[m], planes_queue[k]);
+                        if (p < greatest_angle_cos) {
+                          greatest_angle_cos = p;
+                        }
                       }
                     }
+                    if (greatest_angle_cos > boundary_fix_threshold) {
+                      approximate_free_direction = true;
+                    }
+                    else {
+                      disable_boundary_fix = true;
+                    }
                   }
-                  if (greatest_angle_cos > boundary_fix_threshold) {
-                    approximate_free_direction = true;
+                }
+                else if (size > 1) {
+                  /* When up to 3 constraint normals are found, there is a simple solution. */
+                  const float stop_explosion = 0.999f - fabsf(smd->offset_fac) * 0.05f;
+                  const float q = dot_v3v3(planes_queue[0], planes_queue[1]);
+                  float d = 1.0f - q * q;
+                  cross_v3_v3v3(move_nor, planes_queue[0], planes_queue[1]);
+                  normalize_v3(move_nor);
+                  if (d > FLT_EPSILON * 10 && q < stop_explosion) {
+                    d = 1.0f / d;
+                    mul_v3_fl(planes_queue[0], (planes_queue[0][3] - planes_queue[1][3] * q) * d);
+                    mul_v3_fl(planes_queue[1], (planes_queue[1][3] - planes_queue[0][3] * q) * d);
                   }
                   else {
-                    disable_boundary_fix = true;
+                    d = 1.0f / (fabsf(q) + 1.0f);
+                    mul_v3_fl(planes_queue[0], planes_queue[0][3] * d);
+                    mul_v3_fl(planes_queue[1], planes_queue[1][3] * d);
                   }
-                }
-              }
-              else if (size > 1) {
-                /* When up to 3 constraint normals are found, there is a simple solution. */
-                const float stop_explosion = 0.999f - fabsf(smd->offset_fac) * 0.05f;
-                const float q = dot_v3v3(planes_queue[0], planes_queue[1]);
-                float d = 1.0f - q * q;
-                cross_v3_v3v3(move_nor, planes_queue[0], planes_queue[1]);
-                normalize_v3(move_nor);
-                if (d > FLT_EPSILON * 10 && q < stop_explosion) {
-                  d = 1.0f / d;
-                  mul_v3_fl(planes_queue[0], (planes_queue[0][3] - planes_queue[1][3] * q) * d);
-                  mul_v3_fl(planes_queue[1], (planes_queue[1][3] - planes_queue[0][3] * q) * d);
-                }
-                else {
-                  d = 1.0f / (fabsf(q) + 1.0f);
-                  mul_v3_fl(planes_queue[0], planes_queue[0][3] * d);
-                  mul_v3_fl(planes_queue[1], planes_queue[1][3] * d);
-                }
-                add_v3_v3v3(nor, planes_queue[0], planes_queue[1]);
-                if (size == 3) {
-                  d = dot_v3v3(planes_queue[2], move_nor);
-                  /* The following threshold ignores the third plane if it is almost orthogonal to
-                   * the still free direction. */
-                  if (fabsf(d) > 0.02f) {
-                    float tmp[3];
-                    madd_v3_v3v3fl(tmp, nor, planes_queue[2], -planes_queue[2][3]);
-                    mul_v3_v3fl(tmp, move_nor, dot_v3v3(planes_queue[2], tmp) / d);
-                    sub_v3_v3(nor, tmp);
-                    /* Disable boundary fix if the constraints would be majorly unsatisfied. */
-                    if (fabsf(d) > 1.0f - boundary_fix_threshold) {
-                      disable_boundary_fix = true;
+                  add_v3_v3v3(nor, planes_queue[0], planes_queue[1]);
+                  if (size == 3) {
+                    d = dot_v3v3(planes_queue[2], move_nor);
+                    /* The following threshold ignores the third plane if it is almost orthogonal
+                     * to the still free direction. */
+                    if (fabsf(d) > 0.02f) {
+                      float tmp[3];
+                      madd_v3_v3v3fl(tmp, nor, planes_queue[2], -planes_queue[2][3]);
+                      mul_v3_v3fl(tmp, move_nor, dot_v3v3(planes_queue[2], tmp) / d);
+                      sub_v3_v3(nor, tmp);
+                      /* Disable boundary fix if the constraints would be majorly unsatisfied. */
+                      if (fabsf(d) > 1.0f - boundary_fix_threshold) {
+                        disable_boundary_fix = true;
+                      }
                     }
                   }
+                  approximate_free_direction = false;
                 }
-                approximate_free_direction = false;
-              }
-              else if (size == 1) {
-                /* Face corner case. */
-                mul_v3_v3fl(nor, planes_queue[0], planes_queue[0][3]);
-                if (g->edges_len > 2) {
+                else if (size == 1) {
+                  /* Face corner case. */
+                  mul_v3_v3fl(nor, planes_queue[0], planes_queue[0][3]);
+                  if (g->edges_len > 2) {
+                    disable_boundary_fix = true;
+                    approximate_free_direction = true;
+                  }
+                }
+                else {
+                  /* Fallback case for null faces. */
+                  mul_v3_v3fl(nor, fallback_nor, fallback_ofs);
                   disable_boundary_fix = true;
-                  approximate_free_direction = true;
                 }
+                MEM_freeN(planes_queue);
               }
+              /* Fixed/Even Method. */
               else {
-                /* Fallback case for null faces. */
-                mul_v3_v3fl(nor, fallback_nor, fallback_ofs);
-                disable_boundary_fix = true;
-              }
-              MEM_freeN(planes_queue);
-            }
-            /* Fixed/Even Method. */
-            else {
-              float total_angle = 0;
-              float total_angle_back = 0;
-              NewEdgeRef *first_edge = nullptr;
-              NewEdgeRef **edge_ptr = g->edges;
-              float face_nor[3];
-              float nor_back[3] = {0, 0, 0};
-              bool has_back = false;
-              bool has_front = false;
-              bool cycle = (g->is_orig_closed && !g->split) || g->is_even_split;
-              for (uint k = 0; k < g->edges_len; k++, edge_ptr++) {
-                if (!(k & 1) || (!cycle && k == g->edges_len - 1)) {
-                  NewEdgeRef *edge = *edge_ptr;
-                  for (uint l = 0; l < 2; l++) {
-                    NewFaceRef *face = edge->faces[l];
-                    if (face && (first_edge == nullptr ||
-                                 (first_edge->faces[0] != face && first_edge->faces[1] != face)))
-                    {
-                      float angle = 1.0f;
-                      float ofs = face->reversed ? -ofs_back_clamped : ofs_front_clamped;
-                      /* Use face_weight here to make faces thinner. */
-                      if (do_flat_faces) {
-                        ofs *= face_weight[face->index];
-                      }
-
-                      if (smd->nonmanifold_offset_mode ==
-                          MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_EVEN)
+                float total_angle = 0;
+                float total_angle_back = 0;
+                NewEdgeRef *first_edge = nullptr;
+                NewEdgeRef **edge_ptr = g->edges;
+                float face_nor[3];
+                float nor_back[3] = {0, 0, 0};
+                bool has_back = false;
+                bool has_front = false;
+                bool cycle = (g->is_orig_closed && !g->split) || g->is_even_split;
+                for (uint k = 0; k < g->edges_len; k++, edge_ptr++) {
+                  if (!(k & 1) || (!cycle && k == g->edges_len - 1)) {
+                    NewEdgeRef *edge = *edge_ptr;
+                    for (uint l = 0; l < 2; l++) {
+                      NewFaceRef *face = edge->faces[l];
+                      if (face && (first_edge == nullptr ||
+                                   (first_edge->faces[0] != face && first_edge->faces[1] != face)))
                       {
-                        int corner_next = face->face.start();
-                        int corner = corner_next + (face->face.size() - 1);
-                        int corner_prev = corner - 1;
+                        float angle = 1.0f;
+                        float ofs = face->reversed ? -ofs_back_clamped : ofs_front_clamped;
+                        /* Use face_weight here to make faces thinner. */
+                        if (do_flat_faces) {
+                          ofs *= face_weight[face->index];
+                        }
 
-                        for (int m = 0;
-                             m < face->face.size() && vm[orig_corner_verts[corner]] != i;
-                             m++, corner_next++)
+                        if (smd->nonmanifold_offset_mode ==
+                            MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_EVEN)
                         {
-                          corner_prev = corner;
-                          corner = corner_next;
-                        }
-                        angle = angle_v3v3v3(orig_mvert_co[vm[orig_corner_verts[corner_prev]]],
-                                             orig_mvert_co[i],
-                                             orig_mvert_co[vm[orig_corner_verts[corner_next]]]);
-                        if (face->reversed) {
-                          total_angle_back += angle * ofs * ofs;
+                          int corner_next = face->face.start();
+                          int corner = corner_next + (face->face.size() - 1);
+                          int corner_prev = corner - 1;
+
+                          for (int m = 0;
+                               m < face->face.size() && vm[orig_corner_verts[corner]] != i;
+                               m++, corner_next++)
+                          {
+                            corner_prev = corner;
+                            corner = corner_next;
+                          }
+                          angle = angle_v3v3v3(orig_mvert_co[vm[orig_corner_verts[corner_prev]]],
+                                               orig_mvert_co[i],
+                                               orig_mvert_co[vm[orig_corner_verts[corner_next]]]);
+                          if (face->reversed) {
+                            total_angle_back += angle * ofs * ofs;
+                          }
+                          else {
+                            total_angle += angle * ofs * ofs;
+                          }
                         }
                         else {
-                          total_angle += angle * ofs * ofs;
+                          if (face->reversed) {
+                            total_angle_back++;
+                          }
+                          else {
+                            total_angle++;
+                          }
                         }
-                      }
-                      else {
+                        mul_v3_v3fl(face_nor, face_nors[face->index], angle * ofs);
                         if (face->reversed) {
-                          total_angle_back++;
+                          add_v3_v3(nor_back, face_nor);
+                          has_back = true;
                         }
                         else {
-                          total_angle++;
+                          add_v3_v3(nor, face_nor);
+                          has_front = true;
                         }
                       }
-                      mul_v3_v3fl(face_nor, face_nors[face->index], angle * ofs);
-                      if (face->reversed) {
-                        add_v3_v3(nor_back, face_nor);
-                        has_back = true;
-                      }
-                      else {
-                        add_v3_v3(nor, face_nor);
-                        has_front = true;
-                      }
                     }
-                  }
-                  if ((cycle && k == 0) || (!cycle && k + 3 >= g->edges_len)) {
-                    first_edge = edge;
+                    if ((cycle && k == 0) || (!cycle && k + 3 >= g->edges_len)) {
+                      first_edge = edge;
+                    }
                   }
                 }
-              }
 
-              /* Set normal length with selected method. */
-              if (smd->nonmanifold_offset_mode == MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_EVEN) {
-                if (has_front) {
-                  float length_sq = len_squared_v3(nor);
-                  if (LIKELY(length_sq > FLT_EPSILON)) {
-                    mul_v3_fl(nor, total_angle / length_sq);
-                  }
-                }
-                if (has_back) {
-                  float length_sq = len_squared_v3(nor_back);
-                  if (LIKELY(length_sq > FLT_EPSILON)) {
-                    mul_v3_fl(nor_back, total_angle_back / length_sq);
-                  }
-                  if (!has_front) {
-                    copy_v3_v3(nor, nor_back);
+                /* Set normal length with selected method. */
+                if (smd->nonmanifold_offset_mode == MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_EVEN) {
+                  if (has_front) {
+                    float length_sq = len_squared_v3(nor);
+                    if (LIKELY(length_sq > FLT_EPSILON)) {
+                      mul_v3_fl(nor, total_angle / length_sq);
+                    }
                   }
-                }
-                if (has_front && has_back) {
-                  float nor_length = len_v3(nor);
-                  float nor_back_length = len_v3(nor_back);
-                  float q = dot_v3v3(nor, nor_back);
-                  if (LIKELY(fabsf(q) > FLT_EPSILON)) {
-                    q /= nor_length * nor_back_length;
+                  if (has_back) {
+                    float length_sq = len_squared_v3(nor_back);
+                    if (LIKELY(length_sq > FLT_EPSILON)) {
+                      mul_v3_fl(nor_back, total_angle_back / length_sq);
+                    }
+                    if (!has_front) {
+                      copy_v3_v3(nor, nor_back);
+                    }
                   }
-                  float d = 1.0f - q * q;
-                  if (LIKELY(d > FLT_EPSILON)) {
-                    d = 1.0f / d;
-                    if (LIKELY(nor_length > FLT_EPSILON)) {
-                      mul_v3_fl(nor, (1 - nor_back_length * q / nor_length) * d);
+                  if (has_front && has_back) {
+                    float nor_length = len_v3(nor);
+                    float nor_back_length = len_v3(nor_back);
+                    float q = dot_v3v3(nor, nor_back);
+                    if (LIKELY(fabsf(q) > FLT_EPSILON)) {
+                      q /= nor_length * nor_back_length;
                     }
-                    if (LIKELY(nor_back_length > FLT_EPSILON)) {
-                      mul_v3_fl(nor_back, (1 - nor_length * q / nor_back_length) * d);
+                    float d = 1.0f - q * q;
+                    if (LIKELY(d > FLT_EPSILON)) {
+                      d = 1.0f / d;
+                      if (LIKELY(nor_length > FLT_EPSILON)) {
+                        mul_v3_fl(nor, (1 - nor_back_length * q / nor_length) * d);
+                      }
+                      if (LIKELY(nor_back_length > FLT_EPSILON)) {
+                        mul_v3_fl(nor_back, (1 - nor_length * q / nor_back_length) * d);
+                      }
+                      add_v3_v3(nor, nor_back);
+                    }
+                    else {
+                      mul_v3_fl(nor, 0.5f);
+                      mul_v3_fl(nor_back, 0.5f);
+                      add_v3_v3(nor, nor_back);
                     }
-                    add_v3_v3(nor, nor_back);
                   }
-                  else {
-                    mul_v3_fl(nor, 0.5f);
-                    mul_v3_fl(nor_back, 0.5f);
+                }
+                else {
+                  if (has_front && total_angle > FLT_EPSILON) {
+                    mul_v3_fl(nor, 1.0f / total_angle);
+                  }
+                  if (has_back && total_angle_back > FLT_EPSILON) {
+                    mul_v3_fl(nor_back, 1.0f / total_angle_back);
                     add_v3_v3(nor, nor_back);
+                    if (has_front && total_angle > FLT_EPSILON) {
+                      mul_v3_fl(nor, 0.5f);
+                    }
                   }
                 }
-              }
-              else {
-                if (has_front && total_angle > FLT_EPSILON) {
-                  mul_v3_fl(nor, 1.0f / total_angle);
+                /* Set move_nor for boundary fix. */
+                if (!disable_boundary_fix && g->edges_len > 2) {
+                  approximate_free_direction = true;
                 }
-                if (has_back && total_angle_back > FLT_EPSILON) {
-                  mul_v3_fl(nor_back, 1.0f / total_angle_back);
-                  add_v3_v3(nor, nor_back);
-                  if (has_front && total_angle > FLT_EPSILON) {
-                    mul_v3_fl(nor, 0.5f);
-                  }
+                else {
+                  disable_boundary_fix = true;
                 }
               }
-              /* Set move_nor for boundary fix. */
-              if (!disable_boundary_fix && g->edges_len > 2) {
-                approximate_free_direction = true;
-              }
-              else {
-                disable_boundary_fix = true;
-              }
-            }
-            if (approximate_free_direction) {
-              /* Set move_nor for boundary fix. */
-              NewEdgeRef **edge_ptr = g->edges + 1;
-              float tmp[3];
-              int k;
-              for (k = 1; k + 1 < g->edges_len; k++, edge_ptr++) {
-                const int2 &edge = orig_edges[(*edge_ptr)->old_edge];
-                sub_v3_v3v3(
-                    tmp, orig_mvert_co[vm[edge[0]] == i ? edge[1] : edge[0]], orig_mvert_co[i]);
-                add_v3_v3(move_nor, tmp);
-              }
-              if (k == 1) {
-                disable_boundary_fix = true;
-              }
-              else {
-                disable_boundary_fix = normalize_v3(move_nor) == 0.0f;
-              }
-            }
-            /* Fix boundary verts. */
-            if (!disable_boundary_fix) {
-              /* Constraint normal, nor * constr_nor == 0 after this fix. */
-              float constr_nor[3];
-              const int2 &e0_edge = orig_edges[g->edges[0]->old_edge];
-              const int2 &e1_edge = orig_edges[g->edges[g->edges_len - 1]->old_edge];
-              float e0[3];
-              float e1[3];
-              sub_v3_v3v3(e0,
-                          orig_mvert_co[vm[e0_edge[0]] == i ? e0_edge[1] : e0_edge[0]],
-                          orig_mvert_co[i]);
-              sub_v3_v3v3(e1,
-                          orig_mvert_co[vm[e1_edge[0]] == i ? e1_edge[1] : e1_edge[0]],
-                          orig_mvert_co[i]);
-              if (smd->nonmanifold_boundary_mode == MOD_SOLIDIFY_NONMANIFOLD_BOUNDARY_MODE_FLAT) {
-                cross_v3_v3v3(constr_nor, e0, e1);
-                normalize_v3(constr_nor);
-              }
-              else {
-                BLI_assert(smd->nonmanifold_boundary_mode ==
-                           MOD_SOLIDIFY_NONMANIFOLD_BOUNDARY_MODE_ROUND);
-                float f0[3];
-                float f1[3];
-                if (g->edges[0]->faces[0]->reversed) {
-                  negate_v3_v3(f0, face_nors[g->edges[0]->faces[0]->index]);
+              if (approximate_free_direction) {
+                /* Set move_nor for boundary fix. */
+                NewEdgeRef **edge_ptr = g->edges + 1;
+                float tmp[3];
+                int k;
+                for (k = 1; k + 1 < g->edges_len; k++, edge_ptr++) {
+                  const int2 &edge = orig_edges[(*edge_ptr)->old_edge];
+                  sub_v3_v3v3(
+                      tmp, orig_mvert_co[vm[edge[0]] == i ? edge[1] : edge[0]], orig_mvert_co[i]);
+                  add_v3_v3(move_nor, tmp);
+                }
+                if (k == 1) {
+                  disable_boundary_fix = true;
                 }
                 else {
-                  copy_v3_v3(f0, face_nors[g->edges[0]->faces[0]->index]);
+                  disable_boundary_fix = normalize_v3(move_nor) == 0.0f;
                 }
-                if (g->edges[g->edges_len - 1]->faces[0]->reversed) {
-                  negate_v3_v3(f1, face_nors[g->edges[g->edges_len - 1]->faces[0]->index]);
+              }
+              /* Fix boundary verts. */
+              if (!disable_boundary_fix) {
+                /* Constraint normal, nor * constr_nor == 0 after this fix. */
+                float constr_nor[3];
+                const int2 &e0_edge = orig_edges[g->edges[0]->old_edge];
+                const int2 &e1_edge = orig_edges[g->edges[g->edges_len - 1]->old_edge];
+                float e0[3];
+                float e1[3];
+                sub_v3_v3v3(e0,
+                            orig_mvert_co[vm[e0_edge[0]] == i ? e0_edge[1] : e0_edge[0]],
+                            orig_mvert_co[i]);
+                sub_v3_v3v3(e1,
+                            orig_mvert_co[vm[e1_edge[0]] == i ? e1_edge[1] : e1_edge[0]],
+                            orig_mvert_co[i]);
+                if (smd->nonmanifold_boundary_mode == MOD_SOLIDIFY_NONMANIFOLD_BOUNDARY_MODE_FLAT)
+                {
+                  cross_v3_v3v3(constr_nor, e0, e1);
+                  normalize_v3(constr_nor);
                 }
                 else {
-                  copy_v3_v3(f1, face_nors[g->edges[g->edges_len - 1]->faces[0]->index]);
+                  BLI_assert(smd->nonmanifold_boundary_mode ==
+                             MOD_SOLIDIFY_NONMANIFOLD_BOUNDARY_MODE_ROUND);
+                  float f0[3];
+                  float f1[3];
+                  if (g->edges[0]->faces[0]->reversed) {
+                    negate_v3_v3(f0, face_nors[g->edges[0]->faces[0]->index]);
+                  }
+                  else {
+                    copy_v3_v3(f0, face_nors[g->edges[0]->faces[0]->index]);
+                  }
+                  if (g->edges[g->edges_len - 1]->faces[0]->reversed) {
+                    negate_v3_v3(f1, face_nors[g->edges[g->edges_len - 1]->faces[0]->index]);
+                  }
+                  else {
+                    copy_v3_v3(f1, face_nors[g->edges[g->edges_len - 1]->faces[0]->index]);
+                  }
+                  float n0[3];
+                  float n1[3];
+                  cross_v3_v3v3(n0, e0, f0);
+                  cross_v3_v3v3(n1, f1, e1);
+                  normalize_v3(n0);
+                  normalize_v3(n1);
+                  add_v3_v3v3(constr_nor, n0, n1);
+                  normalize_v3(constr_nor);
+                }
+                float d = dot_v3v3(constr_nor, move_nor);
+                /* Only allow the thickness to increase about 10 times. */
+                if (fabsf(d) > 0.1f) {
+                  mul_v3_fl(move_nor, dot_v3v3(constr_nor, nor) / d);
+                  sub_v3_v3(nor, move_nor);
                 }
-                float n0[3];
-                float n1[3];
-                cross_v3_v3v3(n0, e0, f0);
-                cross_v3_v3v3(n1, f1, e1);
-                normalize_v3(n0);
-                normalize_v3(n1);
-                add_v3_v3v3(constr_nor, n0, n1);
-                normalize_v3(constr_nor);
-              }
-              float d = dot_v3v3(constr_nor, move_nor);
-              /* Only allow the thickness to increase about 10 times. */
-              if (fabsf(d) > 0.1f) {
-                mul_v3_fl(move_nor, dot_v3v3(constr_nor, nor) / d);
-                sub_v3_v3(nor, move_nor);
-              }
-            }
-            float scalar_vgroup = 1;
-            /* Use vertex group. */
-            if (dvert && !do_flat_faces) {
-              const MDeformVert *dv = &dvert[i];
-              if (defgrp_invert) {
-                scalar_vgroup = 1.0f - BKE_defvert_find_weight(dv, defgrp_index);
-              }
-              else {
-                scalar_vgroup = BKE_defvert_find_weight(dv, defgrp_index);
               }
-              scalar_vgroup = offset_fac_vg + (scalar_vgroup * offset_fac_vg_inv);
-            }
-            /* Do clamping. */
-            if (do_clamp) {
-              if (do_angle_clamp) {
-                if (g->edges_len > 2) {
+              float scalar_vgroup = 1;
+              /* Use vertex group. */
+              if (dvert && !do_flat_faces) {
+                const MDeformVert *dv = &dvert[i];
+                if (defgrp_invert) {
+                  scalar_vgroup = 1.0f - BKE_defvert_find_weight(dv, defgrp_index);
+                }
+                else {
+                  scalar_vgroup = BKE_defvert_find_weight(dv, defgrp_index);
+                }
+                scalar_vgroup = offset_fac_vg + (scalar_vgroup * offset_fac_vg_inv);
+              }
+              /* Do clamping. */
+              if (do_clamp) {
+                if (do_angle_clamp) {
+                  if (g->edges_len > 2) {
+                    float min_length = 0;
+                    float angle = 0.5f * M_PI;
+                    uint k = 0;
+                    for (NewEdgeRef **p = g->edges; k < g->edges_len; k++, p++) {
+                      float length = orig_edge_lengths[(*p)->old_edge];
+                      float e_ang = (*p)->angle;
+                      if (e_ang > angle) {
+                        angle = e_ang;
+                      }
+                      if (length < min_length || k == 0) {
+                        min_length = length;
+                      }
+                    }
+                    float cos_ang = cosf(angle * 0.5f);
+                    if (cos_ang > 0) {
+                      float max_off = min_length * 0.5f / cos_ang;
+                      if (max_off < offset * 0.5f) {
+                        scalar_vgroup *= max_off / offset * 2;
+                      }
+                    }
+                  }
+                }
+                else {
                   float min_length = 0;
-                  float angle = 0.5f * M_PI;
                   uint k = 0;
                   for (NewEdgeRef **p = g->edges; k < g->edges_len; k++, p++) {
                     float length = orig_edge_lengths[(*p)->old_edge];
-                    float e_ang = (*p)->angle;
-                    if (e_ang > angle) {
-                      angle = e_ang;
-                    }
                     if (length < min_length || k == 0) {
                       min_length = length;
                     }
                   }
-                  float cos_ang = cosf(angle * 0.5f);
-                  if (cos_ang > 0) {
-                    float max_off = min_length * 0.5f / cos_ang;
-                    if (max_off < offset * 0.5f) {
-                      scalar_vgroup *= max_off / offset * 2;
-                    }
-                  }
-                }
-              }
-              else {
-                float min_length = 0;
-                uint k = 0;
-                for (NewEdgeRef **p = g->edges; k < g->edges_len; k++, p++) {
-                  float length = orig_edge_lengths[(*p)->old_edge];
-                  if (length < min_length || k == 0) {
-                    min_length = length;
+                  if (min_length < offset) {
+                    scalar_vgroup *= min_length / offset;
                   }
                 }
-                if (min_length < offset) {
-                  scalar_vgroup *= min_length / offset;
-                }
               }
+              mul_v3_fl(nor, scalar_vgroup);
+              add_v3_v3v3(g->co, nor, orig_mvert_co[i]);
+            }
+            else {
+              copy_v3_v3(g->co, orig_mvert_co[i]);
             }
-            mul_v3_fl(nor, scalar_vgroup);
-            add_v3_v3v3(g->co, nor, orig_mvert_co[i]);
-          }
-          else {
-            copy_v3_v3(g->co, orig_mvert_co[i]);
           }
         }
       }
-    }
+    });
 
     if (do_flat_faces) {
       MEM_freeN(face_weight);
@@ -2045,21 +2098,19 @@ Mesh *MOD_solidify_nonmanifold_modifyMesh(ModifierData *md,
   }
 
   /* Make_new_verts. */
-  {
-    gs_ptr = orig_vert_groups_arr;
-    for (uint i = 0; i < verts_num; i++, gs_ptr++) {
-      EdgeGroup *gs = *gs_ptr;
+  threading::parallel_for(IndexRange(verts_num), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      EdgeGroup *gs = orig_vert_groups_arr[i];
       if (gs) {
         for (EdgeGroup *g = gs; g->valid; g++) {
           if (g->new_vert != MOD_SOLIDIFY_EMPTY_TAG) {
-            CustomData_copy_data(
-                &mesh->vert_data, &result->vert_data, int(i), int(g->new_vert), 1);
+            CustomData_copy_data(&mesh->vert_data, &result->vert_data, i, int(g->new_vert), 1);
             copy_v3_v3(vert_positions[g->new_vert], g->co);
           }
         }
       }
     }
-  }
+  });
 
   /* Make edges. */
   {
@@ -2397,167 +2448,180 @@ Mesh *MOD_solidify_nonmanifold_modifyMesh(ModifierData *md,
     }
   }
 
-  /* Make boundary faces. */
+  /* Make boundary faces. Every boundary edge gets at most one rim face, with a size that only
+   * depends on the singularities at its verts. The offsets of all rim faces are computed first,
+   * so that they can be filled in parallel. */
   if (do_rim) {
-    for (uint i = 0; i < edges_num; i++) {
-      if (edge_adj_faces_len[i] == 1 && orig_edge_data_arr[i] &&
-          (*orig_edge_data_arr[i])->old_edge == i)
+    auto rim_face_size = [&](const uint i) -> int {
+      if (edge_adj_faces_len[i] != 1 || !orig_edge_data_arr[i] ||
+          (*orig_edge_data_arr[i])->old_edge != i)
       {
-        NewEdgeRef **new_edges = orig_edge_data_arr[i];
-
-        NewEdgeRef *edge1 = new_edges[0];
-        NewEdgeRef *edge2 = new_edges[1];
-        const bool v1_singularity = edge1->link_edge_groups[0]->is_singularity &&
-                                    edge2->link_edge_groups[0]->is_singularity;
-        const bool v2_singularity = edge1->link_edge_groups[1]->is_singularity &&
-                                    edge2->link_edge_groups[1]->is_singularity;
-        if (v1_singularity && v2_singularity) {
-          continue;
+        return 0;
+      }
+      const NewEdgeRef *edge1 = orig_edge_data_arr[i][0];
+      const NewEdgeRef *edge2 = orig_edge_data_arr[i][1];
+      const bool v1_singularity = edge1->link_edge_groups[0]->is_singularity &&
+                                  edge2->link_edge_groups[0]->is_singularity;
+      const bool v2_singularity = edge1->link_edge_groups[1]->is_singularity &&
+                                  edge2->link_edge_groups[1]->is_singularity;
+      if (v1_singularity && v2_singularity) {
+        return 0;
+      }
+      return 2 + int(!v1_singularity) + int(!v2_singularity);
+    };
+
+    IndexMaskMemory memory;
+    const IndexMask rim_edges = IndexMask::from_predicate(
+        IndexRange(edges_num), GrainSize(4096), memory, [&](const int64_t i) {
+          return rim_face_size(uint(i)) != 0;
+        });
+    Array<int> rim_corner_offsets_data(rim_edges.size() + 1);
+    rim_edges.foreach_index(GrainSize(4096), [&](const int64_t i, const int64_t pos) {
+      rim_corner_offsets_data[pos] = rim_face_size(uint(i));
+    });
+    const OffsetIndices rim_corner_offsets = offset_indices::accumulate_counts_to_offsets(
+        rim_corner_offsets_data, int(loop_index));
+
+    rim_edges.foreach_index(GrainSize(1024), [&](const int64_t i, const int64_t pos) {
+      const uint rim_face = face_index + uint(pos);
+      uint rim_loop = uint(rim_corner_offsets[pos].start());
+      NewEdgeRef **new_edges = orig_edge_data_arr[i];
+
+      NewEdgeRef *edge1 = new_edges[0];
+      NewEdgeRef *edge2 = new_edges[1];
+      const bool v1_singularity = edge1->link_edge_groups[0]->is_singularity &&
+                                  edge2->link_edge_groups[0]->is_singularity;
+      const bool v2_singularity = edge1->link_edge_groups[1]->is_singularity &&
+                                  edge2->link_edge_groups[1]->is_singularity;
+
+      const uint orig_face_index = (*new_edges)->faces[0]->index;
+      const blender::IndexRange face = (*new_edges)->faces[0]->face;
+      CustomData_copy_data(&mesh->face_data,
+                           &result->face_data,
+                           int((*new_edges)->faces[0]->index),
+                           int(rim_face),
+                           1);
+      face_offsets[rim_face] = int(rim_loop);
+      dst_material_index.span[rim_face] = (!src_material_index.is_empty() ?
+                                               src_material_index[orig_face_index] :
+                                               0) +
+                                          mat_ofs_rim;
+      CLAMP(dst_material_index.span[rim_face], 0, mat_nr_max);
+
+      int loop1 = -1;
+      int loop2 = -1;
+      const uint old_v1 = vm[orig_edges[edge1->old_edge][0]];
+      const uint old_v2 = vm[orig_edges[edge1->old_edge][1]];
+      for (uint j = 0; j < face.size(); j++) {
+        const int vert = orig_corner_verts[face.start() + j];
+        if (vm[vert] == old_v1) {
+          loop1 = face.start() + int(j);
         }
-
-        const uint orig_face_index = (*new_edges)->faces[0]->index;
-        const blender::IndexRange face = (*new_edges)->faces[0]->face;
-        CustomData_copy_data(&mesh->face_data,
-                             &result->face_data,
-                             int((*new_edges)->faces[0]->index),
-                             int(face_index),
-                             1);
-        face_offsets[face_index] = int(loop_index);
-        dst_material_index.span[face_index] = (!src_material_index.is_empty() ?
-                                                   src_material_index[orig_face_index] :
-                                                   0) +
-                                              mat_ofs_rim;
-        CLAMP(dst_material_index.span[face_index], 0, mat_nr_max);
-        face_index++;
-
-        int loop1 = -1;
-        int loop2 = -1;
-        const uint old_v1 = vm[orig_edges[edge1->old_edge][0]];
-        const uint old_v2 = vm[orig_edges[edge1->old_edge][1]];
-        for (uint j = 0; j < face.size(); j++) {
-          const int vert = orig_corner_verts[face.start() + j];
-          if (vm[vert] == old_v1) {
-            loop1 = face.start() + int(j);
-          }
-          else if (vm[vert] == old_v2) {
-            loop2 = face.start() + int(j);
-          }
+        else if (vm[vert] == old_v2) {
+          loop2 = face.start() + int(j);
         }
-        BLI_assert(loop1 != -1 && loop2 != -1);
-        int2 open_face_edge;
-        uint open_face_edge_index;
-        if (!do_flip) {
-          if (rim_defgrp_index != -1) {
-            BKE_defvert_ensure_index(&dst_dvert[edges[edge1->new_edge][0]], rim_defgrp_index)
-                ->weight = 1.0f;
+      }
+      BLI_assert(loop1 != -1 && loop2 != -1);
+      int2 open_face_edge;
+      uint open_face_edge_index;
+      if (!do_flip) {
+        CustomData_copy_data(&mesh->corner_data, &result->corner_data, loop1, int(rim_loop), 1);
+        corner_verts[rim_loop] = edges[edge1->new_edge][0];
+        corner_edges[rim_loop++] = edge1->new_edge;
+
+        if (!v2_singularity) {
+          open_face_edge_index = edge1->link_edge_groups[1]->open_face_edge;
+          CustomData_copy_data(&mesh->corner_data, &result->corner_data, loop2, int(rim_loop), 1);
+          corner_verts[rim_loop] = edges[edge1->new_edge][1];
+          open_face_edge = edges[open_face_edge_index];
+          if (ELEM(edges[edge2->new_edge][1], open_face_edge[0], open_face_edge[1])) {
+            corner_edges[rim_loop++] = open_face_edge_index;
           }
-          CustomData_copy_data(
-              &mesh->corner_data, &result->corner_data, loop1, int(loop_index), 1);
-          corner_verts[loop_index] = edges[edge1->new_edge][0];
-          corner_edges[loop_index++] = edge1->new_edge;
-
-          if (!v2_singularity) {
-            open_face_edge_index = edge1->link_edge_groups[1]->open_face_edge;
-            if (rim_defgrp_index != -1) {
-              BKE_defvert_ensure_index(&dst_dvert[edges[edge1->new_edge][1]], rim_defgrp_index)
-                  ->weight = 1.0f;
-            }
-            CustomData_copy_data(
-                &mesh->corner_data, &result->corner_data, loop2, int(loop_index), 1);
-            corner_verts[loop_index] = edges[edge1->new_edge][1];
-            open_face_edge = edges[open_face_edge_index];
-            if (ELEM(edges[edge2->new_edge][1], open_face_edge[0], open_face_edge[1])) {
-              corner_edges[loop_index++] = open_face_edge_index;
-            }
-            else {
-              corner_edges[loop_index++] = edge2->link_edge_groups[1]->open_face_edge;
-            }
+          else {
+            corner_edges[rim_loop++] = edge2->link_edge_groups[1]->open_face_edge;
           }
+        }
 
-          if (rim_defgrp_index != -1) {
-            BKE_defvert_ensure_index(&dst_dvert[edges[edge2->new_edge][1]], rim_defgrp_index)
-                ->weight = 1.0f;
+        CustomData_copy_data(&mesh->corner_data, &result->corner_data, loop2, int(rim_loop), 1);
+        corner_verts[rim_loop] = edges[edge2->new_edge][1];
+        corner_edges[rim_loop++] = edge2->new_edge;
+
+        if (!v1_singularity) {
+          open_face_edge_index = edge2->link_edge_groups[0]->open_face_edge;
+          CustomData_copy_data(&mesh->corner_data, &result->corner_data, loop1, int(rim_loop), 1);
+          corner_verts[rim_loop] = edges[edge2->new_edge][0];
+          open_face_edge = edges[open_face_edge_index];
+          if (ELEM(edges[edge1->new_edge][0], open_face_edge[0], open_face_edge[1])) {
+            corner_edges[rim_loop++] = open_face_edge_index;
           }
-          CustomData_copy_data(
-              &mesh->corner_data, &result->corner_data, loop2, int(loop_index), 1);
-          corner_verts[loop_index] = edges[edge2->new_edge][1];
-          corner_edges[loop_index++] = edge2->new_edge;
-
-          if (!v1_singularity) {
-            open_face_edge_index = edge2->link_edge_groups[0]->open_face_edge;
-            if (rim_defgrp_index != -1) {
-              BKE_defvert_ensure_index(&dst_dvert[edges[edge2->new_edge][0]], rim_defgrp_index)
-                  ->weight = 1.0f;
-            }
-            CustomData_copy_data(
-                &mesh->corner_data, &result->corner_data, loop1, int(loop_index), 1);
-            corner_verts[loop_index] = edges[edge2->new_edge][0];
-            open_face_edge = edges[open_face_edge_index];
-            if (ELEM(edges[edge1->new_edge][0], open_face_edge[0], open_face_edge[1])) {
-              corner_edges[loop_index++] = open_face_edge_index;
-            }
-            else {
-              corner_edges[loop_index++] = edge1->link_edge_groups[0]->open_face_edge;
-            }
+          else {
+            corner_edges[rim_loop++] = edge1->link_edge_groups[0]->open_face_edge;
           }
         }
-        else {
-          if (!v1_singularity) {
-            open_face_edge_index = edge1->link_edge_groups[0]->open_face_edge;
-            if (rim_defgrp_index != -1) {
-              BKE_defvert_ensure_index(&dst_dvert[edges[edge1->new_edge][0]], rim_defgrp_index)
-                  ->weight = 1.0f;
-            }
-            CustomData_copy_data(
-                &mesh->corner_data, &result->corner_data, loop1, int(loop_index), 1);
-            corner_verts[loop_index] = edges[edge1->new_edge][0];
-            open_face_edge = edges[open_face_edge_index];
-            if (ELEM(edges[edge2->new_edge][0], open_face_edge[0], open_face_edge[1])) {
-              corner_edges[loop_index++] = open_face_edge_index;
-            }
-            else {
-              corner_edges[loop_index++] = edge2->link_edge_groups[0]->open_face_edge;
-            }
-          }
-
-          if (rim_defgrp_index != -1) {
-            BKE_defvert_ensure_index(&dst_dvert[edges[edge2->new_edge][0]], rim_defgrp_index)
-                ->weight = 1.0f;
+      }
+      else {
+        if (!v1_singularity) {
+          open_face_edge_index = edge1->link_edge_groups[0]->open_face_edge;
+          CustomData_copy_data(&mesh->corner_data, &result->corner_data, loop1, int(rim_loop), 1);
+          corner_verts[rim_loop] = edges[edge1->new_edge][0];
+          open_face_edge = edges[open_face_edge_index];
+          if (ELEM(edges[edge2->new_edge][0], open_face_edge[0], open_face_edge[1])) {
+            corner_edges[rim_loop++] = open_face_edge_index;
           }
-          CustomData_copy_data(
-              &mesh->corner_data, &result->corner_data, loop1, int(loop_index), 1);
-          corner_verts[loop_index] = edges[edge2->new_edge][0];
-          corner_edges[loop_index++] = edge2->new_edge;
-
-          if (!v2_singularity) {
-            open_face_edge_index = edge2->link_edge_groups[1]->open_face_edge;
-            if (rim_defgrp_index != -1) {
-              BKE_defvert_ensure_index(&dst_dvert[edges[edge2->new_edge][1]], rim_defgrp_index)
-                  ->weight = 1.0f;
-            }
-            CustomData_copy_data(
-                &mesh->corner_data, &result->corner_data, loop2, int(loop_index), 1);
-            corner_verts[loop_index] = edges[edge2->new_edge][1];
-            open_face_edge = edges[open_face_edge_index];
-            if (ELEM(edges[edge1->new_edge][1], open_face_edge[0], open_face_edge[1])) {
-              corner_edges[loop_index++] = open_face_edge_index;
-            }
-            else {
-              corner_edges[loop_index++] = edge1->link_edge_groups[1]->open_face_edge;
-            }
+          else {
+            corner_edges[rim_loop++] = edge2->link_edge_groups[0]->open_face_edge;
           }
+        }
 
-          if (rim_defgrp_index != -1) {
-            BKE_defvert_ensure_index(&dst_dvert[edges[edge1->new_edge][1]], rim_defgrp_index)
-                ->weight = 1.0f;
+        CustomData_copy_data(&mesh->corner_data, &result->corner_data, loop1, int(rim_loop), 1);
+        corner_verts[rim_loop] = edges[edge2->new_edge][0];
+        corner_edges[rim_loop++] = edge2->new_edge;
+
+        if (!v2_singularity) {
+          open_face_edge_index = edge2->link_edge_groups[1]->open_face_edge;
+          CustomData_copy_data(&mesh->corner_data, &result->corner_data, loop2, int(rim_loop), 1);
+          corner_verts[rim_loop] = edges[edge2->new_edge][1];
+          open_face_edge = edges[open_face_edge_index];
+          if (ELEM(edges[edge1->new_edge][1], open_face_edge[0], open_face_edge[1])) {
+            corner_edges[rim_loop++] = open_face_edge_index;
+          }
+          else {
+            corner_edges[rim_loop++] = edge1->link_edge_groups[1]->open_face_edge;
           }
-          CustomData_copy_data(
-              &mesh->corner_data, &result->corner_data, loop2, int(loop_index), 1);
-          corner_verts[loop_index] = edges[edge1->new_edge][1];
-          corner_edges[loop_index++] = edge1->new_edge;
         }
+
+        CustomData_copy_data(&mesh->corner_data, &result->corner_data, loop2, int(rim_loop), 1);
+        corner_verts[rim_loop] = edges[edge1->new_edge][1];
+        corner_edges[rim_loop++] = edge1->new_edge;
       }
+      BLI_assert(rim_loop == uint(rim_corner_offsets[pos].one_after_last()));
+    });
+
+    /* Verts are shared by adjacent rim faces, so their weights are set afterwards. */
+    if (rim_defgrp_index != -1) {
+      rim_edges.foreach_index([&](const int64_t i) {
+        const NewEdgeRef *edge1 = orig_edge_data_arr[i][0];
+        const NewEdgeRef *edge2 = orig_edge_data_arr[i][1];
+        const bool v1_singularity = edge1->link_edge_groups[0]->is_singularity &&
+                                    edge2->link_edge_groups[0]->is_singularity;
+        const bool v2_singularity = edge1->link_edge_groups[1]->is_singularity &&
+                                    edge2->link_edge_groups[1]->is_singularity;
+        auto set_rim_weight = [&](const int vert) {
+          BKE_defvert_ensure_index(&dst_dvert[vert], rim_defgrp_index)->weight = 1.0f;
+        };
+        set_rim_weight(edges[edge1->new_edge][0]);
+        set_rim_weight(edges[edge2->new_edge][1]);
+        if (!v2_singularity) {
+          set_rim_weight(edges[edge1->new_edge][1]);
+        }
+        if (!v1_singularity) {
+          set_rim_weight(edges[edge2->new_edge][0]);
+        }
+      });
     }
+
+    face_index += uint(rim_edges.size());
+    loop_index += uint(rim_corner_offsets.total_size());
   }
 
   /* Make faces. */
@@ -6,9 +6,14 @@
  * \ingroup modifiers
  */
 
+#include "BLI_array.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
+#include "BLI_offset_indices.hh"
+#include "BLI_simd.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -162,9 +167,30 @@ struct SDefBindWeightData {
   uint binds_num;
 };
 
+/**
+ * The bind data of #SDefVert flattened into a few arrays, so that evaluation does not have to
+ * chase per-bind pointers or branch on the bind mode. The weights of every mode are converted
+ * to weights of the face corners and multiplied by the influence of the bind, which turns every
+ * bind into a weighted sum of the corners plus an offset along the face normal.
+ */
+struct SDefEvalData {
+  /** Deformed vertex of every bound vertex. */
+  blender::Array<int> vert_indices;
+  /** Binds of every bound vertex. */
+  blender::Array<int> bind_offsets;
+  /** Target face corners of every bind. */
+  blender::Array<int> corner_offsets;
+  /** Distance along the face normal of every bind, multiplied by its influence. */
+  blender::Array<float> normal_dists;
+  /** Target vertex of every corner. */
+  blender::Array<int> corner_verts;
+  /** Weight of every corner, multiplied by the influence of the bind. */
+  blender::Array<float> corner_weights;
+};
+
 struct SDefDeformData {
-  const SDefVert *bind_verts;
-  float (*targetCos)[3];
+  const SDefEvalData *eval_data;
+  blender::Span<blender::float3> target_positions;
   float (*vertexCos)[3];
   const MDeformVert *dvert;
   int defgrp_index;
@@ -208,10 +234,18 @@ static void required_data_mask(ModifierData *md, CustomData_MeshMasks *r_cddata_
   }
 }
 
+static void free_eval_data(SurfaceDeformModifierData *smd)
+{
+  MEM_delete(static_cast<SDefEvalData *>(smd->eval_data));
+  smd->eval_data = nullptr;
+}
+
 static void free_data(ModifierData *md)
 {
   SurfaceDeformModifierData *smd = (SurfaceDeformModifierData *)md;
 
+  free_eval_data(smd);
+
   if (smd->verts) {
     for (int i = 0; i < smd->bind_verts_num; i++) {
       if (smd->verts[i].binds) {
@@ -233,6 +267,7 @@ static void copy_data(const ModifierData *md, ModifierData *target, const int fl
   SurfaceDeformModifierData *tsmd = (SurfaceDeformModifierData *)target;
 
   BKE_modifier_copydata_generic(md, target, flag);
+  tsmd->eval_data = nullptr;
 
   if (smd->verts) {
     tsmd->verts = static_cast<SDefVert *>(MEM_dupallocN(smd->verts));
@@ -1328,93 +1363,152 @@ static bool surfacedeformBind(Object *ob,
   return data.success == 1;
 }
 
-static void deformVert(void *__restrict userdata,
-                       const int index,
-                       const TaskParallelTLS *__restrict /*tls*/)
+static SDefEvalData *eval_data_create(const SDefVert *bind_verts, const int bind_verts_num)
 {
-  const SDefDeformData *const data = (SDefDeformData *)userdata;
-  const SDefBind *sdbind = data->bind_verts[index].binds;
-  const int sdbind_num = data->bind_verts[index].binds_num;
-  const uint vertex_idx = data->bind_verts[index].vertex_idx;
-  float *const vertexCos = data->vertexCos[vertex_idx];
-  float norm[3], temp[3], offset[3];
+  using namespace blender;
+  SDefEvalData *eval_data = MEM_new<SDefEvalData>(__func__);
+
+  eval_data->vert_indices.reinitialize(bind_verts_num);
+  eval_data->bind_offsets.reinitialize(bind_verts_num + 1);
+  for (const int i : IndexRange(bind_verts_num)) {
+    eval_data->vert_indices[i] = int(bind_verts[i].vertex_idx);
+    eval_data->bind_offsets[i] = int(bind_verts[i].binds_num);
+  }
+  const OffsetIndices bind_offsets = offset_indices::accumulate_counts_to_offsets(
+      eval_data->bind_offsets);
+
+  eval_data->normal_dists.reinitialize(bind_offsets.total_size());
+  eval_data->corner_offsets.reinitialize(bind_offsets.total_size() + 1);
+  threading::parallel_for(IndexRange(bind_verts_num), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const SDefBind *sdbind = bind_verts[i].binds;
+      for (const int bind : bind_offsets[i]) {
+        eval_data->normal_dists[bind] = sdbind->normal_dist * sdbind->influence;
+        eval_data->corner_offsets[bind] = int(sdbind->verts_num);
+        sdbind++;
+      }
+    }
+  });
+  const OffsetIndices corner_offsets = offset_indices::accumulate_counts_to_offsets(
+      eval_data->corner_offsets);
+
+  eval_data->corner_verts.reinitialize(corner_offsets.total_size());
+  eval_data->corner_weights.reinitialize(corner_offsets.total_size());
+  threading::parallel_for(IndexRange(bind_verts_num), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const SDefBind *sdbind = bind_verts[i].binds;
+      for (const int bind : bind_offsets[i]) {
+        const IndexRange corners = corner_offsets[bind];
+        MutableSpan<int> verts = eval_data->corner_verts.as_mutable_span().slice(corners);
+        MutableSpan<float> weights = eval_data->corner_weights.as_mutable_span().slice(corners);
+        for (const int k : corners.index_range()) {
+          verts[k] = int(sdbind->vert_inds[k]);
+        }
+        weights.fill(0.0f);
+        switch (sdbind->mode) {
+          case MOD_SDEF_MODE_CORNER_TRIS: {
+            weights.take_front(3).copy_from({sdbind->vert_weights, 3});
+            break;
+          }
+          case MOD_SDEF_MODE_NGONS: {
+            weights.copy_from({sdbind->vert_weights, corners.size()});
+            break;
+          }
+          case MOD_SDEF_MODE_CENTROID: {
+            /* The centroid is the mean of all corners, so its weight is spread over them. */
+            weights.fill(sdbind->vert_weights[2] / float(corners.size()));
+            weights[0] += sdbind->vert_weights[0];
+            weights[1] += sdbind->vert_weights[1];
+            break;
+          }
+        }
+        for (float &weight : weights) {
+          weight *= sdbind->influence;
+        }
+        sdbind++;
+      }
+    }
+  });
 
-  /* Retrieve the value of the weight vertex group if specified. */
-  float weight = 1.0f;
+  return eval_data;
+}
 
-  if (data->dvert && data->defgrp_index != -1) {
-    weight = BKE_defvert_find_weight(&data->dvert[vertex_idx], data->defgrp_index);
+static void deform_verts_range(const SDefDeformData &data, const blender::IndexRange range)
+{
+  using namespace blender;
+  const SDefEvalData &eval_data = *data.eval_data;
+  const OffsetIndices<int> bind_offsets = eval_data.bind_offsets.as_span();
+  const OffsetIndices<int> corner_offsets = eval_data.corner_offsets.as_span();
 
-    if (data->invert_vgroup) {
-      weight = 1.0f - weight;
-    }
-  }
+  /* Positions of the corners of a single face, with one element extra to make it possible to
+   * load the values to SSE registers, which are float4. */
+  Vector<float3, 32> coords_buffer;
 
-  /* Check if this vertex will be deformed. If it is not deformed we return and avoid
-   * unnecessary calculations. */
-  if (weight == 0.0f) {
-    return;
-  }
+  for (const int i : range) {
+    const int vertex_idx = eval_data.vert_indices[i];
+    float *const vertexCos = data.vertexCos[vertex_idx];
 
-  zero_v3(offset);
+    /* Retrieve the value of the weight vertex group if specified. */
+    float weight = 1.0f;
 
-  int max_verts = 0;
-  for (int j = 0; j < sdbind_num; j++) {
-    max_verts = std::max(max_verts, int(sdbind[j].verts_num));
-  }
+    if (data.dvert && data.defgrp_index != -1) {
+      weight = BKE_defvert_find_weight(&data.dvert[vertex_idx], data.defgrp_index);
 
-  /* Allocate a `coords_buffer` that fits all the temp-data. */
-  blender::Array<blender::float3, 256> coords_buffer(max_verts);
+      if (data.invert_vgroup) {
+        weight = 1.0f - weight;
+      }
+    }
 
-  for (int j = 0; j < sdbind_num; j++, sdbind++) {
-    for (int k = 0; k < sdbind->verts_num; k++) {
-      copy_v3_v3(coords_buffer[k], data->targetCos[sdbind->vert_inds[k]]);
+    /* Check if this vertex will be deformed. If it is not deformed we continue and avoid
+     * unnecessary calculations. */
+    if (weight == 0.0f) {
+      continue;
     }
 
-    normal_poly_v3(
-        norm, reinterpret_cast<const float(*)[3]>(coords_buffer.data()), sdbind->verts_num);
-    zero_v3(temp);
-
-    switch (sdbind->mode) {
-      /* ---------- corner_tri mode ---------- */
-      case MOD_SDEF_MODE_CORNER_TRIS: {
-        madd_v3_v3fl(temp, data->targetCos[sdbind->vert_inds[0]], sdbind->vert_weights[0]);
-        madd_v3_v3fl(temp, data->targetCos[sdbind->vert_inds[1]], sdbind->vert_weights[1]);
-        madd_v3_v3fl(temp, data->targetCos[sdbind->vert_inds[2]], sdbind->vert_weights[2]);
-        break;
-      }
+    float offset[3];
+    zero_v3(offset);
 
-      /* ---------- ngon mode ---------- */
-      case MOD_SDEF_MODE_NGONS: {
-        for (int k = 0; k < sdbind->verts_num; k++) {
-          madd_v3_v3fl(temp, coords_buffer[k], sdbind->vert_weights[k]);
-        }
-        break;
-      }
+    for (const int bind : bind_offsets[i]) {
+      const IndexRange corners = corner_offsets[bind];
+      const Span<int> corner_verts = eval_data.corner_verts.as_span().slice(corners);
+      const Span<float> corner_weights = eval_data.corner_weights.as_span().slice(corners);
 
-      /* ---------- centroid mode ---------- */
-      case MOD_SDEF_MODE_CENTROID: {
-        float cent[3];
-        mid_v3_v3_array(
-            cent, reinterpret_cast<const float(*)[3]>(coords_buffer.data()), sdbind->verts_num);
+      coords_buffer.resize(corners.size() + 1);
+      for (const int k : corners.index_range()) {
+        coords_buffer[k] = data.target_positions[corner_verts[k]];
+      }
 
-        madd_v3_v3fl(temp, data->targetCos[sdbind->vert_inds[0]], sdbind->vert_weights[0]);
-        madd_v3_v3fl(temp, data->targetCos[sdbind->vert_inds[1]], sdbind->vert_weights[1]);
-        madd_v3_v3fl(temp, cent, sdbind->vert_weights[2]);
-        break;
+      float norm[3];
+      normal_poly_v3(
+          norm, reinterpret_cast<const float(*)[3]>(coords_buffer.data()), corners.size());
+
+#if BLI_HAVE_SSE2
+      __m128 temp_r = _mm_setzero_ps();
+      for (const int k : corners.index_range()) {
+        /* This will load one extra element, this is ok because
+         * we ignore that part of register anyway.
+         */
+        const __m128 co_r = _mm_loadu_ps(coords_buffer[k]);
+        temp_r = _mm_add_ps(temp_r, _mm_mul_ps(co_r, _mm_set1_ps(corner_weights[k])));
       }
-    }
+      float temp[4];
+      _mm_storeu_ps(temp, temp_r);
+      add_v3_v3(offset, temp);
+#else
+      for (const int k : corners.index_range()) {
+        madd_v3_v3fl(offset, coords_buffer[k], corner_weights[k]);
+      }
+#endif
 
-    /* Apply normal offset (generic for all modes) */
-    madd_v3_v3fl(temp, norm, sdbind->normal_dist);
+      /* Apply normal offset (generic for all modes) */
+      madd_v3_v3fl(offset, norm, eval_data.normal_dists[bind]);
+    }
+    /* Subtract the vertex coord to get the deformation offset. */
+    sub_v3_v3(offset, vertexCos);
 
-    madd_v3_v3fl(offset, temp, sdbind->influence);
+    /* Add the offset to start coord multiplied by the strength and weight values. */
+    madd_v3_v3fl(vertexCos, offset, data.strength * weight);
   }
-  /* Subtract the vertex coord to get the deformation offset. */
-  sub_v3_v3(offset, vertexCos);
-
-  /* Add the offset to start coord multiplied by the strength and weight values. */
-  madd_v3_v3fl(vertexCos, offset, data->strength * weight);
 }
 
 static void surfacedeformModifier_do(ModifierData *md,
@@ -1537,28 +1631,33 @@ static void surfacedeformModifier_do(ModifierData *md,
   MOD_get_vgroup(ob, mesh, smd->defgrp_name, &dvert, &defgrp_index);
   const bool invert_vgroup = (smd->flags & MOD_SDEF_INVERT_VGROUP) != 0;
 
+  /* Flatten the bind data once, it is freed together with the bind data of this evaluated copy of
+   * the modifier. */
+  if (smd->eval_data == nullptr) {
+    smd->eval_data = eval_data_create(smd->verts, smd->bind_verts_num);
+  }
+
+  blender::Array<blender::float3> target_positions(target_verts_num);
+  BKE_mesh_wrapper_vert_coords_copy_with_mat4(
+      target,
+      reinterpret_cast<float(*)[3]>(target_positions.data()),
+      target_verts_num,
+      smd->mat);
+
   /* Actual vertex location update starts here */
   SDefDeformData data{};
-  data.bind_verts = smd->verts;
-  data.targetCos = static_cast<float(*)[3]>(
-      MEM_malloc_arrayN(target_verts_num, sizeof(float[3]), "SDefTargetVertArray"));
+  data.eval_data = static_cast<const SDefEvalData *>(smd->eval_data);
+  data.target_positions = target_positions;
   data.vertexCos = vertexCos;
   data.dvert = dvert;
   data.defgrp_index = defgrp_index;
   data.invert_vgroup = invert_vgroup;
   data.strength = smd->strength;
 
-  if (data.targetCos != nullptr) {
-    BKE_mesh_wrapper_vert_coords_copy_with_mat4(
-        target, data.targetCos, target_verts_num, smd->mat);
-
-    TaskParallelSettings settings;
-    BLI_parallel_range_settings_defaults(&settings);
-    settings.use_threading = (smd->bind_verts_num > 10000);
-    BLI_task_parallel_range(0, smd->bind_verts_num, &data, deformVert, &settings);
-
-    MEM_freeN(data.targetCos);
-  }
+  blender::threading::parallel_for(
+      blender::IndexRange(smd->bind_verts_num), 1024, [&](const blender::IndexRange range) {
+        deform_verts_range(data, range);
+      });
 }
 
 static void deform_verts(ModifierData *md,
@@ -1681,6 +1780,8 @@ static void blend_read(BlendDataReader *reader, ModifierData *md)
 {
   SurfaceDeformModifierData *smd = (SurfaceDeformModifierData *)md;
 
+  smd->eval_data = nullptr;
+
   BLO_read_struct_array(reader, SDefVert, smd->bind_verts_num, &smd->verts);
 
   if (smd->verts) {
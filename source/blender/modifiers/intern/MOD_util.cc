@@ -21,10 +21,12 @@
 
 #include "BKE_action.h" /* BKE_pose_channel_find_name */
 #include "BKE_attribute.hh"
+#include "BKE_customdata.hh"
 #include "BKE_deform.hh"
 #include "BKE_editmesh.hh"
 #include "BKE_image.h"
 #include "BKE_lattice.hh"
+#include "BKE_mesh_types.hh"
 
 #include "BKE_modifier.hh"
 
@@ -186,6 +188,99 @@ void MOD_get_vgroup(const Object *ob,
   }
 }
 
+namespace blender {
+
+/** Gather the arrays identified by #MeshTopologyKey, false if any of them can't be identified. */
+static bool mesh_topology_arrays_gather(const Mesh &mesh,
+                                        std::array<const void *, 4> &r_data,
+                                        std::array<const ImplicitSharingInfo *, 4> &r_infos)
+{
+  const auto add_layer =
+      [&](const int i, const CustomData &data, const eCustomDataType type, const char *name) {
+        const int layer_index = CustomData_get_named_layer_index(&data, type, name);
+        if (layer_index == -1) {
+          r_data[i] = nullptr;
+          r_infos[i] = nullptr;
+          return true;
+        }
+        const CustomDataLayer &layer = data.layers[layer_index];
+        r_data[i] = layer.data;
+        r_infos[i] = layer.sharing_info;
+        return layer.data == nullptr || layer.sharing_info != nullptr;
+      };
+  r_data[0] = mesh.face_offset_indices;
+  r_infos[0] = mesh.runtime->face_offsets_sharing_info;
+  if (r_data[0] != nullptr && r_infos[0] == nullptr) {
+    return false;
+  }
+  return add_layer(1, mesh.edge_data, CD_PROP_INT32_2D, ".edge_verts") &&
+         add_layer(2, mesh.corner_data, CD_PROP_INT32, ".corner_vert") &&
+         add_layer(3, mesh.corner_data, CD_PROP_INT32, ".corner_edge");
+}
+
+MeshTopologyKey::~MeshTopologyKey()
+{
+  this->clear();
+}
+
+void MeshTopologyKey::clear()
+{
+  for (const ImplicitSharingInfo *&sharing_info : sharing_infos_) {
+    if (sharing_info) {
+      sharing_info->remove_weak_user_and_delete_if_last();
+      sharing_info = nullptr;
+    }
+  }
+  verts_num_ = -1;
+}
+
+void MeshTopologyKey::update(const Mesh &mesh)
+{
+  this->clear();
+  if (!mesh_topology_arrays_gather(mesh, data_, sharing_infos_)) {
+    sharing_infos_.fill(nullptr);
+    return;
+  }
+  for (const int i : IndexRange(arrays_num)) {
+    if (sharing_infos_[i]) {
+      sharing_infos_[i]->add_weak_user();
+      versions_[i] = sharing_infos_[i]->version();
+    }
+  }
+  verts_num_ = mesh.verts_num;
+  edges_num_ = mesh.edges_num;
+  faces_num_ = mesh.faces_num;
+  corners_num_ = mesh.corners_num;
+}
+
+bool MeshTopologyKey::matches(const Mesh &mesh) const
+{
+  if (verts_num_ != mesh.verts_num || edges_num_ != mesh.edges_num ||
+      faces_num_ != mesh.faces_num || corners_num_ != mesh.corners_num)
+  {
+    return false;
+  }
+  std::array<const void *, arrays_num> data;
+  std::array<const ImplicitSharingInfo *, arrays_num> sharing_infos;
+  if (!mesh_topology_arrays_gather(mesh, data, sharing_infos)) {
+    return false;
+  }
+  for (const int i : IndexRange(arrays_num)) {
+    if (data[i] != data_[i] || sharing_infos[i] != sharing_infos_[i]) {
+      return false;
+    }
+    /* The weak user keeps the sharing info alive, so it can't be reused for other data. */
+    if (sharing_infos[i] &&
+        (sharing_infos[i]->is_expired() || sharing_infos[i]->version() != versions_[i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace blender
+
 void MOD_depsgraph_update_object_bone_relation(DepsNodeHandle *node,
                                                Object *object,
                                                const char *bonename,
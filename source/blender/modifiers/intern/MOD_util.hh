@@ -11,6 +11,10 @@
 /* so modifier types match their defines */
 #include "MOD_modifiertypes.hh"
 
+#include <array>
+
+#include "BLI_implicit_sharing.hh"
+
 #include "DEG_depsgraph_build.hh"
 
 struct MDeformVert;
@@ -38,6 +42,43 @@ void MOD_get_vgroup(const Object *ob,
                     const MDeformVert **dvert,
                     int *defgrp_index);
 
+namespace blender {
+
+/**
+ * Identifies the topology arrays of a mesh (edges, face offsets, corner vertices and edges)
+ * through implicit sharing, to detect when data cached by a modifier across evaluations no longer
+ * matches the topology without reading the arrays. Positions are not included.
+ *
+ * Only weak users of the arrays are kept, so they aren't kept alive or copied when the mesh is
+ * edited. Editing them changes their sharing version instead. Arrays without sharing info never
+ * match, which only means the cached data is rebuilt.
+ */
+class MeshTopologyKey : NonCopyable, NonMovable {
+  static constexpr int arrays_num = 4;
+
+  int verts_num_ = -1;
+  int edges_num_ = -1;
+  int faces_num_ = -1;
+  int corners_num_ = -1;
+  std::array<const void *, arrays_num> data_ = {};
+  std::array<const ImplicitSharingInfo *, arrays_num> sharing_infos_ = {};
+  std::array<int64_t, arrays_num> versions_ = {};
+
+ public:
+  MeshTopologyKey() = default;
+  ~MeshTopologyKey();
+
+  /** Identify the topology of \a mesh, replacing the previous one. */
+  void update(const Mesh &mesh);
+  /** \return True when the topology of \a mesh didn't change since the last #update. */
+  bool matches(const Mesh &mesh) const;
+
+ private:
+  void clear();
+};
+
+}  // namespace blender
+
 void MOD_depsgraph_update_object_bone_relation(DepsNodeHandle *node,
                                                Object *object,
                                                const char *bonename,
@@ -313,7 +313,7 @@ ModifierTypeInfo modifierType_VolumeDisplace = {
     /*struct_size*/ sizeof(VolumeDisplaceModifierData),
     /*srna*/ &RNA_VolumeDisplaceModifier,
     /*type*/ ModifierTypeType::NonGeometrical,
-    /*flags*/ static_cast<ModifierTypeFlag>(0),
+    /*flags*/ eModifierTypeFlag_AcceptsGeometrySet,
     /*icon*/ ICON_VOLUME_DATA, /* TODO: Use correct icon. */
 
     /*copy_data*/ BKE_modifier_copydata_generic,
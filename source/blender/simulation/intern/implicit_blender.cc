@@ -19,7 +19,10 @@
 
 #  include "BLI_math_geom.h"
 #  include "BLI_math_matrix.h"
+#  include "BLI_array.hh"
 #  include "BLI_math_vector.h"
+#  include "BLI_offset_indices.hh"
+#  include "BLI_task.hh"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.hh"
@@ -170,18 +173,32 @@ DO_INLINE void submul_lfvectorS(float (*to)[3], float (*fLongVector)[3], float s
     VECSUBMUL(to[i], fLongVector[i], scalar);
   }
 }
+/* Vertex count per task for parallel long vector operations. */
+#  define CLOTH_PARALLEL_GRAIN_SIZE 2048
+
 /* dot product for big vector */
 DO_INLINE float dot_lfvector(float (*fLongVectorA)[3], float (*fLongVectorB)[3], uint verts)
 {
-  long i = 0;
-  float temp = 0.0;
-  /* XXX brecht, disabled this for now (first schedule line was already disabled),
-   * due to non-commutative nature of floating point ops this makes the sim give
-   * different results each time you run it!
-   * schedule(guided, 2) */
-  // #pragma omp parallel for reduction(+: temp) if (verts > CLOTH_OPENMP_LIMIT)
-  for (i = 0; i < long(verts); i++) {
-    temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+  /* Floating point addition is not associative, so the result must not depend on how the work
+   * is distributed over threads, otherwise the simulation would give different results each time
+   * it runs. Partial sums are computed over fixed size chunks and then added in order. */
+  const int chunks_num = int(verts / CLOTH_PARALLEL_GRAIN_SIZE) + 1;
+  blender::Array<float, 64> chunk_sums(chunks_num);
+  blender::threading::parallel_for(
+      blender::IndexRange(chunks_num), 1, [&](const blender::IndexRange range) {
+        for (const int chunk : range) {
+          const uint start = uint(chunk) * CLOTH_PARALLEL_GRAIN_SIZE;
+          const uint end = std::min(start + CLOTH_PARALLEL_GRAIN_SIZE, verts);
+          float temp = 0.0f;
+          for (uint i = start; i < end; i++) {
+            temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+          }
+          chunk_sums[chunk] = temp;
+        }
+      });
+  float temp = 0.0f;
+  for (const float chunk_sum : chunk_sums) {
+    temp += chunk_sum;
   }
   return temp;
 }
@@ -201,11 +218,14 @@ DO_INLINE void add_lfvector_lfvector(float (*to)[3],
 DO_INLINE void add_lfvector_lfvectorS(
     float (*to)[3], float (*fLongVectorA)[3], float (*fLongVectorB)[3], float bS, uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
-  }
+  blender::threading::parallel_for(
+      blender::IndexRange(verts),
+      CLOTH_PARALLEL_GRAIN_SIZE,
+      [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
+        }
+      });
 }
 /* `A = B * float + C * float` -> for big vector */
 DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
@@ -613,6 +633,84 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
   del_lfvector(temp);
 }
 
+/**
+ * Row-wise (CSR) index of the blocks of a sparse symmetric big matrix, which only stores the
+ * lower triangle. This allows computing every row of a product with a long vector independently,
+ * and therefore in parallel, without write conflicts between threads.
+ */
+struct BfMatrixRows {
+  /* Blocks to multiply as is, grouped by their row. */
+  blender::Array<int> direct_offsets;
+  blender::Array<int> direct_blocks;
+  /* Off-diagonal blocks to multiply transposed, grouped by their column. */
+  blender::Array<int> transposed_offsets;
+  blender::Array<int> transposed_blocks;
+};
+
+static void bfmatrix_rows_build(const fmatrix3x3 *matrix, BfMatrixRows &rows)
+{
+  using namespace blender;
+  const int vcount = int(matrix[0].vcount);
+  const int blocks_num = int(matrix[0].vcount + matrix[0].scount);
+
+  rows.direct_offsets.reinitialize(vcount + 1);
+  rows.transposed_offsets.reinitialize(vcount + 1);
+  rows.direct_offsets.fill(0);
+  rows.transposed_offsets.fill(0);
+  for (int i = 0; i < blocks_num; i++) {
+    rows.direct_offsets[matrix[i].r]++;
+    if (i >= vcount) {
+      rows.transposed_offsets[matrix[i].c]++;
+    }
+  }
+  const OffsetIndices direct = offset_indices::accumulate_counts_to_offsets(rows.direct_offsets);
+  const OffsetIndices transposed = offset_indices::accumulate_counts_to_offsets(
+      rows.transposed_offsets);
+
+  /* Blocks are added in index order, so that every row sums up its blocks in the same order as
+   * the serial multiplication does. */
+  rows.direct_blocks.reinitialize(direct.total_size());
+  rows.transposed_blocks.reinitialize(transposed.total_size());
+  Array<int> direct_fill(vcount, 0);
+  Array<int> transposed_fill(vcount, 0);
+  for (int i = 0; i < blocks_num; i++) {
+    const int r = int(matrix[i].r);
+    rows.direct_blocks[direct[r].start() + direct_fill[r]++] = i;
+    if (i >= vcount) {
+      const int c = int(matrix[i].c);
+      rows.transposed_blocks[transposed[c].start() + transposed_fill[c]++] = i;
+    }
+  }
+}
+
+/* SPARSE SYMMETRIC multiply big matrix with long vector, using the row index of the matrix.
+ * Gives the same result as #mul_bfmatrix_lfvector. */
+static void mul_bfmatrix_lfvector_rows(float (*to)[3],
+                                       const fmatrix3x3 *from,
+                                       const BfMatrixRows &rows,
+                                       const lfVector *fLongVector)
+{
+  using namespace blender;
+  const OffsetIndices<int> direct(rows.direct_offsets);
+  const OffsetIndices<int> transposed(rows.transposed_offsets);
+  threading::parallel_for(
+      IndexRange(from[0].vcount), CLOTH_PARALLEL_GRAIN_SIZE / 4, [&](const IndexRange range) {
+        for (const int64_t row : range) {
+          /* This is the lower triangle of the sparse matrix,
+           * therefore multiplication occurs with transposed sub-matrices. */
+          float transposed_sum[3] = {0.0f, 0.0f, 0.0f};
+          for (const int i : rows.transposed_blocks.as_span().slice(transposed[row])) {
+            muladd_fmatrixT_fvector(transposed_sum, from[i].m, fLongVector[from[i].r]);
+          }
+          float direct_sum[3] = {0.0f, 0.0f, 0.0f};
+          for (const int i : rows.direct_blocks.as_span().slice(direct[row])) {
+            muladd_fmatrix_fvector(direct_sum, from[i].m, fLongVector[from[i].c]);
+          }
+          add_v3_v3v3(to[row], transposed_sum, direct_sum);
+        }
+      });
+}
+
 /* SPARSE SYMMETRIC sub big matrix with big matrix. */
 /* A -= B * float + C * float --> for big matrix */
 /* VERIFIED */
@@ -742,11 +840,15 @@ BLI_INLINE void root_to_world_m3(Implicit_Data *data,
 
 DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
 {
-  uint i = 0;
-
-  for (i = 0; i < S[0].vcount; i++) {
-    mul_m3_v3(S[i].m, V[S[i].r]);
-  }
+  /* The filter matrix is block diagonal, every block affects a different vertex. */
+  blender::threading::parallel_for(
+      blender::IndexRange(S[0].vcount),
+      CLOTH_PARALLEL_GRAIN_SIZE,
+      [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          mul_m3_v3(S[i].m, V[S[i].r]);
+        }
+      });
 }
 
 /* this version of the CG algorithm does not work very well with partial constraints
@@ -839,6 +941,11 @@ static int cg_filtered(lfVector *ldV,
   lfVector *s = create_lfvector(numverts);
   float bnorm2, delta_new, delta_old, delta_target, alpha;
 
+  /* The matrix doesn't change during the iterations, index it once to multiply rows in
+   * parallel. */
+  BfMatrixRows lA_rows;
+  bfmatrix_rows_build(lA, lA_rows);
+
   cp_lfvector(ldV, z, numverts);
 
   /* d0 = filter(B)^T * P * filter(B) */
@@ -848,7 +955,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector_rows(AdV, lA, lA_rows, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -871,7 +978,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector_rows(q, lA, lA_rows, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
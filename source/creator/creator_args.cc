@@ -70,6 +70,7 @@
 #  endif
 
 #  include "DEG_depsgraph.hh"
+#  include "DEG_depsgraph_debug.hh"
 
 #  include "WM_types.hh"
 
@@ -748,6 +749,8 @@ static void print_help(bArgs *ba, bool all)
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-time");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-pretty");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-uid");
+  BLI_args_print_arg_doc(ba, "--debug-depsgraph-validate");
+  BLI_args_print_arg_doc(ba, "--debug-depsgraph-profile");
   BLI_args_print_arg_doc(ba, "--debug-ghost");
   BLI_args_print_arg_doc(ba, "--debug-wintab");
   BLI_args_print_arg_doc(ba, "--debug-gpu");
@@ -1298,6 +1301,9 @@ static const char arg_handle_debug_mode_generic_set_doc_depsgraph_pretty[] =
 static const char arg_handle_debug_mode_generic_set_doc_depsgraph_uid[] =
     "\n\t"
     "Verify validness of session-wide identifiers assigned to ID data-blocks.";
+static const char arg_handle_debug_mode_generic_set_doc_depsgraph_validate[] =
+    "\n\t"
+    "Compare dependency graphs which skipped a relations update against a full rebuild.";
 static const char arg_handle_debug_mode_generic_set_doc_gpu_force_workarounds[] =
     "\n\t"
     "Enable workarounds for typical GPU issues and disable all GPU extensions.";
@@ -1308,6 +1314,28 @@ static int arg_handle_debug_mode_generic_set(int /*argc*/, const char ** /*argv*
   return 0;
 }
 
+static const char arg_handle_debug_depsgraph_profile_set_doc[] =
+    "<filepath>\n"
+    "\tWrite the time, thread and memory change of every evaluated dependency graph operation\n"
+    "\tto a CSV file, with totals per data-block and per evaluation.";
+static int arg_handle_debug_depsgraph_profile_set(int argc, const char **argv, void * /*data*/)
+{
+  const char *arg_id = "--debug-depsgraph-profile";
+  if (argc > 1) {
+    errno = 0;
+    if (DEG_debug_profile_begin(argv[1])) {
+      G.debug |= G_DEBUG_DEPSGRAPH_PROFILE;
+    }
+    else {
+      const char *err_msg = errno ? strerror(errno) : "unknown";
+      fprintf(stderr, "\nError: %s '%s %s'.\n", err_msg, arg_id, argv[1]);
+    }
+    return 1;
+  }
+  fprintf(stderr, "\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
 static const char arg_handle_debug_mode_io_doc[] =
     "\n\t"
     "Enable debug messages for I/O (Collada, ...).";
@@ -2771,6 +2799,16 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
                "--debug-depsgraph-uid",
                CB_EX(arg_handle_debug_mode_generic_set, depsgraph_uid),
                (void *)G_DEBUG_DEPSGRAPH_UID);
+  BLI_args_add(ba,
+               nullptr,
+               "--debug-depsgraph-validate",
+               CB_EX(arg_handle_debug_mode_generic_set, depsgraph_validate),
+               (void *)G_DEBUG_DEPSGRAPH_VALIDATE);
+  BLI_args_add(ba,
+               nullptr,
+               "--debug-depsgraph-profile",
+               CB(arg_handle_debug_depsgraph_profile_set),
+               nullptr);
   BLI_args_add(ba,
                nullptr,
                "--debug-gpu-force-workarounds",